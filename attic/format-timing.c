@@ -0,0 +1,408 @@
+/*
+ * format-timing.c - Hack to time socktoa(), sockporttoa() and lfptoa()
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Runs random addresses and timestamps through the hand-built text
+ * encoders in libntp/socktoa.c and libntp/dolfptoa.c and through the
+ * inet_ntop(), snprintf() and digit-at-a-time code they replaced,
+ * copied below, and reports ns per call for each.  It also checks
+ * the two give the same string for every input.
+ *
+ * Usage: format-timing [rounds]
+ */
+
+#include "config.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <arpa/inet.h>
+
+#include "ntp_stdlib.h"
+#include "ntp_fp.h"
+#include "ntp_net.h"
+#include "lib_strbuf.h"
+
+#define NINPUTS		1000
+
+/* ------------------------------------------------------------------ */
+/* The old code, as libntp had it */
+
+static const char *
+old_socktoa_r(const sockaddr_u *sock, char *buf, size_t buflen)
+{
+	unsigned long	scope;
+
+	switch(AF(sock)) {
+
+	case AF_INET:
+	case AF_UNSPEC:
+		inet_ntop(AF_INET, PSOCK_ADDR4(sock), buf, buflen);
+		break;
+
+	case AF_INET6:
+		inet_ntop(AF_INET6, PSOCK_ADDR6(sock), buf, buflen);
+		scope = SCOPE_VAR(sock);
+		if (0 != scope && !strchr(buf, '%')) {
+			char buf2[LIB_BUFLENGTH];
+			snprintf(buf2, sizeof(buf2), "%s%%%lu",
+				 buf, scope);
+			buf2[LIB_BUFLENGTH - 1] = '\0';
+			strlcpy(buf, buf2, buflen);
+		}
+		break;
+
+	default:
+		snprintf(buf, buflen,
+			 "(socktoa unknown family %d)",
+			 AF(sock));
+	}
+	return buf;
+}
+
+static const char *
+old_sockporttoa_r(const sockaddr_u *sock, char *buf, size_t buflen)
+{
+	char buf2[LIB_BUFLENGTH];
+
+	old_socktoa_r(sock, buf2, sizeof(buf2));
+	snprintf(buf, buflen,
+		 (IS_IPV6(sock))
+		     ? "[%s]:%hu"
+		     : "%s:%hu",
+		 buf2, SRCPORT(sock));
+	return buf;
+}
+
+static char *
+old_dolfptoa_r(
+	l_fp lfp,
+	bool neg,
+	short ndec,
+	bool msec,
+	char *buf,
+	size_t buflen
+	)
+{
+	uint32_t fpi = lfpuint(lfp);
+	uint32_t fpv = lfpfrac(lfp);
+	uint8_t *cp, *cpend, *cpdec;
+	int dec;
+	uint8_t cbuf[24];
+	char *bp, *bpend;
+
+	/*
+	 * Zero the character buffer
+	 */
+	ZERO(cbuf);
+
+	/*
+	 * Work on the integral part. This should work reasonable on
+	 * all machines with 32 bit arithmetic. Please note that 32 bits
+	 * can *always* be represented with at most 10 decimal digits,
+	 * including a possible rounding from the fractional part.
+	 */
+	cp = cpend = cpdec = &cbuf[10];
+	for (dec = cp - cbuf; dec > 0 && fpi != 0; dec--) {
+		/* can add another digit */
+		uint32_t digit;
+
+		digit  = fpi;
+		fpi   /= 10U;
+		/*
+		 * This should be able to be replaced by [digit -= fpi * 10].
+		 * It is being left as is at the moment for subtle bug avoidance.
+		 */
+		digit -= (fpi << 3) + (fpi << 1); /* i*10 */
+		*--cp  = (uint8_t)digit;
+	}
+
+	/*
+	 * Done that, now deal with the problem of the fraction.  First
+	 * determine the number of decimal places.
+	 */
+	dec = ndec;
+	if (dec < 0) {
+		dec = 0;
+	}
+	if (msec) {
+		dec   += 3;
+		cpdec += 3;
+	}
+	if (dec > (long)sizeof(cbuf) - (cpend - cbuf))
+		dec = (long)sizeof(cbuf) - (cpend - cbuf);
+
+	/*
+	 * If there's a fraction to deal with, do so.
+	 */
+	for (/*NOP*/;  dec > 0 && fpv != 0;  dec--)  {
+		uint32_t digit, tmph, tmpl;
+
+		/* FIXME - get rid of this ugly kludge! */
+#define M_ADD(r_i, r_f, a_i, a_f)	/* r += a */ \
+		do { \
+			uint32_t add_t = (r_f); \
+			(r_f) += (a_f); \
+			(r_i) += (a_i) + ((uint32_t)(r_f) < add_t); \
+		} while (false)
+
+#define	M_LSHIFT(v_i, v_f)		/* v <<= 1 */ \
+		do { \
+			(v_i) = ((uint32_t)(v_i) << 1) | ((uint32_t)(v_f) >> 31);	\
+			(v_f) = ((uint32_t)(v_f) << 1); \
+		} while (false)
+
+		/*
+		 * The scheme here is to multiply the fraction
+		 * (0.1234...) by ten.  This moves a junk of BCD into
+		 * the units part.  record that and iterate.
+		 * multiply by shift/add in two dwords.
+		 */
+		digit = 0;
+		M_LSHIFT(digit, fpv);
+		tmph = digit;
+		tmpl = fpv;
+		M_LSHIFT(digit, fpv);
+		M_LSHIFT(digit, fpv);
+		M_ADD(digit, fpv, tmph, tmpl);
+#undef M_ADD
+#undef M_LSHIFT
+		*cpend++ = (uint8_t)digit;
+	}
+
+	/* decide whether to round or simply extend by zeros */
+	if (dec > 0) {
+		/* only '0' digits left -- just reposition end */
+		cpend += dec;
+	} else {
+		/* some bits remain in 'fpv'; do round */
+		uint8_t *tp    = cpend;
+		int     carry = ((fpv & 0x80000000) != 0);
+
+		for (dec = tp - cbuf;  carry && dec > 0;  dec--) {
+			*--tp += 1;
+			if (*tp == 10)
+				*tp = 0;
+			else
+				carry = false;
+		}
+
+		if (tp < cp) /* rounding from 999 to 1000 or similar? */
+			cp = tp;
+	}
+
+	/*
+	 * We've now got the fraction in cbuf[], with cp pointing at
+	 * the first character, cpend pointing past the last, and
+	 * cpdec pointing at the first character past the decimal.
+	 * Remove leading zeros, then format the number into the
+	 * buffer.
+	 */
+	while (cp < cpdec && *cp == 0)
+		cp++;
+	if (cp >= cpdec)
+		cp = cpdec - 1;
+
+	bp = buf;
+	bpend = buf + buflen - 1;
+	if (neg && bp < bpend)
+		*bp++ = '-';
+	while (cp < cpend && bp < bpend) {
+		if (cp == cpdec) {
+			*bp++ = '.';
+			if (bp == bpend)
+				break;
+		}
+		*bp++ = (char)(*cp++) + '0';
+	}
+	*bp = '\0';
+
+	/*
+	 * Done!
+	 */
+	return buf;
+}
+
+
+/* ------------------------------------------------------------------ */
+
+enum { T_ADDR4, T_ADDR6, T_PORT4, T_PORT6, T_LFPTOA, T_LFPTOMS,
+	T_RAWSTATS, NTESTS };
+
+static const char * const names[NTESTS] = {
+	"socktoa v4", "socktoa v6", "sockporttoa v4", "sockporttoa v6",
+	"lfptoa 6", "lfptoms 3", "ulfptoa 9"
+};
+
+static sockaddr_u addr4[NINPUTS], addr6[NINPUTS];
+static l_fp stamp[NINPUTS], offset[NINPUTS];
+
+static uint32_t
+rand32(void)
+{
+	return ((uint32_t)random() << 16) ^ (uint32_t)random();
+}
+
+/*
+ * IPv6 addresses with plenty of zero groups, a few IPv4-mapped and
+ * IPv4-compatible ones, and some with a scope, so every shortening
+ * rule gets used.
+ */
+static void
+make_inputs(void)
+{
+	for (int i = 0; i < NINPUTS; i++) {
+		uint8_t *a;
+
+		AF(&addr4[i]) = AF_INET;
+		PSOCK_ADDR4(&addr4[i])->s_addr = rand32();
+		SET_PORT(&addr4[i], (uint16_t)rand32());
+
+		AF(&addr6[i]) = AF_INET6;
+		a = (void *)PSOCK_ADDR6(&addr6[i]);
+		for (int w = 0; w < 8; w++) {
+			uint32_t v = (random() % 3) ? 0 : rand32();
+
+			a[2 * w] = (uint8_t)(v >> 8);
+			a[2 * w + 1] = (uint8_t)v;
+		}
+		if (0 == i % 10) {
+			memset(a, 0, 12);
+			if (i % 20)
+				a[10] = a[11] = 0xff;
+		}
+		SCOPE_VAR(&addr6[i]) = (0 == i % 7) ? rand32() % 100 : 0;
+		SET_PORT(&addr6[i], (uint16_t)rand32());
+
+		stamp[i] = lfpinit_u(3900000000U + rand32() % 100000000U,
+				     rand32());
+		offset[i] = lfpinit((int32_t)(rand32() % 20) - 10, rand32());
+	}
+}
+
+static const char *
+run(int test, bool old, int i, char *buf)
+{
+	l_fp fp;
+	bool neg;
+
+	switch (test) {
+	case T_ADDR4:
+		return old ? old_socktoa_r(&addr4[i], buf, LIB_BUFLENGTH)
+			   : socktoa_r(&addr4[i], buf, LIB_BUFLENGTH);
+	case T_ADDR6:
+		return old ? old_socktoa_r(&addr6[i], buf, LIB_BUFLENGTH)
+			   : socktoa_r(&addr6[i], buf, LIB_BUFLENGTH);
+	case T_PORT4:
+		return old ? old_sockporttoa_r(&addr4[i], buf, LIB_BUFLENGTH)
+			   : sockporttoa_r(&addr4[i], buf, LIB_BUFLENGTH);
+	case T_PORT6:
+		return old ? old_sockporttoa_r(&addr6[i], buf, LIB_BUFLENGTH)
+			   : sockporttoa_r(&addr6[i], buf, LIB_BUFLENGTH);
+	case T_LFPTOA:
+	case T_LFPTOMS:
+		fp = offset[i];
+		neg = L_ISNEG(fp);
+		if (neg)
+			L_NEG(fp);
+		if (T_LFPTOA == test)
+			return old ? old_dolfptoa_r(fp, neg, 6, false, buf,
+						    LIB_BUFLENGTH)
+				   : dolfptoa_r(fp, neg, 6, false, buf,
+						LIB_BUFLENGTH);
+		return old ? old_dolfptoa_r(fp, neg, 3, true, buf,
+					    LIB_BUFLENGTH)
+			   : dolfptoa_r(fp, neg, 3, true, buf, LIB_BUFLENGTH);
+	case T_RAWSTATS:
+	default:
+		return old ? old_dolfptoa_r(stamp[i], false, 9, false, buf,
+					    LIB_BUFLENGTH)
+			   : dolfptoa_r(stamp[i], false, 9, false, buf,
+					LIB_BUFLENGTH);
+	}
+}
+
+static double
+ns_since(struct timespec *start)
+{
+	struct timespec stop;
+
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	return (stop.tv_sec - start->tv_sec) * 1e9 +
+	       (stop.tv_nsec - start->tv_nsec);
+}
+
+int
+main(int argc, char *argv[])
+{
+	char ob[LIB_BUFLENGTH], nb[LIB_BUFLENGTH];
+	struct timespec start;
+	double t_old, t_new;
+	long rounds = 2000, r;
+	unsigned long len = 0;
+	int bad = 0;
+
+	if (argc > 2) {
+		printf("Usage: %s [rounds]\n", argv[0]);
+		exit(1);
+	}
+	if (argc > 1)
+		rounds = atol(argv[1]);
+	if (rounds <= 0) {
+		printf("Nothing to do\n");
+		exit(1);
+	}
+	make_inputs();
+
+	/* also exercise every precision for the l_fp formatter */
+	for (int i = 0; i < NINPUTS; i++) {
+		for (short d = -1; d <= 14; d++) {
+			if (strcmp(old_dolfptoa_r(offset[i], false, d, i & 1,
+						  ob, sizeof(ob)),
+				   dolfptoa_r(offset[i], false, d, i & 1,
+					      nb, sizeof(nb)))) {
+				printf("## %d digits: old %s, new %s\n",
+				       d, ob, nb);
+				bad++;
+			}
+		}
+	}
+
+	printf("# ns per call, %ld calls each\n", rounds * NINPUTS);
+	printf("# format              old       new\n");
+	for (int t = 0; t < NTESTS; t++) {
+		for (int i = 0; i < NINPUTS; i++) {
+			if (strcmp(run(t, true, i, ob), run(t, false, i, nb))) {
+				printf("## %s: old %s, new %s\n",
+				       names[t], ob, nb);
+				bad++;
+			}
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (r = 0; r < rounds; r++)
+			for (int i = 0; i < NINPUTS; i++)
+				len += strlen(run(t, true, i, ob));
+		t_old = ns_since(&start);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (r = 0; r < rounds; r++)
+			for (int i = 0; i < NINPUTS; i++)
+				len += strlen(run(t, false, i, nb));
+		t_new = ns_since(&start);
+
+		printf("%-16s %9.1f %9.1f\n", names[t],
+		       t_old / (rounds * NINPUTS), t_new / (rounds * NINPUTS));
+	}
+	if (bad)
+		printf("%d strings differ\n", bad);
+	/* keep the loops from being optimized away */
+	if (0 == len)
+		printf("no output?\n");
+	return bad ? 1 : 0;
+}
@@ -0,0 +1,413 @@
+/*
+ * gpsd-json-timing.c - Hack to time parsing of the gpsd refclock's JSON
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Runs each record of a gpsd stream through the scanner in
+ * include/gpsd_json.h and through the jsmn tokenizer plus member
+ * lookups the driver used before, looking up the members the driver
+ * wants for that class of record, and reports ns per record by class.
+ * It also checks the two agree on every member in the schema.
+ *
+ * The default stream is one cycle from a u-blox receiver behind gpsd
+ * 3.22 with PPS.  To use your own, capture it with something like
+ *
+ *   gpspipe -w -n 200 > stream.json
+ *
+ * and give the file name.
+ *
+ * Usage: gpsd-json-timing [stream-file [rounds]]
+ */
+
+#include "config.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define JSMN_STATIC
+#define JSMN_PARENT_LINKS
+#include "jsmn.h"
+
+#include "gpsd_json.h"
+
+#define MAX_PDU_LEN	8192	/* as in refclock_gpsd.c */
+#define MAXLINES	1000
+
+static const char * const capture[] = {
+	"{\"class\":\"VERSION\",\"release\":\"3.22\",\"rev\":\"3.22\","
+	"\"proto_major\":3,\"proto_minor\":14}",
+
+	"{\"class\":\"DEVICES\",\"devices\":[{\"class\":\"DEVICE\","
+	"\"path\":\"/dev/ttyACM0\",\"driver\":\"u-blox\","
+	"\"subtype\":\"SW ROM CORE 3.01 (107888),HW 00080000\","
+	"\"subtype1\":\"FWVER=SPG 3.01,PROTVER=18.00,GPS;GLO;GAL;BDS,"
+	"SBAS;IMES;QZSS\",\"activated\":\"2021-03-14T12:00:01.203Z\","
+	"\"flags\":1,\"native\":1,\"bps\":9600,\"parity\":\"N\","
+	"\"stopbits\":1,\"cycle\":1.00,\"mincycle\":0.02}]}",
+
+	"{\"class\":\"WATCH\",\"enable\":true,\"json\":true,\"nmea\":false,"
+	"\"raw\":0,\"scaled\":false,\"timing\":false,\"split24\":false,"
+	"\"pps\":true,\"device\":\"/dev/ttyACM0\"}",
+
+	"{\"class\":\"TPV\",\"device\":\"/dev/ttyACM0\",\"status\":2,"
+	"\"mode\":3,\"time\":\"2021-03-14T12:00:03.000Z\","
+	"\"leapseconds\":18,\"ept\":0.005,\"lat\":46.498293369,"
+	"\"lon\":7.567411672,\"altHAE\":1343.1270,\"altMSL\":1291.4920,"
+	"\"alt\":1291.4920,\"epx\":1.814,\"epy\":2.307,\"epv\":3.891,"
+	"\"track\":0.0000,\"magtrack\":2.7364,\"magvar\":2.7,"
+	"\"speed\":0.007,\"climb\":-0.012,\"eps\":4.61,\"epc\":7.78,"
+	"\"ecefx\":4359896.57,\"ecefy\":577837.51,\"ecefz\":4602773.74,"
+	"\"ecefvx\":-0.01,\"ecefvy\":0.00,\"ecefvz\":0.00,"
+	"\"ecefpAcc\":3.01,\"ecefvAcc\":0.07,\"velN\":0.005,"
+	"\"velE\":-0.005,\"velD\":0.012,\"geoidSep\":51.635,"
+	"\"eph\":2.952,\"sep\":4.850}",
+
+	"{\"class\":\"SKY\",\"device\":\"/dev/ttyACM0\","
+	"\"time\":\"2021-03-14T12:00:03.000Z\",\"xdop\":0.62,"
+	"\"ydop\":0.79,\"vdop\":1.35,\"tdop\":0.81,\"hdop\":1.00,"
+	"\"gdop\":1.86,\"pdop\":1.68,\"nSat\":12,\"uSat\":10,"
+	"\"satellites\":["
+	"{\"PRN\":2,\"el\":17.0,\"az\":233.0,\"ss\":20.0,\"used\":true,"
+	"\"gnssid\":0,\"svid\":2,\"health\":1},"
+	"{\"PRN\":5,\"el\":34.0,\"az\":20.0,\"ss\":31.0,\"used\":true,"
+	"\"gnssid\":0,\"svid\":5,\"health\":1},"
+	"{\"PRN\":6,\"el\":39.0,\"az\":25.0,\"ss\":20.0,\"used\":true,"
+	"\"gnssid\":0,\"svid\":6,\"health\":1},"
+	"{\"PRN\":7,\"el\":71.0,\"az\":44.0,\"ss\":24.0,\"used\":true,"
+	"\"gnssid\":0,\"svid\":7,\"health\":1},"
+	"{\"PRN\":9,\"el\":80.0,\"az\":207.0,\"ss\":28.0,\"used\":true,"
+	"\"gnssid\":0,\"svid\":9,\"health\":1},"
+	"{\"PRN\":13,\"el\":8.0,\"az\":308.0,\"ss\":25.0,\"used\":false,"
+	"\"gnssid\":0,\"svid\":13,\"health\":1},"
+	"{\"PRN\":15,\"el\":14.0,\"az\":110.0,\"ss\":40.0,\"used\":true,"
+	"\"gnssid\":0,\"svid\":15,\"health\":1},"
+	"{\"PRN\":20,\"el\":51.0,\"az\":229.0,\"ss\":28.0,\"used\":true,"
+	"\"gnssid\":0,\"svid\":20,\"health\":1},"
+	"{\"PRN\":66,\"el\":39.0,\"az\":112.0,\"ss\":33.0,\"used\":true,"
+	"\"gnssid\":6,\"svid\":2},"
+	"{\"PRN\":67,\"el\":29.0,\"az\":285.0,\"ss\":36.0,\"used\":true,"
+	"\"gnssid\":6,\"svid\":3},"
+	"{\"PRN\":76,\"el\":51.0,\"az\":188.0,\"ss\":41.0,\"used\":true,"
+	"\"gnssid\":6,\"svid\":12},"
+	"{\"PRN\":77,\"el\":28.0,\"az\":351.0,\"ss\":21.0,\"used\":false,"
+	"\"gnssid\":6,\"svid\":13}]}",
+
+	"{\"class\":\"TOFF\",\"device\":\"/dev/ttyACM0\","
+	"\"real_sec\":1615723203,\"real_nsec\":0,"
+	"\"clock_sec\":1615723203,\"clock_nsec\":82637291,"
+	"\"precision\":-1}",
+
+	"{\"class\":\"PPS\",\"device\":\"/dev/ttyACM0\","
+	"\"real_sec\":1615723204,\"real_nsec\":0,"
+	"\"clock_sec\":1615723204,\"clock_nsec\":12513,"
+	"\"precision\":-20,\"qErr\":-11012}",
+};
+
+/* What refclock_gpsd.c looks up for each class it handles */
+static const struct {
+	const char *	name;
+	int		keys[8];	/* terminated by -1 */
+} classes[] = {
+	{ "TPV",     { GJ_MODE, GJ_TIME, GJ_EPT, -1 } },
+	{ "PPS",     { GJ_CLOCK_SEC, GJ_CLOCK_NSEC, GJ_REAL_SEC,
+		       GJ_REAL_NSEC, GJ_PRECISION, -1 } },
+	{ "TOFF",    { GJ_CLOCK_SEC, GJ_CLOCK_NSEC, GJ_REAL_SEC,
+		       GJ_REAL_NSEC, -1 } },
+	{ "VERSION", { GJ_REV, GJ_RELEASE, GJ_PROTO_MAJOR,
+		       GJ_PROTO_MINOR, -1 } },
+	{ "WATCH",   { GJ_DEVICE, GJ_ENABLE, GJ_JSON, -1 } },
+	{ NULL,      { -1 } }	/* everything else is ignored */
+};
+#define NCLASSES	(sizeof(classes) / sizeof(classes[0]))
+
+/* ------------------------------------------------------------------ */
+/* The jsmn path, as refclock_gpsd.c had it */
+
+#define JSMN_MAXTOK	350
+
+typedef struct json_ctx {
+	char *		buf;
+	int		ntok;
+	jsmntok_t	tok[JSMN_MAXTOK];
+} json_ctx;
+
+static int
+json_token_skip(const json_ctx *ctx, int tid)
+{
+	if (tid >= 0 && tid < ctx->ntok) {
+		int len = ctx->tok[tid].size;
+		switch (ctx->tok[tid].type) {
+		case JSMN_OBJECT:
+			len *= 2;
+			/* FALLTHROUGH */
+		case JSMN_ARRAY:
+			for (++tid; len; --len)
+				tid = json_token_skip(ctx, tid);
+			break;
+		case JSMN_PRIMITIVE:
+		case JSMN_STRING:
+		default:
+			++tid;
+			break;
+		}
+		if (tid > ctx->ntok)
+			tid = ctx->ntok;
+	}
+	return tid;
+}
+
+static int
+json_object_lookup(const json_ctx *ctx, int tid, const char *key, int what)
+{
+	int len;
+
+	if (tid < 0 || tid >= ctx->ntok ||
+	    ctx->tok[tid].type != JSMN_OBJECT)
+		return -1;
+	len = ctx->tok[tid].size;
+	for (++tid; len && tid+1 < ctx->ntok; --len) {
+		if (ctx->tok[tid].type != JSMN_STRING) {
+			tid = json_token_skip(ctx, tid);
+			tid = json_token_skip(ctx, tid);
+		} else if (strcmp(key, ctx->buf + ctx->tok[tid].start)) {
+			tid = json_token_skip(ctx, tid+1);
+		} else if (what < 0 || what == (int)ctx->tok[tid+1].type) {
+			return tid + 1;
+		} else {
+			break;
+		}
+		if (tid < 0)
+			break;
+	}
+	return -1;
+}
+
+static bool
+json_parse_record(json_ctx *ctx, char *buf, size_t len)
+{
+	jsmn_parser jsm;
+	int idx, rc;
+
+	jsmn_init(&jsm);
+	rc = jsmn_parse(&jsm, buf, len, ctx->tok, JSMN_MAXTOK);
+	if (rc <= 0)
+		return false;
+	ctx->buf = buf;
+	ctx->ntok = rc;
+	if (JSMN_OBJECT != ctx->tok[0].type)
+		return false;
+	for (idx = 0; idx < ctx->ntok; ++idx)
+		if (ctx->tok[idx].end > ctx->tok[idx].start)
+			ctx->buf[ctx->tok[idx].end] = '\0';
+	return true;
+}
+
+/* ------------------------------------------------------------------ */
+
+static int
+class_of(const char *name)
+{
+	unsigned int i;
+
+	for (i = 0; NULL != classes[i].name; i++)
+		if (NULL != name && !strcmp(name, classes[i].name))
+			break;
+	return (int)i;
+}
+
+/* One record the old way; returns the class index */
+static int
+parse_jsmn(json_ctx *ctx, char *buf, size_t len, const char **out)
+{
+	const char *clsid;
+	int cls, k, tid;
+
+	if (!json_parse_record(ctx, buf, len))
+		return -1;
+	tid = json_object_lookup(ctx, 0, gpsd_json_schema[GJ_CLASS].name,
+				 JSMN_STRING);
+	clsid = (tid < 0) ? NULL : ctx->buf + ctx->tok[tid].start;
+	cls = class_of(clsid);
+	for (k = 0; classes[cls].keys[k] >= 0; k++) {
+		tid = json_object_lookup(ctx, 0,
+			gpsd_json_schema[classes[cls].keys[k]].name, -1);
+		out[k] = (tid < 0) ? NULL : ctx->buf + ctx->tok[tid].start;
+	}
+	return cls;
+}
+
+/* One record the new way */
+static int
+parse_scan(struct gpsd_json *ctx, char *buf, const char **out)
+{
+	const char *clsid;
+	int cls, k;
+
+	if (!gpsd_json_scan(ctx, buf))
+		return -1;
+	clsid = (GJT_STRING == ctx->type[GJ_CLASS]) ? ctx->val[GJ_CLASS] : NULL;
+	cls = class_of(clsid);
+	for (k = 0; classes[cls].keys[k] >= 0; k++)
+		out[k] = (GJT_NONE == ctx->type[classes[cls].keys[k]]) ?
+			 NULL : ctx->val[classes[cls].keys[k]];
+	return cls;
+}
+
+/* Do the two agree on every member in the schema? */
+static int
+compare(const char *line, json_ctx *jctx, struct gpsd_json *sctx)
+{
+	static char a[MAX_PDU_LEN], b[MAX_PDU_LEN];
+	size_t len = strlen(line);
+	bool ok_j, ok_s;
+	int i, tid, bad = 0;
+	const char *vj, *vs;
+
+	memcpy(a, line, len + 1);
+	memcpy(b, line, len + 1);
+	ok_j = json_parse_record(jctx, a, len);
+	ok_s = gpsd_json_scan(sctx, b);
+	if (ok_j != ok_s) {
+		printf("## jsmn %s, scanner %s: %.60s\n",
+		       ok_j ? "accepts" : "rejects",
+		       ok_s ? "accepts" : "rejects", line);
+		return 1;
+	}
+	if (!ok_j)
+		return 0;
+	for (i = 0; i < GJ_NKEYS; i++) {
+		tid = json_object_lookup(jctx, 0, gpsd_json_schema[i].name,
+					 JSMN_STRING);
+		vj = (tid < 0) ? NULL : jctx->buf + jctx->tok[tid].start;
+		vs = (GJT_STRING == sctx->type[i]) ? sctx->val[i] : NULL;
+		if ((NULL == vj) != (NULL == vs) ||
+		    (NULL != vj && strcmp(vj, vs)))
+			bad++;
+		tid = json_object_lookup(jctx, 0, gpsd_json_schema[i].name,
+					 JSMN_PRIMITIVE);
+		vj = (tid < 0) ? NULL : jctx->buf + jctx->tok[tid].start;
+		vs = (GJT_PRIMITIVE == sctx->type[i]) ? sctx->val[i] : NULL;
+		if ((NULL == vj) != (NULL == vs) ||
+		    (NULL != vj && strcmp(vj, vs)))
+			bad++;
+	}
+	if (bad)
+		printf("## %d differences: %.60s\n", bad, line);
+	return bad;
+}
+
+static double
+ns_since(struct timespec *start)
+{
+	struct timespec stop;
+
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	return (stop.tv_sec - start->tv_sec) * 1e9 +
+	       (stop.tv_nsec - start->tv_nsec);
+}
+
+static int
+load(const char *path, char **lines)
+{
+	char buf[MAX_PDU_LEN];
+	FILE *fp;
+	size_t len;
+	int n = 0;
+
+	fp = fopen(path, "r");
+	if (NULL == fp) {
+		perror(path);
+		exit(1);
+	}
+	while (n < MAXLINES && NULL != fgets(buf, sizeof(buf), fp)) {
+		len = strcspn(buf, "\r\n");
+		buf[len] = '\0';
+		if (len > 0)
+			lines[n++] = strdup(buf);
+	}
+	fclose(fp);
+	return n;
+}
+
+int
+main(int argc, char *argv[])
+{
+	static json_ctx jctx;
+	static struct gpsd_json sctx;
+	static char buf[MAX_PDU_LEN];
+	char *lines[MAXLINES];
+	size_t lens[MAXLINES];
+	const char *out[8];
+	double t_jsmn[NCLASSES + 1], t_scan[NCLASSES + 1];
+	unsigned long count[NCLASSES + 1];
+	struct timespec start;
+	long rounds = 100000, r;
+	int nlines, i, cls, bad = 0;
+	unsigned int c;
+
+	if (argc > 3) {
+		printf("Usage: %s [stream-file [rounds]]\n", argv[0]);
+		exit(1);
+	}
+	if (argc > 1) {
+		nlines = load(argv[1], lines);
+	} else {
+		nlines = sizeof(capture) / sizeof(capture[0]);
+		for (i = 0; i < nlines; i++)
+			lines[i] = strdup(capture[i]);
+	}
+	if (argc > 2)
+		rounds = atol(argv[2]);
+	if (0 == nlines || rounds <= 0) {
+		printf("Nothing to do\n");
+		exit(1);
+	}
+
+	for (i = 0; i < nlines; i++) {
+		lens[i] = strlen(lines[i]);
+		bad += compare(lines[i], &jctx, &sctx);
+	}
+
+	memset(t_jsmn, 0, sizeof(t_jsmn));
+	memset(t_scan, 0, sizeof(t_scan));
+	memset(count, 0, sizeof(count));
+	for (i = 0; i < nlines; i++) {
+		/* both parsers write into the line, so each gets a copy */
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (r = 0; r < rounds; r++) {
+			memcpy(buf, lines[i], lens[i] + 1);
+			cls = parse_jsmn(&jctx, buf, lens[i], out);
+		}
+		c = (cls < 0) ? NCLASSES : (unsigned int)cls;
+		t_jsmn[c] += ns_since(&start);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (r = 0; r < rounds; r++) {
+			memcpy(buf, lines[i], lens[i] + 1);
+			cls = parse_scan(&sctx, buf, out);
+		}
+		t_scan[c] += ns_since(&start);
+		count[c] += (unsigned long)rounds;
+	}
+
+	printf("# ns per record\n");
+	printf("# class      records      jsmn   scanner\n");
+	for (c = 0; c <= NCLASSES; c++) {
+		if (0 == count[c])
+			continue;
+		printf("%-9s %10lu %9.0f %9.0f\n",
+		       (c == NCLASSES) ? "(bad)" :
+		       (NULL == classes[c].name) ? "(other)" : classes[c].name,
+		       count[c] / (unsigned long)rounds,
+		       t_jsmn[c] / count[c], t_scan[c] / count[c]);
+	}
+	if (bad)
+		printf("## %d records parsed differently\n", bad);
+	for (i = 0; i < nlines; i++)
+		free(lines[i]);
+	return bad ? 1 : 0;
+}
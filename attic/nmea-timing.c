@@ -0,0 +1,394 @@
+/*
+ * nmea-timing.c - Hack to time parsing of NMEA sentences
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Replays a log of NMEA sentences through the splitter in
+ * include/nmea_sentence.h and through the field_init(), field_parse()
+ * and sscanf() path the NMEA driver used before, pulling out the time,
+ * date and status the driver would for each sentence, and reports ns
+ * per sentence by type.  It also checks the two agree on every
+ * sentence.
+ *
+ * The default log is one cycle from a receiver sending RMC, GGA, GLL,
+ * GSA, GSV, ZDA and Garmin's PGRMF.  To use your own, capture it with
+ * something like
+ *
+ *   cat /dev/gps0 | head -200 > nmea.log
+ *
+ * and give the file name.
+ *
+ * Usage: nmea-timing [log-file [rounds]]
+ */
+
+#include "config.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "nmea_sentence.h"
+
+#define MAXLINE		128	/* BMAX in ntp_refclock.h */
+#define MAXLINES	1000
+
+static const char * const capture[] = {
+	"$GPRMC,120003.00,A,4629.89760,N,00734.04470,E,0.013,,140321,,,A*79",
+	"$GPGGA,120003.00,4629.89760,N,00734.04470,E,1,10,1.00,1291.5,M,"
+	"51.6,M,,*6E",
+	"$GNGLL,4629.89760,N,00734.04470,E,120003.00,A,A*79",
+	"$GPGSA,A,3,02,05,06,07,09,13,20,30,,,,,1.68,1.00,1.35*07",
+	"$GPGSV,3,1,12,02,17,233,20,05,34,020,31,06,39,025,20,07,71,044,24*70",
+	"$GPGSV,3,2,12,09,52,285,33,13,26,172,29,20,14,316,18,30,66,120,35*7F",
+	"$GPZDA,120003.00,14,03,2021,00,00*61",
+	"$PGRMF,2149,129621,140321,120003,18,4629.8976,N,00734.0447,E,A,2,0,"
+	"0,2,1*2A",
+};
+
+static const char * const names[NMEA_ARRAY_SIZE + 1] = {
+	"RMC", "GGA", "GLL", "ZDA", "ZDG", "PGRMF", "other"
+};
+
+/* what the driver gets out of a sentence */
+struct result {
+	int		check;
+	int		sentence;
+	bool		rc_time;
+	bool		rc_date;
+	struct timespec	date;
+	char		qual;
+};
+
+/* ------------------------------------------------------------------ */
+/* The old path, as refclock_nmea.c had it */
+
+typedef struct {
+	char  *base;	/* buffer base		*/
+	char  *cptr;	/* current field ptr	*/
+	int    blen;	/* buffer length	*/
+	int    cidx;	/* current field index	*/
+} old_data;
+
+static int
+field_init(old_data *data, char *cptr, int dlen)
+{
+	uint8_t cs_l = 0, cs_r = 0;
+	char *eptr, tmp;
+
+	if (dlen < 0)
+		dlen = 0;
+	eptr = cptr + dlen;
+	*eptr = '\0';
+	data->base = cptr;
+	data->cptr = cptr;
+	data->cidx = 0;
+	data->blen = dlen;
+	if (*cptr == '\0')
+		return CHECK_EMPTY;
+	if (*cptr++ != '$')
+		return CHECK_INVALID;
+	data->base++;
+	data->cptr++;
+	data->blen--;
+	if (*cptr < 'A' || *cptr > 'Z')
+		return CHECK_INVALID;
+	cs_l ^= *cptr++;
+	while ((*cptr >= 'A' && *cptr <= 'Z') ||
+	       (*cptr >= '0' && *cptr <= '9'))
+		cs_l ^= *cptr++;
+	if (*cptr != ',' || (cptr - data->base) < NMEA_PROTO_IDLEN)
+		return CHECK_INVALID;
+	cs_l ^= *cptr++;
+	while (*cptr && *cptr != '*')
+		cs_l ^= *cptr++;
+	if (*cptr == '\0')
+		return CHECK_VALID;
+	if (*cptr != '*' || cptr != eptr - 3 ||
+	    (cptr - data->base) >= NMEA_PROTO_MAXLEN)
+		return CHECK_INVALID;
+	for (cptr++; (tmp = *cptr) != '\0'; cptr++) {
+		if (tmp >= '0' && tmp <= '9')
+			cs_r = (cs_r << 4) + (tmp - '0');
+		else if (tmp >= 'A' && tmp <= 'F')
+			cs_r = (cs_r << 4) + (tmp - 'A' + 10);
+		else
+			break;
+	}
+	if (cptr != eptr || cs_l != cs_r)
+		return CHECK_INVALID;
+	return CHECK_CSVALID;
+}
+
+static char *
+field_parse(old_data *data, int fn)
+{
+	char tmp;
+
+	if (fn < data->cidx) {
+		data->cidx = 0;
+		data->cptr = data->base;
+	}
+	while ((fn > data->cidx) && (tmp = *data->cptr) != '\0') {
+		data->cidx += (tmp == ',');
+		data->cptr++;
+	}
+	return data->cptr;
+}
+
+static bool
+parse_time(struct timespec *dt, old_data *rd, int idx)
+{
+	static const unsigned long weight[4] = {
+		0, 100000000, 10000000, 1000000
+	};
+	unsigned int h, m, s;
+	unsigned long f;
+	int rc, p1, p2;
+	char *dp;
+
+	dp = field_parse(rd, idx);
+	rc = sscanf(dp, "%2u%2u%2u%n.%3lu%n", &h, &m, &s, &p1, &f, &p2);
+	if (rc < 3 || p1 != 6)
+		return false;
+	if (h > 23 || m > 59 || s > 60)
+		return false;
+	dt->tv_sec += h*3600 + m*60 + s;
+	if (rc == 4)
+		dt->tv_nsec += (long)(f * weight[p2 - p1 - 1]);
+	return true;
+}
+
+static bool
+parse_date(struct timespec *dt, old_data *rd, int idx, enum date_fmt fmt)
+{
+	unsigned int y, m, d;
+	int rc, p;
+	char *dp;
+	struct tm tm;
+
+	dp = field_parse(rd, idx);
+	switch (fmt) {
+	case DATE_1_DDMMYY:
+		rc = sscanf(dp, "%2u%2u%2u%n", &d, &m, &y, &p);
+		if (rc != 3 || p != 6)
+			return false;
+		y += (y > 80) ? 1900 : 2000;
+		break;
+	case DATE_3_DDMMYYYY:
+		rc = sscanf(dp, "%2u,%2u,%4u%n", &d, &m, &y, &p);
+		if (rc != 3 || p != 10)
+			return false;
+		break;
+	default:
+		return false;
+	}
+	if (d < 1 || d > 31 || m < 1 || m > 12)
+		return false;
+	memset(&tm, 0, sizeof(tm));
+	tm.tm_year = (int)y - 1900;
+	tm.tm_mon = (int)m - 1;
+	tm.tm_mday = (int)d;
+	dt->tv_sec += timegm(&tm);
+	return true;
+}
+
+static void
+parse_old(char *line, int len, struct result *res)
+{
+	old_data rd;
+	const struct nmea_layout *lay;
+	char *cp;
+
+	memset(res, 0, sizeof(*res));
+	res->sentence = -1;
+	res->check = field_init(&rd, line, len);
+	if (res->check <= CHECK_INVALID)
+		return;
+	cp = field_parse(&rd, 0);
+	if      (strncmp(cp + 2, "RMC,", 4) == 0)
+		res->sentence = NMEA_GPRMC;
+	else if (strncmp(cp + 2, "GGA,", 4) == 0)
+		res->sentence = NMEA_GPGGA;
+	else if (strncmp(cp + 2, "GLL,", 4) == 0)
+		res->sentence = NMEA_GPGLL;
+	else if (strncmp(cp + 2, "ZDA,", 4) == 0)
+		res->sentence = NMEA_GPZDA;
+	else if (strncmp(cp + 2, "ZDG,", 4) == 0)
+		res->sentence = NMEA_GPZDG;
+	else if (strncmp(cp,   "PGRMF,", 6) == 0)
+		res->sentence = NMEA_PGRMF;
+	else
+		return;
+
+	/* the driver's field order, so field_parse() backs up as it did */
+	lay = &nmea_layout[res->sentence];
+	res->rc_time = parse_time(&res->date, &rd, lay->time);
+	if (lay->qual >= 0)
+		res->qual = *field_parse(&rd, lay->qual);
+	if (DATE_NONE != lay->datefmt)
+		res->rc_date = parse_date(&res->date, &rd, lay->date,
+					  (enum date_fmt)lay->datefmt);
+}
+
+/* ------------------------------------------------------------------ */
+
+static void
+parse_new(char *line, int len, struct result *res)
+{
+	nmea_data rd;
+	const struct nmea_layout *lay;
+
+	memset(res, 0, sizeof(*res));
+	res->sentence = -1;
+	res->check = nmea_scan(&rd, line, len);
+	if (res->check <= CHECK_INVALID)
+		return;
+	res->sentence = nmea_lookup(&rd);
+	if (res->sentence < 0)
+		return;
+	lay = &nmea_layout[res->sentence];
+	res->rc_time = nmea_parse_time(&res->date, nmea_field(&rd, lay->time));
+	if (lay->qual >= 0)
+		res->qual = *nmea_field(&rd, lay->qual);
+	if (DATE_NONE != lay->datefmt)
+		res->rc_date = nmea_parse_date(&res->date,
+					       nmea_field(&rd, lay->date),
+					       (enum date_fmt)lay->datefmt);
+}
+
+/* Do the two agree?  Returns the sentence index for the tally */
+static int
+compare(const char *line, int *bad)
+{
+	char a[MAXLINE], b[MAXLINE];
+	struct result ro, rn;
+	int len = (int)strlen(line);
+
+	memcpy(a, line, (size_t)len + 1);
+	memcpy(b, line, (size_t)len + 1);
+	parse_old(a, len, &ro);
+	parse_new(b, len, &rn);
+	if (ro.check != rn.check || ro.sentence != rn.sentence ||
+	    ro.rc_time != rn.rc_time || ro.rc_date != rn.rc_date ||
+	    ro.date.tv_sec != rn.date.tv_sec ||
+	    ro.date.tv_nsec != rn.date.tv_nsec || ro.qual != rn.qual) {
+		printf("## old %d/%d/%lld.%09ld/%c, new %d/%d/%lld.%09ld/%c: "
+		       "%.60s\n",
+		       ro.check, ro.sentence, (long long)ro.date.tv_sec,
+		       ro.date.tv_nsec, ro.qual ? ro.qual : '-',
+		       rn.check, rn.sentence, (long long)rn.date.tv_sec,
+		       rn.date.tv_nsec, rn.qual ? rn.qual : '-', line);
+		(*bad)++;
+	}
+	return (ro.sentence < 0) ? NMEA_ARRAY_SIZE : ro.sentence;
+}
+
+static double
+ns_since(struct timespec *start)
+{
+	struct timespec stop;
+
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	return (stop.tv_sec - start->tv_sec) * 1e9 +
+	       (stop.tv_nsec - start->tv_nsec);
+}
+
+static int
+load(const char *path, char **lines)
+{
+	char buf[MAXLINE];
+	FILE *fp;
+	size_t len;
+	int n = 0;
+
+	fp = fopen(path, "r");
+	if (NULL == fp) {
+		perror(path);
+		exit(1);
+	}
+	while (n < MAXLINES && NULL != fgets(buf, sizeof(buf), fp)) {
+		len = strcspn(buf, "\r\n");
+		buf[len] = '\0';
+		if (len > 0)
+			lines[n++] = strdup(buf);
+	}
+	fclose(fp);
+	return n;
+}
+
+int
+main(int argc, char *argv[])
+{
+	static char buf[MAXLINE];
+	char *lines[MAXLINES];
+	int lens[MAXLINES];
+	struct result res;
+	double t_old[NMEA_ARRAY_SIZE + 1], t_new[NMEA_ARRAY_SIZE + 1];
+	double o = 0, n = 0;
+	unsigned long count[NMEA_ARRAY_SIZE + 1], total = 0;
+	struct timespec start;
+	long rounds = 100000, r;
+	int nlines, i, c, bad = 0;
+
+	if (argc > 3) {
+		printf("Usage: %s [log-file [rounds]]\n", argv[0]);
+		exit(1);
+	}
+	if (argc > 1) {
+		nlines = load(argv[1], lines);
+	} else {
+		nlines = sizeof(capture) / sizeof(capture[0]);
+		for (i = 0; i < nlines; i++)
+			lines[i] = strdup(capture[i]);
+	}
+	if (argc > 2)
+		rounds = atol(argv[2]);
+	if (0 == nlines || rounds <= 0) {
+		printf("Nothing to do\n");
+		exit(1);
+	}
+
+	memset(t_old, 0, sizeof(t_old));
+	memset(t_new, 0, sizeof(t_new));
+	memset(count, 0, sizeof(count));
+	for (i = 0; i < nlines; i++) {
+		lens[i] = (int)strlen(lines[i]);
+		c = compare(lines[i], &bad);
+
+		/* both write into the line, so each round gets a copy */
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (r = 0; r < rounds; r++) {
+			memcpy(buf, lines[i], (size_t)lens[i] + 1);
+			parse_old(buf, lens[i], &res);
+		}
+		t_old[c] += ns_since(&start);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (r = 0; r < rounds; r++) {
+			memcpy(buf, lines[i], (size_t)lens[i] + 1);
+			parse_new(buf, lens[i], &res);
+		}
+		t_new[c] += ns_since(&start);
+		count[c] += (unsigned long)rounds;
+	}
+
+	printf("# ns per sentence\n");
+	printf("# type     sentences       old       new\n");
+	for (c = 0; c <= NMEA_ARRAY_SIZE; c++) {
+		if (0 == count[c])
+			continue;
+		printf("%-7s %12lu %9.1f %9.1f\n", names[c], count[c],
+		       t_old[c] / count[c], t_new[c] / count[c]);
+		o += t_old[c];
+		n += t_new[c];
+		total += count[c];
+	}
+	printf("%-7s %12lu %9.1f %9.1f\n", "all", total, o / total,
+	       n / total);
+	if (bad)
+		printf("%d sentences parsed differently\n", bad);
+	return bad ? 1 : 0;
+}
@@ -0,0 +1,571 @@
+/*
+ * ntp-load.c - Hack to load test an ntpd server.
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Blasts mode 3 requests at a server (normally a local ntpd over
+ * loopback) with sendmmsg() and collects the replies with recvmmsg().
+ * Reports, per traffic class, requests sent, replies, KoDs, loss and
+ * request to reply latency percentiles.
+ *
+ * Traffic classes, mixed by weight with -m:
+ *   plain    no authentication
+ *   md5      symmetric key, keyid from -M, key from -k keyfile
+ *   cmac     symmetric key, keyid from -C, key from -k keyfile
+ *   nts      NTS, cookies from an NTS-KE exchange with -N host
+ *   junk     malformed packets, no reply expected
+ *   limited  plain requests all from one source address, so
+ *            "restrict ... limited kod" has something to chew on
+ *
+ * The request sequence number goes in the transmit timestamp; the
+ * server copies it to the origin timestamp of the reply.
+ *
+ * For IPv4 loopback servers, -n N spreads traffic over N source
+ * addresses 127.0.1.1 and up.  The limited class uses 127.0.2.1.
+ * Elsewhere all classes share one ephemeral socket.
+ *
+ * NTS cookies are reused round robin.  The server doesn't notice, so
+ * it does the same work, but replies are not checked.
+ *
+ * The server's rate limiting will kick in unless it is configured
+ * with something like "restrict 127.0.0.0 mask 255.0.0.0".
+ *
+ * Usage: ntp-load [-s server] [-r pps] [-d seconds] [-w seconds]
+ *                 [-b batch] [-n sources] [-m class=weight,...]
+ *                 [-k keyfile] [-M keyid] [-C keyid]
+ *                 [-N ke-host[:port]] [-A ca-file] [-V]
+ */
+
+#include "config.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "ntp.h"
+#include "ntp_auth.h"
+#include "ntp_net.h"
+#include "ntp_stdlib.h"
+#include "ntp_syslog.h"
+#ifndef DISABLE_NTS
+#include "ntpd.h"
+#include "nts.h"
+#include "ntp_dns.h"
+#endif
+
+const char *progname = "ntp-load";
+
+enum class {
+	C_PLAIN, C_MD5, C_CMAC, C_NTS, C_JUNK, C_LIMITED, CLASSES
+};
+
+static const char *class_name[CLASSES] = {
+	"plain", "md5", "cmac", "nts", "junk", "limited"
+};
+
+#define MAX_BATCH	256
+#define MAX_SOURCES	64
+#define RING		(1<<20)		/* requests in flight */
+#define PKT_SIZE	(LEN_PKT_NOMAC + MAX_MAC_LEN + 1200)
+
+struct sent {
+	uint64_t when;		/* CLOCK_MONOTONIC ns, 0 if answered */
+	uint64_t seq;
+	uint8_t class;
+};
+
+struct stats {
+	uint64_t sent, replies, kods;
+	uint32_t *lat;		/* reply latency in ns */
+	size_t nlat, maxlat;
+};
+
+struct batch {
+	int fd;
+	int count;
+	struct mmsghdr msgs[MAX_BATCH];
+	struct iovec iov[MAX_BATCH];
+	uint8_t pkt[MAX_BATCH][PKT_SIZE];
+};
+
+static struct sent *ring;
+static struct stats stats[CLASSES];
+static uint64_t late;		/* replies we can't match to a request */
+static int weight[CLASSES];
+
+static sockaddr_u server;
+static int srcfd[MAX_SOURCES], nsources = 1, hotfd = -1;
+static struct batch srcbatch, hotbatch;
+static auth_info *md5key, *cmackey;
+#ifndef DISABLE_NTS
+static struct peer ntspeer;
+#endif
+
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+#ifndef DISABLE_NTS
+/* The DNS callbacks live in ntp_proto.c.  nts_client.c needs them. */
+void dns_take_server(struct peer *a, sockaddr_u *b) {
+	UNUSED_ARG(a);
+	UNUSED_ARG(b);
+}
+
+void dns_take_status(struct peer *a, DNS_Status b) {
+	UNUSED_ARG(a);
+	UNUSED_ARG(b);
+}
+#endif
+
+static void usage(void) {
+	printf("Usage: %s [-s server] [-r pps] [-d seconds] [-w seconds]\n"
+	       "          [-b batch] [-n sources] [-m class=weight,...]\n"
+	       "          [-k keyfile] [-M keyid] [-C keyid]\n"
+	       "          [-N ke-host[:port]] [-A ca-file] [-V]\n"
+	       "classes: plain md5 cmac nts junk limited\n", progname);
+	exit(1);
+}
+
+static void parse_mix(char *arg) {
+	char *item, *save = NULL;
+	int total = 0;
+
+	memset(weight, 0, sizeof(weight));
+	for (item = strtok_r(arg, ",", &save); NULL != item;
+	     item = strtok_r(NULL, ",", &save)) {
+		char *eq = strchr(item, '=');
+		int w = 1, c;
+		if (NULL != eq) {
+			*eq++ = '\0';
+			w = atoi(eq);
+		}
+		for (c = 0; c < CLASSES; c++)
+			if (0 == strcmp(item, class_name[c]))
+				break;
+		if (CLASSES == c || w < 0) {
+			printf("## Oops, bad mix item: %s\n", item);
+			usage();
+		}
+		weight[c] = w;
+	}
+	for (int c = 0; c < CLASSES; c++)
+		total += weight[c];
+	if (0 == total) {
+		printf("## Oops, the mix has no weight.\n");
+		usage();
+	}
+}
+
+/* Smooth weighted round robin: deterministic, evenly interleaved. */
+static int next_class(void) {
+	static int current[CLASSES];
+	int total = 0, best = -1;
+
+	for (int c = 0; c < CLASSES; c++) {
+		if (0 == weight[c])
+			continue;
+		current[c] += weight[c];
+		total += weight[c];
+		if (best < 0 || current[c] > current[best])
+			best = c;
+	}
+	current[best] -= total;
+	return best;
+}
+
+static int open_socket(const char *bindto) {
+	int fd = socket(AF(&server), SOCK_DGRAM, 0);
+	int bufsize = 4*1024*1024;
+
+	if (fd < 0) {
+		perror("socket");
+		exit(1);
+	}
+	setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufsize, sizeof(bufsize));
+	setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &bufsize, sizeof(bufsize));
+	if (NULL != bindto) {
+		struct sockaddr_in sin;
+		memset(&sin, 0, sizeof(sin));
+		sin.sin_family = AF_INET;
+		inet_pton(AF_INET, bindto, &sin.sin_addr);
+		if (bind(fd, (struct sockaddr *)&sin, sizeof(sin)) < 0) {
+			printf("## Oops, can't bind to %s: %s\n",
+			       bindto, strerror(errno));
+			exit(1);
+		}
+	}
+	return fd;
+}
+
+static void open_sockets(void) {
+	bool loopback = IS_IPV4(&server) &&
+	    127 == (ntohl(PSOCK_ADDR4(&server)->s_addr) >> 24);
+	char addr[32];
+
+	if (!loopback)
+		nsources = 1;
+	for (int i = 0; i < nsources; i++) {
+		snprintf(addr, sizeof(addr), "127.0.1.%d", i+1);
+		srcfd[i] = open_socket(loopback ? addr : NULL);
+	}
+	hotfd = loopback ? open_socket("127.0.2.1") : srcfd[0];
+}
+
+/* Build one request.  Returns its length. */
+static size_t make_request(int class, uint64_t seq, uint8_t *buf) {
+	struct pkt *xpkt = (struct pkt *)buf;
+	size_t len = LEN_PKT_NOMAC;
+
+	memset(xpkt, 0, LEN_PKT_NOMAC);
+	xpkt->li_vn_mode = PKT_LI_VN_MODE(LEAP_NOTINSYNC, NTP_VERSION, MODE_CLIENT);
+	xpkt->stratum = STRATUM_PKT_UNSPEC;
+	xpkt->ppoll = NTP_MINPOLL;
+	xpkt->precision = -20;
+	xpkt->xmt.l_ui = htonl((uint32_t)(seq >> 32));
+	xpkt->xmt.l_uf = htonl((uint32_t)seq);
+
+	switch (class) {
+	    case C_MD5:
+		len += (size_t)authencrypt(md5key, (uint32_t *)xpkt, (int)len);
+		break;
+	    case C_CMAC:
+		len += (size_t)authencrypt(cmackey, (uint32_t *)xpkt, (int)len);
+		break;
+	    case C_NTS:
+#ifndef DISABLE_NTS
+		/* Always have all cookies, so no placeholders */
+		ntspeer.nts_state.count = NTS_MAX_COOKIES;
+		len += (size_t)extens_client_send(&ntspeer, xpkt);
+#endif
+		break;
+	    case C_JUNK:
+		/* Too short, bad version, or bad MAC length */
+		switch (seq % 3) {
+		    case 0:
+			len = 1 + seq % (LEN_PKT_NOMAC-1);
+			break;
+		    case 1:
+			xpkt->li_vn_mode = PKT_LI_VN_MODE(LEAP_NOTINSYNC,
+			    NTP_VERSION+1, MODE_CLIENT);
+			break;
+		    default:
+			len += 12;
+			break;
+		}
+		break;
+	    default:
+		break;
+	}
+	return len;
+}
+
+static void queue(struct batch *b, int class, uint64_t seq, uint64_t when) {
+	struct sent *s = &ring[seq % RING];
+	int i = b->count++;
+
+	b->iov[i].iov_base = b->pkt[i];
+	b->iov[i].iov_len = make_request(class, seq, b->pkt[i]);
+	memset(&b->msgs[i].msg_hdr, 0, sizeof(b->msgs[i].msg_hdr));
+	b->msgs[i].msg_hdr.msg_name = &server;
+	b->msgs[i].msg_hdr.msg_namelen = SOCKLEN(&server);
+	b->msgs[i].msg_hdr.msg_iov = &b->iov[i];
+	b->msgs[i].msg_hdr.msg_iovlen = 1;
+
+	s->when = (C_JUNK == class) ? 0 : when;
+	s->seq = seq;
+	s->class = (uint8_t)class;
+	stats[class].sent++;
+}
+
+static void flush(struct batch *b) {
+	int done = 0;
+
+	while (done < b->count) {
+		int n = sendmmsg(b->fd, b->msgs+done, b->count-done, 0);
+		if (n < 0) {
+			if (EINTR == errno || EAGAIN == errno || ENOBUFS == errno)
+				continue;
+			perror("sendmmsg");
+			exit(1);
+		}
+		done += n;
+	}
+	b->count = 0;
+}
+
+static void record(struct stats *st, uint64_t ns) {
+	if (st->nlat == st->maxlat) {
+		st->maxlat = st->maxlat ? 2*st->maxlat : 65536;
+		st->lat = realloc(st->lat, st->maxlat*sizeof(*st->lat));
+		if (NULL == st->lat) {
+			printf("## Oops, out of memory.\n");
+			exit(1);
+		}
+	}
+	st->lat[st->nlat++] = (ns > UINT32_MAX) ? UINT32_MAX : (uint32_t)ns;
+}
+
+/* Drain replies from one socket.  Returns number read. */
+static int drain(int fd) {
+	static struct mmsghdr msgs[MAX_BATCH];
+	static struct iovec iov[MAX_BATCH];
+	static uint8_t bufs[MAX_BATCH][PKT_SIZE];
+	int n;
+
+	for (int i = 0; i < MAX_BATCH; i++) {
+		iov[i].iov_base = bufs[i];
+		iov[i].iov_len = PKT_SIZE;
+		memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+	n = recvmmsg(fd, msgs, MAX_BATCH, MSG_DONTWAIT, NULL);
+	if (n <= 0)
+		return 0;
+
+	uint64_t t = now_ns();
+	for (int i = 0; i < n; i++) {
+		struct pkt *rpkt = (struct pkt *)bufs[i];
+		struct sent *s;
+		uint64_t seq;
+
+		if (msgs[i].msg_len < LEN_PKT_NOMAC)
+			continue;
+		seq = ((uint64_t)ntohl(rpkt->org.l_ui) << 32) |
+		    ntohl(rpkt->org.l_uf);
+		s = &ring[seq % RING];
+		if (s->seq != seq || 0 == s->when) {
+			/* overwritten, duplicate or junk; the slot's
+			 * class may not be the one that was answered */
+			late++;
+			continue;
+		}
+		stats[s->class].replies++;
+		if (STRATUM_PKT_UNSPEC == rpkt->stratum &&
+		    0 == memcmp(&rpkt->refid, "RATE", REFIDLEN))
+			stats[s->class].kods++;
+		else
+			record(&stats[s->class], t - s->when);
+		s->when = 0;
+	}
+	return n;
+}
+
+static int drain_all(void) {
+	int n = 0;
+	for (int i = 0; i < nsources; i++)
+		n += drain(srcfd[i]);
+	if (hotfd != srcfd[0])
+		n += drain(hotfd);
+	return n;
+}
+
+static void wait_input(int ms) {
+	struct pollfd fds[MAX_SOURCES+1];
+	int nfds = 0;
+
+	for (int i = 0; i < nsources; i++) {
+		fds[nfds].fd = srcfd[i];
+		fds[nfds++].events = POLLIN;
+	}
+	fds[nfds].fd = hotfd;
+	fds[nfds++].events = POLLIN;
+	poll(fds, nfds, ms);
+}
+
+static int cmp_u32(const void *a, const void *b) {
+	uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+	return (x > y) - (x < y);
+}
+
+static double pct(struct stats *st, double p) {
+	size_t i;
+	if (0 == st->nlat)
+		return 0;
+	i = (size_t)(p * (st->nlat-1) / 100);
+	return st->lat[i] / 1E3;
+}
+
+static void report(double elapsed) {
+	uint64_t sent = 0, replies = 0;
+
+	printf("# class      sent   replies     kods   lost%%"
+	       "    p50us    p90us    p99us  p99.9us    maxus\n");
+	for (int c = 0; c < CLASSES; c++) {
+		struct stats *st = &stats[c];
+		double lost;
+		if (0 == st->sent)
+			continue;
+		qsort(st->lat, st->nlat, sizeof(*st->lat), cmp_u32);
+		sent += st->sent;
+		replies += st->replies;
+		lost = (C_JUNK == c) ? 0 :
+		    100.0 * (double)(st->sent - st->replies) / st->sent;
+		printf("%-8s %9lu %9lu %8lu %7.2f %8.1f %8.1f %8.1f %8.1f %8.1f\n",
+		       class_name[c], (unsigned long)st->sent,
+		       (unsigned long)st->replies, (unsigned long)st->kods,
+		       lost, pct(st, 50), pct(st, 90), pct(st, 99),
+		       pct(st, 99.9), pct(st, 100));
+	}
+	printf("# %.0f requests/s sent, %.0f replies/s, %.2f s\n",
+	       sent/elapsed, replies/elapsed, elapsed);
+	if (0 != late)
+		printf("# %lu late, duplicate or unmatched replies\n",
+		       (unsigned long)late);
+}
+
+#ifndef DISABLE_NTS
+static void nts_setup(const char *kehost, const char *ca, bool noval) {
+	static char hostbuf[256];
+
+	ntsconfig.ca = ca;
+	if (!nts_client_init() || !nts_cookie_init() || !extens_init()) {
+		printf("## Oops, NTS init failed.\n");
+		exit(1);
+	}
+	memset(&ntspeer, 0, sizeof(ntspeer));
+	if (NULL == kehost) {
+		socktoa_r(&server, hostbuf, sizeof(hostbuf));
+		kehost = hostbuf;
+	}
+	ntspeer.hostname = estrdup(kehost);
+	ntspeer.srcadr = server;
+	ntspeer.cfg.flags = FLAG_NTS | (noval ? FLAG_NTS_NOVAL : 0);
+	if (!nts_probe(&ntspeer)) {
+		printf("## Oops, NTS-KE with %s failed.\n", kehost);
+		exit(1);
+	}
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+	double duration = 5, linger = 1, rate = 0;
+	int batch = 32, op;
+	const char *keyfile = NULL, *kehost = NULL, *ca = NULL;
+	keyid_t md5id = 0, cmacid = 0;
+	bool noval = false;
+	uint64_t seq = 1, start, stop, now;
+	char mix[] = "plain";
+
+	setlinebuf(stdout);
+	parse_mix(mix);
+	decodenetnum("127.0.0.1", &server);
+
+	while ((op = ntp_getopt(argc, argv, "A:b:C:d:k:m:M:n:N:r:s:Vw:")) != -1) {
+		switch (op) {
+		    case 'A': ca = ntp_optarg; break;
+		    case 'b': batch = atoi(ntp_optarg); break;
+		    case 'C': cmacid = (keyid_t)atol(ntp_optarg); break;
+		    case 'd': duration = atof(ntp_optarg); break;
+		    case 'k': keyfile = ntp_optarg; break;
+		    case 'm': parse_mix(ntp_optarg); break;
+		    case 'M': md5id = (keyid_t)atol(ntp_optarg); break;
+		    case 'n': nsources = atoi(ntp_optarg); break;
+		    case 'N': kehost = ntp_optarg; break;
+		    case 'r': rate = atof(ntp_optarg); break;
+		    case 's':
+			if (0 != decodenetnum(ntp_optarg, &server)) {
+				printf("## Oops, bad server address %s\n", ntp_optarg);
+				usage();
+			}
+			break;
+		    case 'V': noval = true; break;
+		    case 'w': linger = atof(ntp_optarg); break;
+		    default: usage();
+		}
+	}
+	if (batch < 1 || batch > MAX_BATCH || nsources < 1 ||
+	    nsources > MAX_SOURCES || duration <= 0)
+		usage();
+
+	syslogit = false;
+	termlogit = true;
+	ssl_init();
+	auth_init();
+	if (weight[C_MD5] || weight[C_CMAC]) {
+		if (NULL == keyfile || !authreadkeys(keyfile)) {
+			printf("## Oops, md5/cmac need a keyfile (-k).\n");
+			exit(1);
+		}
+		if (weight[C_MD5])
+			md5key = authlookup(md5id, false);
+		if (weight[C_CMAC])
+			cmackey = authlookup(cmacid, false);
+		if ((weight[C_MD5] && NULL == md5key) ||
+		    (weight[C_CMAC] && NULL == cmackey)) {
+			printf("## Oops, keyid not found in %s.\n", keyfile);
+			exit(1);
+		}
+	}
+	if (weight[C_NTS]) {
+#ifndef DISABLE_NTS
+		nts_setup(kehost, ca, noval);
+#else
+		UNUSED_ARG(kehost);
+		UNUSED_ARG(ca);
+		UNUSED_ARG(noval);
+		printf("## Oops, built without NTS.\n");
+		exit(1);
+#endif
+	}
+	termlogit = false;
+
+	ring = calloc(RING, sizeof(*ring));
+	if (NULL == ring) {
+		printf("## Oops, out of memory.\n");
+		exit(1);
+	}
+	open_sockets();
+	hotbatch.fd = hotfd;
+
+	printf("# server %s, rate %s, %.1f s, batch %d, %d sources\n",
+	       sockporttoa(&server), rate > 0 ? "paced" : "unlimited",
+	       duration, batch, nsources);
+
+	start = now = now_ns();
+	stop = start + (uint64_t)(duration * 1E9);
+	for (int src = 0; now < stop; src = (src+1) % nsources) {
+		int due = batch;
+
+		if (rate > 0) {
+			double want = rate * (now - start) / 1E9 - (seq - 1);
+			due = want < batch ? (int)want : batch;
+		}
+		if (due > 0) {
+			srcbatch.fd = srcfd[src];
+			for (int i = 0; i < due; i++) {
+				int class = next_class();
+				queue(C_LIMITED == class ? &hotbatch : &srcbatch,
+				      class, seq++, now);
+			}
+			flush(&srcbatch);
+			flush(&hotbatch);
+		}
+		if (0 == drain_all() && due <= 0)
+			wait_input(1);
+		now = now_ns();
+	}
+
+	/* Stragglers */
+	stop = now_ns() + (uint64_t)(linger * 1E9);
+	while (now_ns() < stop) {
+		if (0 == drain_all())
+			wait_input(10);
+	}
+
+	report(duration);
+	return 0;
+}
@@ -0,0 +1,338 @@
+/*
+ * nts-timing.c - Hack to measure the throughput of the NTS server path.
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * This sets up a fixed NTS-KE result (fixed c2s/s2c keys, cookies made
+ * by the real cookie code) and then runs client requests through the
+ * same steps ntpd uses when serving an NTS client:
+ *
+ *   receive():   header parse, extens_server_recv()
+ *   fast_xmit(): header fill, get_systime(), extens_server_send()
+ *
+ * sendpkt() is stubbed out.  The reply is fed back to the client side
+ * with extens_client_recv() so every run is checked end to end and
+ * the client always has a cookie to use on the next request.
+ *
+ * receive() and fast_xmit() themselves can't be linked in here without
+ * dragging in all of ntpd, so the non-NTS parts are copied from them.
+ * Keep them in sync if ntp_proto.c changes.
+ *
+ * Allocations are counted via CRYPTO_set_mem_functions(), so only
+ * memory OpenSSL (and libaes_siv through it) asks for shows up.
+ * Nothing else on this path should allocate.
+ *
+ * Usage: nts-timing [samples]
+ */
+
+#include "config.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <openssl/crypto.h>
+#include <openssl/opensslv.h>
+
+#include "ntp_stdlib.h"
+#include "ntp_syslog.h"
+#include "ntpd.h"
+#include "nts.h"
+#include "nts2.h"
+#include "ntp_dns.h"
+#include "ntp_endian.h"
+#include "recvbuff.h"
+
+const char *progname = "nts-timing";
+
+bool nts_client_send_request_core(uint8_t *buff, int buf_size, int *used,
+    struct peer* peer);
+bool nts_client_process_response_core(uint8_t *buff, int transferred,
+    struct peer* peer);
+bool nts_cookie_init(void);
+
+int SAMPLESIZE = 100000;
+
+/* The DNS callbacks live in ntp_proto.c.  nts_client.c needs them. */
+void dns_take_server(struct peer *a, sockaddr_u *b) {
+	UNUSED_ARG(a);
+	UNUSED_ARG(b);
+}
+
+void dns_take_status(struct peer *a, DNS_Status b) {
+	UNUSED_ARG(a);
+	UNUSED_ARG(b);
+}
+
+/* Allocation counting */
+static uint64_t mallocs, reallocs, frees;
+
+static void *count_malloc(size_t num, const char *file, int line) {
+	UNUSED_ARG(file);
+	UNUSED_ARG(line);
+	mallocs++;
+	return malloc(num);
+}
+
+static void *count_realloc(void *addr, size_t num, const char *file, int line) {
+	UNUSED_ARG(file);
+	UNUSED_ARG(line);
+	reallocs++;
+	return realloc(addr, num);
+}
+
+static void count_free(void *addr, const char *file, int line) {
+	UNUSED_ARG(file);
+	UNUSED_ARG(line);
+	if (NULL != addr)
+		frees++;
+	free(addr);
+}
+
+enum stage {
+	S_CLIENT_SEND,	/* extens_client_send, not server work */
+	S_SERVER_RECV,	/* receive(): parse + extens_server_recv */
+	S_SERVER_XMIT,	/* fast_xmit(): header + extens_server_send */
+	S_CLIENT_RECV,	/* extens_client_recv, not server work */
+	STAGES
+};
+
+static const char *stage_name[STAGES] = {
+	"client_send", "server_recv", "server_xmit", "client_recv"
+};
+
+static double ns_between(struct timespec *start, struct timespec *stop) {
+	return (stop->tv_sec-start->tv_sec)*1E9 + (stop->tv_nsec-start->tv_nsec);
+}
+
+/* Fake the KE exchange: the client request and server response
+ * go through the real KE marshalling code, only the TLS exporter
+ * is replaced with fixed keys. */
+static bool fake_ke(struct peer *peer) {
+	uint8_t buff[2048];
+	struct BufCtl_t buf;
+	int used, aead, keylen;
+	uint8_t c2s[NTS_MAX_KEYLEN], s2c[NTS_MAX_KEYLEN];
+
+	if (!nts_client_send_request_core(buff, sizeof(buff), &used, peer)) {
+		printf("## Oops, nts_client_send_request_core() failed.\n");
+		return false;
+	}
+
+	buf.next = buff;
+	buf.left = used;
+	aead = NO_AEAD;
+	if (!nts_ke_process_receive(&buf, &aead) || NO_AEAD == aead) {
+		printf("## Oops, nts_ke_process_receive() failed.\n");
+		return false;
+	}
+	keylen = nts_get_key_length(aead);
+	for (int i = 0; i < keylen; i++) {
+		c2s[i] = i*i+0x23;
+		s2c[i] = i*i+0x31;
+	}
+
+	buf.next = buff;
+	buf.left = sizeof(buff);
+	nts_ke_setup_send(&buf, aead, c2s, s2c, keylen);
+	used = sizeof(buff)-buf.left;
+
+	if (!nts_client_process_response_core(buff, used, peer)) {
+		printf("## Oops, nts_client_process_response_core() failed.\n");
+		return false;
+	}
+	peer->nts_state.keylen = keylen;
+	memcpy(peer->nts_state.c2s, c2s, keylen);
+	memcpy(peer->nts_state.s2c, s2c, keylen);
+	return true;
+}
+
+/* Mimic the client side of peer_xmit() */
+static size_t client_request(struct peer *peer, struct recvbuf *rbufp) {
+	struct pkt xpkt;
+	size_t sendlen = LEN_PKT_NOMAC;
+	l_fp xmt;
+
+	memset(&xpkt, 0, LEN_PKT_NOMAC);
+	xpkt.li_vn_mode = PKT_LI_VN_MODE(LEAP_NOTINSYNC, NTP_VERSION, MODE_CLIENT);
+	xpkt.stratum = STRATUM_PKT_UNSPEC;
+	xpkt.ppoll = 6;
+	xpkt.precision = -20;
+	get_systime(&xmt);
+	xpkt.xmt.l_ui = htonl(lfpuint(xmt));
+	xpkt.xmt.l_uf = htonl(lfpfrac(xmt));
+	sendlen += (size_t)extens_client_send(peer, &xpkt);
+
+	memcpy(rbufp->recv_buffer, &xpkt, sendlen);
+	rbufp->recv_length = sendlen;
+	get_systime(&rbufp->recv_time);
+	return sendlen;
+}
+
+/* The NTS-relevant part of receive() and parse_packet() */
+static bool server_receive(struct recvbuf *rbufp) {
+	struct parsed_pkt *pkt = &rbufp->pkt;
+	uint8_t const* recv_buf = rbufp->recv_buffer;
+
+	pkt->li_vn_mode = recv_buf[0];
+	pkt->stratum = recv_buf[1];
+	pkt->ppoll = recv_buf[2];
+	pkt->precision = (int8_t)recv_buf[3];
+	pkt->rootdelay = ntp_be32dec(recv_buf + 4);
+	pkt->rootdisp = ntp_be32dec(recv_buf + 8);
+	memcpy(pkt->refid, recv_buf + 12, REFIDLEN);
+	pkt->reftime = ntp_be64dec(recv_buf + 16);
+	pkt->org = ntp_be64dec(recv_buf + 24);
+	pkt->rec = ntp_be64dec(recv_buf + 32);
+	pkt->xmt = ntp_be64dec(recv_buf + 40);
+
+	rbufp->keyid_present = false;
+	rbufp->extens_present =
+	    rbufp->recv_length > (LEN_PKT_NOMAC+MAX_MAC_LEN);
+	rbufp->ntspacket.valid = false;
+
+	if (!rbufp->extens_present)
+		return false;
+	return extens_server_recv(&rbufp->ntspacket,
+	    rbufp->recv_buffer, rbufp->recv_length);
+}
+
+/* The non-KoD, NTS branch of fast_xmit() with sendpkt() stubbed */
+static size_t server_xmit(struct recvbuf *rbufp, struct pkt *xpkt) {
+	size_t sendlen;
+	l_fp xmt_tx;
+
+	xpkt->li_vn_mode = PKT_LI_VN_MODE(LEAP_NOWARNING,
+	    PKT_VERSION(rbufp->pkt.li_vn_mode), MODE_SERVER);
+	xpkt->stratum = 2;
+	xpkt->ppoll = rbufp->pkt.ppoll;
+	xpkt->precision = -20;
+	xpkt->refid = htonl(0x7f7f0101);
+	xpkt->rootdelay = 0;
+	xpkt->rootdisp = 0;
+	xpkt->reftime.l_ui = htonl(lfpuint(rbufp->recv_time));
+	xpkt->reftime.l_uf = htonl(lfpfrac(rbufp->recv_time));
+	xpkt->org.l_ui = htonl(rbufp->pkt.xmt >> 32);
+	xpkt->org.l_uf = htonl(rbufp->pkt.xmt & 0xFFFFFFFF);
+	xpkt->rec.l_ui = htonl(lfpuint(rbufp->recv_time));
+	xpkt->rec.l_uf = htonl(lfpfrac(rbufp->recv_time));
+	get_systime(&xmt_tx);
+	xpkt->xmt.l_ui = htonl(lfpuint(xmt_tx));
+	xpkt->xmt.l_uf = htonl(lfpfrac(xmt_tx));
+
+	sendlen = LEN_PKT_NOMAC;
+	sendlen += extens_server_send(&rbufp->ntspacket, xpkt);
+	if (sendlen > rbufp->recv_length)
+		return 0;	/* fast_xmit() would drop this */
+	return sendlen;		/* sendpkt() goes here */
+}
+
+static void DoNTS(struct peer *peer, int placeholders) {
+	static struct recvbuf rbuf;	/* big, keep it off the stack */
+	struct pkt xpkt;
+	struct timespec t0, t1, t2, t3, t4, start, stop;
+	double stage[STAGES];
+	uint64_t allocs;
+	size_t reqlen = 0, replen = 0;
+	double total, server;
+	int i;
+
+	memset(stage, 0, sizeof(stage));
+	mallocs = reallocs = frees = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < SAMPLESIZE; i++) {
+		/* count N  =>  NTS_MAX_COOKIES-N placeholders */
+		peer->nts_state.count = NTS_MAX_COOKIES-placeholders;
+
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		reqlen = client_request(peer, &rbuf);
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+		if (!server_receive(&rbuf)) {
+			printf("## Oops, extens_server_recv() failed.\n");
+			break;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &t2);
+		replen = server_xmit(&rbuf, &xpkt);
+		clock_gettime(CLOCK_MONOTONIC, &t3);
+		if (0 == replen) {
+			printf("## Oops, reply bigger than request.\n");
+			break;
+		}
+		if (!extens_client_recv(peer, (uint8_t *)&xpkt, (int)replen)) {
+			printf("## Oops, extens_client_recv() failed.\n");
+			break;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &t4);
+
+		stage[S_CLIENT_SEND] += ns_between(&t0, &t1);
+		stage[S_SERVER_RECV] += ns_between(&t1, &t2);
+		stage[S_SERVER_XMIT] += ns_between(&t2, &t3);
+		stage[S_CLIENT_RECV] += ns_between(&t3, &t4);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	if (0 == i)
+		return;
+
+	total = ns_between(&start, &stop);
+	server = stage[S_SERVER_RECV] + stage[S_SERVER_XMIT];
+	allocs = mallocs + reallocs;
+	printf("%2d %5zu %5zu %9.0f", placeholders, reqlen, replen,
+	       1E9*i/server);
+	for (int s = 0; s < STAGES; s++)
+		printf(" %11.0f", stage[s]/i);
+	printf(" %6.2f %6.3f\n", (double)allocs/i, total/1E9);
+}
+
+int main(int argc, char *argv[])
+{
+	struct peer peer;
+
+	if (argc > 1)
+		SAMPLESIZE = atoi(argv[1]);
+	if (SAMPLESIZE <= 0) {
+		printf("Usage: %s [samples]\n", argv[0]);
+		return 1;
+	}
+
+	setlinebuf(stdout);
+	syslogit = false;
+	termlogit = false;
+
+	/* Must be before anything makes OpenSSL allocate. */
+	if (!CRYPTO_set_mem_functions(count_malloc, count_realloc, count_free))
+		printf("## Oops, CRYPTO_set_mem_functions() failed.\n");
+
+	ssl_init();
+	nts_cookie_init();
+	nts_make_cookie_key();	/* no cookie key file, make one */
+	nts_make_cookie_key();	/* push new to old, make new */
+	extens_init();
+
+	memset(&peer, 0, sizeof(peer));
+	if (!fake_ke(&peer))
+		return 1;
+
+	printf("# %s\n", OPENSSL_VERSION_TEXT);
+	printf("# AEAD %d, key length %d, cookie length %d, %d samples\n",
+	       peer.nts_state.aead, peer.nts_state.keylen,
+	       peer.nts_state.cookielen, SAMPLESIZE);
+	printf("\n");
+	printf("# PH=cookie placeholders, Req/Rep=packet lengths\n");
+	printf("# req/s counts only the server stages, times are ns/op\n");
+	printf("# allocs is OpenSSL malloc+realloc per round trip\n");
+	printf("# PH   Req   Rep     req/s");
+	for (int s = 0; s < STAGES; s++)
+		printf(" %s", stage_name[s]);
+	printf(" allocs sec/run\n");
+
+	DoNTS(&peer, 0);
+	DoNTS(&peer, 1);
+	DoNTS(&peer, 3);
+	DoNTS(&peer, NTS_MAX_COOKIES-1);
+
+	return 0;
+}
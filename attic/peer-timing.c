@@ -0,0 +1,214 @@
+/*
+ * peer-timing.c - Hack to measure peer lookups with many associations.
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * This links the real ntpd/ntp_peer.c, mobilizes N client
+ * associations to distinct IPv4 addresses, and N more by hostname
+ * the way pool/DNS servers are, then times
+ *
+ *   findpeer()          what receive() does for every reply
+ *   findpeerbyassoc()   what mode 6 and the TX stamp code do
+ *   findexistingpeer()  by hostname, what config and DNS do
+ *
+ * looking up random existing peers.  The rest of ntpd is stubbed out
+ * below.  N doubles from 16 up to the given maximum, so a flat ns/op
+ * column means the hash tables are keeping up.
+ *
+ * Usage: peer-timing [max-associations [lookups]]
+ */
+
+#include "config.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "ntpd.h"
+#include "ntp_stdlib.h"
+#include "ntp_refclock.h"
+#include "ntp_syslog.h"
+#include "recvbuff.h"
+#include "timespecops.h"
+
+const char *progname = "peer-timing";
+
+/* ntpd pieces ntp_peer.c wants */
+struct clock_control_flags clock_ctl;
+struct ntp_io_data io_data;
+struct system_variables sys_vars;
+uptime_t current_time;
+int peer_ntpdate;
+
+static endpt ep;		/* the one local address */
+
+void peer_clear(struct peer *p, const char *ident, const bool init) {
+	UNUSED_ARG(ident);
+	UNUSED_ARG(init);
+	poll_schedule(p, current_time + (p->associd & 63));
+}
+void restrict_source(struct peer *p) { UNUSED_ARG(p); }
+void unrestrict_source(struct peer *p) { UNUSED_ARG(p); }
+#ifdef REFCLOCK
+void refclock_unpeer(struct peer *p) { UNUSED_ARG(p); }
+#endif
+endpt *select_peerinterface(struct peer *p, sockaddr_u *a, endpt *e) {
+	UNUSED_ARG(p);
+	UNUSED_ARG(a);
+	UNUSED_ARG(e);
+	return &ep;
+}
+endpt *findinterface(sockaddr_u *a) {
+	UNUSED_ARG(a);
+	return &ep;
+}
+const char *latoa(endpt *e) {
+	UNUSED_ARG(e);
+	return "-";
+}
+int mprintf_event(int evcode, struct peer *p, const char *fmt, ...) {
+	UNUSED_ARG(evcode);
+	UNUSED_ARG(p);
+	UNUSED_ARG(fmt);
+	return 0;
+}
+
+
+static void
+make_addr(sockaddr_u *addr, unsigned int i)
+{
+	ZERO_SOCK(addr);
+	AF(addr) = AF_INET;
+	SET_ADDR4(addr, 0x0a000000 + i + 1);	/* 10.0.0.1 and up */
+	SET_PORT(addr, NTP_PORT);
+}
+
+static void
+make_name(char *buf, size_t len, unsigned int i)
+{
+	snprintf(buf, len, "s%u.farm.example.net", i);
+}
+
+static double
+ns_since(struct timespec *start)
+{
+	struct timespec stop;
+
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	return (stop.tv_sec - start->tv_sec) * 1e9 +
+	       (stop.tv_nsec - start->tv_nsec);
+}
+
+static void
+run(unsigned int count, unsigned int lookups)
+{
+	struct peer **	peers;
+	struct peer **	named;
+	struct peer_ctl	ctl;
+	struct recvbuf	rbuf;
+	struct timespec	start;
+	sockaddr_u	addr;
+	char		name[64];
+	double		t_add, t_find, t_assoc, t_name, t_del;
+	unsigned int	i, j;
+	unsigned long	misses = 0;
+
+	peers = emalloc(count * sizeof(*peers));
+	named = emalloc(count * sizeof(*named));
+	ZERO(ctl);
+	ctl.version = NTP_VERSION;
+	ctl.minpoll = NTP_MINDPOLL;
+	ctl.maxpoll = NTP_MAXDPOLL;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < count; i++) {
+		make_addr(&addr, i);
+		ctl.flags = 0;
+		peers[i] = newpeer(&addr, NULL, &ep, MODE_CLIENT, &ctl,
+				   MDF_UCAST, false);
+		make_name(name, sizeof(name), i);
+		ZERO_SOCK(&addr);
+		AF(&addr) = AF_INET;
+		ctl.flags = FLAG_LOOKUP;
+		named[i] = newpeer(&addr, name, &ep, MODE_CLIENT, &ctl,
+				   MDF_UCAST, false);
+		if (NULL == peers[i] || NULL == named[i]) {
+			printf("## Oops, newpeer() failed at %u\n", i);
+			exit(1);
+		}
+	}
+	t_add = ns_since(&start) / (2 * count);
+
+	ZERO(rbuf);
+	rbuf.dstadr = &ep;
+	srandom(count);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < lookups; i++) {
+		j = (unsigned int)random() % count;
+		make_addr(&rbuf.recv_srcadr, j);
+		if (findpeer(&rbuf) != peers[j])
+			misses++;
+	}
+	t_find = ns_since(&start) / lookups;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < lookups; i++) {
+		j = (unsigned int)random() % count;
+		if (findpeerbyassoc(peers[j]->associd) != peers[j])
+			misses++;
+	}
+	t_assoc = ns_since(&start) / lookups;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < lookups; i++) {
+		j = (unsigned int)random() % count;
+		make_name(name, sizeof(name), j);
+		if (findexistingpeer(NULL, name, NULL, -1) != named[j])
+			misses++;
+	}
+	t_name = ns_since(&start) / lookups;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < count; i++) {
+		unpeer(peers[i]);
+		unpeer(named[i]);
+	}
+	t_del = ns_since(&start) / (2 * count);
+
+	printf("%7u %9.0f %9.0f %9.0f %9.0f %9.0f",
+	       count, t_add, t_find, t_assoc, t_name, t_del);
+	if (misses)
+		printf("  ## %lu wrong answers", misses);
+	printf("\n");
+	free(peers);
+	free(named);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int max = 10000;
+	unsigned int lookups = 1000000;
+	unsigned int count;
+
+	if (argc > 1)
+		max = (unsigned int)atoi(argv[1]);
+	if (argc > 2)
+		lookups = (unsigned int)atoi(argv[2]);
+	if (argc > 3 || 0 == max || 0 == lookups) {
+		printf("Usage: %s [max-associations [lookups]]\n", argv[0]);
+		exit(1);
+	}
+
+	syslogit = false;
+	termlogit = false;
+	init_peer();
+	printf("# ns per operation\n");
+	printf("#  assoc    newpeer  findpeer     assoc  hostname    unpeer\n");
+	for (count = 16; count < max; count *= 2)
+		run(count, lookups);
+	run(max, lookups);
+	return 0;
+}
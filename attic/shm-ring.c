@@ -0,0 +1,187 @@
+/*
+ * shm-ring.c - Test producer for the version 2 (ring) SHM refclock
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Writes synthetic samples into the ring segment described in
+ * include/ntp_shm.h at a fixed rate, the way a GPS daemon would.  Each
+ * sample claims the reference clock is the system clock plus a fixed
+ * offset and some uniform jitter.  With -f it also rings the FIFO
+ * doorbell after every sample.
+ *
+ * Point ntpd at it with something like
+ *
+ *   refclock shm unit 2 mode 2 minpoll 4 maxpoll 4 path /tmp/shm2 flag4 1
+ *
+ * and run "shm-ring -u 2 -r 100 -f /tmp/shm2".  Every sample written
+ * should show up as good in the clockstats line and none as lost.
+ *
+ * Usage: shm-ring [-u unit] [-r rate] [-o offset] [-j jitter]
+ *                 [-c count] [-f fifo] [-p]
+ */
+
+#include "config.h"
+
+#include <sys/types.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(HAVE_STDATOMIC_H)
+# include <stdatomic.h>
+#endif /* HAVE_STDATOMIC_H */
+
+#include "ntp_shm.h"
+#include "timespecops.h"
+
+static void
+barrier(void)
+{
+#if defined(HAVE_STDATOMIC_H)
+	atomic_thread_fence(memory_order_seq_cst);
+#else
+	__sync_synchronize();
+#endif /* HAVE_STDATOMIC_H */
+}
+
+static struct shm_ring *
+attach(int unit, bool forall)
+{
+	struct shm_ring *ring;
+	int shmid;
+
+	shmid = shmget(SHM_RING_KEY + unit, sizeof(*ring),
+		       IPC_CREAT | (forall ? 0666 : 0600));
+	if (-1 == shmid) {
+		perror("shmget");
+		exit(1);
+	}
+	ring = shmat(shmid, 0, 0);
+	if ((void *)-1 == ring) {
+		perror("shmat");
+		exit(1);
+	}
+	if (0 == ring->magic) {
+		ring->version = SHM_RING_VERSION;
+		ring->slots = SHM_RING_SLOTS;
+		ring->sample_size = sizeof(struct shm_sample);
+		ring->magic = SHM_RING_MAGIC;
+	}
+	if (SHM_RING_MAGIC != ring->magic ||
+	    SHM_RING_VERSION != ring->version ||
+	    SHM_RING_SLOTS != ring->slots ||
+	    sizeof(struct shm_sample) != ring->sample_size) {
+		fprintf(stderr, "shm-ring: segment layout not understood\n");
+		exit(1);
+	}
+	return ring;
+}
+
+static void
+put(struct shm_ring *ring, struct timespec clk, struct timespec rcv)
+{
+	uint32_t n = ring->head;
+	volatile struct shm_sample *slot = &ring->sample[n % SHM_RING_SLOTS];
+
+	slot->seq = 0;
+	barrier();
+	slot->clock_sec = clk.tv_sec;
+	slot->clock_nsec = (int32_t)clk.tv_nsec;
+	slot->recv_sec = rcv.tv_sec;
+	slot->recv_nsec = (int32_t)rcv.tv_nsec;
+	slot->leap = 0;
+	slot->precision = -20;
+	barrier();
+	slot->seq = n + 1;
+	barrier();
+	ring->head = n + 1;
+}
+
+int
+main(int argc, char *argv[])
+{
+	struct shm_ring *ring;
+	struct timespec next, now, clk, step;
+	double rate = 10, offset = 0, jitter = 0;
+	long count = -1, written = 0;
+	const char *fifo = NULL;
+	bool forall = false;
+	int unit = 2;
+	int doorbell = -1;
+	int ch;
+
+	while ((ch = getopt(argc, argv, "u:r:o:j:c:f:p")) != -1) {
+		switch (ch) {
+		case 'u':
+			unit = atoi(optarg);
+			break;
+		case 'r':
+			rate = atof(optarg);
+			break;
+		case 'o':
+			offset = atof(optarg);
+			break;
+		case 'j':
+			jitter = atof(optarg);
+			break;
+		case 'c':
+			count = atol(optarg);
+			break;
+		case 'f':
+			fifo = optarg;
+			break;
+		case 'p':
+			forall = true;
+			break;
+		default:
+			fprintf(stderr,
+				"Usage: %s [-u unit] [-r rate] [-o offset] "
+				"[-j jitter] [-c count] [-f fifo] [-p]\n",
+				argv[0]);
+			exit(1);
+		}
+	}
+	if (rate <= 0) {
+		fprintf(stderr, "shm-ring: rate must be positive\n");
+		exit(1);
+	}
+
+	ring = attach(unit, forall);
+	if (NULL != fifo) {
+		doorbell = open(fifo, O_WRONLY | O_NONBLOCK);
+		if (-1 == doorbell)
+			fprintf(stderr, "shm-ring: %s: %s, no doorbell\n",
+				fifo, strerror(errno));
+	}
+
+	step = d_to_tspec(1 / rate);
+	clock_gettime(CLOCK_MONOTONIC, &next);
+	while (count < 0 || written < count) {
+		clock_gettime(CLOCK_REALTIME, &now);
+		clk = add_tspec(now, d_to_tspec(offset +
+			jitter * (2.0 * random() / RAND_MAX - 1)));
+		put(ring, clk, now);
+		written++;
+		/* a full FIFO means ntpd is already due to look */
+		if (-1 != doorbell && write(doorbell, "", 1) < 0 &&
+		    EAGAIN != errno) {
+			perror("doorbell");
+			close(doorbell);
+			doorbell = -1;
+		}
+		next = add_tspec(next, step);
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+				       &next, NULL) == EINTR)
+			continue;
+	}
+	printf("%ld samples written to unit %d\n", written, unit);
+	return 0;
+}
@@ -0,0 +1,27 @@
+BINDIR = '/usr/local/bin'
+BUILD_DOC = False
+BUILD_MAN = False
+DATADIR = '/usr/local/share'
+DATAROOTDIR = '/usr/local/share'
+DOCDIR = '/usr/local/share/doc/ntpsec'
+DVIDIR = '/usr/local/share/doc/ntpsec'
+EXEC_PREFIX = '/usr/local'
+HTMLDIR = '/usr/local/share/doc/ntpsec'
+INCLUDEDIR = '/usr/local/include'
+INFODIR = '/usr/local/share/info'
+LIBDIR = '/usr/local/lib64'
+LIBEXECDIR = '/usr/local/libexec'
+LOCALEDIR = '/usr/local/share/locale'
+LOCALSTATEDIR = '/usr/local/var'
+MANDIR = '/usr/local/share/man'
+OLDINCLUDEDIR = '/usr/include'
+OPT_STORE = {}
+PACKAGE = 'ntpsec'
+PDFDIR = '/usr/local/share/doc/ntpsec'
+PREFIX = '/usr/local'
+PSDIR = '/usr/local/share/doc/ntpsec'
+SBINDIR = '/usr/local/sbin'
+SHAREDSTATEDIR = '/usr/local/com'
+SYSCONFDIR = '/usr/local/etc'
+ntpc = 'ffi'
+ntpcver = '1.1.0'
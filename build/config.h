@@ -0,0 +1,115 @@
+/* WARNING! All changes made to this file will be lost! */
+
+#ifndef W_CONFIG_H_WAF
+#define W_CONFIG_H_WAF
+
+#define NTPSEC_VERSION "1.2.1+"
+#define NTPSEC_VERSION_EXTENDED "1.2.1+97a9e98-dirty"
+#define HAS_f_stack_protector_all 1
+#define HAS_PIC 1
+#define HAS_PIE 1
+/* #undef HAS_unused */
+#define HAS_w_cast_qual 1
+#define HAS_w_disabled_optimization 1
+#define HAS_w_float_equal 1
+#define HAS_w_format 1
+#define HAS_w_format_security 1
+#define HAS_w_format_signedness 1
+#define HAS_w_implicit_function_declaration 1
+#define HAS_w_init_self 1
+#define HAS_w_invalid_pch 1
+#define HAS_w_missing_declarations 1
+#define HAS_w_multichar 1
+#define HAS_w_packed 1
+#define HAS_w_pointer_arith 1
+#define HAS_w_shadow 1
+#define HAS_w_suggest_attribute_noreturn 1
+#define HAS_w_write_strings 1
+#define HAS_LTO 1
+#define HAS_z_now 1
+#define HAS_stripall 1
+#define HAS_relro 1
+/* #undef HAVE_STRUCT_IF_LADDRCONF */
+/* #undef HAVE_STRUCT_IF_LADDRREQ */
+#define HAVE_STRUCT_TIMEX 1
+#define HAVE_STRUCT_NTPTIMEVAL 1
+/* #undef HAVE_STRUCT_TIMEX_TIME_TICK */
+#define HAVE_STRUCT_TIMEX_MODES 1
+/* #undef HAVE_STRUCT_NTPTIMEVAL_TIME_TV_NSEC */
+#define HAVE_STRUCT_NTPTIMEVAL_TAI 1
+#define NTP_SIZEOF_LONG 8 /* Size of long from <None> */
+#define NTP_SIZEOF_TIME_T 8 /* Size of time_t from <time.h> */
+#define HAVE__UNWIND_BACKTRACE 1 /* Whether _Unwind_Backtrace() exists */
+#define HAVE_ADJTIMEX 1 /* Whether adjtimex() exists */
+#define HAVE_BACKTRACE_SYMBOLS_FD 1 /* Whether backtrace_symbols_fd() exists */
+#define HAVE_NTP_ADJTIME 1 /* Whether ntp_adjtime() exists */
+#define HAVE_NTP_GETTIME 1 /* Whether ntp_gettime() exists */
+#define HAVE_RES_INIT 1 /* Whether res_init() exists */
+/* #undef HAVE_STRLCPY */
+/* #undef HAVE_STRLCAT */
+#define HAVE_TIMEGM 1 /* Whether timegm() exists */
+/* #undef HAVE_PRIV_NTP_ADJTIME */
+#define HAVE_TIMER_CREATE 1 /* Whether timer_create() exists */
+#define HAVE_CMAC_CTX_NEW 1 /* Whether CMAC_CTX_new() exists */
+#define HAVE_EVP_PKEY_NEW_CMAC_KEY 1 /* Whether EVP_PKEY_new_CMAC_key() exists */
+#define HAVE_STDBOOL_H 1 /* Sanity check. */
+#define HAVE_ALLOCA_H 1 /* <alloca.h> header */
+#define HAVE_ARPA_NAMESER_H 1 /* <arpa/nameser.h> header */
+/* #undef HAVE_BSD_STRING_H */
+#define HAVE_IFADDRS_H 1 /* <ifaddrs.h> header */
+#define HAVE_LINUX_IF_ADDR_H 1 /* <linux/if_addr.h> header */
+#define HAVE_LINUX_NET_TSTAMP_H 1 /* <linux/net_tstamp.h> header */
+#define HAVE_LINUX_RTNETLINK_H 1 /* <linux/rtnetlink.h> header */
+#define HAVE_LINUX_SERIAL_H 1 /* <linux/serial.h> header */
+/* #undef HAVE_NET_IF6_H */
+#define HAVE_NET_ROUTE_H 1 /* <net/route.h> header */
+/* #undef HAVE_PRIV_H */
+#define HAVE_STDATOMIC_H 1 /* <stdatomic.h> header */
+/* #undef HAVE_SYS_CLOCKCTL_H */
+#define HAVE_SYS_IOCTL_H 1 /* <sys/ioctl.h> header */
+/* #undef HAVE_SYS_MODEM_H */
+/* #undef HAVE_SYS_SOCKIO_H */
+/* #undef HAVE_SYS_SYSCTL_H */
+/* #undef HAVE_TIMEPPS_H */
+/* #undef HAVE_SYS_TIMEPPS_H */
+#define HAVE_SYS_TIMERFD_H 1 /* <sys/timerfd.h> header */
+#define HAVE_SYS_TIMEX_H 1 /* <sys/timex.h> header */
+/* #undef ISC_PLATFORM_HAVESALEN */
+#define STRERROR_CHAR 1 /* Whether strerror_r returns char* */
+/* #undef HAVE_LIBSCF_H */
+#define CLOCK_LOCAL 1 /* Enable 'Undisciplined Local Clock' refclock */
+#define CLOCK_SPECTRACOM 1 /* Enable 'Spectracom GPS Receivers' refclock */
+#define CLOCK_TRUETIME 1 /* Enable 'TrueTime GPS/GOES/OMEGA Receivers' refclock */
+#define CLOCK_COMPUTIME 1 /* Enable individual parse clock */
+#define CLOCK_DCF7000 1 /* Enable individual parse clock */
+#define CLOCK_HOPF6021 1 /* Enable individual parse clock */
+#define CLOCK_MEINBERG 1 /* Enable individual parse clock */
+#define CLOCK_RAWDCF 1 /* Enable individual parse clock */
+#define CLOCK_RCC8000 1 /* Enable individual parse clock */
+#define CLOCK_SCHMID 1 /* Enable individual parse clock */
+#define CLOCK_SEL240X 1 /* Enable individual parse clock */
+#define CLOCK_TRIMTAIP 1 /* Enable individual parse clock */
+#define CLOCK_TRIMTSIP 1 /* Enable individual parse clock */
+#define CLOCK_VARITEXT 1 /* Enable individual parse clock */
+#define CLOCK_WHARTON_400A 1 /* Enable individual parse clock */
+#define CLOCK_GENERIC 1 /* Enable 'Generic Reference Driver (Parse)' refclock */
+#define CLOCK_ARBITER 1 /* Enable 'Arbiter 1088A/B GPS Receiver' refclock */
+#define CLOCK_MODEM 1 /* Enable 'NIST/USNO/PTB Modem Time Services' refclock */
+#define CLOCK_NMEA 1 /* Enable 'Generic NMEA GPS Receiver' refclock */
+#define CLOCK_HPGPS 1 /* Enable 'Hewlett Packard 58503A GPS Receiver' refclock */
+#define CLOCK_SHM 1 /* Enable 'Shared Memory Driver' refclock */
+#define CLOCK_TRIMBLE 1 /* Enable 'Trimble Navigation GPSes' refclock */
+#define CLOCK_JJY 1 /* Enable 'JJY Receivers' refclock */
+#define CLOCK_ZYFER 1 /* Enable 'Zyfer GPStarplus Receiver' refclock */
+#define CLOCK_GPSDJSON 1 /* Enable 'GPSD NG client protocol' refclock */
+#define REFCLOCK 1 /* Enable refclock support */
+#define ENABLE_DROPROOT 1 /* Drop root after initialising */
+#define ENABLE_FUZZ 1 /* Enable fuzzing low bits of time */
+#define NEED_REUSEADDR_FOR_IFADDRBIND 1 /* Whether SO_REUSEADDR is needed to open same sockets on alternate interfaces, required by Linux at least */
+#define DIR_SEP '/' /* Directory separator used */
+#define HAVE_SYS_PRCTL_H 1
+/* #undef HAVE_SYS_CAPABILITY_H */
+/* #undef HAVE_DNS_SD_H */
+/* #undef ENABLE_CLASSIC_MODE */
+
+#endif /* W_CONFIG_H_WAF */
@@ -0,0 +1,973 @@
+/*
+ * ntp_keyword.h
+ * 
+ * NOTE: edit this file with caution, it is generated by keyword-gen.c
+ *	 Generated 2026-10-19 05:43:38 UTC	  diff_ignore_line
+ *
+ */
+#include "ntp_scanner.h"
+#include "ntp_parser.tab.h"
+
+#define LOWEST_KEYWORD_ID 258
+
+const char * const keyword_text[190] = {
+	/* 0       258                  258 */	"adjrate",
+	/* 1       259                  259 */	"aead",
+	/* 2       260                  260 */	"age",
+	/* 3       261                  261 */	"all",
+	/* 4       262                  262 */	"allan",
+	/* 5       263                  263 */	"allpeers",
+	/* 6       264                  264 */	NULL,
+	/* 7       265                  265 */	"auth",
+	/* 8       266                  266 */	"average",
+	/* 9       267                  267 */	"baud",
+	/* 10      268                  268 */	"bias",
+	/* 11      269                  269 */	"binary",
+	/* 12      270                  270 */	"burst",
+	/* 13      271                  271 */	"calibrate",
+	/* 14      272                  272 */	"ca",
+	/* 15      273                  273 */	"ceiling",
+	/* 16      274                  274 */	"cert",
+	/* 17      275                  275 */	"clock",
+	/* 18      276                  276 */	"clockstats",
+	/* 19      277                  277 */	NULL,
+	/* 20      278                  278 */	"cookie",
+	/* 21      279                  279 */	"controlkey",
+	/* 22      280                  280 */	"ctl",
+	/* 23      281                  281 */	"day",
+	/* 24      282                  282 */	"default",
+	/* 25      283                  283 */	"disable",
+	/* 26      284                  284 */	"dispersion",
+	/* 27      285                  285 */	NULL,
+	/* 28      286                  286 */	"driftfile",
+	/* 29      287                  287 */	"drop",
+	/* 30      288                  288 */	"dscp",
+	/* 31      289                  289 */	NULL,
+	/* 32      290                  290 */	"...",
+	/* 33      291                  291 */	"enable",
+	/* 34      292                  292 */	"end",
+	/* 35      293                  293 */	NULL,
+	/* 36      294                  294 */	"file",
+	/* 37      295                  295 */	"filegen",
+	/* 38      296                  296 */	"filenum",
+	/* 39      297                  297 */	"flag1",
+	/* 40      298                  298 */	"flag2",
+	/* 41      299                  299 */	"flag3",
+	/* 42      300                  300 */	"flag4",
+	/* 43      301                  301 */	"flake",
+	/* 44      302                  302 */	"floor",
+	/* 45      303                  303 */	"freq",
+	/* 46      304                  304 */	"fudge",
+	/* 47      305                  305 */	"holdover",
+	/* 48      306                  306 */	"huffpuff",
+	/* 49      307                  307 */	"iburst",
+	/* 50      308                  308 */	"ignore",
+	/* 51      309                  309 */	"incalloc",
+	/* 52      310                  310 */	"incmem",
+	/* 53      311                  311 */	"initalloc",
+	/* 54      312                  312 */	"initmem",
+	/* 55      313                  313 */	"includefile",
+	/* 56      314                  314 */	NULL,
+	/* 57      315                  315 */	"interface",
+	/* 58      316                  316 */	"interval",
+	/* 59      317                  317 */	NULL,
+	/* 60      318                  318 */	"io",
+	/* 61      319                  319 */	"ipv4",
+	/* 62      320                  320 */	"-4",
+	/* 63      321                  321 */	"ipv6",
+	/* 64      322                  322 */	"-6",
+	/* 65      323                  323 */	"kernel",
+	/* 66      324                  324 */	"key",
+	/* 67      325                  325 */	"keys",
+	/* 68      326                  326 */	"kod",
+	/* 69      327                  327 */	"mssntp",
+	/* 70      328                  328 */	"leapfile",
+	/* 71      329                  329 */	"leapsmearinterval",
+	/* 72      330                  330 */	"limit",
+	/* 73      331                  331 */	"limited",
+	/* 74      332                  332 */	"link",
+	/* 75      333                  333 */	"listen",
+	/* 76      334                  334 */	"logconfig",
+	/* 77      335                  335 */	"logfile",
+	/* 78      336                  336 */	"logqueue",
+	/* 79      337                  337 */	"loopstats",
+	/* 80      338                  338 */	"mask",
+	/* 81      339                  339 */	"maxage",
+	/* 82      340                  340 */	"maxclock",
+	/* 83      341                  341 */	"maxdepth",
+	/* 84      342                  342 */	"maxdisp",
+	/* 85      343                  343 */	"maxdist",
+	/* 86      344                  344 */	"maxmem",
+	/* 87      345                  345 */	"maxpoll",
+	/* 88      346                  346 */	"maxtls",
+	/* 89      347                  347 */	"mdnstries",
+	/* 90      348                  348 */	"mem",
+	/* 91      349                  349 */	"memlock",
+	/* 92      350                  350 */	"metrics",
+	/* 93      351                  351 */	"minage",
+	/* 94      352                  352 */	"minclock",
+	/* 95      353                  353 */	"mindepth",
+	/* 96      354                  354 */	"mindist",
+	/* 97      355                  355 */	"minpoll",
+	/* 98      356                  356 */	"minsane",
+	/* 99      357                  357 */	"mintls",
+	/* 100     358                  358 */	"mode",
+	/* 101     359                  359 */	"monitor",
+	/* 102     360                  360 */	"month",
+	/* 103     361                  361 */	"mru",
+	/* 104     362                  362 */	"nic",
+	/* 105     363                  363 */	"nolink",
+	/* 106     364                  364 */	"nomodify",
+	/* 107     365                  365 */	"nomrulist",
+	/* 108     366                  366 */	"none",
+	/* 109     367                  367 */	"nonvolatile",
+	/* 110     368                  368 */	"nopeer",
+	/* 111     369                  369 */	"noquery",
+	/* 112     370                  370 */	"noselect",
+	/* 113     371                  371 */	"noserve",
+	/* 114     372                  372 */	"notrap",
+	/* 115     373                  373 */	"notrust",
+	/* 116     374                  374 */	"noval",
+	/* 117     375                  375 */	"ntp",
+	/* 118     376                  376 */	"ntpport",
+	/* 119     377                  377 */	"ntpsigndsocket",
+	/* 120     378                  378 */	"nts",
+	/* 121     379                  379 */	"orphan",
+	/* 122     380                  380 */	"orphanwait",
+	/* 123     381                  381 */	"panic",
+	/* 124     382                  382 */	"path",
+	/* 125     383                  383 */	"peer",
+	/* 126     384                  384 */	"peerstats",
+	/* 127     385                  385 */	"phone",
+	/* 128     386                  386 */	"pid",
+	/* 129     387                  387 */	"pidfile",
+	/* 130     388                  388 */	"pool",
+	/* 131     389                  389 */	"port",
+	/* 132     390                  390 */	"ppspath",
+	/* 133     391                  391 */	"prefer",
+	/* 134     392                  392 */	"protostats",
+	/* 135     393                  393 */	"rawstats",
+	/* 136     394                  394 */	"refclock",
+	/* 137     395                  395 */	"refid",
+	/* 138     396                  396 */	"requestkey",
+	/* 139     397                  397 */	NULL,
+	/* 140     398                  398 */	"reservoir",
+	/* 141     399                  399 */	"reset",
+	/* 142     400                  400 */	"restrict",
+	/* 143     401                  401 */	"rlimit",
+	/* 144     402                  402 */	"sample",
+	/* 145     403                  403 */	NULL,
+	/* 146     404                  404 */	"server",
+	/* 147     405                  405 */	"setvar",
+	/* 148     406                  406 */	"shmstats",
+	/* 149     407                  407 */	"source",
+	/* 150     408                  408 */	"stacksize",
+	/* 151     409                  409 */	"stages",
+	/* 152     410                  410 */	"statistics",
+	/* 153     411                  411 */	"stats",
+	/* 154     412                  412 */	"statsdir",
+	/* 155     413                  413 */	"step",
+	/* 156     414                  414 */	"stepback",
+	/* 157     415                  415 */	"stepfwd",
+	/* 158     416                  416 */	"stepout",
+	/* 159     417                  417 */	"stratum",
+	/* 160     418                  418 */	"subtype",
+	/* 161     419                  419 */	NULL,
+	/* 162     420                  420 */	"sys",
+	/* 163     421                  421 */	"sysstats",
+	/* 164     422                  422 */	"tick",
+	/* 165     423                  423 */	"time1",
+	/* 166     424                  424 */	"time2",
+	/* 167     425                  425 */	"timer",
+	/* 168     426                  426 */	NULL,
+	/* 169     427                  427 */	"tinker",
+	/* 170     428                  428 */	"text",
+	/* 171     429                  429 */	NULL,
+	/* 172     430                  430 */	"tlsciphersuites",
+	/* 173     431                  431 */	"tos",
+	/* 174     432                  432 */	"true",
+	/* 175     433                  433 */	"trustedkey",
+	/* 176     434                  434 */	"txstamp",
+	/* 177     435                  435 */	"type",
+	/* 178     436                  436 */	NULL,
+	/* 179     437                  437 */	"unit",
+	/* 180     438                  438 */	"unconfig",
+	/* 181     439                  439 */	"unpeer",
+	/* 182     440                  440 */	"unrestrict",
+	/* 183     441                  441 */	"usestats",
+	/* 184     442                  442 */	"version",
+	/* 185     443                  443 */	NULL,
+	/* 186     444                  444 */	"week",
+	/* 187     445                  445 */	"wildcard",
+	/* 188     446                  446 */	"xleave",
+	/* 189     447                  447 */	"year"
+};
+
+#define SCANNER_INIT_S 759
+
+const scan_state sst[762] = {
+/*SS_T( ch,	f-by, match, other ),				 */
+  0,				      /*     0                   */
+  S_ST( '-',	3,      322,     0 ), /*     1                   */
+  S_ST( '.',	3,        3,     1 ), /*     2                   */
+  S_ST( '.',	3,      290,     0 ), /*     3 .                 */
+  S_ST( 'a',	3,       21,     2 ), /*     4                   */
+  S_ST( 'd',	3,        6,     0 ), /*     5 a                 */
+  S_ST( 'j',	3,        7,     0 ), /*     6 ad                */
+  S_ST( 'r',	3,        8,     0 ), /*     7 adj               */
+  S_ST( 'a',	3,        9,     0 ), /*     8 adjr              */
+  S_ST( 't',	3,      258,     0 ), /*     9 adjra             */
+  S_ST( 'e',	3,       11,     5 ), /*    10 a                 */
+  S_ST( 'a',	3,      259,     0 ), /*    11 ae                */
+  S_ST( 'g',	3,      260,    10 ), /*    12 a                 */
+  S_ST( 'l',	3,      261,    12 ), /*    13 a                 */
+  S_ST( 'a',	3,      262,     0 ), /*    14 all               */
+  S_ST( 'p',	3,       16,    14 ), /*    15 all               */
+  S_ST( 'e',	3,       17,     0 ), /*    16 allp              */
+  S_ST( 'e',	3,       18,     0 ), /*    17 allpe             */
+  S_ST( 'r',	3,      263,     0 ), /*    18 allpee            */
+  S_ST( 'u',	3,       20,    13 ), /*    19 a                 */
+  S_ST( 't',	3,      265,     0 ), /*    20 au                */
+  S_ST( 'v',	3,       22,    19 ), /*    21 a                 */
+  S_ST( 'e',	3,       23,     0 ), /*    22 av                */
+  S_ST( 'r',	3,       24,     0 ), /*    23 ave               */
+  S_ST( 'a',	3,       25,     0 ), /*    24 aver              */
+  S_ST( 'g',	3,      266,     0 ), /*    25 avera             */
+  S_ST( 'b',	3,       34,     4 ), /*    26                   */
+  S_ST( 'a',	3,       28,     0 ), /*    27 b                 */
+  S_ST( 'u',	3,      267,     0 ), /*    28 ba                */
+  S_ST( 'i',	3,       31,    27 ), /*    29 b                 */
+  S_ST( 'a',	3,      268,     0 ), /*    30 bi                */
+  S_ST( 'n',	3,       32,    30 ), /*    31 bi                */
+  S_ST( 'a',	3,       33,     0 ), /*    32 bin               */
+  S_ST( 'r',	3,      269,     0 ), /*    33 bina              */
+  S_ST( 'u',	3,       35,    29 ), /*    34 b                 */
+  S_ST( 'r',	3,       36,     0 ), /*    35 bu                */
+  S_ST( 's',	3,      270,     0 ), /*    36 bur               */
+  S_ST( 'c',	3,       68,    26 ), /*    37                   */
+  S_ST( 'l',	3,       39,     0 ), /*    38 ca                */
+  S_ST( 'i',	3,       40,     0 ), /*    39 cal               */
+  S_ST( 'b',	3,       41,     0 ), /*    40 cali              */
+  S_ST( 'r',	3,       42,     0 ), /*    41 calib             */
+  S_ST( 'a',	3,       43,     0 ), /*    42 calibr            */
+  S_ST( 't',	3,      271,     0 ), /*    43 calibra           */
+  S_ST( 'e',	3,       49,   272 ), /*    44 c                 */
+  S_ST( 'i',	3,       46,     0 ), /*    45 ce                */
+  S_ST( 'l',	3,       47,     0 ), /*    46 cei               */
+  S_ST( 'i',	3,       48,     0 ), /*    47 ceil              */
+  S_ST( 'n',	3,      273,     0 ), /*    48 ceili             */
+  S_ST( 'r',	3,      274,    45 ), /*    49 ce                */
+  S_ST( 'l',	3,       51,    44 ), /*    50 c                 */
+  S_ST( 'o',	3,       52,     0 ), /*    51 cl                */
+  S_ST( 'c',	3,      275,     0 ), /*    52 clo               */
+  S_ST( 's',	3,       54,     0 ), /*    53 clock             */
+  S_ST( 't',	3,       55,     0 ), /*    54 clocks            */
+  S_ST( 'a',	3,       56,     0 ), /*    55 clockst           */
+  S_ST( 't',	3,      276,     0 ), /*    56 clocksta          */
+  S_ST( 'o',	3,       65,    50 ), /*    57 c                 */
+  S_ST( 'n',	3,       59,     0 ), /*    58 co                */
+  S_ST( 't',	3,       60,     0 ), /*    59 con               */
+  S_ST( 'r',	3,       61,     0 ), /*    60 cont              */
+  S_ST( 'o',	3,       62,     0 ), /*    61 contr             */
+  S_ST( 'l',	3,       63,     0 ), /*    62 contro            */
+  S_ST( 'k',	3,       64,     0 ), /*    63 control           */
+  S_ST( 'e',	3,      279,     0 ), /*    64 controlk          */
+  S_ST( 'o',	3,       66,    58 ), /*    65 co                */
+  S_ST( 'k',	3,       67,     0 ), /*    66 coo               */
+  S_ST( 'i',	3,      278,     0 ), /*    67 cook              */
+  S_ST( 't',	3,      280,    57 ), /*    68 c                 */
+  S_ST( 'd',	3,       95,    37 ), /*    69                   */
+  S_ST( 'a',	3,      281,     0 ), /*    70 d                 */
+  S_ST( 'e',	3,       72,    70 ), /*    71 d                 */
+  S_ST( 'f',	3,       73,     0 ), /*    72 de                */
+  S_ST( 'a',	3,       74,     0 ), /*    73 def               */
+  S_ST( 'u',	3,       75,     0 ), /*    74 defa              */
+  S_ST( 'l',	3,      282,     0 ), /*    75 defau             */
+  S_ST( 'i',	3,       77,    71 ), /*    76 d                 */
+  S_ST( 's',	3,       81,     0 ), /*    77 di                */
+  S_ST( 'a',	3,       79,     0 ), /*    78 dis               */
+  S_ST( 'b',	3,       80,     0 ), /*    79 disa              */
+  S_ST( 'l',	3,      283,     0 ), /*    80 disab             */
+  S_ST( 'p',	3,       82,    78 ), /*    81 dis               */
+  S_ST( 'e',	3,       83,     0 ), /*    82 disp              */
+  S_ST( 'r',	3,       84,     0 ), /*    83 dispe             */
+  S_ST( 's',	3,       85,     0 ), /*    84 disper            */
+  S_ST( 'i',	3,       86,     0 ), /*    85 dispers           */
+  S_ST( 'o',	3,      284,     0 ), /*    86 dispersi          */
+  S_ST( 'r',	3,       94,    76 ), /*    87 d                 */
+  S_ST( 'i',	3,       89,     0 ), /*    88 dr                */
+  S_ST( 'f',	3,       90,     0 ), /*    89 dri               */
+  S_ST( 't',	3,       91,     0 ), /*    90 drif              */
+  S_ST( 'f',	3,       92,     0 ), /*    91 drift             */
+  S_ST( 'i',	3,       93,     0 ), /*    92 driftf            */
+  S_ST( 'l',	3,      286,     0 ), /*    93 driftfi           */
+  S_ST( 'o',	3,      287,    88 ), /*    94 dr                */
+  S_ST( 's',	3,       96,    87 ), /*    95 d                 */
+  S_ST( 'c',	3,      288,     0 ), /*    96 ds                */
+  S_ST( 'e',	3,       98,    69 ), /*    97                   */
+  S_ST( 'n',	3,      292,     0 ), /*    98 e                 */
+  S_ST( 'a',	3,      100,     0 ), /*    99 en                */
+  S_ST( 'b',	3,      101,     0 ), /*   100 ena               */
+  S_ST( 'l',	3,      291,     0 ), /*   101 enab              */
+  S_ST( 'f',	3,      117,    97 ), /*   102                   */
+  S_ST( 'i',	3,      104,     0 ), /*   103 f                 */
+  S_ST( 'l',	3,      294,     0 ), /*   104 fi                */
+  S_ST( 'g',	3,      106,     0 ), /*   105 file              */
+  S_ST( 'e',	3,      295,     0 ), /*   106 fileg             */
+  S_ST( 'n',	3,      108,   105 ), /*   107 file              */
+  S_ST( 'u',	3,      296,     0 ), /*   108 filen             */
+  S_ST( 'l',	3,      113,   103 ), /*   109 f                 */
+  S_ST( 'a',	3,      112,     0 ), /*   110 fl                */
+  S_ST( 'g',	3,      300,     0 ), /*   111 fla               */
+  S_ST( 'k',	3,      301,   111 ), /*   112 fla               */
+  S_ST( 'o',	3,      114,   110 ), /*   113 fl                */
+  S_ST( 'o',	3,      302,     0 ), /*   114 flo               */
+  S_ST( 'r',	3,      116,   109 ), /*   115 f                 */
+  S_ST( 'e',	3,      303,     0 ), /*   116 fr                */
+  S_ST( 'u',	3,      118,   115 ), /*   117 f                 */
+  S_ST( 'd',	3,      119,     0 ), /*   118 fu                */
+  S_ST( 'g',	3,      304,     0 ), /*   119 fud               */
+  S_ST( 'h',	3,      127,   102 ), /*   120                   */
+  S_ST( 'o',	3,      122,     0 ), /*   121 h                 */
+  S_ST( 'l',	3,      123,     0 ), /*   122 ho                */
+  S_ST( 'd',	3,      124,     0 ), /*   123 hol               */
+  S_ST( 'o',	3,      125,     0 ), /*   124 hold              */
+  S_ST( 'v',	3,      126,     0 ), /*   125 holdo             */
+  S_ST( 'e',	3,      305,     0 ), /*   126 holdov            */
+  S_ST( 'u',	3,      128,   121 ), /*   127 h                 */
+  S_ST( 'f',	3,      129,     0 ), /*   128 hu                */
+  S_ST( 'f',	3,      130,     0 ), /*   129 huf               */
+  S_ST( 'p',	3,      131,     0 ), /*   130 huff              */
+  S_ST( 'u',	3,      132,     0 ), /*   131 huffp             */
+  S_ST( 'f',	3,      306,     0 ), /*   132 huffpu            */
+  S_ST( 'i',	3,      173,   120 ), /*   133                   */
+  S_ST( 'b',	3,      135,     0 ), /*   134 i                 */
+  S_ST( 'u',	3,      136,     0 ), /*   135 ib                */
+  S_ST( 'r',	3,      137,     0 ), /*   136 ibu               */
+  S_ST( 's',	3,      307,     0 ), /*   137 ibur              */
+  S_ST( 'g',	3,      139,   134 ), /*   138 i                 */
+  S_ST( 'n',	3,      140,     0 ), /*   139 ig                */
+  S_ST( 'o',	3,      141,     0 ), /*   140 ign               */
+  S_ST( 'r',	3,      308,     0 ), /*   141 igno              */
+  S_ST( 'n',	3,      165,   138 ), /*   142 i                 */
+  S_ST( 'c',	3,      155,     0 ), /*   143 in                */
+  S_ST( 'a',	3,      145,     0 ), /*   144 inc               */
+  S_ST( 'l',	3,      146,     0 ), /*   145 inca              */
+  S_ST( 'l',	3,      147,     0 ), /*   146 incal             */
+  S_ST( 'o',	3,      309,     0 ), /*   147 incall            */
+  S_ST( 'l',	3,      149,   144 ), /*   148 inc               */
+  S_ST( 'u',	3,      150,     0 ), /*   149 incl              */
+  S_ST( 'd',	3,      151,     0 ), /*   150 inclu             */
+  S_ST( 'e',	3,      152,     0 ), /*   151 includ            */
+  S_ST( 'f',	3,      153,     0 ), /*   152 include           */
+  S_ST( 'i',	3,      154,     0 ), /*   153 includef          */
+  S_ST( 'l',	3,      313,     0 ), /*   154 includefi         */
+  S_ST( 'm',	3,      156,   148 ), /*   155 inc               */
+  S_ST( 'e',	3,      310,     0 ), /*   156 incm              */
+  S_ST( 'i',	3,      158,   143 ), /*   157 in                */
+  S_ST( 't',	3,      163,     0 ), /*   158 ini               */
+  S_ST( 'a',	3,      160,     0 ), /*   159 init              */
+  S_ST( 'l',	3,      161,     0 ), /*   160 inita             */
+  S_ST( 'l',	3,      162,     0 ), /*   161 inital            */
+  S_ST( 'o',	3,      311,     0 ), /*   162 initall           */
+  S_ST( 'm',	3,      164,   159 ), /*   163 init              */
+  S_ST( 'e',	3,      312,     0 ), /*   164 initm             */
+  S_ST( 't',	3,      166,   157 ), /*   165 in                */
+  S_ST( 'e',	3,      167,     0 ), /*   166 int               */
+  S_ST( 'r',	3,      171,     0 ), /*   167 inte              */
+  S_ST( 'f',	3,      169,     0 ), /*   168 inter             */
+  S_ST( 'a',	3,      170,     0 ), /*   169 interf            */
+  S_ST( 'c',	3,      315,     0 ), /*   170 interfa           */
+  S_ST( 'v',	3,      172,   168 ), /*   171 inter             */
+  S_ST( 'a',	3,      316,     0 ), /*   172 interv            */
+  S_ST( 'p',	3,      174,   318 ), /*   173 i                 */
+  S_ST( 'v',	3,      321,     0 ), /*   174 ip                */
+  S_ST( 'k',	3,      180,   133 ), /*   175                   */
+  S_ST( 'e',	3,      324,     0 ), /*   176 k                 */
+  S_ST( 'r',	3,      178,     0 ), /*   177 ke                */
+  S_ST( 'n',	3,      179,     0 ), /*   178 ker               */
+  S_ST( 'e',	3,      323,     0 ), /*   179 kern              */
+  S_ST( 'o',	3,      326,   176 ), /*   180 k                 */
+  S_ST( 'l',	3,      208,   175 ), /*   181                   */
+  S_ST( 'e',	3,      183,     0 ), /*   182 l                 */
+  S_ST( 'a',	3,      184,     0 ), /*   183 le                */
+  S_ST( 'p',	3,      188,     0 ), /*   184 lea               */
+  S_ST( 'f',	3,      186,     0 ), /*   185 leap              */
+  S_ST( 'i',	3,      187,     0 ), /*   186 leapf             */
+  S_ST( 'l',	3,      328,     0 ), /*   187 leapfi            */
+  S_ST( 's',	3,      189,   185 ), /*   188 leap              */
+  S_ST( 'm',	3,      190,     0 ), /*   189 leaps             */
+  S_ST( 'e',	3,      191,     0 ), /*   190 leapsm            */
+  S_ST( 'a',	3,      192,     0 ), /*   191 leapsme           */
+  S_ST( 'r',	3,      193,     0 ), /*   192 leapsmea          */
+  S_ST( 'i',	3,      194,     0 ), /*   193 leapsmear         */
+  S_ST( 'n',	3,      195,     0 ), /*   194 leapsmeari        */
+  S_ST( 't',	3,      196,     0 ), /*   195 leapsmearin       */
+  S_ST( 'e',	3,      197,     0 ), /*   196 leapsmearint      */
+  S_ST( 'r',	3,      198,     0 ), /*   197 leapsmearinte     */
+  S_ST( 'v',	3,      199,     0 ), /*   198 leapsmearinter    */
+  S_ST( 'a',	3,      329,     0 ), /*   199 leapsmearinterv   */
+  S_ST( 'i',	3,      205,   182 ), /*   200 l                 */
+  S_ST( 'm',	3,      202,     0 ), /*   201 li                */
+  S_ST( 'i',	3,      330,     0 ), /*   202 lim               */
+  S_ST( 'e',	3,      331,     0 ), /*   203 limit             */
+  S_ST( 'n',	3,      332,   201 ), /*   204 li                */
+  S_ST( 's',	3,      206,   204 ), /*   205 li                */
+  S_ST( 't',	3,      207,     0 ), /*   206 lis               */
+  S_ST( 'e',	3,      333,     0 ), /*   207 list              */
+  S_ST( 'o',	3,      222,   200 ), /*   208 l                 */
+  S_ST( 'g',	3,      218,     0 ), /*   209 lo                */
+  S_ST( 'c',	3,      211,     0 ), /*   210 log               */
+  S_ST( 'o',	3,      212,     0 ), /*   211 logc              */
+  S_ST( 'n',	3,      213,     0 ), /*   212 logco             */
+  S_ST( 'f',	3,      214,     0 ), /*   213 logcon            */
+  S_ST( 'i',	3,      334,     0 ), /*   214 logconf           */
+  S_ST( 'f',	3,      216,   210 ), /*   215 log               */
+  S_ST( 'i',	3,      217,     0 ), /*   216 logf              */
+  S_ST( 'l',	3,      335,     0 ), /*   217 logfi             */
+  S_ST( 'q',	3,      219,   215 ), /*   218 log               */
+  S_ST( 'u',	3,      220,     0 ), /*   219 logq              */
+  S_ST( 'e',	3,      221,     0 ), /*   220 logqu             */
+  S_ST( 'u',	3,      336,     0 ), /*   221 logque            */
+  S_ST( 'o',	3,      223,   209 ), /*   222 lo                */
+  S_ST( 'p',	3,      224,     0 ), /*   223 loo               */
+  S_ST( 's',	3,      225,     0 ), /*   224 loop              */
+  S_ST( 't',	3,      226,     0 ), /*   225 loops             */
+  S_ST( 'a',	3,      227,     0 ), /*   226 loopst            */
+  S_ST( 't',	3,      337,     0 ), /*   227 loopsta           */
+  S_ST( 'm',	3,      472,   181 ), /*   228                   */
+  S_ST( 'a',	3,      231,     0 ), /*   229 m                 */
+  S_ST( 's',	3,      338,     0 ), /*   230 ma                */
+  S_ST( 'x',	3,      249,   230 ), /*   231 ma                */
+  S_ST( 'a',	3,      233,     0 ), /*   232 max               */
+  S_ST( 'g',	3,      339,     0 ), /*   233 maxa              */
+  S_ST( 'c',	3,      235,   232 ), /*   234 max               */
+  S_ST( 'l',	3,      236,     0 ), /*   235 maxc              */
+  S_ST( 'o',	3,      237,     0 ), /*   236 maxcl             */
+  S_ST( 'c',	3,      340,     0 ), /*   237 maxclo            */
+  S_ST( 'd',	3,      242,   234 ), /*   238 max               */
+  S_ST( 'e',	3,      240,     0 ), /*   239 maxd              */
+  S_ST( 'p',	3,      241,     0 ), /*   240 maxde             */
+  S_ST( 't',	3,      341,     0 ), /*   241 maxdep            */
+  S_ST( 'i',	3,      243,   239 ), /*   242 maxd              */
+  S_ST( 's',	3,      343,     0 ), /*   243 maxdi             */
+  S_ST( 'm',	3,      245,   238 ), /*   244 max               */
+  S_ST( 'e',	3,      344,     0 ), /*   245 maxm              */
+  S_ST( 'p',	3,      247,   244 ), /*   246 max               */
+  S_ST( 'o',	3,      248,     0 ), /*   247 maxp              */
+  S_ST( 'l',	3,      345,     0 ), /*   248 maxpo             */
+  S_ST( 't',	3,      250,   246 ), /*   249 max               */
+  S_ST( 'l',	3,      346,     0 ), /*   250 maxt              */
+  S_ST( 'd',	3,      252,   229 ), /*   251 m                 */
+  S_ST( 'n',	3,      253,     0 ), /*   252 md                */
+  S_ST( 's',	3,      254,     0 ), /*   253 mdn               */
+  S_ST( 't',	3,      255,     0 ), /*   254 mdns              */
+  S_ST( 'r',	3,      256,     0 ), /*   255 mdnst             */
+  S_ST( 'i',	3,      257,     0 ), /*   256 mdnstr            */
+  S_ST( 'e',	3,      347,     0 ), /*   257 mdnstri           */
+  S_ST( 'e',	0,        0,     0 ), /*   258 258               */
+  S_ST( 'd',	1,        0,     0 ), /*   259 259               */
+  S_ST( 'e',	0,        0,     0 ), /*   260 260               */
+  S_ST( 'l',	0,       15,     0 ), /*   261 261               */
+  S_ST( 'n',	0,        0,     0 ), /*   262 262               */
+  S_ST( 's',	0,        0,     0 ), /*   263 263               */
+  S_ST( 'e',	3,      293,   251 ), /*   264 m                 */
+  S_ST( 'h',	0,        0,     0 ), /*   265 265               */
+  S_ST( 'e',	0,        0,     0 ), /*   266 266               */
+  S_ST( 'd',	0,        0,     0 ), /*   267 267               */
+  S_ST( 's',	0,        0,     0 ), /*   268 268               */
+  S_ST( 'y',	0,        0,     0 ), /*   269 269               */
+  S_ST( 't',	0,        0,     0 ), /*   270 270               */
+  S_ST( 'e',	0,        0,     0 ), /*   271 271               */
+  S_ST( 'a',	0,       38,     0 ), /*   272 272               */
+  S_ST( 'g',	0,        0,     0 ), /*   273 273               */
+  S_ST( 't',	0,        0,     0 ), /*   274 274               */
+  S_ST( 'k',	1,       53,     0 ), /*   275 275               */
+  S_ST( 's',	0,        0,     0 ), /*   276 276               */
+  S_ST( 'l',	3,      285,     0 ), /*   277 mem               */
+  S_ST( 'e',	0,        0,     0 ), /*   278 278               */
+  S_ST( 'y',	0,        0,     0 ), /*   279 279               */
+  S_ST( 'l',	0,        0,     0 ), /*   280 280               */
+  S_ST( 'y',	0,        0,     0 ), /*   281 281               */
+  S_ST( 't',	0,        0,     0 ), /*   282 282               */
+  S_ST( 'e',	0,        0,     0 ), /*   283 283               */
+  S_ST( 'n',	0,        0,     0 ), /*   284 284               */
+  S_ST( 'o',	3,      289,     0 ), /*   285 meml              */
+  S_ST( 'e',	1,        0,     0 ), /*   286 286               */
+  S_ST( 'p',	0,        0,     0 ), /*   287 287               */
+  S_ST( 'p',	0,        0,     0 ), /*   288 288               */
+  S_ST( 'c',	3,      349,     0 ), /*   289 memlo             */
+  S_ST( '.',	0,        0,     0 ), /*   290 290               */
+  S_ST( 'e',	0,        0,     0 ), /*   291 291               */
+  S_ST( 'd',	0,        0,    99 ), /*   292 292               */
+  S_ST( 't',	3,      314,   348 ), /*   293 me                */
+  S_ST( 'e',	1,      107,     0 ), /*   294 294               */
+  S_ST( 'n',	0,        0,     0 ), /*   295 295               */
+  S_ST( 'm',	0,        0,     0 ), /*   296 296               */
+  S_ST( '1',	0,        0,     0 ), /*   297 297               */
+  S_ST( '2',	0,        0,   297 ), /*   298 298               */
+  S_ST( '3',	0,        0,   298 ), /*   299 299               */
+  S_ST( '4',	0,        0,   299 ), /*   300 300               */
+  S_ST( 'e',	0,        0,     0 ), /*   301 301               */
+  S_ST( 'r',	0,        0,     0 ), /*   302 302               */
+  S_ST( 'q',	0,        0,     0 ), /*   303 303               */
+  S_ST( 'e',	1,        0,     0 ), /*   304 304               */
+  S_ST( 'r',	0,        0,     0 ), /*   305 305               */
+  S_ST( 'f',	0,        0,     0 ), /*   306 306               */
+  S_ST( 't',	0,        0,     0 ), /*   307 307               */
+  S_ST( 'e',	0,        0,     0 ), /*   308 308               */
+  S_ST( 'c',	0,        0,     0 ), /*   309 309               */
+  S_ST( 'm',	0,        0,     0 ), /*   310 310               */
+  S_ST( 'c',	0,        0,     0 ), /*   311 311               */
+  S_ST( 'm',	0,        0,     0 ), /*   312 312               */
+  S_ST( 'e',	1,        0,     0 ), /*   313 313               */
+  S_ST( 'r',	3,      317,     0 ), /*   314 met               */
+  S_ST( 'e',	0,        0,     0 ), /*   315 315               */
+  S_ST( 'l',	0,        0,     0 ), /*   316 316               */
+  S_ST( 'i',	3,      397,     0 ), /*   317 metr              */
+  S_ST( 'o',	0,        0,   142 ), /*   318 318               */
+  S_ST( '4',	0,        0,     0 ), /*   319 319               */
+  S_ST( '4',	0,        0,     0 ), /*   320 320               */
+  S_ST( '6',	0,        0,   319 ), /*   321 321               */
+  S_ST( '6',	0,        0,   320 ), /*   322 322               */
+  S_ST( 'l',	0,        0,     0 ), /*   323 323               */
+  S_ST( 'y',	0,      325,   177 ), /*   324 324               */
+  S_ST( 's',	1,        0,     0 ), /*   325 325               */
+  S_ST( 'd',	0,        0,     0 ), /*   326 326               */
+  S_ST( 'p',	0,        0,     0 ), /*   327 327               */
+  S_ST( 'e',	1,        0,     0 ), /*   328 328               */
+  S_ST( 'l',	0,        0,     0 ), /*   329 329               */
+  S_ST( 't',	0,      203,     0 ), /*   330 330               */
+  S_ST( 'd',	0,        0,     0 ), /*   331 331               */
+  S_ST( 'k',	0,        0,     0 ), /*   332 332               */
+  S_ST( 'n',	0,        0,     0 ), /*   333 333               */
+  S_ST( 'g',	2,        0,     0 ), /*   334 334               */
+  S_ST( 'e',	1,        0,     0 ), /*   335 335               */
+  S_ST( 'e',	0,        0,     0 ), /*   336 336               */
+  S_ST( 's',	0,        0,     0 ), /*   337 337               */
+  S_ST( 'k',	0,        0,     0 ), /*   338 338               */
+  S_ST( 'e',	0,        0,     0 ), /*   339 339               */
+  S_ST( 'k',	0,        0,     0 ), /*   340 340               */
+  S_ST( 'h',	0,        0,     0 ), /*   341 341               */
+  S_ST( 'p',	0,        0,     0 ), /*   342 342               */
+  S_ST( 't',	0,        0,   342 ), /*   343 343               */
+  S_ST( 'm',	0,        0,     0 ), /*   344 344               */
+  S_ST( 'l',	0,        0,     0 ), /*   345 345               */
+  S_ST( 's',	0,        0,     0 ), /*   346 346               */
+  S_ST( 's',	0,        0,     0 ), /*   347 347               */
+  S_ST( 'm',	0,      277,     0 ), /*   348 348               */
+  S_ST( 'k',	0,        0,     0 ), /*   349 349               */
+  S_ST( 's',	0,        0,     0 ), /*   350 350               */
+  S_ST( 'e',	0,        0,     0 ), /*   351 351               */
+  S_ST( 'k',	0,        0,     0 ), /*   352 352               */
+  S_ST( 'h',	0,        0,     0 ), /*   353 353               */
+  S_ST( 't',	0,        0,     0 ), /*   354 354               */
+  S_ST( 'l',	0,        0,     0 ), /*   355 355               */
+  S_ST( 'e',	0,        0,     0 ), /*   356 356               */
+  S_ST( 's',	0,        0,     0 ), /*   357 357               */
+  S_ST( 'e',	0,        0,     0 ), /*   358 358               */
+  S_ST( 'r',	0,        0,     0 ), /*   359 359               */
+  S_ST( 'h',	0,        0,     0 ), /*   360 360               */
+  S_ST( 'u',	0,        0,     0 ), /*   361 361               */
+  S_ST( 'c',	0,        0,     0 ), /*   362 362               */
+  S_ST( 'k',	0,        0,     0 ), /*   363 363               */
+  S_ST( 'y',	0,        0,     0 ), /*   364 364               */
+  S_ST( 't',	0,        0,     0 ), /*   365 365               */
+  S_ST( 'e',	0,        0,     0 ), /*   366 366               */
+  S_ST( 'e',	0,        0,     0 ), /*   367 367               */
+  S_ST( 'r',	0,        0,     0 ), /*   368 368               */
+  S_ST( 'y',	0,        0,     0 ), /*   369 369               */
+  S_ST( 't',	0,        0,     0 ), /*   370 370               */
+  S_ST( 'e',	0,        0,     0 ), /*   371 371               */
+  S_ST( 'p',	0,        0,     0 ), /*   372 372               */
+  S_ST( 't',	0,        0,     0 ), /*   373 373               */
+  S_ST( 'l',	0,        0,     0 ), /*   374 374               */
+  S_ST( 'p',	0,      525,     0 ), /*   375 375               */
+  S_ST( 't',	0,        0,     0 ), /*   376 376               */
+  S_ST( 't',	1,        0,     0 ), /*   377 377               */
+  S_ST( 's',	0,        0,   375 ), /*   378 378               */
+  S_ST( 'n',	0,      540,     0 ), /*   379 379               */
+  S_ST( 't',	0,        0,     0 ), /*   380 380               */
+  S_ST( 'c',	0,        0,     0 ), /*   381 381               */
+  S_ST( 'h',	1,        0,     0 ), /*   382 382               */
+  S_ST( 'r',	1,      550,     0 ), /*   383 383               */
+  S_ST( 's',	0,        0,     0 ), /*   384 384               */
+  S_ST( 'e',	2,        0,     0 ), /*   385 385               */
+  S_ST( 'd',	0,      558,     0 ), /*   386 386               */
+  S_ST( 'e',	1,        0,     0 ), /*   387 387               */
+  S_ST( 'l',	1,        0,     0 ), /*   388 388               */
+  S_ST( 't',	0,        0,     0 ), /*   389 389               */
+  S_ST( 'h',	1,        0,     0 ), /*   390 390               */
+  S_ST( 'r',	0,        0,     0 ), /*   391 391               */
+  S_ST( 's',	0,        0,     0 ), /*   392 392               */
+  S_ST( 's',	0,        0,     0 ), /*   393 393               */
+  S_ST( 'k',	1,        0,     0 ), /*   394 394               */
+  S_ST( 'd',	1,        0,     0 ), /*   395 395               */
+  S_ST( 'y',	0,        0,     0 ), /*   396 396               */
+  S_ST( 'c',	3,      350,     0 ), /*   397 metri             */
+  S_ST( 'r',	0,        0,     0 ), /*   398 398               */
+  S_ST( 't',	0,        0,   603 ), /*   399 399               */
+  S_ST( 't',	0,        0,     0 ), /*   400 400               */
+  S_ST( 't',	0,        0,     0 ), /*   401 401               */
+  S_ST( 'e',	0,        0,     0 ), /*   402 402               */
+  S_ST( 'i',	3,      419,   264 ), /*   403 m                 */
+  S_ST( 'r',	1,        0,     0 ), /*   404 404               */
+  S_ST( 'r',	1,        0,     0 ), /*   405 405               */
+  S_ST( 's',	0,        0,     0 ), /*   406 406               */
+  S_ST( 'e',	0,        0,     0 ), /*   407 407               */
+  S_ST( 'e',	0,        0,     0 ), /*   408 408               */
+  S_ST( 's',	0,        0,     0 ), /*   409 409               */
+  S_ST( 's',	0,        0,     0 ), /*   410 410               */
+  S_ST( 's',	0,      652,   647 ), /*   411 411               */
+  S_ST( 'r',	1,        0,     0 ), /*   412 412               */
+  S_ST( 'p',	0,      660,     0 ), /*   413 413               */
+  S_ST( 'k',	0,        0,     0 ), /*   414 414               */
+  S_ST( 'd',	0,        0,     0 ), /*   415 415               */
+  S_ST( 't',	0,        0,     0 ), /*   416 416               */
+  S_ST( 'm',	0,        0,     0 ), /*   417 417               */
+  S_ST( 'e',	0,        0,     0 ), /*   418 418               */
+  S_ST( 'n',	3,      462,     0 ), /*   419 mi                */
+  S_ST( 's',	0,      672,     0 ), /*   420 420               */
+  S_ST( 's',	0,        0,     0 ), /*   421 421               */
+  S_ST( 'k',	0,        0,     0 ), /*   422 422               */
+  S_ST( '1',	0,        0,     0 ), /*   423 423               */
+  S_ST( '2',	0,        0,   423 ), /*   424 424               */
+  S_ST( 'r',	0,        0,   424 ), /*   425 425               */
+  S_ST( 'a',	3,      429,     0 ), /*   426 min               */
+  S_ST( 'r',	0,        0,     0 ), /*   427 427               */
+  S_ST( 't',	0,        0,     0 ), /*   428 428               */
+  S_ST( 'g',	3,      351,     0 ), /*   429 mina              */
+  S_ST( 's',	1,        0,     0 ), /*   430 430               */
+  S_ST( 's',	0,        0,     0 ), /*   431 431               */
+  S_ST( 'e',	0,        0,     0 ), /*   432 432               */
+  S_ST( 'y',	0,        0,     0 ), /*   433 433               */
+  S_ST( 'p',	0,        0,     0 ), /*   434 434               */
+  S_ST( 'e',	0,        0,     0 ), /*   435 435               */
+  S_ST( 'c',	3,      443,   426 ), /*   436 min               */
+  S_ST( 't',	0,        0,     0 ), /*   437 437               */
+  S_ST( 'g',	1,        0,     0 ), /*   438 438               */
+  S_ST( 'r',	1,        0,     0 ), /*   439 439               */
+  S_ST( 't',	0,        0,     0 ), /*   440 440               */
+  S_ST( 's',	0,        0,     0 ), /*   441 441               */
+  S_ST( 'n',	0,        0,     0 ), /*   442 442               */
+  S_ST( 'l',	3,      448,     0 ), /*   443 minc              */
+  S_ST( 'k',	0,        0,     0 ), /*   444 444               */
+  S_ST( 'd',	0,        0,     0 ), /*   445 445               */
+  S_ST( 'e',	0,        0,     0 ), /*   446 446               */
+  S_ST( 'r',	0,        0,     0 ), /*   447 447               */
+  S_ST( 'o',	3,      449,     0 ), /*   448 mincl             */
+  S_ST( 'c',	3,      352,     0 ), /*   449 minclo            */
+  S_ST( 'd',	3,      454,   436 ), /*   450 min               */
+  S_ST( 'e',	3,      452,     0 ), /*   451 mind              */
+  S_ST( 'p',	3,      453,     0 ), /*   452 minde             */
+  S_ST( 't',	3,      353,     0 ), /*   453 mindep            */
+  S_ST( 'i',	3,      455,   451 ), /*   454 mind              */
+  S_ST( 's',	3,      354,     0 ), /*   455 mindi             */
+  S_ST( 'p',	3,      457,   450 ), /*   456 min               */
+  S_ST( 'o',	3,      458,     0 ), /*   457 minp              */
+  S_ST( 'l',	3,      355,     0 ), /*   458 minpo             */
+  S_ST( 's',	3,      460,   456 ), /*   459 min               */
+  S_ST( 'a',	3,      461,     0 ), /*   460 mins              */
+  S_ST( 'n',	3,      356,     0 ), /*   461 minsa             */
+  S_ST( 't',	3,      463,   459 ), /*   462 min               */
+  S_ST( 'l',	3,      357,     0 ), /*   463 mint              */
+  S_ST( 'o',	3,      466,   403 ), /*   464 m                 */
+  S_ST( 'd',	3,      358,     0 ), /*   465 mo                */
+  S_ST( 'n',	3,      470,   465 ), /*   466 mo                */
+  S_ST( 'i',	3,      468,     0 ), /*   467 mon               */
+  S_ST( 't',	3,      469,     0 ), /*   468 moni              */
+  S_ST( 'o',	3,      359,     0 ), /*   469 monit             */
+  S_ST( 't',	3,      360,   467 ), /*   470 mon               */
+  S_ST( 'r',	3,      361,   464 ), /*   471 m                 */
+  S_ST( 's',	3,      473,   471 ), /*   472 m                 */
+  S_ST( 's',	3,      474,     0 ), /*   473 ms                */
+  S_ST( 'n',	3,      475,     0 ), /*   474 mss               */
+  S_ST( 't',	3,      327,     0 ), /*   475 mssn              */
+  S_ST( 'n',	3,      521,   228 ), /*   476                   */
+  S_ST( 'i',	3,      362,     0 ), /*   477 n                 */
+  S_ST( 'o',	3,      519,   477 ), /*   478 n                 */
+  S_ST( 'l',	3,      480,     0 ), /*   479 no                */
+  S_ST( 'i',	3,      481,     0 ), /*   480 nol               */
+  S_ST( 'n',	3,      363,     0 ), /*   481 noli              */
+  S_ST( 'm',	3,      487,   479 ), /*   482 no                */
+  S_ST( 'o',	3,      484,     0 ), /*   483 nom               */
+  S_ST( 'd',	3,      485,     0 ), /*   484 nomo              */
+  S_ST( 'i',	3,      486,     0 ), /*   485 nomod             */
+  S_ST( 'f',	3,      364,     0 ), /*   486 nomodi            */
+  S_ST( 'r',	3,      488,   483 ), /*   487 nom               */
+  S_ST( 'u',	3,      489,     0 ), /*   488 nomr              */
+  S_ST( 'l',	3,      490,     0 ), /*   489 nomru             */
+  S_ST( 'i',	3,      491,     0 ), /*   490 nomrul            */
+  S_ST( 's',	3,      365,     0 ), /*   491 nomruli           */
+  S_ST( 'n',	3,      493,   482 ), /*   492 no                */
+  S_ST( 'v',	3,      494,   366 ), /*   493 non               */
+  S_ST( 'o',	3,      495,     0 ), /*   494 nonv              */
+  S_ST( 'l',	3,      496,     0 ), /*   495 nonvo             */
+  S_ST( 'a',	3,      497,     0 ), /*   496 nonvol            */
+  S_ST( 't',	3,      498,     0 ), /*   497 nonvola           */
+  S_ST( 'i',	3,      499,     0 ), /*   498 nonvolat          */
+  S_ST( 'l',	3,      367,     0 ), /*   499 nonvolati         */
+  S_ST( 'p',	3,      501,   492 ), /*   500 no                */
+  S_ST( 'e',	3,      502,     0 ), /*   501 nop               */
+  S_ST( 'e',	3,      368,     0 ), /*   502 nope              */
+  S_ST( 'q',	3,      504,   500 ), /*   503 no                */
+  S_ST( 'u',	3,      505,     0 ), /*   504 noq               */
+  S_ST( 'e',	3,      506,     0 ), /*   505 noqu              */
+  S_ST( 'r',	3,      369,     0 ), /*   506 noque             */
+  S_ST( 's',	3,      508,   503 ), /*   507 no                */
+  S_ST( 'e',	3,      512,     0 ), /*   508 nos               */
+  S_ST( 'l',	3,      510,     0 ), /*   509 nose              */
+  S_ST( 'e',	3,      511,     0 ), /*   510 nosel             */
+  S_ST( 'c',	3,      370,     0 ), /*   511 nosele            */
+  S_ST( 'r',	3,      513,   509 ), /*   512 nose              */
+  S_ST( 'v',	3,      371,     0 ), /*   513 noser             */
+  S_ST( 't',	3,      515,   507 ), /*   514 no                */
+  S_ST( 'r',	3,      517,     0 ), /*   515 not               */
+  S_ST( 'a',	3,      372,     0 ), /*   516 notr              */
+  S_ST( 'u',	3,      518,   516 ), /*   517 notr              */
+  S_ST( 's',	3,      373,     0 ), /*   518 notru             */
+  S_ST( 'v',	3,      520,   514 ), /*   519 no                */
+  S_ST( 'a',	3,      374,     0 ), /*   520 nov               */
+  S_ST( 't',	3,      378,   478 ), /*   521 n                 */
+  S_ST( 'p',	3,      523,     0 ), /*   522 ntp               */
+  S_ST( 'o',	3,      524,     0 ), /*   523 ntpp              */
+  S_ST( 'r',	3,      376,     0 ), /*   524 ntppo             */
+  S_ST( 's',	3,      526,   522 ), /*   525 ntp               */
+  S_ST( 'i',	3,      527,     0 ), /*   526 ntps              */
+  S_ST( 'g',	3,      528,     0 ), /*   527 ntpsi             */
+  S_ST( 'n',	3,      529,     0 ), /*   528 ntpsig            */
+  S_ST( 'd',	3,      530,     0 ), /*   529 ntpsign           */
+  S_ST( 's',	3,      531,     0 ), /*   530 ntpsignd          */
+  S_ST( 'o',	3,      532,     0 ), /*   531 ntpsignds         */
+  S_ST( 'c',	3,      533,     0 ), /*   532 ntpsigndso        */
+  S_ST( 'k',	3,      534,     0 ), /*   533 ntpsigndsoc       */
+  S_ST( 'e',	3,      377,     0 ), /*   534 ntpsigndsock      */
+  S_ST( 'o',	3,      536,   476 ), /*   535                   */
+  S_ST( 'r',	3,      537,     0 ), /*   536 o                 */
+  S_ST( 'p',	3,      538,     0 ), /*   537 or                */
+  S_ST( 'h',	3,      539,     0 ), /*   538 orp               */
+  S_ST( 'a',	3,      379,     0 ), /*   539 orph              */
+  S_ST( 'w',	3,      541,     0 ), /*   540 orphan            */
+  S_ST( 'a',	3,      542,     0 ), /*   541 orphanw           */
+  S_ST( 'i',	3,      380,     0 ), /*   542 orphanwa          */
+  S_ST( 'p',	3,      569,   535 ), /*   543                   */
+  S_ST( 'a',	3,      547,     0 ), /*   544 p                 */
+  S_ST( 'n',	3,      546,     0 ), /*   545 pa                */
+  S_ST( 'i',	3,      381,     0 ), /*   546 pan               */
+  S_ST( 't',	3,      382,   545 ), /*   547 pa                */
+  S_ST( 'e',	3,      549,   544 ), /*   548 p                 */
+  S_ST( 'e',	3,      383,     0 ), /*   549 pe                */
+  S_ST( 's',	3,      551,     0 ), /*   550 peer              */
+  S_ST( 't',	3,      552,     0 ), /*   551 peers             */
+  S_ST( 'a',	3,      553,     0 ), /*   552 peerst            */
+  S_ST( 't',	3,      384,     0 ), /*   553 peersta           */
+  S_ST( 'h',	3,      555,   548 ), /*   554 p                 */
+  S_ST( 'o',	3,      556,     0 ), /*   555 ph                */
+  S_ST( 'n',	3,      385,     0 ), /*   556 pho               */
+  S_ST( 'i',	3,      386,   554 ), /*   557 p                 */
+  S_ST( 'f',	3,      559,     0 ), /*   558 pid               */
+  S_ST( 'i',	3,      560,     0 ), /*   559 pidf              */
+  S_ST( 'l',	3,      387,     0 ), /*   560 pidfi             */
+  S_ST( 'o',	3,      563,   557 ), /*   561 p                 */
+  S_ST( 'o',	3,      388,     0 ), /*   562 po                */
+  S_ST( 'r',	3,      389,   562 ), /*   563 po                */
+  S_ST( 'p',	3,      565,   561 ), /*   564 p                 */
+  S_ST( 's',	3,      566,     0 ), /*   565 pp                */
+  S_ST( 'p',	3,      567,     0 ), /*   566 pps               */
+  S_ST( 'a',	3,      568,     0 ), /*   567 ppsp              */
+  S_ST( 't',	3,      390,     0 ), /*   568 ppspa             */
+  S_ST( 'r',	3,      573,   564 ), /*   569 p                 */
+  S_ST( 'e',	3,      571,     0 ), /*   570 pr                */
+  S_ST( 'f',	3,      572,     0 ), /*   571 pre               */
+  S_ST( 'e',	3,      391,     0 ), /*   572 pref              */
+  S_ST( 'o',	3,      574,   570 ), /*   573 pr                */
+  S_ST( 't',	3,      575,     0 ), /*   574 pro               */
+  S_ST( 'o',	3,      576,     0 ), /*   575 prot              */
+  S_ST( 's',	3,      577,     0 ), /*   576 proto             */
+  S_ST( 't',	3,      578,     0 ), /*   577 protos            */
+  S_ST( 'a',	3,      579,     0 ), /*   578 protost           */
+  S_ST( 't',	3,      392,     0 ), /*   579 protosta          */
+  S_ST( 'r',	3,      611,   543 ), /*   580                   */
+  S_ST( 'a',	3,      582,     0 ), /*   581 r                 */
+  S_ST( 'w',	3,      583,     0 ), /*   582 ra                */
+  S_ST( 's',	3,      584,     0 ), /*   583 raw               */
+  S_ST( 't',	3,      585,     0 ), /*   584 raws              */
+  S_ST( 'a',	3,      586,     0 ), /*   585 rawst             */
+  S_ST( 't',	3,      393,     0 ), /*   586 rawsta            */
+  S_ST( 'e',	3,      601,   581 ), /*   587 r                 */
+  S_ST( 'f',	3,      593,     0 ), /*   588 re                */
+  S_ST( 'c',	3,      590,     0 ), /*   589 ref               */
+  S_ST( 'l',	3,      591,     0 ), /*   590 refc              */
+  S_ST( 'o',	3,      592,     0 ), /*   591 refcl             */
+  S_ST( 'c',	3,      394,     0 ), /*   592 refclo            */
+  S_ST( 'i',	3,      395,   589 ), /*   593 ref               */
+  S_ST( 'q',	3,      595,   588 ), /*   594 re                */
+  S_ST( 'u',	3,      596,     0 ), /*   595 req               */
+  S_ST( 'e',	3,      597,     0 ), /*   596 requ              */
+  S_ST( 's',	3,      598,     0 ), /*   597 reque             */
+  S_ST( 't',	3,      599,     0 ), /*   598 reques            */
+  S_ST( 'k',	3,      600,     0 ), /*   599 request           */
+  S_ST( 'e',	3,      396,     0 ), /*   600 requestk          */
+  S_ST( 's',	3,      607,   594 ), /*   601 re                */
+  S_ST( 'e',	3,      399,     0 ), /*   602 res               */
+  S_ST( 'r',	3,      604,     0 ), /*   603 rese              */
+  S_ST( 'v',	3,      605,     0 ), /*   604 reser             */
+  S_ST( 'o',	3,      606,     0 ), /*   605 reserv            */
+  S_ST( 'i',	3,      398,     0 ), /*   606 reservo           */
+  S_ST( 't',	3,      608,   602 ), /*   607 res               */
+  S_ST( 'r',	3,      609,     0 ), /*   608 rest              */
+  S_ST( 'i',	3,      610,     0 ), /*   609 restr             */
+  S_ST( 'c',	3,      400,     0 ), /*   610 restri            */
+  S_ST( 'l',	3,      612,   587 ), /*   611 r                 */
+  S_ST( 'i',	3,      613,     0 ), /*   612 rl                */
+  S_ST( 'm',	3,      614,     0 ), /*   613 rli               */
+  S_ST( 'i',	3,      401,     0 ), /*   614 rlim              */
+  S_ST( 's',	3,      671,   580 ), /*   615                   */
+  S_ST( 'a',	3,      617,     0 ), /*   616 s                 */
+  S_ST( 'm',	3,      618,     0 ), /*   617 sa                */
+  S_ST( 'p',	3,      619,     0 ), /*   618 sam               */
+  S_ST( 'l',	3,      402,     0 ), /*   619 samp              */
+  S_ST( 'e',	3,      624,   616 ), /*   620 s                 */
+  S_ST( 'r',	3,      622,     0 ), /*   621 se                */
+  S_ST( 'v',	3,      623,     0 ), /*   622 ser               */
+  S_ST( 'e',	3,      404,     0 ), /*   623 serv              */
+  S_ST( 't',	3,      625,   621 ), /*   624 se                */
+  S_ST( 'v',	3,      626,     0 ), /*   625 set               */
+  S_ST( 'a',	3,      405,     0 ), /*   626 setv              */
+  S_ST( 'h',	3,      628,   620 ), /*   627 s                 */
+  S_ST( 'm',	3,      629,     0 ), /*   628 sh                */
+  S_ST( 's',	3,      630,     0 ), /*   629 shm               */
+  S_ST( 't',	3,      631,     0 ), /*   630 shms              */
+  S_ST( 'a',	3,      632,     0 ), /*   631 shmst             */
+  S_ST( 't',	3,      406,     0 ), /*   632 shmsta            */
+  S_ST( 'o',	3,      634,   627 ), /*   633 s                 */
+  S_ST( 'u',	3,      635,     0 ), /*   634 so                */
+  S_ST( 'r',	3,      636,     0 ), /*   635 sou               */
+  S_ST( 'c',	3,      407,     0 ), /*   636 sour              */
+  S_ST( 't',	3,      662,   633 ), /*   637 s                 */
+  S_ST( 'a',	3,      646,     0 ), /*   638 st                */
+  S_ST( 'c',	3,      640,     0 ), /*   639 sta               */
+  S_ST( 'k',	3,      641,     0 ), /*   640 stac              */
+  S_ST( 's',	3,      642,     0 ), /*   641 stack             */
+  S_ST( 'i',	3,      643,     0 ), /*   642 stacks            */
+  S_ST( 'z',	3,      408,     0 ), /*   643 stacksi           */
+  S_ST( 'g',	3,      645,   639 ), /*   644 sta               */
+  S_ST( 'e',	3,      409,     0 ), /*   645 stag              */
+  S_ST( 't',	3,      411,   644 ), /*   646 sta               */
+  S_ST( 'i',	3,      648,     0 ), /*   647 stat              */
+  S_ST( 's',	3,      649,     0 ), /*   648 stati             */
+  S_ST( 't',	3,      650,     0 ), /*   649 statis            */
+  S_ST( 'i',	3,      651,     0 ), /*   650 statist           */
+  S_ST( 'c',	3,      410,     0 ), /*   651 statisti          */
+  S_ST( 'd',	3,      653,     0 ), /*   652 stats             */
+  S_ST( 'i',	3,      412,     0 ), /*   653 statsd            */
+  S_ST( 'e',	3,      413,   638 ), /*   654 st                */
+  S_ST( 'b',	3,      656,     0 ), /*   655 step              */
+  S_ST( 'a',	3,      657,     0 ), /*   656 stepb             */
+  S_ST( 'c',	3,      414,     0 ), /*   657 stepba            */
+  S_ST( 'f',	3,      659,   655 ), /*   658 step              */
+  S_ST( 'w',	3,      415,     0 ), /*   659 stepf             */
+  S_ST( 'o',	3,      661,   658 ), /*   660 step              */
+  S_ST( 'u',	3,      416,     0 ), /*   661 stepo             */
+  S_ST( 'r',	3,      663,   654 ), /*   662 st                */
+  S_ST( 'a',	3,      664,     0 ), /*   663 str               */
+  S_ST( 't',	3,      665,     0 ), /*   664 stra              */
+  S_ST( 'u',	3,      417,     0 ), /*   665 strat             */
+  S_ST( 'u',	3,      667,   637 ), /*   666 s                 */
+  S_ST( 'b',	3,      668,     0 ), /*   667 su                */
+  S_ST( 't',	3,      669,     0 ), /*   668 sub               */
+  S_ST( 'y',	3,      670,     0 ), /*   669 subt              */
+  S_ST( 'p',	3,      418,     0 ), /*   670 subty             */
+  S_ST( 'y',	3,      420,   666 ), /*   671 s                 */
+  S_ST( 's',	3,      673,     0 ), /*   672 sys               */
+  S_ST( 't',	3,      674,     0 ), /*   673 syss              */
+  S_ST( 'a',	3,      675,     0 ), /*   674 sysst             */
+  S_ST( 't',	3,      421,     0 ), /*   675 syssta            */
+  S_ST( 't',	3,      713,   615 ), /*   676                   */
+  S_ST( 'e',	3,      678,     0 ), /*   677 t                 */
+  S_ST( 'x',	3,      428,     0 ), /*   678 te                */
+  S_ST( 'i',	3,      683,   677 ), /*   679 t                 */
+  S_ST( 'c',	3,      422,     0 ), /*   680 ti                */
+  S_ST( 'm',	3,      682,   680 ), /*   681 ti                */
+  S_ST( 'e',	3,      425,     0 ), /*   682 tim               */
+  S_ST( 'n',	3,      684,   681 ), /*   683 ti                */
+  S_ST( 'k',	3,      685,     0 ), /*   684 tin               */
+  S_ST( 'e',	3,      427,     0 ), /*   685 tink              */
+  S_ST( 'l',	3,      687,   679 ), /*   686 t                 */
+  S_ST( 's',	3,      688,     0 ), /*   687 tl                */
+  S_ST( 'c',	3,      689,     0 ), /*   688 tls               */
+  S_ST( 'i',	3,      690,     0 ), /*   689 tlsc              */
+  S_ST( 'p',	3,      691,     0 ), /*   690 tlsci             */
+  S_ST( 'h',	3,      692,     0 ), /*   691 tlscip            */
+  S_ST( 'e',	3,      693,     0 ), /*   692 tlsciph           */
+  S_ST( 'r',	3,      694,     0 ), /*   693 tlsciphe          */
+  S_ST( 's',	3,      695,     0 ), /*   694 tlscipher         */
+  S_ST( 'u',	3,      696,     0 ), /*   695 tlsciphers        */
+  S_ST( 'i',	3,      697,     0 ), /*   696 tlsciphersu       */
+  S_ST( 't',	3,      698,     0 ), /*   697 tlsciphersui      */
+  S_ST( 'e',	3,      430,     0 ), /*   698 tlsciphersuit     */
+  S_ST( 'o',	3,      431,   686 ), /*   699 t                 */
+  S_ST( 'r',	3,      701,   699 ), /*   700 t                 */
+  S_ST( 'u',	3,      702,     0 ), /*   701 tr                */
+  S_ST( 's',	3,      703,   432 ), /*   702 tru               */
+  S_ST( 't',	3,      704,     0 ), /*   703 trus              */
+  S_ST( 'e',	3,      705,     0 ), /*   704 trust             */
+  S_ST( 'd',	3,      706,     0 ), /*   705 truste            */
+  S_ST( 'k',	3,      707,     0 ), /*   706 trusted           */
+  S_ST( 'e',	3,      433,     0 ), /*   707 trustedk          */
+  S_ST( 'x',	3,      709,   700 ), /*   708 t                 */
+  S_ST( 's',	3,      710,     0 ), /*   709 tx                */
+  S_ST( 't',	3,      711,     0 ), /*   710 txs               */
+  S_ST( 'a',	3,      712,     0 ), /*   711 txst              */
+  S_ST( 'm',	3,      434,     0 ), /*   712 txsta             */
+  S_ST( 'y',	3,      714,   708 ), /*   713 t                 */
+  S_ST( 'p',	3,      435,     0 ), /*   714 ty                */
+  S_ST( 'u',	3,      733,   676 ), /*   715                   */
+  S_ST( 'n',	3,      726,     0 ), /*   716 u                 */
+  S_ST( 'c',	3,      718,     0 ), /*   717 un                */
+  S_ST( 'o',	3,      719,     0 ), /*   718 unc               */
+  S_ST( 'n',	3,      720,     0 ), /*   719 unco              */
+  S_ST( 'f',	3,      721,     0 ), /*   720 uncon             */
+  S_ST( 'i',	3,      438,     0 ), /*   721 unconf            */
+  S_ST( 'i',	3,      437,   717 ), /*   722 un                */
+  S_ST( 'p',	3,      724,   722 ), /*   723 un                */
+  S_ST( 'e',	3,      725,     0 ), /*   724 unp               */
+  S_ST( 'e',	3,      439,     0 ), /*   725 unpe              */
+  S_ST( 'r',	3,      727,   723 ), /*   726 un                */
+  S_ST( 'e',	3,      728,     0 ), /*   727 unr               */
+  S_ST( 's',	3,      729,     0 ), /*   728 unre              */
+  S_ST( 't',	3,      730,     0 ), /*   729 unres             */
+  S_ST( 'r',	3,      731,     0 ), /*   730 unrest            */
+  S_ST( 'i',	3,      732,     0 ), /*   731 unrestr           */
+  S_ST( 'c',	3,      440,     0 ), /*   732 unrestri          */
+  S_ST( 's',	3,      734,   716 ), /*   733 u                 */
+  S_ST( 'e',	3,      735,     0 ), /*   734 us                */
+  S_ST( 's',	3,      736,     0 ), /*   735 use               */
+  S_ST( 't',	3,      737,     0 ), /*   736 uses              */
+  S_ST( 'a',	3,      738,     0 ), /*   737 usest             */
+  S_ST( 't',	3,      441,     0 ), /*   738 usesta            */
+  S_ST( 'v',	3,      740,   715 ), /*   739                   */
+  S_ST( 'e',	3,      741,     0 ), /*   740 v                 */
+  S_ST( 'r',	3,      742,     0 ), /*   741 ve                */
+  S_ST( 's',	3,      743,     0 ), /*   742 ver               */
+  S_ST( 'i',	3,      744,     0 ), /*   743 vers              */
+  S_ST( 'o',	3,      442,     0 ), /*   744 versi             */
+  S_ST( 'w',	3,      748,   739 ), /*   745                   */
+  S_ST( 'e',	3,      747,     0 ), /*   746 w                 */
+  S_ST( 'e',	3,      444,     0 ), /*   747 we                */
+  S_ST( 'i',	3,      749,   746 ), /*   748 w                 */
+  S_ST( 'l',	3,      750,     0 ), /*   749 wi                */
+  S_ST( 'd',	3,      751,     0 ), /*   750 wil               */
+  S_ST( 'c',	3,      752,     0 ), /*   751 wild              */
+  S_ST( 'a',	3,      753,     0 ), /*   752 wildc             */
+  S_ST( 'r',	3,      445,     0 ), /*   753 wildca            */
+  S_ST( 'x',	3,      755,   745 ), /*   754                   */
+  S_ST( 'l',	3,      756,     0 ), /*   755 x                 */
+  S_ST( 'e',	3,      757,     0 ), /*   756 xl                */
+  S_ST( 'a',	3,      758,     0 ), /*   757 xle               */
+  S_ST( 'v',	3,      446,     0 ), /*   758 xlea              */
+  S_ST( 'y',	3,      760,   754 ), /*   759 [initial state]   */
+  S_ST( 'e',	3,      761,     0 ), /*   760 y                 */
+  S_ST( 'a',	3,      447,     0 )  /*   761 ye                */
+};
+
@@ -0,0 +1,3322 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 0
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 13 "/root/repo/ntpd/ntp_parser.y"
+
+  #include "config.h"
+
+  #include "ntp.h"
+  #include "ntpd.h"
+  #include "ntp_machine.h"
+  #include "ntp_stdlib.h"
+  #include "ntp_filegen.h"
+  #include "ntp_scanner.h"
+  #include "ntp_config.h"
+
+  #define YYMALLOC	emalloc
+  #define YYFREE	free
+  #define YYERROR_VERBOSE
+  #define YYMAXDEPTH	1000	/* stop the madness sooner */
+  void yyerror(const char *msg);
+
+#line 89 "ntp_parser.tab.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "ntp_parser.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_T_Adjrate = 3,                  /* T_Adjrate  */
+  YYSYMBOL_T_Aead = 4,                     /* T_Aead  */
+  YYSYMBOL_T_Age = 5,                      /* T_Age  */
+  YYSYMBOL_T_All = 6,                      /* T_All  */
+  YYSYMBOL_T_Allan = 7,                    /* T_Allan  */
+  YYSYMBOL_T_Allpeers = 8,                 /* T_Allpeers  */
+  YYSYMBOL_T_Ask = 9,                      /* T_Ask  */
+  YYSYMBOL_T_Auth = 10,                    /* T_Auth  */
+  YYSYMBOL_T_Average = 11,                 /* T_Average  */
+  YYSYMBOL_T_Baud = 12,                    /* T_Baud  */
+  YYSYMBOL_T_Bias = 13,                    /* T_Bias  */
+  YYSYMBOL_T_Binary = 14,                  /* T_Binary  */
+  YYSYMBOL_T_Burst = 15,                   /* T_Burst  */
+  YYSYMBOL_T_Calibrate = 16,               /* T_Calibrate  */
+  YYSYMBOL_T_Ca = 17,                      /* T_Ca  */
+  YYSYMBOL_T_Ceiling = 18,                 /* T_Ceiling  */
+  YYSYMBOL_T_Cert = 19,                    /* T_Cert  */
+  YYSYMBOL_T_Clock = 20,                   /* T_Clock  */
+  YYSYMBOL_T_Clockstats = 21,              /* T_Clockstats  */
+  YYSYMBOL_T_Cohort = 22,                  /* T_Cohort  */
+  YYSYMBOL_T_Cookie = 23,                  /* T_Cookie  */
+  YYSYMBOL_T_ControlKey = 24,              /* T_ControlKey  */
+  YYSYMBOL_T_Ctl = 25,                     /* T_Ctl  */
+  YYSYMBOL_T_Day = 26,                     /* T_Day  */
+  YYSYMBOL_T_Default = 27,                 /* T_Default  */
+  YYSYMBOL_T_Disable = 28,                 /* T_Disable  */
+  YYSYMBOL_T_Dispersion = 29,              /* T_Dispersion  */
+  YYSYMBOL_T_Double = 30,                  /* T_Double  */
+  YYSYMBOL_T_Driftfile = 31,               /* T_Driftfile  */
+  YYSYMBOL_T_Drop = 32,                    /* T_Drop  */
+  YYSYMBOL_T_Dscp = 33,                    /* T_Dscp  */
+  YYSYMBOL_T_Expire = 34,                  /* T_Expire  */
+  YYSYMBOL_T_Ellipsis = 35,                /* T_Ellipsis  */
+  YYSYMBOL_T_Enable = 36,                  /* T_Enable  */
+  YYSYMBOL_T_End = 37,                     /* T_End  */
+  YYSYMBOL_T_False = 38,                   /* T_False  */
+  YYSYMBOL_T_File = 39,                    /* T_File  */
+  YYSYMBOL_T_Filegen = 40,                 /* T_Filegen  */
+  YYSYMBOL_T_Filenum = 41,                 /* T_Filenum  */
+  YYSYMBOL_T_Flag1 = 42,                   /* T_Flag1  */
+  YYSYMBOL_T_Flag2 = 43,                   /* T_Flag2  */
+  YYSYMBOL_T_Flag3 = 44,                   /* T_Flag3  */
+  YYSYMBOL_T_Flag4 = 45,                   /* T_Flag4  */
+  YYSYMBOL_T_Flake = 46,                   /* T_Flake  */
+  YYSYMBOL_T_Floor = 47,                   /* T_Floor  */
+  YYSYMBOL_T_Freq = 48,                    /* T_Freq  */
+  YYSYMBOL_T_Fudge = 49,                   /* T_Fudge  */
+  YYSYMBOL_T_Holdover = 50,                /* T_Holdover  */
+  YYSYMBOL_T_Huffpuff = 51,                /* T_Huffpuff  */
+  YYSYMBOL_T_Iburst = 52,                  /* T_Iburst  */
+  YYSYMBOL_T_Ignore = 53,                  /* T_Ignore  */
+  YYSYMBOL_T_Incalloc = 54,                /* T_Incalloc  */
+  YYSYMBOL_T_Incmem = 55,                  /* T_Incmem  */
+  YYSYMBOL_T_Initalloc = 56,               /* T_Initalloc  */
+  YYSYMBOL_T_Initmem = 57,                 /* T_Initmem  */
+  YYSYMBOL_T_Includefile = 58,             /* T_Includefile  */
+  YYSYMBOL_T_Integer = 59,                 /* T_Integer  */
+  YYSYMBOL_T_Interface = 60,               /* T_Interface  */
+  YYSYMBOL_T_Interval = 61,                /* T_Interval  */
+  YYSYMBOL_T_Intrange = 62,                /* T_Intrange  */
+  YYSYMBOL_T_Io = 63,                      /* T_Io  */
+  YYSYMBOL_T_Ipv4 = 64,                    /* T_Ipv4  */
+  YYSYMBOL_T_Ipv4_flag = 65,               /* T_Ipv4_flag  */
+  YYSYMBOL_T_Ipv6 = 66,                    /* T_Ipv6  */
+  YYSYMBOL_T_Ipv6_flag = 67,               /* T_Ipv6_flag  */
+  YYSYMBOL_T_Kernel = 68,                  /* T_Kernel  */
+  YYSYMBOL_T_Key = 69,                     /* T_Key  */
+  YYSYMBOL_T_Keys = 70,                    /* T_Keys  */
+  YYSYMBOL_T_Kod = 71,                     /* T_Kod  */
+  YYSYMBOL_T_Mssntp = 72,                  /* T_Mssntp  */
+  YYSYMBOL_T_Leapfile = 73,                /* T_Leapfile  */
+  YYSYMBOL_T_Leapsmearinterval = 74,       /* T_Leapsmearinterval  */
+  YYSYMBOL_T_Limit = 75,                   /* T_Limit  */
+  YYSYMBOL_T_Limited = 76,                 /* T_Limited  */
+  YYSYMBOL_T_Link = 77,                    /* T_Link  */
+  YYSYMBOL_T_Listen = 78,                  /* T_Listen  */
+  YYSYMBOL_T_Logconfig = 79,               /* T_Logconfig  */
+  YYSYMBOL_T_Logfile = 80,                 /* T_Logfile  */
+  YYSYMBOL_T_Logqueue = 81,                /* T_Logqueue  */
+  YYSYMBOL_T_Loopstats = 82,               /* T_Loopstats  */
+  YYSYMBOL_T_Mask = 83,                    /* T_Mask  */
+  YYSYMBOL_T_Maxage = 84,                  /* T_Maxage  */
+  YYSYMBOL_T_Maxclock = 85,                /* T_Maxclock  */
+  YYSYMBOL_T_Maxdepth = 86,                /* T_Maxdepth  */
+  YYSYMBOL_T_Maxdisp = 87,                 /* T_Maxdisp  */
+  YYSYMBOL_T_Maxdist = 88,                 /* T_Maxdist  */
+  YYSYMBOL_T_Maxmem = 89,                  /* T_Maxmem  */
+  YYSYMBOL_T_Maxpoll = 90,                 /* T_Maxpoll  */
+  YYSYMBOL_T_Maxtls = 91,                  /* T_Maxtls  */
+  YYSYMBOL_T_Mdnstries = 92,               /* T_Mdnstries  */
+  YYSYMBOL_T_Mem = 93,                     /* T_Mem  */
+  YYSYMBOL_T_Memlock = 94,                 /* T_Memlock  */
+  YYSYMBOL_T_Metrics = 95,                 /* T_Metrics  */
+  YYSYMBOL_T_Minage = 96,                  /* T_Minage  */
+  YYSYMBOL_T_Minclock = 97,                /* T_Minclock  */
+  YYSYMBOL_T_Mindepth = 98,                /* T_Mindepth  */
+  YYSYMBOL_T_Mindist = 99,                 /* T_Mindist  */
+  YYSYMBOL_T_Minpoll = 100,                /* T_Minpoll  */
+  YYSYMBOL_T_Minsane = 101,                /* T_Minsane  */
+  YYSYMBOL_T_Mintls = 102,                 /* T_Mintls  */
+  YYSYMBOL_T_Mode = 103,                   /* T_Mode  */
+  YYSYMBOL_T_Monitor = 104,                /* T_Monitor  */
+  YYSYMBOL_T_Month = 105,                  /* T_Month  */
+  YYSYMBOL_T_Mru = 106,                    /* T_Mru  */
+  YYSYMBOL_T_Nic = 107,                    /* T_Nic  */
+  YYSYMBOL_T_Nolink = 108,                 /* T_Nolink  */
+  YYSYMBOL_T_Nomodify = 109,               /* T_Nomodify  */
+  YYSYMBOL_T_Nomrulist = 110,              /* T_Nomrulist  */
+  YYSYMBOL_T_None = 111,                   /* T_None  */
+  YYSYMBOL_T_Nonvolatile = 112,            /* T_Nonvolatile  */
+  YYSYMBOL_T_Nopeer = 113,                 /* T_Nopeer  */
+  YYSYMBOL_T_Noquery = 114,                /* T_Noquery  */
+  YYSYMBOL_T_Noselect = 115,               /* T_Noselect  */
+  YYSYMBOL_T_Noserve = 116,                /* T_Noserve  */
+  YYSYMBOL_T_Notrap = 117,                 /* T_Notrap  */
+  YYSYMBOL_T_Notrust = 118,                /* T_Notrust  */
+  YYSYMBOL_T_Noval = 119,                  /* T_Noval  */
+  YYSYMBOL_T_Ntp = 120,                    /* T_Ntp  */
+  YYSYMBOL_T_Ntpport = 121,                /* T_Ntpport  */
+  YYSYMBOL_T_NtpSignDsocket = 122,         /* T_NtpSignDsocket  */
+  YYSYMBOL_T_Nts = 123,                    /* T_Nts  */
+  YYSYMBOL_T_Orphan = 124,                 /* T_Orphan  */
+  YYSYMBOL_T_Orphanwait = 125,             /* T_Orphanwait  */
+  YYSYMBOL_T_Panic = 126,                  /* T_Panic  */
+  YYSYMBOL_T_Path = 127,                   /* T_Path  */
+  YYSYMBOL_T_Peer = 128,                   /* T_Peer  */
+  YYSYMBOL_T_Peerstats = 129,              /* T_Peerstats  */
+  YYSYMBOL_T_Phone = 130,                  /* T_Phone  */
+  YYSYMBOL_T_Pid = 131,                    /* T_Pid  */
+  YYSYMBOL_T_Pidfile = 132,                /* T_Pidfile  */
+  YYSYMBOL_T_Pool = 133,                   /* T_Pool  */
+  YYSYMBOL_T_Port = 134,                   /* T_Port  */
+  YYSYMBOL_T_Ppspath = 135,                /* T_Ppspath  */
+  YYSYMBOL_T_Prefer = 136,                 /* T_Prefer  */
+  YYSYMBOL_T_Protostats = 137,             /* T_Protostats  */
+  YYSYMBOL_T_Rawstats = 138,               /* T_Rawstats  */
+  YYSYMBOL_T_Refclock = 139,               /* T_Refclock  */
+  YYSYMBOL_T_Refid = 140,                  /* T_Refid  */
+  YYSYMBOL_T_Requestkey = 141,             /* T_Requestkey  */
+  YYSYMBOL_T_Require = 142,                /* T_Require  */
+  YYSYMBOL_T_Reservoir = 143,              /* T_Reservoir  */
+  YYSYMBOL_T_Reset = 144,                  /* T_Reset  */
+  YYSYMBOL_T_Restrict = 145,               /* T_Restrict  */
+  YYSYMBOL_T_Rlimit = 146,                 /* T_Rlimit  */
+  YYSYMBOL_T_Sample = 147,                 /* T_Sample  */
+  YYSYMBOL_T_Saveconfigdir = 148,          /* T_Saveconfigdir  */
+  YYSYMBOL_T_Server = 149,                 /* T_Server  */
+  YYSYMBOL_T_Setvar = 150,                 /* T_Setvar  */
+  YYSYMBOL_T_Shmstats = 151,               /* T_Shmstats  */
+  YYSYMBOL_T_Source = 152,                 /* T_Source  */
+  YYSYMBOL_T_Stacksize = 153,              /* T_Stacksize  */
+  YYSYMBOL_T_Stages = 154,                 /* T_Stages  */
+  YYSYMBOL_T_Statistics = 155,             /* T_Statistics  */
+  YYSYMBOL_T_Stats = 156,                  /* T_Stats  */
+  YYSYMBOL_T_Statsdir = 157,               /* T_Statsdir  */
+  YYSYMBOL_T_Step = 158,                   /* T_Step  */
+  YYSYMBOL_T_Stepback = 159,               /* T_Stepback  */
+  YYSYMBOL_T_Stepfwd = 160,                /* T_Stepfwd  */
+  YYSYMBOL_T_Stepout = 161,                /* T_Stepout  */
+  YYSYMBOL_T_Stratum = 162,                /* T_Stratum  */
+  YYSYMBOL_T_Subtype = 163,                /* T_Subtype  */
+  YYSYMBOL_T_String = 164,                 /* T_String  */
+  YYSYMBOL_T_Sys = 165,                    /* T_Sys  */
+  YYSYMBOL_T_Sysstats = 166,               /* T_Sysstats  */
+  YYSYMBOL_T_Tick = 167,                   /* T_Tick  */
+  YYSYMBOL_T_Time1 = 168,                  /* T_Time1  */
+  YYSYMBOL_T_Time2 = 169,                  /* T_Time2  */
+  YYSYMBOL_T_Timer = 170,                  /* T_Timer  */
+  YYSYMBOL_T_Timingstats = 171,            /* T_Timingstats  */
+  YYSYMBOL_T_Tinker = 172,                 /* T_Tinker  */
+  YYSYMBOL_T_Text = 173,                   /* T_Text  */
+  YYSYMBOL_T_Tlsciphers = 174,             /* T_Tlsciphers  */
+  YYSYMBOL_T_Tlsciphersuites = 175,        /* T_Tlsciphersuites  */
+  YYSYMBOL_T_Tos = 176,                    /* T_Tos  */
+  YYSYMBOL_T_True = 177,                   /* T_True  */
+  YYSYMBOL_T_Trustedkey = 178,             /* T_Trustedkey  */
+  YYSYMBOL_T_Txstamp = 179,                /* T_Txstamp  */
+  YYSYMBOL_T_Type = 180,                   /* T_Type  */
+  YYSYMBOL_T_U_int = 181,                  /* T_U_int  */
+  YYSYMBOL_T_Unit = 182,                   /* T_Unit  */
+  YYSYMBOL_T_Unconfig = 183,               /* T_Unconfig  */
+  YYSYMBOL_T_Unpeer = 184,                 /* T_Unpeer  */
+  YYSYMBOL_T_Unrestrict = 185,             /* T_Unrestrict  */
+  YYSYMBOL_T_Usestats = 186,               /* T_Usestats  */
+  YYSYMBOL_T_Version = 187,                /* T_Version  */
+  YYSYMBOL_T_WanderThreshold = 188,        /* T_WanderThreshold  */
+  YYSYMBOL_T_Week = 189,                   /* T_Week  */
+  YYSYMBOL_T_Wildcard = 190,               /* T_Wildcard  */
+  YYSYMBOL_T_Xleave = 191,                 /* T_Xleave  */
+  YYSYMBOL_T_Year = 192,                   /* T_Year  */
+  YYSYMBOL_T_Flag = 193,                   /* T_Flag  */
+  YYSYMBOL_T_EOC = 194,                    /* T_EOC  */
+  YYSYMBOL_195_ = 195,                     /* '='  */
+  YYSYMBOL_196_ = 196,                     /* '('  */
+  YYSYMBOL_197_ = 197,                     /* ')'  */
+  YYSYMBOL_YYACCEPT = 198,                 /* $accept  */
+  YYSYMBOL_configuration = 199,            /* configuration  */
+  YYSYMBOL_command_list = 200,             /* command_list  */
+  YYSYMBOL_command = 201,                  /* command  */
+  YYSYMBOL_server_command = 202,           /* server_command  */
+  YYSYMBOL_client_type = 203,              /* client_type  */
+  YYSYMBOL_address = 204,                  /* address  */
+  YYSYMBOL_ip_address = 205,               /* ip_address  */
+  YYSYMBOL_address_fam = 206,              /* address_fam  */
+  YYSYMBOL_option_list = 207,              /* option_list  */
+  YYSYMBOL_option = 208,                   /* option  */
+  YYSYMBOL_option_flag = 209,              /* option_flag  */
+  YYSYMBOL_option_flag_keyword = 210,      /* option_flag_keyword  */
+  YYSYMBOL_option_int = 211,               /* option_int  */
+  YYSYMBOL_option_int_keyword = 212,       /* option_int_keyword  */
+  YYSYMBOL_option_double = 213,            /* option_double  */
+  YYSYMBOL_option_boolean = 214,           /* option_boolean  */
+  YYSYMBOL_option_string = 215,            /* option_string  */
+  YYSYMBOL_option_double_keyword = 216,    /* option_double_keyword  */
+  YYSYMBOL_option_bool_keyword = 217,      /* option_bool_keyword  */
+  YYSYMBOL_unpeer_command = 218,           /* unpeer_command  */
+  YYSYMBOL_unpeer_keyword = 219,           /* unpeer_keyword  */
+  YYSYMBOL_other_mode_command = 220,       /* other_mode_command  */
+  YYSYMBOL_authentication_command = 221,   /* authentication_command  */
+  YYSYMBOL_orphan_mode_command = 222,      /* orphan_mode_command  */
+  YYSYMBOL_tos_option_list = 223,          /* tos_option_list  */
+  YYSYMBOL_tos_option = 224,               /* tos_option  */
+  YYSYMBOL_tos_option_int_keyword = 225,   /* tos_option_int_keyword  */
+  YYSYMBOL_tos_option_dbl_keyword = 226,   /* tos_option_dbl_keyword  */
+  YYSYMBOL_monitoring_command = 227,       /* monitoring_command  */
+  YYSYMBOL_stats_list = 228,               /* stats_list  */
+  YYSYMBOL_stat = 229,                     /* stat  */
+  YYSYMBOL_filegen_option_list = 230,      /* filegen_option_list  */
+  YYSYMBOL_filegen_option = 231,           /* filegen_option  */
+  YYSYMBOL_link_nolink = 232,              /* link_nolink  */
+  YYSYMBOL_binary_text = 233,              /* binary_text  */
+  YYSYMBOL_enable_disable = 234,           /* enable_disable  */
+  YYSYMBOL_rawstats_option_list = 235,     /* rawstats_option_list  */
+  YYSYMBOL_rawstats_option = 236,          /* rawstats_option  */
+  YYSYMBOL_rawstats_option_keyword = 237,  /* rawstats_option_keyword  */
+  YYSYMBOL_metrics_option_list = 238,      /* metrics_option_list  */
+  YYSYMBOL_metrics_option = 239,           /* metrics_option  */
+  YYSYMBOL_filegen_type = 240,             /* filegen_type  */
+  YYSYMBOL_restrict_prefix = 241,          /* restrict_prefix  */
+  YYSYMBOL_access_control_command = 242,   /* access_control_command  */
+  YYSYMBOL_ac_flag_list = 243,             /* ac_flag_list  */
+  YYSYMBOL_access_control_flag = 244,      /* access_control_flag  */
+  YYSYMBOL_limit_option_list = 245,        /* limit_option_list  */
+  YYSYMBOL_limit_option = 246,             /* limit_option  */
+  YYSYMBOL_limit_option_keyword = 247,     /* limit_option_keyword  */
+  YYSYMBOL_mru_option_list = 248,          /* mru_option_list  */
+  YYSYMBOL_mru_option = 249,               /* mru_option  */
+  YYSYMBOL_mru_option_keyword = 250,       /* mru_option_keyword  */
+  YYSYMBOL_fudge_command = 251,            /* fudge_command  */
+  YYSYMBOL_fudge_factor_list = 252,        /* fudge_factor_list  */
+  YYSYMBOL_fudge_factor = 253,             /* fudge_factor  */
+  YYSYMBOL_fudge_factor_dbl_keyword = 254, /* fudge_factor_dbl_keyword  */
+  YYSYMBOL_fudge_factor_bool_keyword = 255, /* fudge_factor_bool_keyword  */
+  YYSYMBOL_refclock_command = 256,         /* refclock_command  */
+  YYSYMBOL_optional_unit = 257,            /* optional_unit  */
+  YYSYMBOL_rlimit_command = 258,           /* rlimit_command  */
+  YYSYMBOL_rlimit_option_list = 259,       /* rlimit_option_list  */
+  YYSYMBOL_rlimit_option = 260,            /* rlimit_option  */
+  YYSYMBOL_rlimit_option_keyword = 261,    /* rlimit_option_keyword  */
+  YYSYMBOL_system_option_command = 262,    /* system_option_command  */
+  YYSYMBOL_system_option_list = 263,       /* system_option_list  */
+  YYSYMBOL_system_option = 264,            /* system_option  */
+  YYSYMBOL_system_option_flag_keyword = 265, /* system_option_flag_keyword  */
+  YYSYMBOL_system_option_local_flag_keyword = 266, /* system_option_local_flag_keyword  */
+  YYSYMBOL_tinker_command = 267,           /* tinker_command  */
+  YYSYMBOL_tinker_option_list = 268,       /* tinker_option_list  */
+  YYSYMBOL_tinker_option = 269,            /* tinker_option  */
+  YYSYMBOL_tinker_option_keyword = 270,    /* tinker_option_keyword  */
+  YYSYMBOL_nts_command = 271,              /* nts_command  */
+  YYSYMBOL_nts_option_list = 272,          /* nts_option_list  */
+  YYSYMBOL_nts_option = 273,               /* nts_option  */
+  YYSYMBOL_nts_string_option_keyword = 274, /* nts_string_option_keyword  */
+  YYSYMBOL_miscellaneous_command = 275,    /* miscellaneous_command  */
+  YYSYMBOL_misc_cmd_dbl_keyword = 276,     /* misc_cmd_dbl_keyword  */
+  YYSYMBOL_misc_cmd_int_keyword = 277,     /* misc_cmd_int_keyword  */
+  YYSYMBOL_misc_cmd_str_keyword = 278,     /* misc_cmd_str_keyword  */
+  YYSYMBOL_misc_cmd_str_lcl_keyword = 279, /* misc_cmd_str_lcl_keyword  */
+  YYSYMBOL_drift_parm = 280,               /* drift_parm  */
+  YYSYMBOL_variable_assign = 281,          /* variable_assign  */
+  YYSYMBOL_t_default_or_zero = 282,        /* t_default_or_zero  */
+  YYSYMBOL_log_config_list = 283,          /* log_config_list  */
+  YYSYMBOL_log_config_command = 284,       /* log_config_command  */
+  YYSYMBOL_interface_command = 285,        /* interface_command  */
+  YYSYMBOL_interface_nic = 286,            /* interface_nic  */
+  YYSYMBOL_nic_rule_class = 287,           /* nic_rule_class  */
+  YYSYMBOL_nic_rule_action = 288,          /* nic_rule_action  */
+  YYSYMBOL_reset_command = 289,            /* reset_command  */
+  YYSYMBOL_counter_set_list = 290,         /* counter_set_list  */
+  YYSYMBOL_counter_set_keyword = 291,      /* counter_set_keyword  */
+  YYSYMBOL_integer_list_range = 292,       /* integer_list_range  */
+  YYSYMBOL_integer_list_range_elt = 293,   /* integer_list_range_elt  */
+  YYSYMBOL_integer_range = 294,            /* integer_range  */
+  YYSYMBOL_string_list = 295,              /* string_list  */
+  YYSYMBOL_boolean = 296,                  /* boolean  */
+  YYSYMBOL_number = 297                    /* number  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* !defined yyoverflow */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  215
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   655
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  198
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  100
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  321
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  413
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   449
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_uint8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+     196,   197,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,   195,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    76,    77,    78,    79,    80,    81,    82,    83,    84,
+      85,    86,    87,    88,    89,    90,    91,    92,    93,    94,
+      95,    96,    97,    98,    99,   100,   101,   102,   103,   104,
+     105,   106,   107,   108,   109,   110,   111,   112,   113,   114,
+     115,   116,   117,   118,   119,   120,   121,   122,   123,   124,
+     125,   126,   127,   128,   129,   130,   131,   132,   133,   134,
+     135,   136,   137,   138,   139,   140,   141,   142,   143,   144,
+     145,   146,   147,   148,   149,   150,   151,   152,   153,   154,
+     155,   156,   157,   158,   159,   160,   161,   162,   163,   164,
+     165,   166,   167,   168,   169,   170,   171,   172,   173,   174,
+     175,   176,   177,   178,   179,   180,   181,   182,   183,   184,
+     185,   186,   187,   188,   189,   190,   191,   192,   193,   194
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   337,   337,   341,   342,   343,   359,   360,   361,   362,
+     363,   364,   365,   366,   367,   368,   369,   370,   371,   372,
+     373,   381,   391,   392,   393,   397,   398,   403,   408,   410,
+     416,   417,   425,   426,   427,   428,   429,   433,   438,   439,
+     440,   441,   442,   443,   444,   445,   449,   451,   453,   465,
+     466,   467,   468,   469,   470,   471,   472,   473,   474,   478,
+     483,   488,   490,   492,   494,   496,   498,   500,   502,   507,
+     508,   509,   513,   514,   515,   516,   525,   533,   547,   548,
+     557,   568,   570,   572,   578,   580,   590,   595,   600,   608,
+     610,   612,   617,   618,   619,   620,   621,   625,   626,   627,
+     628,   629,   638,   640,   649,   656,   658,   663,   668,   676,
+     677,   678,   679,   680,   681,   682,   683,   688,   689,   697,
+     707,   716,   731,   740,   745,   746,   750,   751,   755,   756,
+     760,   765,   773,   775,   780,   781,   782,   786,   791,   799,
+     808,   818,   823,   824,   825,   826,   827,   828,   829,   838,
+     839,   843,   847,   851,   859,   867,   875,   890,   905,   918,
+     919,   927,   928,   929,   930,   931,   932,   933,   934,   935,
+     936,   937,   938,   939,   940,   944,   949,   957,   962,   963,
+     964,   968,   973,   981,   986,   987,   988,   989,   990,   991,
+     992,   993,   994,  1002,  1012,  1017,  1025,  1027,  1029,  1038,
+    1043,  1044,  1048,  1049,  1050,  1051,  1059,  1071,  1073,  1083,
+    1088,  1093,  1101,  1106,  1107,  1108,  1117,  1119,  1124,  1129,
+    1137,  1139,  1156,  1157,  1158,  1159,  1163,  1164,  1165,  1166,
+    1174,  1179,  1184,  1192,  1197,  1198,  1199,  1200,  1201,  1202,
+    1203,  1204,  1205,  1206,  1207,  1216,  1221,  1226,  1234,  1236,
+    1238,  1245,  1246,  1247,  1248,  1249,  1250,  1251,  1252,  1253,
+    1261,  1262,  1263,  1270,  1277,  1284,  1300,  1319,  1321,  1323,
+    1325,  1327,  1332,  1333,  1337,  1341,  1350,  1354,  1355,  1356,
+    1360,  1371,  1381,  1390,  1395,  1397,  1401,  1406,  1414,  1439,
+    1446,  1456,  1457,  1461,  1462,  1463,  1464,  1468,  1469,  1470,
+    1474,  1479,  1484,  1492,  1493,  1494,  1495,  1496,  1497,  1498,
+    1508,  1513,  1521,  1523,  1527,  1532,  1537,  1545,  1554,  1555,
+    1559,  1560
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "T_Adjrate", "T_Aead",
+  "T_Age", "T_All", "T_Allan", "T_Allpeers", "T_Ask", "T_Auth",
+  "T_Average", "T_Baud", "T_Bias", "T_Binary", "T_Burst", "T_Calibrate",
+  "T_Ca", "T_Ceiling", "T_Cert", "T_Clock", "T_Clockstats", "T_Cohort",
+  "T_Cookie", "T_ControlKey", "T_Ctl", "T_Day", "T_Default", "T_Disable",
+  "T_Dispersion", "T_Double", "T_Driftfile", "T_Drop", "T_Dscp",
+  "T_Expire", "T_Ellipsis", "T_Enable", "T_End", "T_False", "T_File",
+  "T_Filegen", "T_Filenum", "T_Flag1", "T_Flag2", "T_Flag3", "T_Flag4",
+  "T_Flake", "T_Floor", "T_Freq", "T_Fudge", "T_Holdover", "T_Huffpuff",
+  "T_Iburst", "T_Ignore", "T_Incalloc", "T_Incmem", "T_Initalloc",
+  "T_Initmem", "T_Includefile", "T_Integer", "T_Interface", "T_Interval",
+  "T_Intrange", "T_Io", "T_Ipv4", "T_Ipv4_flag", "T_Ipv6", "T_Ipv6_flag",
+  "T_Kernel", "T_Key", "T_Keys", "T_Kod", "T_Mssntp", "T_Leapfile",
+  "T_Leapsmearinterval", "T_Limit", "T_Limited", "T_Link", "T_Listen",
+  "T_Logconfig", "T_Logfile", "T_Logqueue", "T_Loopstats", "T_Mask",
+  "T_Maxage", "T_Maxclock", "T_Maxdepth", "T_Maxdisp", "T_Maxdist",
+  "T_Maxmem", "T_Maxpoll", "T_Maxtls", "T_Mdnstries", "T_Mem", "T_Memlock",
+  "T_Metrics", "T_Minage", "T_Minclock", "T_Mindepth", "T_Mindist",
+  "T_Minpoll", "T_Minsane", "T_Mintls", "T_Mode", "T_Monitor", "T_Month",
+  "T_Mru", "T_Nic", "T_Nolink", "T_Nomodify", "T_Nomrulist", "T_None",
+  "T_Nonvolatile", "T_Nopeer", "T_Noquery", "T_Noselect", "T_Noserve",
+  "T_Notrap", "T_Notrust", "T_Noval", "T_Ntp", "T_Ntpport",
+  "T_NtpSignDsocket", "T_Nts", "T_Orphan", "T_Orphanwait", "T_Panic",
+  "T_Path", "T_Peer", "T_Peerstats", "T_Phone", "T_Pid", "T_Pidfile",
+  "T_Pool", "T_Port", "T_Ppspath", "T_Prefer", "T_Protostats",
+  "T_Rawstats", "T_Refclock", "T_Refid", "T_Requestkey", "T_Require",
+  "T_Reservoir", "T_Reset", "T_Restrict", "T_Rlimit", "T_Sample",
+  "T_Saveconfigdir", "T_Server", "T_Setvar", "T_Shmstats", "T_Source",
+  "T_Stacksize", "T_Stages", "T_Statistics", "T_Stats", "T_Statsdir",
+  "T_Step", "T_Stepback", "T_Stepfwd", "T_Stepout", "T_Stratum",
+  "T_Subtype", "T_String", "T_Sys", "T_Sysstats", "T_Tick", "T_Time1",
+  "T_Time2", "T_Timer", "T_Timingstats", "T_Tinker", "T_Text",
+  "T_Tlsciphers", "T_Tlsciphersuites", "T_Tos", "T_True", "T_Trustedkey",
+  "T_Txstamp", "T_Type", "T_U_int", "T_Unit", "T_Unconfig", "T_Unpeer",
+  "T_Unrestrict", "T_Usestats", "T_Version", "T_WanderThreshold", "T_Week",
+  "T_Wildcard", "T_Xleave", "T_Year", "T_Flag", "T_EOC", "'='", "'('",
+  "')'", "$accept", "configuration", "command_list", "command",
+  "server_command", "client_type", "address", "ip_address", "address_fam",
+  "option_list", "option", "option_flag", "option_flag_keyword",
+  "option_int", "option_int_keyword", "option_double", "option_boolean",
+  "option_string", "option_double_keyword", "option_bool_keyword",
+  "unpeer_command", "unpeer_keyword", "other_mode_command",
+  "authentication_command", "orphan_mode_command", "tos_option_list",
+  "tos_option", "tos_option_int_keyword", "tos_option_dbl_keyword",
+  "monitoring_command", "stats_list", "stat", "filegen_option_list",
+  "filegen_option", "link_nolink", "binary_text", "enable_disable",
+  "rawstats_option_list", "rawstats_option", "rawstats_option_keyword",
+  "metrics_option_list", "metrics_option", "filegen_type",
+  "restrict_prefix", "access_control_command", "ac_flag_list",
+  "access_control_flag", "limit_option_list", "limit_option",
+  "limit_option_keyword", "mru_option_list", "mru_option",
+  "mru_option_keyword", "fudge_command", "fudge_factor_list",
+  "fudge_factor", "fudge_factor_dbl_keyword", "fudge_factor_bool_keyword",
+  "refclock_command", "optional_unit", "rlimit_command",
+  "rlimit_option_list", "rlimit_option", "rlimit_option_keyword",
+  "system_option_command", "system_option_list", "system_option",
+  "system_option_flag_keyword", "system_option_local_flag_keyword",
+  "tinker_command", "tinker_option_list", "tinker_option",
+  "tinker_option_keyword", "nts_command", "nts_option_list", "nts_option",
+  "nts_string_option_keyword", "miscellaneous_command",
+  "misc_cmd_dbl_keyword", "misc_cmd_int_keyword", "misc_cmd_str_keyword",
+  "misc_cmd_str_lcl_keyword", "drift_parm", "variable_assign",
+  "t_default_or_zero", "log_config_list", "log_config_command",
+  "interface_command", "interface_nic", "nic_rule_class",
+  "nic_rule_action", "reset_command", "counter_set_list",
+  "counter_set_keyword", "integer_list_range", "integer_list_range_elt",
+  "integer_range", "string_list", "boolean", "number", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-247)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-7)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+       3,  -179,   -40,    26,  -142,  -247,    26,  -247,   -10,   -42,
+    -138,  -247,  -136,  -247,  -247,    33,  -134,  -247,   -22,   -48,
+     386,  -247,  -247,  -119,   187,  -247,  -118,  -247,  -247,    73,
+    -114,    -8,    92,  -247,   -39,  -247,  -247,  -111,   -10,  -107,
+    -247,   210,   391,   -51,  -247,  -247,  -247,    58,   251,  -135,
+    -247,   -42,  -247,     4,  -247,  -247,  -247,  -247,   144,  -247,
+    -247,  -247,  -247,  -247,  -247,  -247,  -247,   -21,     1,   -99,
+     -97,  -247,     9,  -247,  -247,  -247,  -247,  -247,  -247,  -247,
+    -247,  -247,  -247,  -247,    26,  -247,  -247,  -247,    38,  -247,
+      26,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,
+    -247,  -247,  -247,   182,  -247,   -89,   379,  -247,  -247,  -247,
+    -247,    33,  -247,   -21,  -247,  -134,  -247,  -247,    21,   -76,
+      30,   -48,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,
+    -247,  -247,   386,  -247,    31,  -247,  -247,  -247,  -247,  -247,
+    -247,  -247,  -247,  -247,  -247,  -247,  -247,   187,  -247,   -73,
+    -247,   -72,  -247,   -71,  -247,  -247,    73,  -247,    40,   -85,
+    -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,    92,  -247,
+    -247,  -247,  -247,   -39,  -247,    44,   -90,  -247,   -10,  -247,
+    -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,
+    -247,  -247,   210,  -247,   -21,  -247,    -3,  -247,  -247,  -247,
+    -247,  -247,  -247,  -247,  -247,  -247,   391,  -247,    47,   -21,
+    -247,    49,   -51,  -247,  -247,  -247,   -83,  -247,  -247,   -43,
+    -247,  -247,    86,    89,  -247,  -247,    41,  -247,  -247,  -247,
+    -247,  -247,  -247,  -247,  -247,  -247,     0,  -247,  -247,    -7,
+    -247,  -247,  -247,  -247,   -41,    70,  -247,  -247,   182,  -247,
+     -21,    -3,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,
+    -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,    80,
+    -247,  -247,  -247,  -247,   -24,  -247,  -247,  -247,  -247,  -247,
+    -247,  -247,  -247,  -247,  -247,   115,  -247,  -247,   150,   -85,
+     468,  -247,  -247,   468,   468,     8,  -247,  -247,  -247,  -247,
+    -247,  -247,  -247,  -247,  -247,    16,  -247,  -247,  -247,     7,
+    -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,
+     150,   130,   124,    25,    34,  -247,  -247,  -247,    39,    43,
+    -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,
+    -247,  -247,  -247,  -247,    48,    50,  -247,    54,    57,  -247,
+     149,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,
+    -247,   -49,  -247,  -247,  -247,   -21,    -3,  -247,  -247,  -247,
+    -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,
+    -247,  -247,  -247,   468,   468,  -247,  -247,  -247,  -247,  -247,
+    -247,  -247,  -247,  -247,  -247,  -247,  -247,    32,  -247,  -247,
+    -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,
+    -247,   468,  -247
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int16 yydefact[] =
+{
+       0,     0,     0,     0,   282,   274,     0,   267,     0,     0,
+       0,   291,     0,   276,   275,     0,     0,   277,     0,     0,
+       0,   292,   272,     0,     0,    24,     0,   278,    23,     0,
+       0,     0,     0,   149,     0,   279,    22,     0,     0,     0,
+     273,     0,     0,     0,    78,    79,   150,     0,     2,     0,
+       7,     0,     8,     0,     9,    10,    13,    11,     0,    12,
+      14,    15,    16,    17,    18,    19,    20,     0,     0,     0,
+       0,   260,     0,   261,     5,    81,   222,   223,   226,   224,
+     225,   227,   228,   229,   217,   219,   220,   221,   280,   268,
+     216,   109,   110,   111,   114,   112,   113,   115,   116,   117,
+      28,    29,    27,     0,    25,     0,     6,    82,   178,   179,
+     180,   151,   176,     0,   288,   269,   287,    80,     0,     0,
+       0,   106,   138,   184,   185,   186,   187,   188,   190,   191,
+     189,   192,   152,   182,     0,    85,   251,   252,   253,   254,
+     249,   250,   255,   258,   259,   256,   257,   245,   247,     0,
+     316,   270,   136,     0,   135,   134,   105,   131,     0,   207,
+      83,   303,   304,   305,   306,   307,   308,   309,   300,   302,
+     215,   213,   214,   209,   211,     0,     0,   271,   102,   108,
+     103,   234,   235,   236,   237,   238,   239,   240,   241,   242,
+     243,   244,   230,   232,     0,    92,     0,    93,   101,    98,
+      99,   100,    97,    96,    94,    95,    86,    88,     0,     0,
+     312,     0,    84,   311,   313,     1,     0,     4,    30,     0,
+      76,   159,    28,    29,   159,   159,    25,   321,   320,   262,
+     263,   264,   265,   299,   298,   297,     0,   218,   281,   104,
+     202,   203,   204,   205,     0,     0,   200,   201,   193,   195,
+       0,     0,    26,   266,   175,   177,   286,   141,   140,   139,
+     137,   181,   183,   246,   248,   315,   133,   130,   132,     0,
+      30,   301,   210,   212,     0,   107,   231,   233,   319,   317,
+     318,    91,    87,    89,    90,     0,   310,     3,    21,   207,
+     155,   159,   159,   158,   153,     0,   293,   294,   295,   290,
+     296,   289,   126,   129,   128,     0,   124,   125,   127,     0,
+     118,   121,   122,   123,   199,   198,   194,   196,   197,   208,
+     206,   285,     0,     0,     0,    56,    69,    38,     0,     0,
+      49,    72,    73,    74,    75,    57,    39,    50,    52,    51,
+      53,    40,    41,    42,     0,     0,    43,     0,     0,    58,
+       0,    54,    70,    71,    44,    55,    45,    31,    32,    37,
+      33,     0,    34,    36,    35,     0,     0,    77,   161,   162,
+     163,   164,   165,   166,   167,   168,   169,   170,   171,   172,
+     173,   174,   160,   156,   157,   159,   119,   148,   144,   146,
+     142,   143,   145,   147,   120,   284,   283,     0,    68,    64,
+      66,    67,    62,    63,    61,    65,    48,    46,    47,    59,
+      60,   154,   314
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -247,  -247,  -247,   -32,  -247,  -247,    -4,   -57,  -247,   -38,
+    -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,  -247,
+    -247,  -247,  -247,  -247,  -247,  -247,    22,  -247,  -247,  -247,
+    -247,   -35,  -247,  -247,  -247,  -247,  -247,  -247,    66,  -247,
+    -247,   109,  -247,  -247,  -247,  -207,  -247,  -247,   120,  -247,
+    -247,   101,  -247,  -247,  -247,   -14,  -247,  -247,  -247,   -54,
+    -247,  -247,    63,  -247,  -247,   231,   -70,  -247,  -247,  -247,
+    -247,    51,  -247,  -247,  -247,    94,  -247,  -247,  -247,  -247,
+    -247,  -247,  -247,  -247,  -247,  -247,   127,  -247,  -247,  -247,
+    -247,  -247,  -247,    76,  -247,    35,  -247,  -247,  -246,  -113
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int16 yydefgoto[] =
+{
+       0,    47,    48,    49,    50,    51,   103,   104,   105,   288,
+     357,   358,   359,   360,   361,   362,   363,   364,   365,   366,
+      52,    53,    54,    55,    56,   206,   207,   208,   209,    57,
+     178,    99,   239,   310,   311,   312,   313,   156,   157,   158,
+     121,   122,   394,    58,    59,   290,   382,   111,   112,   113,
+     132,   133,   134,    60,   248,   249,   250,   251,    61,   270,
+      62,   173,   174,   175,    63,    84,    85,    86,    87,    64,
+     192,   193,   194,    65,   147,   148,   149,    66,    67,    68,
+      69,    70,    89,   177,   396,   115,   116,    71,    72,   301,
+     236,    73,   168,   169,   212,   213,   214,   151,   281,   229
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+     255,   226,   170,   179,     1,   318,   296,   302,   210,   227,
+     407,    91,   387,   118,   237,    74,   216,   293,   294,    75,
+     237,   303,    88,   100,   219,   101,   106,     2,   107,   304,
+     114,     3,   305,   388,     4,   278,     5,   117,   228,     6,
+       7,   233,    76,     8,   108,   135,   150,   218,   109,   220,
+     159,   160,     9,   176,   225,   171,   279,   180,   215,   217,
+     230,    10,   234,    11,   297,   231,   298,   232,   238,   100,
+     306,   101,    92,    12,   253,   252,    13,    14,    15,   119,
+     257,   277,    16,    17,   383,   384,   120,   235,   258,   259,
+     262,   264,   265,   266,    77,    18,   284,   269,    19,   268,
+     161,   307,   162,   273,   110,   274,   283,    78,   285,    20,
+      21,   287,   389,   291,   172,    22,   292,   163,   390,    93,
+     410,   289,   102,   314,   295,    23,    24,    94,    95,   315,
+      79,    25,   408,    26,   152,    27,    28,   317,   391,   319,
+     321,    29,    30,   275,    31,   211,    80,    32,    33,    34,
+     322,    35,    36,    37,   323,   164,    96,   395,    38,   324,
+      39,    97,   325,   326,   299,   327,   308,   328,   102,   329,
+      40,   221,   102,   309,   280,    41,    98,    81,   411,    42,
+     386,    43,    82,   397,   330,   165,    44,    45,    46,   398,
+     300,   136,   331,   332,   333,   334,   392,    -6,   399,   393,
+     335,   153,   336,   400,   137,    83,   138,   401,   406,   222,
+     139,   223,   402,   181,   403,   140,   154,   182,   404,   337,
+     155,   405,   267,   141,   240,   241,   242,   243,   282,   412,
+     260,   254,   320,   261,   316,   367,   272,    90,   385,   183,
+     338,   263,   256,   276,   271,     0,     0,   286,     0,     0,
+     339,     0,   409,   340,     0,     0,   142,   166,   184,     0,
+       0,   185,   167,     0,     0,   341,     0,     0,     0,   342,
+       0,     0,     0,   343,     0,     2,     0,   344,   143,     3,
+       0,     0,     4,     0,     5,   345,   346,     6,     7,   144,
+     347,     8,   348,     0,     0,     0,   224,     0,     0,     0,
+       9,     0,     0,     0,   349,     0,     0,     0,   102,    10,
+       0,    11,   350,   351,     0,     0,     0,     0,   352,   353,
+       0,    12,   244,     0,    13,    14,    15,   354,     0,     0,
+      16,    17,     0,     0,     0,     0,   186,   355,     0,     0,
+       0,   356,     0,    18,   245,     0,    19,     0,     0,     0,
+     246,   247,     0,     0,     0,     0,     0,    20,    21,     0,
+       0,   145,   146,    22,     0,     0,     0,     0,   187,   188,
+     189,   190,     0,    23,    24,     0,     0,   191,     0,    25,
+       0,    26,     0,    27,    28,     0,     0,     0,     0,    29,
+      30,     0,    31,     0,     0,    32,    33,    34,     0,    35,
+      36,    37,     0,     2,     0,     0,    38,     3,    39,   195,
+       4,     0,     5,   196,     0,     6,     7,     0,    40,     8,
+       0,     0,     0,    41,     0,     0,     0,    42,     9,    43,
+       0,     0,     0,     0,    44,    45,    46,    10,   197,    11,
+     123,   124,   125,   126,     0,    -6,     0,     0,     0,    12,
+       0,     0,    13,    14,    15,     0,     0,     0,    16,    17,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+     127,    18,   128,     0,    19,   129,   198,     0,   199,   200,
+       0,     0,   130,     0,   131,    20,    21,     0,   201,     0,
+     202,    22,   203,     0,     0,     0,     0,     0,     0,     0,
+       0,    23,    24,     0,     0,     0,     0,    25,     0,    26,
+       0,    27,    28,     0,   368,   204,   205,    29,    30,     0,
+      31,   369,     0,    32,    33,    34,     0,    35,    36,    37,
+       0,     0,     0,     0,    38,     0,    39,     0,     0,   370,
+     371,     0,     0,     0,   372,     0,    40,     0,     0,     0,
+       0,    41,     0,     0,     0,    42,     0,    43,     0,     0,
+       0,     0,    44,    45,    46,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,   373,   374,     0,
+       0,   375,   376,     0,   377,   378,   379,     0,     0,   380,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,   381
+};
+
+static const yytype_int16 yycheck[] =
+{
+     113,    58,    41,    38,     1,   251,     6,    14,    59,    30,
+      59,    21,     5,    61,    84,   194,    48,   224,   225,    59,
+      90,    28,   164,    65,    20,    67,   164,    24,   164,    36,
+     164,    28,    39,    26,    31,    38,    33,    59,    59,    36,
+      37,    32,    16,    40,    11,   164,   164,    51,    15,    53,
+     164,    59,    49,   164,    58,    94,    59,   164,     0,   194,
+      59,    58,    53,    60,    64,   164,    66,   164,    30,    65,
+      77,    67,    82,    70,   106,   164,    73,    74,    75,   127,
+      59,   194,    79,    80,   291,   292,   134,    78,   164,    59,
+      59,   164,   164,   164,    68,    92,   209,   182,    95,    59,
+       8,   108,    10,    59,    71,   195,    59,    81,    59,   106,
+     107,   194,   105,    27,   153,   112,    27,    25,   111,   129,
+     366,   164,   164,   164,    83,   122,   123,   137,   138,    59,
+     104,   128,   181,   130,    61,   132,   133,   250,   131,    59,
+     164,   138,   139,   178,   141,   196,   120,   144,   145,   146,
+      35,   148,   149,   150,     4,    63,   166,    27,   155,     9,
+     157,   171,    12,    13,   164,    15,   173,    17,   164,    19,
+     167,    27,   164,   180,   177,   172,   186,   151,   385,   176,
+     164,   178,   156,    59,    34,    93,   183,   184,   185,   164,
+     190,     4,    42,    43,    44,    45,   189,   194,   164,   192,
+      50,   128,    52,   164,    17,   179,    19,   164,    59,    65,
+      23,    67,   164,     3,   164,    28,   143,     7,   164,    69,
+     147,   164,   156,    36,    42,    43,    44,    45,   206,   197,
+     121,   111,   270,   132,   248,   289,   173,     6,   295,    29,
+      90,   147,   115,   192,   168,    -1,    -1,   212,    -1,    -1,
+     100,    -1,   365,   103,    -1,    -1,    69,   165,    48,    -1,
+      -1,    51,   170,    -1,    -1,   115,    -1,    -1,    -1,   119,
+      -1,    -1,    -1,   123,    -1,    24,    -1,   127,    91,    28,
+      -1,    -1,    31,    -1,    33,   135,   136,    36,    37,   102,
+     140,    40,   142,    -1,    -1,    -1,   152,    -1,    -1,    -1,
+      49,    -1,    -1,    -1,   154,    -1,    -1,    -1,   164,    58,
+      -1,    60,   162,   163,    -1,    -1,    -1,    -1,   168,   169,
+      -1,    70,   140,    -1,    73,    74,    75,   177,    -1,    -1,
+      79,    80,    -1,    -1,    -1,    -1,   126,   187,    -1,    -1,
+      -1,   191,    -1,    92,   162,    -1,    95,    -1,    -1,    -1,
+     168,   169,    -1,    -1,    -1,    -1,    -1,   106,   107,    -1,
+      -1,   174,   175,   112,    -1,    -1,    -1,    -1,   158,   159,
+     160,   161,    -1,   122,   123,    -1,    -1,   167,    -1,   128,
+      -1,   130,    -1,   132,   133,    -1,    -1,    -1,    -1,   138,
+     139,    -1,   141,    -1,    -1,   144,   145,   146,    -1,   148,
+     149,   150,    -1,    24,    -1,    -1,   155,    28,   157,    18,
+      31,    -1,    33,    22,    -1,    36,    37,    -1,   167,    40,
+      -1,    -1,    -1,   172,    -1,    -1,    -1,   176,    49,   178,
+      -1,    -1,    -1,    -1,   183,   184,   185,    58,    47,    60,
+      54,    55,    56,    57,    -1,   194,    -1,    -1,    -1,    70,
+      -1,    -1,    73,    74,    75,    -1,    -1,    -1,    79,    80,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      84,    92,    86,    -1,    95,    89,    85,    -1,    87,    88,
+      -1,    -1,    96,    -1,    98,   106,   107,    -1,    97,    -1,
+      99,   112,   101,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,   122,   123,    -1,    -1,    -1,    -1,   128,    -1,   130,
+      -1,   132,   133,    -1,    46,   124,   125,   138,   139,    -1,
+     141,    53,    -1,   144,   145,   146,    -1,   148,   149,   150,
+      -1,    -1,    -1,    -1,   155,    -1,   157,    -1,    -1,    71,
+      72,    -1,    -1,    -1,    76,    -1,   167,    -1,    -1,    -1,
+      -1,   172,    -1,    -1,    -1,   176,    -1,   178,    -1,    -1,
+      -1,    -1,   183,   184,   185,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,   109,   110,    -1,
+      -1,   113,   114,    -1,   116,   117,   118,    -1,    -1,   121,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,   187
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int16 yystos[] =
+{
+       0,     1,    24,    28,    31,    33,    36,    37,    40,    49,
+      58,    60,    70,    73,    74,    75,    79,    80,    92,    95,
+     106,   107,   112,   122,   123,   128,   130,   132,   133,   138,
+     139,   141,   144,   145,   146,   148,   149,   150,   155,   157,
+     167,   172,   176,   178,   183,   184,   185,   199,   200,   201,
+     202,   203,   218,   219,   220,   221,   222,   227,   241,   242,
+     251,   256,   258,   262,   267,   271,   275,   276,   277,   278,
+     279,   285,   286,   289,   194,    59,    16,    68,    81,   104,
+     120,   151,   156,   179,   263,   264,   265,   266,   164,   280,
+     263,    21,    82,   129,   137,   138,   166,   171,   186,   229,
+      65,    67,   164,   204,   205,   206,   164,   164,    11,    15,
+      71,   245,   246,   247,   164,   283,   284,    59,    61,   127,
+     134,   238,   239,    54,    55,    56,    57,    84,    86,    89,
+      96,    98,   248,   249,   250,   164,     4,    17,    19,    23,
+      28,    36,    69,    91,   102,   174,   175,   272,   273,   274,
+     164,   295,    61,   128,   143,   147,   235,   236,   237,   164,
+      59,     8,    10,    25,    63,    93,   165,   170,   290,   291,
+      41,    94,   153,   259,   260,   261,   164,   281,   228,   229,
+     164,     3,     7,    29,    48,    51,   126,   158,   159,   160,
+     161,   167,   268,   269,   270,    18,    22,    47,    85,    87,
+      88,    97,    99,   101,   124,   125,   223,   224,   225,   226,
+      59,   196,   292,   293,   294,     0,   201,   194,   204,    20,
+     204,    27,    65,    67,   152,   204,   205,    30,    59,   297,
+      59,   164,   164,    32,    53,    78,   288,   264,    30,   230,
+      42,    43,    44,    45,   140,   162,   168,   169,   252,   253,
+     254,   255,   164,   201,   246,   297,   284,    59,   164,    59,
+     239,   249,    59,   273,   164,   164,   164,   236,    59,   182,
+     257,   291,   260,    59,   195,   229,   269,   297,    38,    59,
+     177,   296,   224,    59,   297,    59,   293,   194,   207,   164,
+     243,    27,    27,   243,   243,    83,     6,    64,    66,   164,
+     190,   287,    14,    28,    36,    39,    77,   108,   173,   180,
+     231,   232,   233,   234,   164,    59,   253,   297,   296,    59,
+     207,   164,    35,     4,     9,    12,    13,    15,    17,    19,
+      34,    42,    43,    44,    45,    50,    52,    69,    90,   100,
+     103,   115,   119,   123,   127,   135,   136,   140,   142,   154,
+     162,   163,   168,   169,   177,   187,   191,   208,   209,   210,
+     211,   212,   213,   214,   215,   216,   217,   257,    46,    53,
+      71,    72,    76,   109,   110,   113,   114,   116,   117,   118,
+     121,   187,   244,   243,   243,   205,   164,     5,    26,   105,
+     111,   131,   189,   192,   240,    27,   282,    59,   164,   164,
+     164,   164,   164,   164,   164,   164,    59,    59,   181,   297,
+     296,   243,   197
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int16 yyr1[] =
+{
+       0,   198,   199,   200,   200,   200,   201,   201,   201,   201,
+     201,   201,   201,   201,   201,   201,   201,   201,   201,   201,
+     201,   202,   203,   203,   203,   204,   204,   205,   206,   206,
+     207,   207,   208,   208,   208,   208,   208,   209,   210,   210,
+     210,   210,   210,   210,   210,   210,   211,   211,   211,   212,
+     212,   212,   212,   212,   212,   212,   212,   212,   212,   213,
+     214,   215,   215,   215,   215,   215,   215,   215,   215,   216,
+     216,   216,   217,   217,   217,   217,   218,   218,   219,   219,
+     220,   221,   221,   221,   221,   221,   222,   223,   223,   224,
+     224,   224,   225,   225,   225,   225,   225,   226,   226,   226,
+     226,   226,   227,   227,   227,   227,   227,   228,   228,   229,
+     229,   229,   229,   229,   229,   229,   229,   230,   230,   231,
+     231,   231,   231,   231,   232,   232,   233,   233,   234,   234,
+     235,   235,   236,   236,   237,   237,   237,   238,   238,   239,
+     239,   239,   240,   240,   240,   240,   240,   240,   240,   241,
+     241,   242,   242,   242,   242,   242,   242,   242,   242,   243,
+     243,   244,   244,   244,   244,   244,   244,   244,   244,   244,
+     244,   244,   244,   244,   244,   245,   245,   246,   247,   247,
+     247,   248,   248,   249,   250,   250,   250,   250,   250,   250,
+     250,   250,   250,   251,   252,   252,   253,   253,   253,   253,
+     254,   254,   255,   255,   255,   255,   256,   257,   257,   258,
+     259,   259,   260,   261,   261,   261,   262,   262,   263,   263,
+     264,   264,   265,   265,   265,   265,   266,   266,   266,   266,
+     267,   268,   268,   269,   270,   270,   270,   270,   270,   270,
+     270,   270,   270,   270,   270,   271,   272,   272,   273,   273,
+     273,   274,   274,   274,   274,   274,   274,   274,   274,   274,
+     275,   275,   275,   275,   275,   275,   275,   275,   275,   275,
+     275,   275,   276,   276,   277,   277,   278,   279,   279,   279,
+     280,   280,   280,   281,   282,   282,   283,   283,   284,   285,
+     285,   286,   286,   287,   287,   287,   287,   288,   288,   288,
+     289,   290,   290,   291,   291,   291,   291,   291,   291,   291,
+     292,   292,   293,   293,   294,   295,   295,   296,   296,   296,
+     297,   297
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     3,     2,     2,     0,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     3,     1,     1,     1,     1,     2,     1,     1,     1,
+       0,     2,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     2,     2,     2,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     1,
+       1,     1,     1,     1,     1,     1,     2,     4,     1,     1,
+       2,     2,     2,     2,     2,     2,     2,     2,     1,     2,
+       2,     2,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     2,     2,     3,     2,     2,     2,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     0,     2,     2,
+       2,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       2,     1,     2,     2,     1,     1,     1,     2,     1,     2,
+       2,     2,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     2,     2,     3,     5,     3,     4,     4,     3,     0,
+       2,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     2,     1,     2,     1,     1,
+       1,     2,     1,     2,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     3,     2,     1,     2,     2,     2,     2,
+       1,     1,     1,     1,     1,     1,     4,     0,     2,     2,
+       2,     1,     2,     1,     1,     1,     2,     2,     2,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       2,     2,     1,     2,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     2,     2,     1,     2,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     2,     2,     2,     2,     3,     1,     2,     2,
+       2,     2,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     2,     0,     4,     1,     0,     2,     1,     1,     3,
+       3,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       2,     2,     1,     1,     1,     1,     1,     1,     1,     1,
+       2,     1,     1,     1,     5,     2,     1,     1,     1,     1,
+       1,     1
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+
+
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
+{
+  YY_USE (yyvaluep);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/* Lookahead token kind.  */
+int yychar;
+
+/* The semantic value of the lookahead symbol.  */
+YYSTYPE yylval;
+/* Number of syntax errors so far.  */
+int yynerrs;
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (void)
+{
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 5: /* command_list: error T_EOC  */
+#line 344 "/root/repo/ntpd/ntp_parser.y"
+                {
+			/* I will need to incorporate much more fine grained
+			 * error messages. The following should suffice for
+			 * the time being.
+			 */
+			struct FILE_INFO * ip_ctx = lex_current();
+			msyslog(LOG_ERR,
+				"CONFIG: syntax error in %s line %d, column %d",
+				ip_ctx->fname,
+				ip_ctx->errpos.nline,
+				ip_ctx->errpos.ncol);
+			parsing_errors++;
+		}
+#line 1822 "ntp_parser.tab.c"
+    break;
+
+  case 21: /* server_command: client_type address option_list  */
+#line 382 "/root/repo/ntpd/ntp_parser.y"
+                {
+			peer_node *my_node;
+
+			my_node = create_peer_node((yyvsp[-2].Integer), (yyvsp[-1].Address_node), (yyvsp[0].Attr_val_fifo));
+			APPEND_G_FIFO(cfgt.peers, my_node);
+		}
+#line 1833 "ntp_parser.tab.c"
+    break;
+
+  case 26: /* address: address_fam T_String  */
+#line 399 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Address_node) = create_address_node((yyvsp[0].String), (yyvsp[-1].Integer)); }
+#line 1839 "ntp_parser.tab.c"
+    break;
+
+  case 27: /* ip_address: T_String  */
+#line 404 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Address_node) = create_address_node((yyvsp[0].String), AF_UNSPEC); }
+#line 1845 "ntp_parser.tab.c"
+    break;
+
+  case 28: /* address_fam: T_Ipv4_flag  */
+#line 409 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Integer) = AF_INET; }
+#line 1851 "ntp_parser.tab.c"
+    break;
+
+  case 29: /* address_fam: T_Ipv6_flag  */
+#line 411 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Integer) = AF_INET6; }
+#line 1857 "ntp_parser.tab.c"
+    break;
+
+  case 30: /* option_list: %empty  */
+#line 416 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val_fifo) = NULL; }
+#line 1863 "ntp_parser.tab.c"
+    break;
+
+  case 31: /* option_list: option_list option  */
+#line 418 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 1872 "ntp_parser.tab.c"
+    break;
+
+  case 37: /* option_flag: option_flag_keyword  */
+#line 434 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival(T_Flag, (yyvsp[0].Integer)); }
+#line 1878 "ntp_parser.tab.c"
+    break;
+
+  case 46: /* option_int: option_int_keyword T_Integer  */
+#line 450 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer)); }
+#line 1884 "ntp_parser.tab.c"
+    break;
+
+  case 47: /* option_int: option_int_keyword T_U_int  */
+#line 452 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_uval((yyvsp[-1].Integer), (unsigned int)(yyvsp[0].Integer)); }
+#line 1890 "ntp_parser.tab.c"
+    break;
+
+  case 48: /* option_int: T_Stratum T_Integer  */
+#line 454 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if ((yyvsp[0].Integer) >= 0 && (yyvsp[0].Integer) <= STRATUM_UNSPEC) {
+				(yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer));
+			} else {
+				(yyval.Attr_val) = NULL;
+				yyerror("fudge factor: stratum value out of bounds, ignored");
+			}
+		}
+#line 1903 "ntp_parser.tab.c"
+    break;
+
+  case 59: /* option_double: option_double_keyword number  */
+#line 479 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_dval((yyvsp[-1].Integer), (yyvsp[0].Double)); }
+#line 1909 "ntp_parser.tab.c"
+    break;
+
+  case 60: /* option_boolean: option_bool_keyword boolean  */
+#line 484 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer)); }
+#line 1915 "ntp_parser.tab.c"
+    break;
+
+  case 61: /* option_string: T_Refid T_String  */
+#line 489 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 1921 "ntp_parser.tab.c"
+    break;
+
+  case 62: /* option_string: T_Path T_String  */
+#line 491 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 1927 "ntp_parser.tab.c"
+    break;
+
+  case 63: /* option_string: T_Ppspath T_String  */
+#line 493 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 1933 "ntp_parser.tab.c"
+    break;
+
+  case 64: /* option_string: T_Ask T_String  */
+#line 495 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 1939 "ntp_parser.tab.c"
+    break;
+
+  case 65: /* option_string: T_Require T_String  */
+#line 497 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 1945 "ntp_parser.tab.c"
+    break;
+
+  case 66: /* option_string: T_Ca T_String  */
+#line 499 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 1951 "ntp_parser.tab.c"
+    break;
+
+  case 67: /* option_string: T_Cert T_String  */
+#line 501 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 1957 "ntp_parser.tab.c"
+    break;
+
+  case 68: /* option_string: T_Aead T_String  */
+#line 503 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 1963 "ntp_parser.tab.c"
+    break;
+
+  case 76: /* unpeer_command: unpeer_keyword address  */
+#line 526 "/root/repo/ntpd/ntp_parser.y"
+                {
+			unpeer_node *my_node;
+
+			my_node = create_unpeer_node((yyvsp[0].Address_node));
+			if (my_node)
+				APPEND_G_FIFO(cfgt.unpeers, my_node);
+		}
+#line 1975 "ntp_parser.tab.c"
+    break;
+
+  case 77: /* unpeer_command: unpeer_keyword T_Clock T_String optional_unit  */
+#line 534 "/root/repo/ntpd/ntp_parser.y"
+                {
+#ifdef REFCLOCK
+			unpeer_node *my_node;
+
+			my_node = create_unpeer_node(addr_from_typeunit((yyvsp[-1].String), (yyvsp[0].Integer)));
+			if (my_node)
+				APPEND_G_FIFO(cfgt.unpeers, my_node);
+#else
+			yyerror("no refclock support was compiled in.");
+#endif /* REFCLOCK */
+		}
+#line 1991 "ntp_parser.tab.c"
+    break;
+
+  case 80: /* other_mode_command: T_Mdnstries T_Integer  */
+#line 558 "/root/repo/ntpd/ntp_parser.y"
+                        { cfgt.mdnstries = (yyvsp[0].Integer); }
+#line 1997 "ntp_parser.tab.c"
+    break;
+
+  case 81: /* authentication_command: T_ControlKey T_Integer  */
+#line 569 "/root/repo/ntpd/ntp_parser.y"
+                        { cfgt.auth.control_key = (yyvsp[0].Integer); }
+#line 2003 "ntp_parser.tab.c"
+    break;
+
+  case 82: /* authentication_command: T_Keys T_String  */
+#line 571 "/root/repo/ntpd/ntp_parser.y"
+                        { cfgt.auth.keys = (yyvsp[0].String); }
+#line 2009 "ntp_parser.tab.c"
+    break;
+
+  case 83: /* authentication_command: T_Requestkey T_Integer  */
+#line 573 "/root/repo/ntpd/ntp_parser.y"
+                        {
+			    msyslog(LOG_WARNING,
+				    "CONFIG: requestkey is a no-op because "
+				    "ntpdc has been removed.");
+			}
+#line 2019 "ntp_parser.tab.c"
+    break;
+
+  case 84: /* authentication_command: T_Trustedkey integer_list_range  */
+#line 579 "/root/repo/ntpd/ntp_parser.y"
+                { CONCAT_G_FIFOS(cfgt.auth.trusted_key_list, (yyvsp[0].Attr_val_fifo)); }
+#line 2025 "ntp_parser.tab.c"
+    break;
+
+  case 85: /* authentication_command: T_NtpSignDsocket T_String  */
+#line 581 "/root/repo/ntpd/ntp_parser.y"
+                        { cfgt.auth.ntp_signd_socket = (yyvsp[0].String); }
+#line 2031 "ntp_parser.tab.c"
+    break;
+
+  case 86: /* orphan_mode_command: T_Tos tos_option_list  */
+#line 591 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.orphan_cmds, (yyvsp[0].Attr_val_fifo)); }
+#line 2037 "ntp_parser.tab.c"
+    break;
+
+  case 87: /* tos_option_list: tos_option_list tos_option  */
+#line 596 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2046 "ntp_parser.tab.c"
+    break;
+
+  case 88: /* tos_option_list: tos_option  */
+#line 601 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2055 "ntp_parser.tab.c"
+    break;
+
+  case 89: /* tos_option: tos_option_int_keyword T_Integer  */
+#line 609 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_dval((yyvsp[-1].Integer), (double)(yyvsp[0].Integer)); }
+#line 2061 "ntp_parser.tab.c"
+    break;
+
+  case 90: /* tos_option: tos_option_dbl_keyword number  */
+#line 611 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_dval((yyvsp[-1].Integer), (yyvsp[0].Double)); }
+#line 2067 "ntp_parser.tab.c"
+    break;
+
+  case 91: /* tos_option: T_Cohort boolean  */
+#line 613 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_dval((yyvsp[-1].Integer), (double)(yyvsp[0].Integer)); }
+#line 2073 "ntp_parser.tab.c"
+    break;
+
+  case 102: /* monitoring_command: T_Statistics stats_list  */
+#line 639 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.stats_list, (yyvsp[0].Int_fifo)); }
+#line 2079 "ntp_parser.tab.c"
+    break;
+
+  case 103: /* monitoring_command: T_Statsdir T_String  */
+#line 641 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if (lex_from_file()) {
+				cfgt.stats_dir = (yyvsp[0].String);
+			} else {
+				YYFREE((yyvsp[0].String));
+				yyerror("statsdir remote configuration ignored");
+			}
+		}
+#line 2092 "ntp_parser.tab.c"
+    break;
+
+  case 104: /* monitoring_command: T_Filegen stat filegen_option_list  */
+#line 650 "/root/repo/ntpd/ntp_parser.y"
+                {
+			filegen_node *fgn;
+
+			fgn = create_filegen_node((yyvsp[-1].Integer), (yyvsp[0].Attr_val_fifo));
+			APPEND_G_FIFO(cfgt.filegen_opts, fgn);
+		}
+#line 2103 "ntp_parser.tab.c"
+    break;
+
+  case 105: /* monitoring_command: T_Rawstats rawstats_option_list  */
+#line 657 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.rawstats_opts, (yyvsp[0].Attr_val_fifo)); }
+#line 2109 "ntp_parser.tab.c"
+    break;
+
+  case 106: /* monitoring_command: T_Metrics metrics_option_list  */
+#line 659 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.metrics_opts, (yyvsp[0].Attr_val_fifo)); }
+#line 2115 "ntp_parser.tab.c"
+    break;
+
+  case 107: /* stats_list: stats_list stat  */
+#line 664 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Int_fifo) = (yyvsp[-1].Int_fifo);
+			APPEND_G_FIFO((yyval.Int_fifo), create_int_node((yyvsp[0].Integer)));
+		}
+#line 2124 "ntp_parser.tab.c"
+    break;
+
+  case 108: /* stats_list: stat  */
+#line 669 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Int_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Int_fifo), create_int_node((yyvsp[0].Integer)));
+		}
+#line 2133 "ntp_parser.tab.c"
+    break;
+
+  case 117: /* filegen_option_list: %empty  */
+#line 688 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val_fifo) = NULL; }
+#line 2139 "ntp_parser.tab.c"
+    break;
+
+  case 118: /* filegen_option_list: filegen_option_list filegen_option  */
+#line 690 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2148 "ntp_parser.tab.c"
+    break;
+
+  case 119: /* filegen_option: T_File T_String  */
+#line 698 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if (lex_from_file()) {
+				(yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String));
+			} else {
+				(yyval.Attr_val) = NULL;
+				YYFREE((yyvsp[0].String));
+				yyerror("filegen file remote config ignored");
+			}
+		}
+#line 2162 "ntp_parser.tab.c"
+    break;
+
+  case 120: /* filegen_option: T_Type filegen_type  */
+#line 708 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if (lex_from_file()) {
+				(yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer));
+			} else {
+				(yyval.Attr_val) = NULL;
+				yyerror("filegen type remote config ignored");
+			}
+		}
+#line 2175 "ntp_parser.tab.c"
+    break;
+
+  case 121: /* filegen_option: link_nolink  */
+#line 717 "/root/repo/ntpd/ntp_parser.y"
+                {
+			const char *err;
+
+			if (lex_from_file()) {
+				(yyval.Attr_val) = create_attr_ival(T_Flag, (yyvsp[0].Integer));
+			} else {
+				(yyval.Attr_val) = NULL;
+				if (T_Link == (yyvsp[0].Integer))
+					err = "filegen link remote config ignored";
+				else
+					err = "filegen nolink remote config ignored";
+				yyerror(err);
+			}
+		}
+#line 2194 "ntp_parser.tab.c"
+    break;
+
+  case 122: /* filegen_option: binary_text  */
+#line 732 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if (lex_from_file()) {
+				(yyval.Attr_val) = create_attr_ival(T_Flag, (yyvsp[0].Integer));
+			} else {
+				(yyval.Attr_val) = NULL;
+				yyerror("filegen format remote config ignored");
+			}
+		}
+#line 2207 "ntp_parser.tab.c"
+    break;
+
+  case 123: /* filegen_option: enable_disable  */
+#line 741 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival(T_Flag, (yyvsp[0].Integer)); }
+#line 2213 "ntp_parser.tab.c"
+    break;
+
+  case 130: /* rawstats_option_list: rawstats_option_list rawstats_option  */
+#line 761 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2222 "ntp_parser.tab.c"
+    break;
+
+  case 131: /* rawstats_option_list: rawstats_option  */
+#line 766 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2231 "ntp_parser.tab.c"
+    break;
+
+  case 132: /* rawstats_option: rawstats_option_keyword T_Integer  */
+#line 774 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer)); }
+#line 2237 "ntp_parser.tab.c"
+    break;
+
+  case 133: /* rawstats_option: T_Peer T_String  */
+#line 776 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 2243 "ntp_parser.tab.c"
+    break;
+
+  case 137: /* metrics_option_list: metrics_option_list metrics_option  */
+#line 787 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2252 "ntp_parser.tab.c"
+    break;
+
+  case 138: /* metrics_option_list: metrics_option  */
+#line 792 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2261 "ntp_parser.tab.c"
+    break;
+
+  case 139: /* metrics_option: T_Port T_Integer  */
+#line 800 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if (lex_from_file()) {
+				(yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer));
+			} else {
+				(yyval.Attr_val) = NULL;
+				yyerror("metrics port remote config ignored");
+			}
+		}
+#line 2274 "ntp_parser.tab.c"
+    break;
+
+  case 140: /* metrics_option: T_Path T_String  */
+#line 809 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if (lex_from_file()) {
+				(yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String));
+			} else {
+				(yyval.Attr_val) = NULL;
+				YYFREE((yyvsp[0].String));
+				yyerror("metrics path remote config ignored");
+			}
+		}
+#line 2288 "ntp_parser.tab.c"
+    break;
+
+  case 141: /* metrics_option: T_Interval T_Integer  */
+#line 819 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer)); }
+#line 2294 "ntp_parser.tab.c"
+    break;
+
+  case 151: /* access_control_command: T_Limit limit_option_list  */
+#line 844 "/root/repo/ntpd/ntp_parser.y"
+                {
+			CONCAT_G_FIFOS(cfgt.limit_opts, (yyvsp[0].Attr_val_fifo));
+		}
+#line 2302 "ntp_parser.tab.c"
+    break;
+
+  case 152: /* access_control_command: T_Mru mru_option_list  */
+#line 848 "/root/repo/ntpd/ntp_parser.y"
+                {
+			CONCAT_G_FIFOS(cfgt.mru_opts, (yyvsp[0].Attr_val_fifo));
+		}
+#line 2310 "ntp_parser.tab.c"
+    break;
+
+  case 153: /* access_control_command: restrict_prefix address ac_flag_list  */
+#line 852 "/root/repo/ntpd/ntp_parser.y"
+                {
+			restrict_node *rn;
+
+			rn = create_restrict_node((yyvsp[-2].Integer), (yyvsp[-1].Address_node), NULL, (yyvsp[0].Int_fifo),
+						  lex_current()->curpos.nline);
+			APPEND_G_FIFO(cfgt.restrict_opts, rn);
+		}
+#line 2322 "ntp_parser.tab.c"
+    break;
+
+  case 154: /* access_control_command: restrict_prefix ip_address T_Mask ip_address ac_flag_list  */
+#line 860 "/root/repo/ntpd/ntp_parser.y"
+                {
+			restrict_node *rn;
+
+			rn = create_restrict_node((yyvsp[-4].Integer), (yyvsp[-3].Address_node), (yyvsp[-1].Address_node), (yyvsp[0].Int_fifo),
+						  lex_current()->curpos.nline);
+			APPEND_G_FIFO(cfgt.restrict_opts, rn);
+		}
+#line 2334 "ntp_parser.tab.c"
+    break;
+
+  case 155: /* access_control_command: restrict_prefix T_Default ac_flag_list  */
+#line 868 "/root/repo/ntpd/ntp_parser.y"
+                {
+			restrict_node *rn;
+
+			rn = create_restrict_node((yyvsp[-2].Integer), NULL, NULL, (yyvsp[0].Int_fifo),
+						  lex_current()->curpos.nline);
+			APPEND_G_FIFO(cfgt.restrict_opts, rn);
+		}
+#line 2346 "ntp_parser.tab.c"
+    break;
+
+  case 156: /* access_control_command: restrict_prefix T_Ipv4_flag T_Default ac_flag_list  */
+#line 876 "/root/repo/ntpd/ntp_parser.y"
+                {
+			restrict_node *rn;
+
+			rn = create_restrict_node((yyvsp[-3].Integer),
+				create_address_node(
+					estrdup("0.0.0.0"),
+					AF_INET),
+				create_address_node(
+					estrdup("0.0.0.0"),
+					AF_INET),
+				(yyvsp[0].Int_fifo),
+				lex_current()->curpos.nline);
+			APPEND_G_FIFO(cfgt.restrict_opts, rn);
+		}
+#line 2365 "ntp_parser.tab.c"
+    break;
+
+  case 157: /* access_control_command: restrict_prefix T_Ipv6_flag T_Default ac_flag_list  */
+#line 891 "/root/repo/ntpd/ntp_parser.y"
+                {
+			restrict_node *rn;
+
+			rn = create_restrict_node((yyvsp[-3].Integer),
+				create_address_node(
+					estrdup("::"),
+					AF_INET6),
+				create_address_node(
+					estrdup("::"),
+					AF_INET6),
+				(yyvsp[0].Int_fifo),
+				lex_current()->curpos.nline);
+			APPEND_G_FIFO(cfgt.restrict_opts, rn);
+		}
+#line 2384 "ntp_parser.tab.c"
+    break;
+
+  case 158: /* access_control_command: restrict_prefix T_Source ac_flag_list  */
+#line 906 "/root/repo/ntpd/ntp_parser.y"
+                {
+			restrict_node *	rn;
+
+			APPEND_G_FIFO((yyvsp[0].Int_fifo), create_int_node((yyvsp[-1].Integer)));
+			rn = create_restrict_node(
+				(yyvsp[-2].Integer), NULL, NULL, (yyvsp[0].Int_fifo), lex_current()->curpos.nline);
+			APPEND_G_FIFO(cfgt.restrict_opts, rn);
+		}
+#line 2397 "ntp_parser.tab.c"
+    break;
+
+  case 159: /* ac_flag_list: %empty  */
+#line 918 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Int_fifo) = NULL; }
+#line 2403 "ntp_parser.tab.c"
+    break;
+
+  case 160: /* ac_flag_list: ac_flag_list access_control_flag  */
+#line 920 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Int_fifo) = (yyvsp[-1].Int_fifo);
+			APPEND_G_FIFO((yyval.Int_fifo), create_int_node((yyvsp[0].Integer)));
+		}
+#line 2412 "ntp_parser.tab.c"
+    break;
+
+  case 175: /* limit_option_list: limit_option_list limit_option  */
+#line 945 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2421 "ntp_parser.tab.c"
+    break;
+
+  case 176: /* limit_option_list: limit_option  */
+#line 950 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2430 "ntp_parser.tab.c"
+    break;
+
+  case 177: /* limit_option: limit_option_keyword number  */
+#line 958 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_dval((yyvsp[-1].Integer), (yyvsp[0].Double)); }
+#line 2436 "ntp_parser.tab.c"
+    break;
+
+  case 181: /* mru_option_list: mru_option_list mru_option  */
+#line 969 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2445 "ntp_parser.tab.c"
+    break;
+
+  case 182: /* mru_option_list: mru_option  */
+#line 974 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2454 "ntp_parser.tab.c"
+    break;
+
+  case 183: /* mru_option: mru_option_keyword T_Integer  */
+#line 982 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer)); }
+#line 2460 "ntp_parser.tab.c"
+    break;
+
+  case 193: /* fudge_command: T_Fudge address fudge_factor_list  */
+#line 1003 "/root/repo/ntpd/ntp_parser.y"
+                {
+			addr_opts_node *aon;
+
+			aon = create_addr_opts_node((yyvsp[-1].Address_node), (yyvsp[0].Attr_val_fifo));
+			APPEND_G_FIFO(cfgt.fudge, aon);
+		}
+#line 2471 "ntp_parser.tab.c"
+    break;
+
+  case 194: /* fudge_factor_list: fudge_factor_list fudge_factor  */
+#line 1013 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2480 "ntp_parser.tab.c"
+    break;
+
+  case 195: /* fudge_factor_list: fudge_factor  */
+#line 1018 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2489 "ntp_parser.tab.c"
+    break;
+
+  case 196: /* fudge_factor: fudge_factor_dbl_keyword number  */
+#line 1026 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_dval((yyvsp[-1].Integer), (yyvsp[0].Double)); }
+#line 2495 "ntp_parser.tab.c"
+    break;
+
+  case 197: /* fudge_factor: fudge_factor_bool_keyword boolean  */
+#line 1028 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer)); }
+#line 2501 "ntp_parser.tab.c"
+    break;
+
+  case 198: /* fudge_factor: T_Stratum T_Integer  */
+#line 1030 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if ((yyvsp[0].Integer) >= 0 && (yyvsp[0].Integer) <= 16) {
+				(yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer));
+			} else {
+				(yyval.Attr_val) = NULL;
+				yyerror("fudge factor: stratum value not in [0..16], ignored");
+			}
+		}
+#line 2514 "ntp_parser.tab.c"
+    break;
+
+  case 199: /* fudge_factor: T_Refid T_String  */
+#line 1039 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 2520 "ntp_parser.tab.c"
+    break;
+
+  case 206: /* refclock_command: T_Refclock T_String optional_unit option_list  */
+#line 1060 "/root/repo/ntpd/ntp_parser.y"
+                {
+#ifdef REFCLOCK
+			address_node *fakeaddr = addr_from_typeunit((yyvsp[-2].String), (yyvsp[-1].Integer));
+			peer_node *my_node = create_peer_node(T_Server, fakeaddr, (yyvsp[0].Attr_val_fifo));
+			APPEND_G_FIFO(cfgt.peers, my_node);
+#endif /* REFCLOCK */
+		}
+#line 2532 "ntp_parser.tab.c"
+    break;
+
+  case 207: /* optional_unit: %empty  */
+#line 1071 "/root/repo/ntpd/ntp_parser.y"
+                        {(yyval.Integer) = 0;}
+#line 2538 "ntp_parser.tab.c"
+    break;
+
+  case 208: /* optional_unit: T_Unit T_Integer  */
+#line 1074 "/root/repo/ntpd/ntp_parser.y"
+                        {(yyval.Integer) = (yyvsp[0].Integer);}
+#line 2544 "ntp_parser.tab.c"
+    break;
+
+  case 209: /* rlimit_command: T_Rlimit rlimit_option_list  */
+#line 1084 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.rlimit, (yyvsp[0].Attr_val_fifo)); }
+#line 2550 "ntp_parser.tab.c"
+    break;
+
+  case 210: /* rlimit_option_list: rlimit_option_list rlimit_option  */
+#line 1089 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2559 "ntp_parser.tab.c"
+    break;
+
+  case 211: /* rlimit_option_list: rlimit_option  */
+#line 1094 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2568 "ntp_parser.tab.c"
+    break;
+
+  case 212: /* rlimit_option: rlimit_option_keyword T_Integer  */
+#line 1102 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer)); }
+#line 2574 "ntp_parser.tab.c"
+    break;
+
+  case 216: /* system_option_command: T_Enable system_option_list  */
+#line 1118 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.enable_opts, (yyvsp[0].Attr_val_fifo)); }
+#line 2580 "ntp_parser.tab.c"
+    break;
+
+  case 217: /* system_option_command: T_Disable system_option_list  */
+#line 1120 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.disable_opts, (yyvsp[0].Attr_val_fifo)); }
+#line 2586 "ntp_parser.tab.c"
+    break;
+
+  case 218: /* system_option_list: system_option_list system_option  */
+#line 1125 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2595 "ntp_parser.tab.c"
+    break;
+
+  case 219: /* system_option_list: system_option  */
+#line 1130 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2604 "ntp_parser.tab.c"
+    break;
+
+  case 220: /* system_option: system_option_flag_keyword  */
+#line 1138 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival(T_Flag, (yyvsp[0].Integer)); }
+#line 2610 "ntp_parser.tab.c"
+    break;
+
+  case 221: /* system_option: system_option_local_flag_keyword  */
+#line 1140 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if (lex_from_file()) {
+				(yyval.Attr_val) = create_attr_ival(T_Flag, (yyvsp[0].Integer));
+			} else {
+				char err_str[128];
+
+				(yyval.Attr_val) = NULL;
+				snprintf(err_str, sizeof(err_str),
+					 "enable/disable %s remote configuration ignored",
+					 keyword((yyvsp[0].Integer)));
+				yyerror(err_str);
+			}
+		}
+#line 2628 "ntp_parser.tab.c"
+    break;
+
+  case 230: /* tinker_command: T_Tinker tinker_option_list  */
+#line 1175 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.tinker, (yyvsp[0].Attr_val_fifo)); }
+#line 2634 "ntp_parser.tab.c"
+    break;
+
+  case 231: /* tinker_option_list: tinker_option_list tinker_option  */
+#line 1180 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2643 "ntp_parser.tab.c"
+    break;
+
+  case 232: /* tinker_option_list: tinker_option  */
+#line 1185 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2652 "ntp_parser.tab.c"
+    break;
+
+  case 233: /* tinker_option: tinker_option_keyword number  */
+#line 1193 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_dval((yyvsp[-1].Integer), (yyvsp[0].Double)); }
+#line 2658 "ntp_parser.tab.c"
+    break;
+
+  case 245: /* nts_command: T_Nts nts_option_list  */
+#line 1217 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.nts, (yyvsp[0].Attr_val_fifo)); }
+#line 2664 "ntp_parser.tab.c"
+    break;
+
+  case 246: /* nts_option_list: nts_option_list nts_option  */
+#line 1222 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2673 "ntp_parser.tab.c"
+    break;
+
+  case 247: /* nts_option_list: nts_option  */
+#line 1227 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2682 "ntp_parser.tab.c"
+    break;
+
+  case 248: /* nts_option: nts_string_option_keyword T_String  */
+#line 1235 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String)); }
+#line 2688 "ntp_parser.tab.c"
+    break;
+
+  case 249: /* nts_option: T_Disable  */
+#line 1237 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[0].Integer), 0); }
+#line 2694 "ntp_parser.tab.c"
+    break;
+
+  case 250: /* nts_option: T_Enable  */
+#line 1239 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival((yyvsp[0].Integer), 1); }
+#line 2700 "ntp_parser.tab.c"
+    break;
+
+  case 262: /* miscellaneous_command: misc_cmd_dbl_keyword number  */
+#line 1264 "/root/repo/ntpd/ntp_parser.y"
+                {
+			attr_val *av;
+
+			av = create_attr_dval((yyvsp[-1].Integer), (yyvsp[0].Double));
+			APPEND_G_FIFO(cfgt.vars, av);
+		}
+#line 2711 "ntp_parser.tab.c"
+    break;
+
+  case 263: /* miscellaneous_command: misc_cmd_int_keyword T_Integer  */
+#line 1271 "/root/repo/ntpd/ntp_parser.y"
+                {
+			attr_val *av;
+
+			av = create_attr_ival((yyvsp[-1].Integer), (yyvsp[0].Integer));
+			APPEND_G_FIFO(cfgt.vars, av);
+		}
+#line 2722 "ntp_parser.tab.c"
+    break;
+
+  case 264: /* miscellaneous_command: misc_cmd_str_keyword T_String  */
+#line 1278 "/root/repo/ntpd/ntp_parser.y"
+                {
+			attr_val *av;
+
+			av = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String));
+			APPEND_G_FIFO(cfgt.vars, av);
+		}
+#line 2733 "ntp_parser.tab.c"
+    break;
+
+  case 265: /* miscellaneous_command: misc_cmd_str_lcl_keyword T_String  */
+#line 1285 "/root/repo/ntpd/ntp_parser.y"
+                {
+			char error_text[64];
+			attr_val *av;
+
+			if (lex_from_file()) {
+				av = create_attr_sval((yyvsp[-1].Integer), (yyvsp[0].String));
+				APPEND_G_FIFO(cfgt.vars, av);
+			} else {
+				YYFREE((yyvsp[0].String));
+				snprintf(error_text, sizeof(error_text),
+					 "%s remote config ignored",
+					 keyword((yyvsp[-1].Integer)));
+				yyerror(error_text);
+			}
+		}
+#line 2753 "ntp_parser.tab.c"
+    break;
+
+  case 266: /* miscellaneous_command: T_Includefile T_String command  */
+#line 1301 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if (!lex_from_file()) {
+				YYFREE((yyvsp[-1].String)); /* avoid leak */
+				yyerror("remote includefile ignored");
+				break;
+			}
+			if (lex_level() > MAXINCLUDELEVEL) {
+				fprintf(stderr, "getconfig(): Maximum include file level exceeded.\n");
+				msyslog(LOG_ERR, "CONFIG: Maximum include file level exceeded.");
+			} else {
+				const char * path = (yyvsp[-1].String);
+				if (!lex_push_file(path)) {
+					fprintf(stderr, "getconfig(): Couldn't open <%s>\n", path);
+					msyslog(LOG_ERR, "CONFIG: Couldn't open <%s>", path);
+				}
+			}
+			YYFREE((yyvsp[-1].String)); /* avoid leak */
+		}
+#line 2776 "ntp_parser.tab.c"
+    break;
+
+  case 267: /* miscellaneous_command: T_End  */
+#line 1320 "/root/repo/ntpd/ntp_parser.y"
+                        { lex_flush_stack(); }
+#line 2782 "ntp_parser.tab.c"
+    break;
+
+  case 268: /* miscellaneous_command: T_Driftfile drift_parm  */
+#line 1322 "/root/repo/ntpd/ntp_parser.y"
+                        { /* see drift_parm below for actions */ }
+#line 2788 "ntp_parser.tab.c"
+    break;
+
+  case 269: /* miscellaneous_command: T_Logconfig log_config_list  */
+#line 1324 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.logconfig, (yyvsp[0].Attr_val_fifo)); }
+#line 2794 "ntp_parser.tab.c"
+    break;
+
+  case 270: /* miscellaneous_command: T_Phone string_list  */
+#line 1326 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.phone, (yyvsp[0].String_fifo)); }
+#line 2800 "ntp_parser.tab.c"
+    break;
+
+  case 271: /* miscellaneous_command: T_Setvar variable_assign  */
+#line 1328 "/root/repo/ntpd/ntp_parser.y"
+                        { APPEND_G_FIFO(cfgt.setvar, (yyvsp[0].Set_var)); }
+#line 2806 "ntp_parser.tab.c"
+    break;
+
+  case 275: /* misc_cmd_int_keyword: T_Leapsmearinterval  */
+#line 1342 "/root/repo/ntpd/ntp_parser.y"
+                {
+#ifndef ENABLE_LEAP_SMEAR
+			yyerror("Built without LEAP_SMEAR support.");
+#endif
+		}
+#line 2816 "ntp_parser.tab.c"
+    break;
+
+  case 280: /* drift_parm: T_String  */
+#line 1361 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if (lex_from_file()) {
+				attr_val *av;
+				av = create_attr_sval(T_Driftfile, (yyvsp[0].String));
+				APPEND_G_FIFO(cfgt.vars, av);
+			} else {
+				YYFREE((yyvsp[0].String));
+				yyerror("driftfile remote configuration ignored");
+			}
+		}
+#line 2831 "ntp_parser.tab.c"
+    break;
+
+  case 281: /* drift_parm: T_String T_Double  */
+#line 1372 "/root/repo/ntpd/ntp_parser.y"
+                {
+			attr_val *av;
+
+			av = create_attr_sval(T_Driftfile, (yyvsp[-1].String));
+			APPEND_G_FIFO(cfgt.vars, av);
+			av = create_attr_dval(T_WanderThreshold, (yyvsp[0].Double));
+			APPEND_G_FIFO(cfgt.vars, av);
+		}
+#line 2844 "ntp_parser.tab.c"
+    break;
+
+  case 282: /* drift_parm: %empty  */
+#line 1381 "/root/repo/ntpd/ntp_parser.y"
+                {
+			attr_val *av;
+
+			av = create_attr_sval(T_Driftfile, estrdup(""));
+			APPEND_G_FIFO(cfgt.vars, av);
+		}
+#line 2855 "ntp_parser.tab.c"
+    break;
+
+  case 283: /* variable_assign: T_String '=' T_String t_default_or_zero  */
+#line 1391 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Set_var) = create_setvar_node((yyvsp[-3].String), (yyvsp[-1].String), (yyvsp[0].Integer)); }
+#line 2861 "ntp_parser.tab.c"
+    break;
+
+  case 285: /* t_default_or_zero: %empty  */
+#line 1397 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Integer) = 0; }
+#line 2867 "ntp_parser.tab.c"
+    break;
+
+  case 286: /* log_config_list: log_config_list log_config_command  */
+#line 1402 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2876 "ntp_parser.tab.c"
+    break;
+
+  case 287: /* log_config_list: log_config_command  */
+#line 1407 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2885 "ntp_parser.tab.c"
+    break;
+
+  case 288: /* log_config_command: T_String  */
+#line 1415 "/root/repo/ntpd/ntp_parser.y"
+                {
+			char	prefix;
+			char *	type;
+
+			switch ((yyvsp[0].String)[0]) {
+
+			case '+':
+			case '-':
+			case '=':
+				prefix = (yyvsp[0].String)[0];
+				type = (yyvsp[0].String) + 1;
+				break;
+
+			default:
+				prefix = '=';
+				type = (yyvsp[0].String);
+			}
+
+			(yyval.Attr_val) = create_attr_sval(prefix, estrdup(type));
+			YYFREE((yyvsp[0].String));
+		}
+#line 2911 "ntp_parser.tab.c"
+    break;
+
+  case 289: /* interface_command: interface_nic nic_rule_action nic_rule_class  */
+#line 1440 "/root/repo/ntpd/ntp_parser.y"
+                {
+			nic_rule_node *nrn;
+
+			nrn = create_nic_rule_node((yyvsp[0].Integer), NULL, (yyvsp[-1].Integer));
+			APPEND_G_FIFO(cfgt.nic_rules, nrn);
+		}
+#line 2922 "ntp_parser.tab.c"
+    break;
+
+  case 290: /* interface_command: interface_nic nic_rule_action T_String  */
+#line 1447 "/root/repo/ntpd/ntp_parser.y"
+                {
+			nic_rule_node *nrn;
+
+			nrn = create_nic_rule_node(0, (yyvsp[0].String), (yyvsp[-1].Integer));
+			APPEND_G_FIFO(cfgt.nic_rules, nrn);
+		}
+#line 2933 "ntp_parser.tab.c"
+    break;
+
+  case 300: /* reset_command: T_Reset counter_set_list  */
+#line 1475 "/root/repo/ntpd/ntp_parser.y"
+                        { CONCAT_G_FIFOS(cfgt.reset_counters, (yyvsp[0].Int_fifo)); }
+#line 2939 "ntp_parser.tab.c"
+    break;
+
+  case 301: /* counter_set_list: counter_set_list counter_set_keyword  */
+#line 1480 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Int_fifo) = (yyvsp[-1].Int_fifo);
+			APPEND_G_FIFO((yyval.Int_fifo), create_int_node((yyvsp[0].Integer)));
+		}
+#line 2948 "ntp_parser.tab.c"
+    break;
+
+  case 302: /* counter_set_list: counter_set_keyword  */
+#line 1485 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Int_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Int_fifo), create_int_node((yyvsp[0].Integer)));
+		}
+#line 2957 "ntp_parser.tab.c"
+    break;
+
+  case 310: /* integer_list_range: integer_list_range integer_list_range_elt  */
+#line 1509 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = (yyvsp[-1].Attr_val_fifo);
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2966 "ntp_parser.tab.c"
+    break;
+
+  case 311: /* integer_list_range: integer_list_range_elt  */
+#line 1514 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.Attr_val_fifo) = NULL;
+			APPEND_G_FIFO((yyval.Attr_val_fifo), (yyvsp[0].Attr_val));
+		}
+#line 2975 "ntp_parser.tab.c"
+    break;
+
+  case 312: /* integer_list_range_elt: T_Integer  */
+#line 1522 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_ival('i', (yyvsp[0].Integer)); }
+#line 2981 "ntp_parser.tab.c"
+    break;
+
+  case 314: /* integer_range: '(' T_Integer T_Ellipsis T_Integer ')'  */
+#line 1528 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Attr_val) = create_attr_rangeval('-', (yyvsp[-3].Integer), (yyvsp[-1].Integer)); }
+#line 2987 "ntp_parser.tab.c"
+    break;
+
+  case 315: /* string_list: string_list T_String  */
+#line 1533 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.String_fifo) = (yyvsp[-1].String_fifo);
+			APPEND_G_FIFO((yyval.String_fifo), create_string_node((yyvsp[0].String)));
+		}
+#line 2996 "ntp_parser.tab.c"
+    break;
+
+  case 316: /* string_list: T_String  */
+#line 1538 "/root/repo/ntpd/ntp_parser.y"
+                {
+			(yyval.String_fifo) = NULL;
+			APPEND_G_FIFO((yyval.String_fifo), create_string_node((yyvsp[0].String)));
+		}
+#line 3005 "ntp_parser.tab.c"
+    break;
+
+  case 317: /* boolean: T_Integer  */
+#line 1546 "/root/repo/ntpd/ntp_parser.y"
+                {
+			if ((yyvsp[0].Integer) != 0 && (yyvsp[0].Integer) != 1) {
+				yyerror("Integer value is not boolean (0 or 1). Assuming 1");
+				(yyval.Integer) = 1;
+			} else {
+				(yyval.Integer) = (yyvsp[0].Integer);
+			}
+		}
+#line 3018 "ntp_parser.tab.c"
+    break;
+
+  case 318: /* boolean: T_True  */
+#line 1554 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Integer) = 1; }
+#line 3024 "ntp_parser.tab.c"
+    break;
+
+  case 319: /* boolean: T_False  */
+#line 1555 "/root/repo/ntpd/ntp_parser.y"
+                        { (yyval.Integer) = 0; }
+#line 3030 "ntp_parser.tab.c"
+    break;
+
+  case 320: /* number: T_Integer  */
+#line 1559 "/root/repo/ntpd/ntp_parser.y"
+                                { (yyval.Double) = (double)(yyvsp[0].Integer); }
+#line 3036 "ntp_parser.tab.c"
+    break;
+
+
+#line 3040 "ntp_parser.tab.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      yyerror (YY_("syntax error"));
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+
+  return yyresult;
+}
+
+#line 1564 "/root/repo/ntpd/ntp_parser.y"
+
+
+#ifdef REFCLOCK
+address_node *
+addr_from_typeunit(char *type, int unit)
+{
+	char addrbuf[1025];	/* NI_MAXHOSTS on Linux */
+	int dtype;
+
+	for (dtype = 1; dtype < (int)num_refclock_conf; dtype++)
+	    if (refclock_conf[dtype]->basename != NULL && strcasecmp(refclock_conf[dtype]->basename, type) == 0)
+		goto foundit;
+	 msyslog(LOG_ERR, "CONFIG: Unknown driver name %s", type);
+	 exit(1);
+foundit:
+	snprintf(addrbuf, sizeof(addrbuf), "127.127.%d.%d", dtype, unit);
+	return create_address_node(estrdup(addrbuf), AF_INET);
+}
+#endif /* REFCLOCK */
+
+void
+yyerror(
+	const char *msg
+	)
+{
+	int retval;
+	struct FILE_INFO * ip_ctx;
+
+	ip_ctx = lex_current();
+	ip_ctx->errpos = ip_ctx->tokpos;
+
+	msyslog(LOG_ERR, "CONFIG: line %d column %d %s",
+		ip_ctx->errpos.nline, ip_ctx->errpos.ncol, msg);
+	if (lex_from_file()) {
+                /* all is good, so far */
+                return;
+        }
+        /* Uh, oh, got an error */
+
+	/* Increment the number of errors */
+	++remote_config.no_errors;
+
+	/* Save the error message in the correct buffer */
+	if ((MAXLINE - 10) < remote_config.err_pos) {
+		/* err_msg already full, ignore this */
+		return;
+	}
+	retval = snprintf(remote_config.err_msg + remote_config.err_pos,
+			  (size_t)(MAXLINE - remote_config.err_pos),
+			  "column %d %s", ip_ctx->errpos.ncol, msg);
+
+	/* Increment the value of err_pos */
+	if (retval > 0) {
+		/* careful, retval is not bytes written, it is
+		 * bytes that would have been written if space had
+                 * been available */
+		remote_config.err_pos += retval;
+		if (MAXLINE < remote_config.err_pos) {
+			/* err_msg overflowed! */
+			remote_config.err_pos = MAXLINE;
+		}
+	}
+}
+
+
+/*
+ * token_name - convert T_ token integers to text
+ *		example: token_name(T_Server) returns "T_Server"
+ */
+const char *
+token_name(
+	int token
+	)
+{
+	return yytname[YYTRANSLATE(token)];
+}
+
+
+/* Initial Testing function -- ignore */
+#if 0
+int main(int argc, char *argv[])
+{
+	ip_file = FOPEN(argv[1], "r");
+	if (!ip_file)
+		fprintf(stderr, "ERROR!! Could not open file: %s\n", argv[1]);
+	yyparse();
+	return 0;
+}
+#endif
+
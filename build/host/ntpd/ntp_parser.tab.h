@@ -0,0 +1,287 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_NTP_PARSER_TAB_H_INCLUDED
+# define YY_YY_NTP_PARSER_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    T_Adjrate = 258,               /* T_Adjrate  */
+    T_Aead = 259,                  /* T_Aead  */
+    T_Age = 260,                   /* T_Age  */
+    T_All = 261,                   /* T_All  */
+    T_Allan = 262,                 /* T_Allan  */
+    T_Allpeers = 263,              /* T_Allpeers  */
+    T_Ask = 264,                   /* T_Ask  */
+    T_Auth = 265,                  /* T_Auth  */
+    T_Average = 266,               /* T_Average  */
+    T_Baud = 267,                  /* T_Baud  */
+    T_Bias = 268,                  /* T_Bias  */
+    T_Binary = 269,                /* T_Binary  */
+    T_Burst = 270,                 /* T_Burst  */
+    T_Calibrate = 271,             /* T_Calibrate  */
+    T_Ca = 272,                    /* T_Ca  */
+    T_Ceiling = 273,               /* T_Ceiling  */
+    T_Cert = 274,                  /* T_Cert  */
+    T_Clock = 275,                 /* T_Clock  */
+    T_Clockstats = 276,            /* T_Clockstats  */
+    T_Cohort = 277,                /* T_Cohort  */
+    T_Cookie = 278,                /* T_Cookie  */
+    T_ControlKey = 279,            /* T_ControlKey  */
+    T_Ctl = 280,                   /* T_Ctl  */
+    T_Day = 281,                   /* T_Day  */
+    T_Default = 282,               /* T_Default  */
+    T_Disable = 283,               /* T_Disable  */
+    T_Dispersion = 284,            /* T_Dispersion  */
+    T_Double = 285,                /* T_Double  */
+    T_Driftfile = 286,             /* T_Driftfile  */
+    T_Drop = 287,                  /* T_Drop  */
+    T_Dscp = 288,                  /* T_Dscp  */
+    T_Expire = 289,                /* T_Expire  */
+    T_Ellipsis = 290,              /* T_Ellipsis  */
+    T_Enable = 291,                /* T_Enable  */
+    T_End = 292,                   /* T_End  */
+    T_False = 293,                 /* T_False  */
+    T_File = 294,                  /* T_File  */
+    T_Filegen = 295,               /* T_Filegen  */
+    T_Filenum = 296,               /* T_Filenum  */
+    T_Flag1 = 297,                 /* T_Flag1  */
+    T_Flag2 = 298,                 /* T_Flag2  */
+    T_Flag3 = 299,                 /* T_Flag3  */
+    T_Flag4 = 300,                 /* T_Flag4  */
+    T_Flake = 301,                 /* T_Flake  */
+    T_Floor = 302,                 /* T_Floor  */
+    T_Freq = 303,                  /* T_Freq  */
+    T_Fudge = 304,                 /* T_Fudge  */
+    T_Holdover = 305,              /* T_Holdover  */
+    T_Huffpuff = 306,              /* T_Huffpuff  */
+    T_Iburst = 307,                /* T_Iburst  */
+    T_Ignore = 308,                /* T_Ignore  */
+    T_Incalloc = 309,              /* T_Incalloc  */
+    T_Incmem = 310,                /* T_Incmem  */
+    T_Initalloc = 311,             /* T_Initalloc  */
+    T_Initmem = 312,               /* T_Initmem  */
+    T_Includefile = 313,           /* T_Includefile  */
+    T_Integer = 314,               /* T_Integer  */
+    T_Interface = 315,             /* T_Interface  */
+    T_Interval = 316,              /* T_Interval  */
+    T_Intrange = 317,              /* T_Intrange  */
+    T_Io = 318,                    /* T_Io  */
+    T_Ipv4 = 319,                  /* T_Ipv4  */
+    T_Ipv4_flag = 320,             /* T_Ipv4_flag  */
+    T_Ipv6 = 321,                  /* T_Ipv6  */
+    T_Ipv6_flag = 322,             /* T_Ipv6_flag  */
+    T_Kernel = 323,                /* T_Kernel  */
+    T_Key = 324,                   /* T_Key  */
+    T_Keys = 325,                  /* T_Keys  */
+    T_Kod = 326,                   /* T_Kod  */
+    T_Mssntp = 327,                /* T_Mssntp  */
+    T_Leapfile = 328,              /* T_Leapfile  */
+    T_Leapsmearinterval = 329,     /* T_Leapsmearinterval  */
+    T_Limit = 330,                 /* T_Limit  */
+    T_Limited = 331,               /* T_Limited  */
+    T_Link = 332,                  /* T_Link  */
+    T_Listen = 333,                /* T_Listen  */
+    T_Logconfig = 334,             /* T_Logconfig  */
+    T_Logfile = 335,               /* T_Logfile  */
+    T_Logqueue = 336,              /* T_Logqueue  */
+    T_Loopstats = 337,             /* T_Loopstats  */
+    T_Mask = 338,                  /* T_Mask  */
+    T_Maxage = 339,                /* T_Maxage  */
+    T_Maxclock = 340,              /* T_Maxclock  */
+    T_Maxdepth = 341,              /* T_Maxdepth  */
+    T_Maxdisp = 342,               /* T_Maxdisp  */
+    T_Maxdist = 343,               /* T_Maxdist  */
+    T_Maxmem = 344,                /* T_Maxmem  */
+    T_Maxpoll = 345,               /* T_Maxpoll  */
+    T_Maxtls = 346,                /* T_Maxtls  */
+    T_Mdnstries = 347,             /* T_Mdnstries  */
+    T_Mem = 348,                   /* T_Mem  */
+    T_Memlock = 349,               /* T_Memlock  */
+    T_Metrics = 350,               /* T_Metrics  */
+    T_Minage = 351,                /* T_Minage  */
+    T_Minclock = 352,              /* T_Minclock  */
+    T_Mindepth = 353,              /* T_Mindepth  */
+    T_Mindist = 354,               /* T_Mindist  */
+    T_Minpoll = 355,               /* T_Minpoll  */
+    T_Minsane = 356,               /* T_Minsane  */
+    T_Mintls = 357,                /* T_Mintls  */
+    T_Mode = 358,                  /* T_Mode  */
+    T_Monitor = 359,               /* T_Monitor  */
+    T_Month = 360,                 /* T_Month  */
+    T_Mru = 361,                   /* T_Mru  */
+    T_Nic = 362,                   /* T_Nic  */
+    T_Nolink = 363,                /* T_Nolink  */
+    T_Nomodify = 364,              /* T_Nomodify  */
+    T_Nomrulist = 365,             /* T_Nomrulist  */
+    T_None = 366,                  /* T_None  */
+    T_Nonvolatile = 367,           /* T_Nonvolatile  */
+    T_Nopeer = 368,                /* T_Nopeer  */
+    T_Noquery = 369,               /* T_Noquery  */
+    T_Noselect = 370,              /* T_Noselect  */
+    T_Noserve = 371,               /* T_Noserve  */
+    T_Notrap = 372,                /* T_Notrap  */
+    T_Notrust = 373,               /* T_Notrust  */
+    T_Noval = 374,                 /* T_Noval  */
+    T_Ntp = 375,                   /* T_Ntp  */
+    T_Ntpport = 376,               /* T_Ntpport  */
+    T_NtpSignDsocket = 377,        /* T_NtpSignDsocket  */
+    T_Nts = 378,                   /* T_Nts  */
+    T_Orphan = 379,                /* T_Orphan  */
+    T_Orphanwait = 380,            /* T_Orphanwait  */
+    T_Panic = 381,                 /* T_Panic  */
+    T_Path = 382,                  /* T_Path  */
+    T_Peer = 383,                  /* T_Peer  */
+    T_Peerstats = 384,             /* T_Peerstats  */
+    T_Phone = 385,                 /* T_Phone  */
+    T_Pid = 386,                   /* T_Pid  */
+    T_Pidfile = 387,               /* T_Pidfile  */
+    T_Pool = 388,                  /* T_Pool  */
+    T_Port = 389,                  /* T_Port  */
+    T_Ppspath = 390,               /* T_Ppspath  */
+    T_Prefer = 391,                /* T_Prefer  */
+    T_Protostats = 392,            /* T_Protostats  */
+    T_Rawstats = 393,              /* T_Rawstats  */
+    T_Refclock = 394,              /* T_Refclock  */
+    T_Refid = 395,                 /* T_Refid  */
+    T_Requestkey = 396,            /* T_Requestkey  */
+    T_Require = 397,               /* T_Require  */
+    T_Reservoir = 398,             /* T_Reservoir  */
+    T_Reset = 399,                 /* T_Reset  */
+    T_Restrict = 400,              /* T_Restrict  */
+    T_Rlimit = 401,                /* T_Rlimit  */
+    T_Sample = 402,                /* T_Sample  */
+    T_Saveconfigdir = 403,         /* T_Saveconfigdir  */
+    T_Server = 404,                /* T_Server  */
+    T_Setvar = 405,                /* T_Setvar  */
+    T_Shmstats = 406,              /* T_Shmstats  */
+    T_Source = 407,                /* T_Source  */
+    T_Stacksize = 408,             /* T_Stacksize  */
+    T_Stages = 409,                /* T_Stages  */
+    T_Statistics = 410,            /* T_Statistics  */
+    T_Stats = 411,                 /* T_Stats  */
+    T_Statsdir = 412,              /* T_Statsdir  */
+    T_Step = 413,                  /* T_Step  */
+    T_Stepback = 414,              /* T_Stepback  */
+    T_Stepfwd = 415,               /* T_Stepfwd  */
+    T_Stepout = 416,               /* T_Stepout  */
+    T_Stratum = 417,               /* T_Stratum  */
+    T_Subtype = 418,               /* T_Subtype  */
+    T_String = 419,                /* T_String  */
+    T_Sys = 420,                   /* T_Sys  */
+    T_Sysstats = 421,              /* T_Sysstats  */
+    T_Tick = 422,                  /* T_Tick  */
+    T_Time1 = 423,                 /* T_Time1  */
+    T_Time2 = 424,                 /* T_Time2  */
+    T_Timer = 425,                 /* T_Timer  */
+    T_Timingstats = 426,           /* T_Timingstats  */
+    T_Tinker = 427,                /* T_Tinker  */
+    T_Text = 428,                  /* T_Text  */
+    T_Tlsciphers = 429,            /* T_Tlsciphers  */
+    T_Tlsciphersuites = 430,       /* T_Tlsciphersuites  */
+    T_Tos = 431,                   /* T_Tos  */
+    T_True = 432,                  /* T_True  */
+    T_Trustedkey = 433,            /* T_Trustedkey  */
+    T_Txstamp = 434,               /* T_Txstamp  */
+    T_Type = 435,                  /* T_Type  */
+    T_U_int = 436,                 /* T_U_int  */
+    T_Unit = 437,                  /* T_Unit  */
+    T_Unconfig = 438,              /* T_Unconfig  */
+    T_Unpeer = 439,                /* T_Unpeer  */
+    T_Unrestrict = 440,            /* T_Unrestrict  */
+    T_Usestats = 441,              /* T_Usestats  */
+    T_Version = 442,               /* T_Version  */
+    T_WanderThreshold = 443,       /* T_WanderThreshold  */
+    T_Week = 444,                  /* T_Week  */
+    T_Wildcard = 445,              /* T_Wildcard  */
+    T_Xleave = 446,                /* T_Xleave  */
+    T_Year = 447,                  /* T_Year  */
+    T_Flag = 448,                  /* T_Flag  */
+    T_EOC = 449                    /* T_EOC  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 37 "/root/repo/ntpd/ntp_parser.y"
+
+	char *			String;
+	double			Double;
+	int			Integer;
+	unsigned		U_int;
+	gen_fifo *		Generic_fifo;
+	attr_val *		Attr_val;
+	attr_val_fifo *		Attr_val_fifo;
+	int_fifo *		Int_fifo;
+	string_fifo *		String_fifo;
+	address_node *		Address_node;
+	address_fifo *		Address_fifo;
+	setvar_node *		Set_var;
+
+#line 273 "ntp_parser.tab.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+extern YYSTYPE yylval;
+
+
+int yyparse (void);
+
+
+#endif /* !YY_YY_NTP_PARSER_TAB_H_INCLUDED  */
@@ -0,0 +1,884 @@
+# -*- coding: utf-8 -*-
+
+"""
+statfiles.py - class for digesting and plotting NTP logfiles
+
+Requires gnuplot and liberation fonts installed.
+
+"""
+# SPDX-License-Identifier: BSD-2-Clause
+from __future__ import print_function, division
+
+import array
+import calendar
+import gc
+import glob
+import gzip
+import heapq
+import io
+import mmap
+import operator
+import os
+import re
+import socket
+import struct
+import sys
+import time
+import zlib
+
+try:
+    import numpy
+except ImportError:
+    numpy = None    # the array module does, only slower
+
+
+class BinaryStats:
+    """Reader for the binary statistics files ntpd writes when a filegen
+    is configured "binary".  include/ntp_filegen.h describes the layout.
+
+    The file is mapped, not read, and records are decoded a run at a
+    time with one struct format, so a month of loopstats loads quickly.
+    Records are assumed to be in time order, as ntpd writes them."""
+    MAGIC = b"NTPSTATB"
+    VERSION = 1
+    HEADER = "8sHHHHII16s"
+    COLUMN = "12sHcB"
+    # what our own column types are stored as
+    STORAGE = {'T': 'Q', 'S': 'I'}
+    DATA, STRING, MORE = 0, 1, 2
+
+    @staticmethod
+    def open(path):
+        """Return a BinaryStats for path, or None if it isn't one.
+        Compressed files are inflated into memory.  Raises ValueError
+        for a binary file that can't be read."""
+        try:
+            with io.open(path, 'rb') as fp:
+                head = fp.read(len(BinaryStats.MAGIC))
+                if head[:2] == b"\x1f\x8b":
+                    # look before inflating the whole thing
+                    fp.seek(0)
+                    peek = zlib.decompressobj(16 + zlib.MAX_WBITS)
+                    if peek.decompress(fp.read(4096), len(head)) != \
+                            BinaryStats.MAGIC:
+                        return None
+                    fp.seek(0)
+                    buf = zlib.decompress(fp.read(), 16 + zlib.MAX_WBITS)
+                elif head == BinaryStats.MAGIC:
+                    buf = mmap.mmap(fp.fileno(), 0, access=mmap.ACCESS_READ)
+                else:
+                    return None
+        except (IOError, OSError, zlib.error):
+            return None
+        return BinaryStats(buf)
+
+    def __init__(self, buf):
+        self.buf = buf
+        if not hasattr(struct.Struct, "iter_unpack"):
+            raise ValueError("binary statistics need Python 3")
+        size = struct.calcsize("<" + self.HEADER)
+        if len(buf) < size or buf[:len(self.MAGIC)] != self.MAGIC:
+            raise ValueError("not a binary statistics file")
+        if struct.unpack_from("<I", buf, 16)[0] == 0x01020304:
+            order = "<"
+        else:
+            order = ">"
+        (_, version, self.hsize, self.recsize, ncols, _, _,
+         stream) = struct.unpack_from(order + self.HEADER, buf, 0)
+        if version != self.VERSION:
+            raise ValueError("binary statistics version %d" % version)
+        self.stream = stream.split(b"\0")[0].decode("ascii")
+        names = []
+        types = []
+        offsets = []
+        colsize = struct.calcsize(order + self.COLUMN)
+        for i in range(ncols):
+            (name, offset, ctype, _) = struct.unpack_from(
+                order + self.COLUMN, buf, size + i * colsize)
+            names.append(name.split(b"\0")[0].decode("ascii"))
+            types.append(ctype.decode("ascii"))
+            offsets.append(offset)
+        if "time" not in names:
+            raise ValueError("binary statistics without a time column")
+
+        # One format for a whole record, the kind then the columns in
+        # the order they are stored.  pick puts time first and the
+        # rest in header order, and that is the order of names.
+        fmt = order + "H"
+        pos = 2
+        stored = sorted(range(ncols), key=lambda i: offsets[i])
+        for i in stored:
+            code = self.STORAGE.get(types[i], types[i])
+            fmt += "x" * (offsets[i] - pos) + code
+            pos = offsets[i] + struct.calcsize(order + code)
+        fmt += "x" * (self.recsize - pos)
+        self.record = struct.Struct(fmt)
+        if self.record.size != self.recsize:
+            raise ValueError("binary statistics record size mismatch")
+        tcol = names.index("time")
+        want = [tcol] + [i for i in range(ncols) if i != tcol]
+        self.names = [names[i] for i in want]
+        self.types = [types[i] for i in want]
+        self.pick = operator.itemgetter(*[1 + stored.index(i) for i in want])
+        self.timeoff = offsets[tcol]
+        self.time = struct.Struct(order + "d")
+        self.string = struct.Struct(order + "HHI")
+        # a partial record at the end is still being written
+        self.nrec = (len(buf) - self.hsize) // self.recsize
+        # the low byte of each record's kind
+        kindoff = self.hsize + (0 if "<" == order else 1)
+        self.kinds = bytes(memoryview(buf)[
+            kindoff:self.hsize + self.nrec * self.recsize:self.recsize])
+
+    def __time_at(self, i):
+        "Time of the first data record at or after record i."
+        i = self.kinds.find(b"\0", i)
+        if i < 0:
+            return None
+        return self.time.unpack_from(
+            self.buf, self.hsize + i * self.recsize + self.timeoff)[0]
+
+    def __bisect(self, when, after=False):
+        "Index of the first data record at, or if after is set past, when."
+        lo, hi = 0, self.nrec
+        while lo < hi:
+            mid = (lo + hi) // 2
+            stamp = self.__time_at(mid)
+            if stamp is None or stamp > when or (stamp == when and
+                                                 not after):
+                hi = mid
+            else:
+                lo = mid + 1
+        return lo
+
+    def __define(self, strings, i):
+        "Apply the string definition record at index i."
+        at = self.hsize + i * self.recsize
+        (kind, length, ident) = self.string.unpack_from(self.buf, at)
+        text = self.buf[at + self.string.size:
+                        at + self.string.size + length].decode(
+                            "utf-8", "replace")
+        if self.MORE == kind:
+            strings[ident] = strings.get(ident, "") + text
+        else:
+            strings[ident] = text
+
+    def runs(self, starttime=None, endtime=None, lfp=None, millis=False,
+             limit=4096):
+        """Generate the rows records() returns a run of at most limit
+        at a time, so a long file need not be decoded all at once."""
+        first = 0 if starttime is None else self.__bisect(starttime)
+        last = self.nrec if endtime is None else \
+            self.__bisect(endtime, after=True)
+        skip = 1 if millis else 0
+        scols = [skip + i for i, t in enumerate(self.types) if 'S' == t]
+        if lfp is not None:
+            tcols = [skip + i for i, t in enumerate(self.types)
+                     if 'T' == t]
+        else:
+            tcols = []
+        strings = {}
+        get = strings.get
+        defs = [m.start() for m in re.finditer(b"[^\0]", self.kinds)]
+        defs.append(self.nrec)
+        i = 0
+        # HOT LOOP!  Whole runs between definitions are decoded at once
+        for d in defs:
+            lo, hi = max(i, first), min(d, last)
+            while lo < hi:
+                top = min(hi, lo + limit)
+                view = memoryview(self.buf)[
+                    self.hsize + lo * self.recsize:
+                    self.hsize + top * self.recsize]
+                recs = map(self.pick, self.record.iter_unpack(view))
+                if millis:
+                    run = [[int(rec[0] * 1000)] + list(rec) for rec in recs]
+                else:
+                    run = list(map(list, recs))
+                for c in scols:
+                    for row in run:
+                        row[c] = get(row[c], "-")
+                for c in tcols:
+                    for row in run:
+                        row[c] = lfp(row[c])
+                yield run
+                lo = top
+            if d >= last:
+                break
+            self.__define(strings, d)
+            i = d + 1
+
+    def records(self, starttime=None, endtime=None, lfp=None,
+                millis=False):
+        """Return the data records from starttime to endtime as lists,
+        ordered as names is, with strings in place.  l_fps are left as
+        integers unless a function to convert them is given.  With
+        millis, each list starts with the time in whole milliseconds
+        as well, the way NTPStats rows do."""
+        rows = []
+        for run in self.runs(starttime, endtime, lfp, millis, self.nrec):
+            rows += run
+        return rows
+
+    @staticmethod
+    def lfptoa(value):
+        "An l_fp as ntpd prints it, seconds to nine places."
+        (sec, ns) = divmod(((value * 1000000000) + (1 << 31)) >> 32,
+                           1000000000)
+        return "%d.%09d" % (sec, ns)
+
+    def unixized(self, starttime, endtime):
+        """Rows laid out as NTPStats.unixize() makes them from the text
+        form of the same records: milliseconds, Unix time, then the
+        other columns in order.  Numbers stay numbers, except l_fps,
+        which are printed as ntpd would have."""
+        return self.records(starttime, endtime, self.lfptoa, True)
+
+
+class StatStream:
+    """The rows of one statistics stem from starttime to endtime, read
+    from the files each time the stream is iterated instead of being
+    loaded up front.  Rows are as NTPStats makes them.
+
+    Each file is assumed to be in time order, as ntpd writes them.
+    A plain file is mapped and the start of the window found by
+    bisection; a compressed one is read from the start.  Files are
+    read a chunk at a time, stop at the end of the window, and are
+    merged rather than sorted, so memory does not grow with the
+    amount of data."""
+    CHUNK = 1 << 20     # bytes of text handled at a time
+
+    def __init__(self, parts, starttime, endtime, unix=False,
+                 column=None, value=None):
+        self.parts = parts
+        self.starttime = starttime
+        self.endtime = endtime
+        self.unix = unix        # time first, as in temps and gpsd
+        self.column = column
+        self.value = value
+
+    def where(self, column, value):
+        "The rows of this stream with value in the given column."
+        return StatStream(self.parts, self.starttime, self.endtime,
+                          self.unix, column, value)
+
+    def __stamp(self, line):
+        "Unix time of a line of text, or None."
+        split = line.split(None, 2)
+        try:
+            if self.unix:
+                return float(split[0])
+            return (NTPStats.SecondsInDay * int(split[0]) +
+                    float(split[1]) - 3506716800)
+        except (ValueError, IndexError):
+            return None
+
+    def __rows(self, lines):
+        if self.unix:
+            return NTPStats.unixtimed(lines, self.starttime, self.endtime)
+        return NTPStats.unixize(lines, self.starttime, self.endtime)
+
+    def __seek(self, buf):
+        """Offset of a line at or before the first one in the window.
+        Lines that don't parse are passed over on the way."""
+        lo, hi = 0, len(buf)
+        while hi - lo > 4096:
+            pos = buf.find(b"\n", (lo + hi) // 2) + 1
+            if pos <= 0 or pos >= hi:
+                break
+            stamp = None
+            nxt = pos
+            while stamp is None and nxt < hi:
+                end = buf.find(b"\n", nxt)
+                if end < 0:
+                    end = len(buf)
+                stamp = self.__stamp(buf[nxt:end].decode("ascii",
+                                                          "replace"))
+                nxt = end + 1
+            if stamp is None or stamp >= self.starttime:
+                hi = pos
+            else:
+                lo = pos
+        return lo
+
+    def __chunks(self, path):
+        "Lists of lines of a text file, from about the window start."
+        if path.endswith("gz"):
+            with gzip.open(path, 'rb') as fp:
+                rest = b""
+                while True:
+                    data = fp.read(self.CHUNK)
+                    if not data:
+                        break
+                    data = rest + data
+                    end = data.rfind(b"\n") + 1
+                    rest = data[end:]
+                    yield data[:end].decode("ascii", "replace").splitlines()
+                if rest:
+                    yield [rest.decode("ascii", "replace")]
+            return
+        with io.open(path, 'rb') as fp:
+            try:
+                buf = mmap.mmap(fp.fileno(), 0, access=mmap.ACCESS_READ)
+            except (ValueError, mmap.error):
+                return      # empty
+        pos = self.__seek(buf)
+        while pos < len(buf):
+            end = buf.find(b"\n", pos + self.CHUNK) + 1
+            if end <= 0:
+                end = len(buf)
+            yield buf[pos:end].decode("ascii", "replace").splitlines()
+            pos = end
+
+    def __lines(self, lines, pos):
+        "Unix time of the first parseable line from pos on, or None."
+        for line in lines[pos:] if pos >= 0 else reversed(lines):
+            stamp = self.__stamp(line)
+            if stamp is not None:
+                return stamp
+        return None
+
+    def __first(self, path):
+        """No row of a file is earlier than this, in milliseconds:
+        the time on its first line, or on its first binary record."""
+        try:
+            binary = BinaryStats.open(path)
+            if binary is not None:
+                for run in binary.runs(millis=True, limit=1):
+                    return run[0][0]
+                return 0
+            if path.endswith("gz"):
+                fp = gzip.open(path, 'rb')
+            else:
+                fp = io.open(path, 'rb')
+            with fp:
+                for _ in range(10):
+                    stamp = self.__stamp(fp.readline().decode("ascii",
+                                                              "replace"))
+                    if stamp is not None:
+                        return int(stamp * 1000)
+        except (IOError, OSError, ValueError, zlib.error):
+            pass
+        return 0        # can't tell, so open it first
+
+    def __part(self, path):
+        "Non-empty runs of rows of one file, in file order."
+        try:
+            binary = BinaryStats.open(path)
+        except ValueError as e:
+            sys.stderr.write("ntpviz: WARNING: %s: %s\n" % (path, e))
+            return
+        try:
+            if binary is not None:
+                for run in binary.runs(self.starttime, self.endtime,
+                                       binary.lfptoa, True):
+                    if run:
+                        yield run
+                return
+            for lines in self.__chunks(path):
+                # whole chunks before the window are passed over
+                # unparsed; past it, the rest of the file is too
+                last = self.__lines(lines, -1)
+                if last is not None and last < self.starttime:
+                    continue
+                first = self.__lines(lines, 0)
+                if first is not None and first > self.endtime:
+                    return
+                if isinstance(self.value, str):
+                    # only lines that could match are worth parsing
+                    lines = [line for line in lines if self.value in line]
+                run = self.__rows(lines)
+                if run:
+                    yield run
+                if last is not None and last > self.endtime:
+                    return
+        except IOError:  # pragma: no cover
+            sys.stderr.write("ntpviz: WARNING: could not read %s\n" % path)
+
+    def runs(self):
+        """Generate the rows in time order, a list at a time.  Parts
+        are merged a run at a time while they don't overlap, which for
+        the usual daily files is always, and a row at a time where
+        they do."""
+        # Parts wait, unopened, until the merge reaches the earliest
+        # time they could hold, so few are open at once.
+        waiting = []
+        for i, path in enumerate(self.parts):
+            waiting.append((self.__first(path), i, path))
+        waiting.sort(reverse=True)
+        heap = []
+        while heap or waiting:
+            while waiting and (not heap or waiting[-1][0] <= heap[0][0]):
+                (_, i, path) = waiting.pop()
+                gen = self.__part(path)
+                run = next(gen, None)
+                if run is not None:
+                    heapq.heappush(heap, (run[0][0], i, run, gen))
+            if not heap:
+                continue
+            (_, i, run, gen) = heap[0]
+            limit = [entry[0] for entry in heap[1:3]]
+            if waiting:
+                limit.append(waiting[-1][0])
+            limit = min(limit) if limit else None
+            if limit is None or run[-1][0] <= limit:
+                out = run
+                run = next(gen, None)
+            else:
+                # the rows up to where the next run starts
+                lo, hi = 1, len(run)
+                while lo < hi:
+                    mid = (lo + hi) // 2
+                    if run[mid][0] <= limit:
+                        lo = mid + 1
+                    else:
+                        hi = mid
+                out = run[:lo]
+                run = run[lo:]
+            if run is None:
+                heapq.heappop(heap)
+            else:
+                heapq.heapreplace(heap, (run[0][0], i, run, gen))
+            if self.column is not None:
+                column, value = self.column, self.value
+                out = [row for row in out
+                       if column < len(row) and row[column] == value]
+            if out:
+                yield out
+
+    def __iter__(self):
+        for run in self.runs():
+            for row in run:
+                yield row
+
+    def __bool__(self):
+        for _ in self:
+            return True
+        return False
+
+    __nonzero__ = __bool__      # Python 2
+
+
+class StatColumns:
+    """Numeric fields of a set of rows, a column each, with the Unix
+    time of each row in times.  Values are doubles in arrays, NaN
+    where a row had no number, and are read in one pass so every plot
+    of a stem can share them.  numpy is used when it is installed."""
+    GAP = 2200      # seconds between rows that break a plot line
+
+    def __init__(self, fields):
+        self.times = array.array('d')
+        self.cols = dict((field, array.array('d')) for field in fields)
+        self.__memo = {}
+
+    @staticmethod
+    def read(rows, fields, split=None):
+        """Columns of the given fields of rows, a list or StatStream.
+        With split, a dictionary of them by the value of that field."""
+        runs = rows.runs() if isinstance(rows, StatStream) else [rows]
+        if split is None:
+            columns = StatColumns(fields)
+            for run in runs:
+                columns.__extend(run)
+            return columns
+        columns = {}
+        for run in runs:
+            groups = {}
+            for row in run:
+                if split < len(row):
+                    groups.setdefault(row[split], []).append(row)
+            for (key, group) in groups.items():
+                if key not in columns:
+                    columns[key] = StatColumns(fields)
+                columns[key].__extend(group)
+        return columns
+
+    def __extend(self, run):
+        # HOT LOOP!  A column at a time, row by row only if one is bad
+        self.times.extend([float(row[1]) for row in run])
+        for (field, col) in self.cols.items():
+            try:
+                col.extend([float(row[field]) for row in run])
+            except (ValueError, IndexError, TypeError):
+                for row in run:
+                    try:
+                        col.append(float(row[field]))
+                    except (ValueError, IndexError, TypeError):
+                        col.append(float('nan'))
+
+    def __len__(self):
+        return len(self.times)
+
+    def memo(self, key, make):
+        "What make() returns, worked out the first time key is asked."
+        if key not in self.__memo:
+            self.__memo[key] = make()
+        return self.__memo[key]
+
+    def select(self, *fields):
+        """(times, columns) of the rows with numbers in all the given
+        fields, as arrays, or numpy arrays when numpy is there."""
+        return self.memo(("select",) + fields,
+                         lambda: self.__select(fields))
+
+    def __select(self, fields):
+        if numpy is not None:
+            times = numpy.frombuffer(self.times, dtype=float)
+            cols = [numpy.frombuffer(self.cols[f], dtype=float)
+                    for f in fields]
+            if not len(times):
+                return (times, cols)
+            keep = ~numpy.isnan(cols[0])
+            for col in cols[1:]:
+                keep &= ~numpy.isnan(col)
+            if keep.all():
+                return (times, cols)
+            return (times[keep], [col[keep] for col in cols])
+        cols = [self.cols[f] for f in fields]
+        keep = range(len(self.times))
+        for col in cols:
+            keep = [i for i in keep if col[i] == col[i]]    # not NaN
+        if len(keep) == len(self.times):
+            return (self.times, cols)
+        return (array.array('d', [self.times[i] for i in keep]),
+                [array.array('d', [col[i] for i in keep]) for col in cols])
+
+    def sorted(self, field, fields=None):
+        """The values of field in the rows select() picks for fields,
+        by default just field, in ascending order."""
+        fields = fields or (field,)
+
+        def make():
+            values = self.select(*fields)[1][fields.index(field)]
+            if numpy is not None:
+                return numpy.sort(values)
+            return array.array('d', sorted(values))
+        return self.memo(("sorted", field) + fields, make)
+
+    def plot(self, *fields):
+        """gnuplot inline data: time and the given fields, for rows
+        with numbers in all of them, broken where rows are far apart."""
+        (times, cols) = self.select(*fields)
+        if numpy is not None:
+            gaps = numpy.flatnonzero(numpy.diff(times, prepend=0.0) >
+                                     self.GAP).tolist()
+        else:
+            last = 0.0
+            gaps = []
+            for (i, when) in enumerate(times):
+                if self.GAP < when - last:
+                    gaps.append(i)
+                last = when
+        # milliseconds and nine digits are all a plot can show
+        line = " ".join(["%.3f"] + ["%.9g"] * len(cols)) + "\n"
+        gaps.append(len(times))
+        parts = []
+        start = 0
+        for gap in gaps:
+            # a bounded number of rows at a time, to spare memory
+            text = []
+            for lo in range(start, gap, 65536):
+                hi = min(gap, lo + 65536)
+                if numpy is not None:
+                    rows = zip(times[lo:hi].tolist(),
+                               *[col[lo:hi].tolist() for col in cols])
+                else:
+                    rows = zip(times[lo:hi], *[col[lo:hi] for col in cols])
+                text.append("".join(map(line.__mod__, rows)))
+            parts.append("".join(text))
+            start = gap
+        return "\n".join(parts) + "e\n"
+
+
+class NTPStats:
+    "Gather statistics for a specified NTP site"
+    SecondsInDay = 24*60*60
+    DefaultPeriod = 7*24*60*60  # default 7 days, 604800 secs
+    peermap = {}    # cached result of peersplit()
+    period = None
+    starttime = None
+    endtime = None
+    sitename = ''
+
+    @staticmethod
+    def unixize(lines, starttime, endtime):
+        """Extract first two fields, MJD and seconds past midnight.
+        convert timestamp (MJD & seconds past midnight) to Unix time
+        Replace MJD+second with Unix time."""
+        # HOT LOOP!  Do not change w/o profiling before and after
+        lines1 = []
+        for line in lines:
+            try:
+                split = line.split()
+                mjd = int(split[0])
+                second = float(split[1])
+            except ValueError:
+                # unparseable, skip this line
+                continue
+
+            # warning: 32 bit overflows
+            time = NTPStats.SecondsInDay * mjd + second - 3506716800
+            if starttime <= time <= endtime:
+                # time as integer number milli seconds
+                split[0] = int(time * 1000)
+                # time as string
+                split[1] = str(time)
+                lines1.append(split)
+        return lines1
+
+    @staticmethod
+    def unixtimed(lines, starttime, endtime):
+        """Split lines that already start with Unix time, as temps and
+        gpsd do, and prefix the ones from starttime to endtime with
+        the time in milliseconds."""
+        lines1 = []
+        for line in lines:
+            split = line.split()
+            if 3 > len(split):
+                # skip short lines
+                continue
+
+            try:
+                time_float = float(split[0])
+            except ValueError:
+                # ignore comment lines, lines with no time
+                continue
+
+            if starttime <= time_float <= endtime:
+                # prefix with int milli sec.
+                split.insert(0, int(time_float * 1000))
+                lines1.append(split)
+        return lines1
+
+    @staticmethod
+    def timestamp(line):
+        "get Unix time from converted line."
+        return float(line.split()[0])
+
+    @staticmethod
+    def percentiles(percents, values):
+        """Return given percentiles of a given row in a given set of entries.
+        assuming values are already split and sorted"""
+        ret = {}
+        length = len(values)
+        if 1 >= length:
+            # uh, oh...
+            if 1 == length:
+                # just one data value, set all to that one value
+                value = values[0]
+            else:
+                # no data, set all to zero
+                value = 0
+            for perc in percents:
+                ret["p" + str(perc)] = value
+        else:
+            for perc in percents:
+                if perc == 100:
+                    ret["p100"] = values[length - 1]
+                else:
+                    ret["p" + str(perc)] = values[int(length * (perc/100))]
+        return ret
+
+    @staticmethod
+    def ip_label(key):
+        "Produce appropriate label for an IP address."
+        # If it's a new-style NTPsep clock label, pass it through,
+        # Otherwise we expect it to be an IP address and the next guard fires
+        if key[0].isdigit():
+            # TO BE REMOVED SOMEDAY
+            # Clock address - only possible if we're looking at a logfile made
+            # by NTP Classic or an NTPsec version configured with
+            # --enable-classic-mode.  Nasty that we have to emit a numeric
+            # driver type here.
+            if key.startswith("127.127."):
+                (_, _, clock_type, unit) = key.split(".")
+                return "REFCLOCK(type=%s,unit=%s)" % (clock_type, unit)
+            # Ordinary IP address - replace with primary hostname.
+            # Punt if the lookup fails.
+            try:
+                (hostname, _, _) = socket.gethostbyaddr(key)
+                return hostname
+            except socket.herror:
+                pass
+        return key      # Someday, be smarter than this.
+
+    def __init__(self, statsdir, sitename=None,
+                 period=None, starttime=None, endtime=None,
+                 streaming=False):
+        """Grab content of logfiles, sorted by timestamp.  With
+        streaming, each stem is a StatStream that reads the files only
+        as it is iterated, instead of a list of everything in them."""
+        if period is None:
+            period = NTPStats.DefaultPeriod
+        self.period = period
+
+        # Default to one week before the latest date
+        if endtime is None and starttime is None:
+            endtime = int(time.time())
+            starttime = endtime - period
+        elif starttime is None and endtime is not None:
+            starttime = endtime - period
+        elif starttime is not None and endtime is None:
+            endtime = starttime + period
+        self.starttime = starttime
+        self.endtime = endtime
+
+        self.sitename = sitename or os.path.basename(statsdir)
+        if 'ntpstats' == self.sitename:
+            # boring, use hostname
+            self.sitename = socket.getfqdn()
+
+        if not os.path.isdir(statsdir):  # pragma: no cover
+            sys.stderr.write("ntpviz: ERROR: %s is not a directory\n"
+                             % statsdir)
+            raise SystemExit(1)
+
+        self.streaming = streaming
+        if streaming:
+            for stem in ("clockstats", "peerstats", "loopstats",
+                         "rawstats", "temps", "gpsd"):
+                setattr(self, stem, self.__stream_stem(statsdir, stem))
+            return
+
+        self.binary = {}    # rows from binary files, by stem
+        self.clockstats = []
+        self.peerstats = []
+        self.loopstats = []
+        self.rawstats = []
+        self.temps = []
+        self.gpsd = []
+
+        # Loading makes millions of small lists and no garbage, so
+        # the collector only slows it down.
+        collecting = gc.isenabled()
+        gc.disable()
+        try:
+            for stem in ("clockstats", "peerstats", "loopstats",
+                         "rawstats", "temps", "gpsd"):
+                lines = self.__load_stem(statsdir, stem)
+                processed = self.__process_stem(stem, lines)
+                setattr(self, stem, processed)
+        finally:
+            if collecting:
+                gc.enable()
+
+    def __parts(self, statsdir, stem):
+        "The files of a stem that may hold records in the window."
+        pattern = os.path.join(statsdir, stem)
+        if stem != "temps" and stem != "gpsd":
+            pattern += "."
+        parts = []
+        for logpart in glob.glob(pattern + "*"):
+            try:
+                # skip files older than starttime
+                if self.starttime > os.path.getmtime(logpart):
+                    continue
+            except OSError:  # pragma: no cover
+                continue
+            parts.append(logpart)
+        return parts
+
+    def __stream_stem(self, statsdir, stem):
+        return StatStream(self.__parts(statsdir, stem),
+                          self.starttime, self.endtime,
+                          unix=(stem == "temps" or stem == "gpsd"))
+
+    def __split(self, rows):
+        """Map the values of field 2 of rows to the rows with each.
+        Streams are split into streams, with one pass to find the
+        values, and lists into lists."""
+        splitmap = {}
+        if isinstance(rows, StatStream):
+            for row in rows:
+                if 2 < len(row) and row[2] not in splitmap:
+                    splitmap[row[2]] = rows.where(2, row[2])
+            return splitmap
+        for row in rows:
+            try:
+                key = row[2]
+                if key not in splitmap:
+                    splitmap[key] = []
+                splitmap[key].append(row)
+            except IndexError:  # pragma: no cover
+                # ignore corrupted rows
+                pass
+        return splitmap
+
+    def __load_stem(self, statsdir, stem):
+        lines = []
+        try:
+            pattern = os.path.join(statsdir, stem)
+            if stem != "temps" and stem != "gpsd":
+                pattern += "."
+            for logpart in glob.glob(pattern + "*"):
+                # skip files older than starttime
+                if self.starttime > os.path.getmtime(logpart):
+                    continue
+                try:
+                    binary = BinaryStats.open(logpart)
+                except ValueError as e:
+                    sys.stderr.write("ntpviz: WARNING: %s: %s\n"
+                                     % (logpart, e))
+                    continue
+                if binary is not None:
+                    self.binary.setdefault(stem, []).extend(
+                        binary.unixized(self.starttime, self.endtime))
+                    continue
+                if logpart.endswith("gz"):
+                    lines += gzip.open(logpart, 'rt').readlines()
+                else:
+                    lines += open(logpart, 'r').readlines()
+        except IOError:  # pragma: no cover
+            sys.stderr.write("ntpviz: WARNING: could not read %s\n"
+                             % logpart)
+
+        return lines
+
+    def __process_stem(self, stem, lines):
+        if stem == "temps" or stem == "gpsd":
+            # temps and gpsd are already in UNIX time
+            lines1 = NTPStats.unixtimed(lines, self.starttime, self.endtime)
+        else:
+            # Morph first fields into Unix time with fractional seconds
+            # ut into nice dictionary of dictionary rows
+            lines1 = NTPStats.unixize(lines, self.starttime, self.endtime)
+            lines1 += self.binary.pop(stem, [])
+
+        # Sort by datestamp
+        # by default, a tuple sort()s on the 1st item, which is a nice
+        # integer of milli seconds.  This is faster than using
+        # cmp= or key=
+        lines1.sort()
+        return lines1
+
+    def peersplit(self):
+        """Return a dictionary mapping peerstats IPs to entry subsets.
+        This is very expensive, so cache the result"""
+        if not self.peermap:
+            # peerstats field 2, refclock id
+            self.peermap.update(self.__split(self.peerstats))
+        return self.peermap
+
+    def gpssplit(self):
+        "Return a dictionary mapping gps sources to entry subsets."
+        return self.__split(self.gpsd)
+
+    def tempssplit(self):
+        "Return a dictionary mapping temperature sources to entry subsets."
+        return self.__split(self.temps)
+
+
+def iso_to_posix(time_string):
+    "Accept timestamps in ISO 8661 format or numeric POSIX time. UTC only."
+    if str(time_string).isdigit():
+        return int(time_string)
+    time_struct = time.strptime(time_string, "%Y-%m-%dT%H:%M:%S")
+    # don't use time.mktime() as that is local tz
+    return calendar.timegm(time_struct)
+
+
+def posix_to_iso(unix_time):
+    "ISO 8601 string in UTC from Unix time."
+    return time.strftime("%Y-%m-%dT%H:%M:%S", time.gmtime(unix_time))
+
+# end
@@ -0,0 +1,85 @@
+# -*- coding: utf-8 -*-
+
+import unittest
+import ntp.shmstats
+import os
+import struct
+import tempfile
+
+
+class TestShmStats(unittest.TestCase):
+    target = ntp.shmstats
+
+    def build(self, seq=2, sys_fields=None, peers=(), slots=4):
+        "A segment as ntpd would lay it out, optionally an older one."
+        m = self.target
+        if sys_fields is None:
+            sys_fields = m.SYS_FIELDS
+        sysfmt = "=" + "".join(code for (_, code) in sys_fields)
+        peerfmt = "=" + "".join(code for (_, code) in m.PEER_FIELDS)
+        sys_size = struct.calcsize(sysfmt)
+        peer_size = struct.calcsize(peerfmt)
+        data = m.HEAD.pack(m.SHMSTATS_MAGIC, m.SHMSTATS_VERSION, 64,
+                           sys_size, peer_size, slots, seq, len(peers),
+                           1700000000)
+        data += b"\0" * (64 - len(data))
+        values = []
+        for (name, code) in sys_fields:
+            values.append(-0.25 if code == "d" else len(values))
+        data += struct.pack(sysfmt, *values)
+        for (address, assoc) in peers:
+            values = [address, b"example.org"]
+            for (_, code) in m.PEER_FIELDS[2:]:
+                values.append(0.5 if code == "d" else assoc)
+            data += struct.pack(peerfmt, *values)
+        data += b"\0" * (peer_size * (slots - len(peers)))
+        fd, path = tempfile.mkstemp()
+        os.write(fd, data)
+        os.close(fd)
+        self.addCleanup(os.remove, path)
+        return path
+
+    def test_read(self):
+        path = self.build(peers=[(b"192.0.2.1", 7), (b"2001:db8::1", 8)])
+        stats = self.target.ShmStats(path=path)
+        (system, peers) = stats.read()
+        stats.close()
+        self.assertEqual(stats.time, 1700000000)
+        self.assertEqual(system["uptime"], 0)
+        self.assertEqual(system["stratum"], 1)
+        self.assertEqual(system["rootdelay"], -0.25)
+        self.assertEqual(system["nts_ke_probes_bad"],
+                         len(self.target.SYS_FIELDS) - 1)
+        self.assertEqual(len(peers), 2)
+        self.assertEqual(peers[1]["address"], "2001:db8::1")
+        self.assertEqual(peers[1]["name"], "example.org")
+        self.assertEqual(peers[1]["assoc"], 8)
+        self.assertEqual(peers[0]["offset"], 0.5)
+
+    def test_older_writer(self):
+        "Fields the writer doesn't have are left out."
+        path = self.build(sys_fields=self.target.SYS_FIELDS[:3])
+        stats = self.target.ShmStats(path=path)
+        (system, peers) = stats.read()
+        stats.close()
+        self.assertEqual(sorted(system), ["leap", "stratum", "uptime"])
+        self.assertEqual(peers, [])
+
+    def test_mid_update(self):
+        path = self.build(seq=3)
+        stats = self.target.ShmStats(path=path)
+        stats.WAIT = 0.01
+        self.assertRaises(self.target.ShmStatsError, stats.read)
+        stats.close()
+
+    def test_not_a_segment(self):
+        fd, path = tempfile.mkstemp()
+        os.write(fd, b"\0" * 128)
+        os.close(fd)
+        self.addCleanup(os.remove, path)
+        self.assertRaises(self.target.ShmStatsError,
+                          self.target.ShmStats, path=path)
+
+
+if __name__ == '__main__':
+    unittest.main()
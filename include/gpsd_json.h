@@ -0,0 +1,307 @@
+/*
+ * gpsd_json.h - single-pass scanner for the gpsd refclock's JSON records
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * GPSD sends one JSON object per line, and the driver reads a handful
+ * of top-level members out of each.  Rather than tokenize the whole
+ * line and then search the tokens for every member wanted, this walks
+ * the line once against a fixed table of the members the driver knows.
+ * A wanted member's value is NUL-terminated in place and remembered by
+ * pointer; anything else, including the big nested arrays in SKY
+ * records, is stepped over without being looked at closely.
+ *
+ * Strings are left escaped, as they were with jsmn.  The first
+ * occurrence of a member wins.  Values of members we don't want are
+ * only skipped, not checked, so a record that is bad in those places
+ * may still be accepted.
+ */
+#ifndef GUARD_GPSD_JSON_H
+#define GUARD_GPSD_JSON_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * The members the driver uses, from all the record classes it reads.
+ * Keep these in alphabetical order; gpsd_json_lookup() relies on it.
+ */
+enum gpsd_json_key {
+	GJ_CLASS,
+	GJ_CLOCK_MUSEC,		/* PPS, before protocol 3.9 */
+	GJ_CLOCK_NSEC,		/* PPS and TOFF */
+	GJ_CLOCK_SEC,
+	GJ_DEVICE,		/* WATCH */
+	GJ_ENABLE,
+	GJ_EPT,			/* TPV */
+	GJ_JSON,		/* WATCH */
+	GJ_MODE,		/* TPV */
+	GJ_PRECISION,		/* PPS */
+	GJ_PROTO_MAJOR,		/* VERSION */
+	GJ_PROTO_MINOR,
+	GJ_REAL_MUSEC,		/* PPS and TOFF */
+	GJ_REAL_NSEC,
+	GJ_REAL_SEC,
+	GJ_RELEASE,		/* VERSION */
+	GJ_REV,
+	GJ_TIME,		/* TPV */
+	GJ_NKEYS
+};
+
+/* what a wanted member turned out to be */
+enum gpsd_json_type {
+	GJT_NONE = 0,		/* not in the record */
+	GJT_STRING,
+	GJT_PRIMITIVE,		/* number, true, false or null */
+	GJT_COMPOUND		/* object or array, value not kept */
+};
+
+struct gpsd_json {
+	const char *	val[GJ_NKEYS];	/* NUL-terminated, in the line */
+	uint8_t		type[GJ_NKEYS];
+};
+
+#define GJ_KEY(k, s)	[k] = { s, sizeof(s) - 1 }
+
+static const struct gpsd_json_schema {
+	const char *	name;
+	size_t		len;
+} gpsd_json_schema[GJ_NKEYS] = {
+	GJ_KEY(GJ_CLASS,	"class"),
+	GJ_KEY(GJ_CLOCK_MUSEC,	"clock_musec"),
+	GJ_KEY(GJ_CLOCK_NSEC,	"clock_nsec"),
+	GJ_KEY(GJ_CLOCK_SEC,	"clock_sec"),
+	GJ_KEY(GJ_DEVICE,	"device"),
+	GJ_KEY(GJ_ENABLE,	"enable"),
+	GJ_KEY(GJ_EPT,		"ept"),
+	GJ_KEY(GJ_JSON,		"json"),
+	GJ_KEY(GJ_MODE,		"mode"),
+	GJ_KEY(GJ_PRECISION,	"precision"),
+	GJ_KEY(GJ_PROTO_MAJOR,	"proto_major"),
+	GJ_KEY(GJ_PROTO_MINOR,	"proto_minor"),
+	GJ_KEY(GJ_REAL_MUSEC,	"real_musec"),
+	GJ_KEY(GJ_REAL_NSEC,	"real_nsec"),
+	GJ_KEY(GJ_REAL_SEC,	"real_sec"),
+	GJ_KEY(GJ_RELEASE,	"release"),
+	GJ_KEY(GJ_REV,		"rev"),
+	GJ_KEY(GJ_TIME,		"time"),
+};
+
+#undef GJ_KEY
+
+/*
+ * Character classes for the inner loops, so each byte costs one load
+ * and one test.  NUL is in all of them.
+ */
+#define GJC_SPACE	0x01	/* JSON whitespace */
+#define GJC_BARE	0x02	/* ends a number, true, false or null */
+#define GJC_QUOTED	0x04	/* ends a run of string characters */
+#define GJC_NEST	0x08	/* matters when skipping a compound */
+
+static const uint8_t gpsd_json_cclass[256] = {
+	['\0'] = GJC_BARE | GJC_QUOTED | GJC_NEST,
+	[' ']  = GJC_SPACE | GJC_BARE,
+	['\t'] = GJC_SPACE | GJC_BARE,
+	['\r'] = GJC_SPACE | GJC_BARE,
+	['\n'] = GJC_SPACE | GJC_BARE,
+	[',']  = GJC_BARE,
+	['}']  = GJC_BARE | GJC_NEST,
+	[']']  = GJC_BARE | GJC_NEST,
+	['{']  = GJC_NEST,
+	['[']  = GJC_NEST,
+	['"']  = GJC_QUOTED | GJC_NEST,
+	['\\'] = GJC_QUOTED,
+};
+
+#define GJC_IS(cp, c)	(gpsd_json_cclass[(unsigned char)*(cp)] & (c))
+
+/* JSON whitespace; GPSD sends none, but be polite */
+static char *
+gpsd_json_space(
+	char *	cp
+	)
+{
+	while (GJC_IS(cp, GJC_SPACE))
+		cp++;
+	return cp;
+}
+
+/* cp is just past an opening quote; return the closing one */
+static char *
+gpsd_json_string(
+	char *	cp
+	)
+{
+	for (;;) {
+		while (!GJC_IS(cp, GJC_QUOTED))
+			cp++;
+		if ('"' == *cp)
+			return cp;
+		if ('\0' == *cp || '\0' == cp[1])
+			return NULL;
+		cp += 2;	/* backslash and what it escapes */
+	}
+}
+
+/* cp is at a bare value; return the character after it */
+static char *
+gpsd_json_bare(
+	char *	cp
+	)
+{
+	while (!GJC_IS(cp, GJC_BARE))
+		cp++;
+	return cp;
+}
+
+/* step over the value at cp, returning what follows it */
+static char *
+gpsd_json_skip(
+	char *	cp
+	)
+{
+	int	depth = 0;
+
+	if ('"' == *cp) {
+		cp = gpsd_json_string(cp + 1);
+		return (NULL != cp) ? cp + 1 : NULL;
+	}
+	if ('{' != *cp && '[' != *cp)
+		return gpsd_json_bare(cp);
+	for (;;) {
+		while (!GJC_IS(cp, GJC_NEST))
+			cp++;
+		switch (*cp++) {
+		case '"':
+			cp = gpsd_json_string(cp);
+			if (NULL == cp)
+				return NULL;
+			cp++;
+			break;
+		case '{':
+		case '[':
+			depth++;
+			break;
+		case '}':
+		case ']':
+			if (0 == --depth)
+				return cp;
+			break;
+		default:	/* ran off the end */
+			return NULL;
+		}
+	}
+}
+
+/*
+ * Most members of a TPV or SKY record are of no interest, so go
+ * straight to the few names with the same initial letter.
+ */
+static int
+gpsd_json_lookup(
+	const char *	key,
+	size_t		len
+	)
+{
+	int	i, end;
+
+	switch (key[0]) {
+	case 'c': i = GJ_CLASS;		end = GJ_DEVICE;	break;
+	case 'd': i = GJ_DEVICE;	end = GJ_ENABLE;	break;
+	case 'e': i = GJ_ENABLE;	end = GJ_JSON;		break;
+	case 'j': i = GJ_JSON;		end = GJ_MODE;		break;
+	case 'm': i = GJ_MODE;		end = GJ_PRECISION;	break;
+	case 'p': i = GJ_PRECISION;	end = GJ_REAL_MUSEC;	break;
+	case 'r': i = GJ_REAL_MUSEC;	end = GJ_TIME;		break;
+	case 't': i = GJ_TIME;		end = GJ_NKEYS;		break;
+	default:  return -1;
+	}
+	for (; i < end; i++)
+		if (gpsd_json_schema[i].len == len &&
+		    !memcmp(gpsd_json_schema[i].name, key, len))
+			return i;
+	return -1;
+}
+
+/*
+ * gpsd_json_scan - pick the wanted members out of one record
+ *
+ * line must be NUL-terminated and is modified.  Returns false unless
+ * it holds a single well-formed object at the top level.
+ */
+static bool
+gpsd_json_scan(
+	struct gpsd_json *	ctx,
+	char *			line
+	)
+{
+	char *	cp, * key, * val;
+	char	ch;
+	int	idx;
+
+	memset(ctx->type, GJT_NONE, sizeof(ctx->type));
+	cp = gpsd_json_space(line);
+	if ('{' != *cp)
+		return false;
+	cp = gpsd_json_space(cp + 1);
+	if ('}' == *cp)
+		return true;
+
+	for (;;) {
+		if ('"' != *cp)
+			return false;
+		key = cp + 1;
+		cp = gpsd_json_string(key);
+		if (NULL == cp)
+			return false;
+		idx = gpsd_json_lookup(key, (size_t)(cp - key));
+		cp = gpsd_json_space(cp + 1);
+		if (':' != *cp)
+			return false;
+		cp = gpsd_json_space(cp + 1);
+
+		if (idx < 0 || GJT_NONE != ctx->type[idx]) {
+			cp = gpsd_json_skip(cp);
+			if (NULL == cp)
+				return false;
+			ch = *(cp = gpsd_json_space(cp));
+		} else if ('"' == *cp) {
+			val = cp + 1;
+			cp = gpsd_json_string(val);
+			if (NULL == cp)
+				return false;
+			*cp = '\0';
+			ctx->val[idx] = val;
+			ctx->type[idx] = GJT_STRING;
+			ch = *(cp = gpsd_json_space(cp + 1));
+		} else if ('{' == *cp || '[' == *cp) {
+			cp = gpsd_json_skip(cp);
+			if (NULL == cp)
+				return false;
+			ctx->val[idx] = NULL;
+			ctx->type[idx] = GJT_COMPOUND;
+			ch = *(cp = gpsd_json_space(cp));
+		} else {
+			/* terminating a bare value eats its delimiter */
+			val = cp;
+			cp = gpsd_json_bare(cp);
+			if (cp == val)
+				return false;
+			ch = *cp;
+			*cp = '\0';
+			ctx->val[idx] = val;
+			ctx->type[idx] = GJT_PRIMITIVE;
+			if (GJC_IS(&ch, GJC_SPACE))
+				ch = *(cp = gpsd_json_space(cp + 1));
+		}
+
+		if ('}' == ch)
+			return true;
+		if (',' != ch)
+			return false;
+		cp = gpsd_json_space(cp + 1);
+	}
+}
+
+#endif /* GUARD_GPSD_JSON_H */
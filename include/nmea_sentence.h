@@ -0,0 +1,430 @@
+/*
+ * nmea_sentence.h - one-pass splitting of NMEA 0183 sentences
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * The NMEA driver used to walk each sentence once to check it, then
+ * walk it again from the front for every field it wanted, and hand
+ * the time and date fields to sscanf().  Here one pass over the
+ * sentence finds every field separator and the checksum, after which
+ * any field is an array index away.  The checksum itself is an XOR
+ * over the body, done a word at a time.  Sentence names are looked
+ * up in a table, and a second table says where each sentence keeps
+ * its time, date and status, so the driver needs no per-sentence
+ * code for those.
+ */
+#ifndef GUARD_NMEA_SENTENCE_H
+#define GUARD_NMEA_SENTENCE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#define NMEA_PROTO_IDLEN	5	/* tag name must be at least 5 chars */
+#define NMEA_PROTO_MAXLEN	80	/* max chars in sentence, excluding CS */
+#define NMEA_PROTO_FIELDS	32	/* not official; limit on fields per record */
+
+/* NMEA sentence array indexes for those we use */
+#define NMEA_GPRMC	0	/* recommended min. nav. */
+#define NMEA_GPGGA	1	/* fix and quality */
+#define NMEA_GPGLL	2	/* geo. lat/long */
+#define NMEA_GPZDA	3	/* date/time */
+/*
+ * $GPZDG is a proprietary sentence that violates the spec, by not
+ * using $P and an assigned company identifier to prefix the sentence
+ * identifier.	When used with this driver, the system needs to be
+ * isolated from other NTP networks, as it operates in GPS time, not
+ * UTC as is much more common.	GPS time is >15 seconds different from
+ * UTC due to not respecting leap seconds since 1970 or so.  Other
+ * than the different timebase, $GPZDG is similar to $GPZDA.
+ */
+#define NMEA_GPZDG	4
+#define NMEA_PGRMF	5
+#define NMEA_ARRAY_SIZE (NMEA_PGRMF + 1)
+
+/* date formats we support */
+enum date_fmt {
+	DATE_NONE,	/* no date in the sentence */
+	DATE_1_DDMMYY,	/* use 1 field	with 2-digit year */
+	DATE_3_DDMMYYYY	/* use 3 fields with 4-digit year */
+};
+
+/* results for 'nmea_scan()'
+ *
+ * Note: If a checksum is present, the checksum test must pass OK or the
+ * sentence is tagged invalid.
+ */
+#define CHECK_EMPTY  -1	/* no data			*/
+#define CHECK_INVALID 0	/* not a valid NMEA sentence	*/
+#define CHECK_VALID   1	/* valid but without checksum	*/
+#define CHECK_CSVALID 2	/* valid with checksum OK	*/
+
+/*
+ * A split sentence.  Fields stay in the buffer, separated by their
+ * commas as before, so a field pointer also reaches the fields after
+ * it and the sentence can still be logged as it came.
+ */
+typedef struct {
+	char *	base;		/* sentence, after the '$' */
+	int	blen;		/* its length */
+	int	nfields;	/* fields found, counting the name */
+	char *	field[NMEA_PROTO_FIELDS + 1];
+} nmea_data;
+
+/*
+ * Where each sentence we use keeps what we want from it, indexed by
+ * the NMEA_* sentence numbers.  Field 0 is the name.  wipe lists the
+ * position fields, and is ended by -1, which also stands for the
+ * checksum.
+ */
+static const struct nmea_layout {
+	int8_t		time;		/* HHMMSS[.sss] */
+	int8_t		date;		/* first date field */
+	uint8_t		datefmt;	/* enum date_fmt */
+	int8_t		qual;		/* status field, -1 for none */
+	char		tag;		/* status value meaning good... */
+	bool		inv;		/* ...or meaning bad */
+	bool		wnro;		/* date is subject to week rollover */
+	int8_t		wipe[5];
+} nmea_layout[NMEA_ARRAY_SIZE] = {
+	[NMEA_GPRMC] = { 1, 9, DATE_1_DDMMYY,    2, 'A', false, true,
+			 { 3, 4, 5, 6, -1 } },
+	[NMEA_GPGGA] = { 1, -1, DATE_NONE,       6, '0', true,  false,
+			 { 2, 4, -1 } },
+	[NMEA_GPGLL] = { 5, -1, DATE_NONE,       6, 'A', false, false,
+			 { 1, 3, -1 } },
+	[NMEA_GPZDA] = { 1, 2, DATE_3_DDMMYYYY, -1, 0,   false, true,
+			 { -1 } },
+	[NMEA_GPZDG] = { 1, 2, DATE_3_DDMMYYYY,  4, '0', true,  true,
+			 { -1 } },
+	[NMEA_PGRMF] = { 4, 3, DATE_1_DDMMYY,   11, '0', true,  false,
+			 { 6, 8, -1 } },
+};
+
+/*
+ * Sentence names are five characters.  Standard ones are a two-letter
+ * talker ID, which we ignore so $GLGGA and $GNGGA work as well as
+ * $GPGGA, and a three-letter type.  Proprietary ones have to match in
+ * full.
+ */
+static const struct nmea_tag {
+	char		talker[3];	/* "" for any */
+	char		type[4];
+	uint8_t		sentence;
+} nmea_tags[] = {
+	{ "",   "RMC", NMEA_GPRMC },
+	{ "",   "GGA", NMEA_GPGGA },
+	{ "",   "GLL", NMEA_GPGLL },
+	{ "",   "ZDA", NMEA_GPZDA },
+	{ "",   "ZDG", NMEA_GPZDG },
+	{ "PG", "RMF", NMEA_PGRMF },
+};
+
+/* Character classes, so the scan costs one load and one test a byte */
+#define NMEAC_STOP	0x01	/* ends a field: ',', '*' or NUL */
+#define NMEAC_NAME	0x02	/* may be in a sentence name */
+#define NMEAC_HEX	0x04	/* checksum digit */
+
+static const uint8_t nmea_cclass[256] = {
+	['\0'] = NMEAC_STOP, [','] = NMEAC_STOP, ['*'] = NMEAC_STOP,
+	['0'] = NMEAC_NAME | NMEAC_HEX, ['1'] = NMEAC_NAME | NMEAC_HEX,
+	['2'] = NMEAC_NAME | NMEAC_HEX, ['3'] = NMEAC_NAME | NMEAC_HEX,
+	['4'] = NMEAC_NAME | NMEAC_HEX, ['5'] = NMEAC_NAME | NMEAC_HEX,
+	['6'] = NMEAC_NAME | NMEAC_HEX, ['7'] = NMEAC_NAME | NMEAC_HEX,
+	['8'] = NMEAC_NAME | NMEAC_HEX, ['9'] = NMEAC_NAME | NMEAC_HEX,
+	['A'] = NMEAC_NAME | NMEAC_HEX, ['B'] = NMEAC_NAME | NMEAC_HEX,
+	['C'] = NMEAC_NAME | NMEAC_HEX, ['D'] = NMEAC_NAME | NMEAC_HEX,
+	['E'] = NMEAC_NAME | NMEAC_HEX, ['F'] = NMEAC_NAME | NMEAC_HEX,
+	['G'] = NMEAC_NAME, ['H'] = NMEAC_NAME, ['I'] = NMEAC_NAME,
+	['J'] = NMEAC_NAME, ['K'] = NMEAC_NAME, ['L'] = NMEAC_NAME,
+	['M'] = NMEAC_NAME, ['N'] = NMEAC_NAME, ['O'] = NMEAC_NAME,
+	['P'] = NMEAC_NAME, ['Q'] = NMEAC_NAME, ['R'] = NMEAC_NAME,
+	['S'] = NMEAC_NAME, ['T'] = NMEAC_NAME, ['U'] = NMEAC_NAME,
+	['V'] = NMEAC_NAME, ['W'] = NMEAC_NAME, ['X'] = NMEAC_NAME,
+	['Y'] = NMEAC_NAME, ['Z'] = NMEAC_NAME,
+};
+
+#define NMEAC_IS(cp, c)	(nmea_cclass[(unsigned char)*(cp)] & (c))
+
+/*
+ * 8-bit XOR of len bytes.  XOR has no carries, so XOR the buffer a
+ * word at a time and fold the word down at the end; the compiler can
+ * turn the word loop into vector instructions.
+ */
+static uint8_t
+nmea_xor(
+	const char *	cp,
+	size_t		len
+	)
+{
+	uint64_t	acc = 0, w;
+	uint8_t		cs;
+
+	for (; len >= sizeof(w); cp += sizeof(w), len -= sizeof(w)) {
+		memcpy(&w, cp, sizeof(w));
+		acc ^= w;
+	}
+	acc ^= acc >> 32;
+	acc ^= acc >> 16;
+	acc ^= acc >> 8;
+	cs = (uint8_t)acc;
+	while (len--)
+		cs ^= (uint8_t)*cp++;
+	return cs;
+}
+
+static int
+nmea_hexdigit(
+	char	c
+	)
+{
+	return (c <= '9') ? c - '0' : c - 'A' + 10;
+}
+
+/*
+ * -------------------------------------------------------------------
+ * nmea_scan - check a sentence and find its fields
+ *
+ * format is $XXXXX,1,2,3,4*ML
+ *
+ * 8-bit XOR of characters between $ and * noninclusive is transmitted
+ * in last two chars M and L holding most and least significant nibbles
+ * in hex representation such as:
+ *
+ *   $GPGLL,5057.970,N,00146.110,E,142451,A*27
+ *   $GPVTG,089.0,T,,,15.2,N,,*7F
+ *
+ * Some other constraints:
+ * + The field name must at least 5 upcase characters or digits and must
+ *   start with a character.
+ * + The checksum (if present) must be uppercase hex digits.
+ * + The length of a sentence is limited to 80 characters (not including
+ *   the final CR/LF nor the checksum, but including the leading '$')
+ *
+ * cptr must have room for a NUL at cptr[dlen].  Only the first
+ * NMEA_PROTO_FIELDS + 1 fields can be looked up; the rest read as
+ * empty.
+ *
+ * Return values:
+ *  + CHECK_EMPTY
+ *	There was nothing there.
+ *  + CHECK_INVALID
+ *	The data does not form a valid NMEA sentence or a checksum error
+ *	occurred.
+ *  + CHECK_VALID
+ *	The data is a valid NMEA sentence but contains no checksum.
+ *  + CHECK_CSVALID
+ *	The data is a valid NMEA sentence and passed the checksum test.
+ * -------------------------------------------------------------------
+ */
+static int
+nmea_scan(
+	nmea_data *	data,
+	char *		cptr,
+	int		dlen
+	)
+{
+	char *	eptr;
+	char *	cp;
+	int	n;
+
+	if (dlen < 0)
+		dlen = 0;
+	eptr = cptr + dlen;
+	*eptr = '\0';
+	data->nfields = 0;
+
+	if ('\0' == *cptr)
+		return CHECK_EMPTY;
+	if ('$' != *cptr++)
+		return CHECK_INVALID;
+	data->base = cptr;
+	data->blen = dlen - 1;
+
+	/* every field start, up to the checksum or the end */
+	data->field[0] = cptr;
+	n = 1;
+	cp = cptr;
+	for (;;) {
+		while (!NMEAC_IS(cp, NMEAC_STOP))
+			cp++;
+		if (',' != *cp)
+			break;
+		if (n <= NMEA_PROTO_FIELDS)
+			data->field[n++] = cp + 1;
+		cp++;
+	}
+	data->nfields = n;
+
+	/* field name: '[A-Z][A-Z0-9]{4,},' */
+	if (n < 2 || data->field[1] - cptr - 1 < NMEA_PROTO_IDLEN ||
+	    *cptr < 'A' || *cptr > 'Z')
+		return CHECK_INVALID;
+	for (eptr = data->field[1] - 1; cptr < eptr; cptr++)
+		if (!NMEAC_IS(cptr, NMEAC_NAME))
+			return CHECK_INVALID;
+
+	/* checksum field: (\*[0-9A-F]{2})?$ */
+	if ('\0' == *cp)
+		return CHECK_VALID;
+	if (cp != data->base + data->blen - 3 ||
+	    cp - data->base >= NMEA_PROTO_MAXLEN ||
+	    !NMEAC_IS(cp + 1, NMEAC_HEX) || !NMEAC_IS(cp + 2, NMEAC_HEX))
+		return CHECK_INVALID;
+	if (nmea_xor(data->base, (size_t)(cp - data->base)) !=
+	    (nmea_hexdigit(cp[1]) << 4 | nmea_hexdigit(cp[2])))
+		return CHECK_INVALID;
+	return CHECK_CSVALID;
+}
+
+/* fetch a field by index, zero being the name; missing ones are "" */
+static char *
+nmea_field(
+	const nmea_data *	data,
+	int			fn
+	)
+{
+	if (fn >= 0 && fn < data->nfields)
+		return data->field[fn];
+	return data->base + data->blen;
+}
+
+/* which of the sentences we use is this, or -1 */
+static int
+nmea_lookup(
+	const nmea_data *	data
+	)
+{
+	const char *	name = data->base;
+	unsigned int	i;
+
+	if (data->field[1] - name - 1 != NMEA_PROTO_IDLEN)
+		return -1;
+	for (i = 0; i < sizeof(nmea_tags) / sizeof(nmea_tags[0]); i++)
+		if (!memcmp(name + 2, nmea_tags[i].type, 3) &&
+		    ('\0' == nmea_tags[i].talker[0] ||
+		     !memcmp(name, nmea_tags[i].talker, 2)))
+			return nmea_tags[i].sentence;
+	return -1;
+}
+
+/* exactly n decimal digits */
+static bool
+nmea_digits(
+	const char *	cp,
+	int		n,
+	unsigned int *	val
+	)
+{
+	unsigned int	v = 0, d;
+
+	while (n--) {
+		d = (unsigned int)(*cp++ - '0');
+		if (d > 9)
+			return false;
+		v = v * 10 + d;
+	}
+	*val = v;
+	return true;
+}
+
+/*
+ * -------------------------------------------------------------------
+ * Parse a time stamp in HHMMSS[.sss] format with error checking.
+ * Digits of the fraction past the third are ignored.
+ *
+ * Add result to arg
+ *
+ * returns true on success, false on failure
+ * -------------------------------------------------------------------
+ */
+static bool
+nmea_parse_time(
+	struct timespec *	dt,	/* result date+time */
+	const char *		dp
+	)
+{
+	static const long weight[3] = { 100000000, 10000000, 1000000 };
+	unsigned int	h, m, s, d;
+	long		f = 0;
+	int		i;
+
+	if (!nmea_digits(dp, 2, &h) || !nmea_digits(dp + 2, 2, &m) ||
+	    !nmea_digits(dp + 4, 2, &s))
+		return false;
+	if (h > 23 || m > 59 || s > 60)
+		return false;
+	if ('.' == dp[6])
+		for (i = 0; i < 3 && nmea_digits(dp + 7 + i, 1, &d); i++)
+			f += (long)d * weight[i];
+
+	dt->tv_sec += h*3600 + m*60 + s;
+	dt->tv_nsec += f;
+	return true;
+}
+
+/*
+ * -------------------------------------------------------------------
+ * Parse a date string from an NMEA sentence. This could either be a
+ * partial date in DDMMYY format in one field, or DD,MM,YYYY full date
+ * spec spanning three fields.
+ *
+ * Add result to arg
+ *
+ * returns true on success, false on failure
+ * -------------------------------------------------------------------
+ */
+static bool
+nmea_parse_date(
+	struct timespec *	dt,	/* result pointer */
+	const char *		dp,
+	enum date_fmt		fmt
+	)
+{
+	unsigned int	y, m, d;
+	struct tm	tm;
+
+	switch (fmt) {
+
+	case DATE_1_DDMMYY:
+		if (!nmea_digits(dp, 2, &d) || !nmea_digits(dp + 2, 2, &m) ||
+		    !nmea_digits(dp + 4, 2, &y))
+			return false;
+		/* We know the time is now > 2000 but
+		 * GPS might be off by n*1024 weeks.
+		 * WNRO: Week Number Roll Over, ~20 years
+		 * Don't break that correction.
+		 *
+		 * GPS time started in 1980
+		 *   anything < 80 is from the next century.
+		 */
+		y += (y > 80) ? 1900 : 2000;
+		break;
+
+	case DATE_3_DDMMYYYY:
+		if (!nmea_digits(dp, 2, &d) || ',' != dp[2] ||
+		    !nmea_digits(dp + 3, 2, &m) || ',' != dp[5] ||
+		    !nmea_digits(dp + 6, 4, &y))
+			return false;
+		break;
+
+	case DATE_NONE:
+	default:
+		return false;
+	}
+
+	/* value sanity check */
+	if (d < 1 || d > 31 || m < 1 || m > 12)
+		return false;
+
+	/* timegm is non-Posix. */
+	memset(&tm, 0, sizeof(tm));
+	tm.tm_year = (int)y - 1900;
+	tm.tm_mon = (int)m - 1;
+	tm.tm_mday = (int)d;
+	dt->tv_sec += timegm(&tm);	/* No error checking */
+	return true;
+}
+
+#endif /* GUARD_NMEA_SENTENCE_H */
@@ -157,6 +157,8 @@ typedef struct netendpt {
 	bool	ignore_packets; /* listen-read-drop this? */
 	struct peer *	peers;		/* list of peers using endpt */
 	unsigned int	peercnt;	/* count of same */
+	struct txstamp_slot *txring;	/* sends awaiting a TX stamp */
+	uint32_t	txkey;		/* kernel id of next send */
 } endpt;
 
 /*
@@ -190,6 +192,7 @@ struct peer_ctl {
 	uint32_t	mode;	/* only used by refclocks */
 #ifdef REFCLOCK
 	uint32_t	baud;
+	uint32_t	stages;	/* median filter stages */
 	char		*path;
 	char		*ppspath;
 #endif /* REFCLOCK */
@@ -248,7 +251,10 @@ struct peer {
 	struct peer *p_link;	/* link pointer in free & peer lists */
 	struct peer *adr_link;	/* link pointer in address hash */
 	struct peer *aid_link;	/* link pointer in associd hash */
+	struct peer *name_link;	/* link pointer in hostname hash */
 	struct peer *ilink;	/* list of peers for interface */
+	struct peer *due_link;	/* link pointer in poll due list */
+	int	pollidx;	/* poll queue slot + 1, 0 if not queued */
 	struct peer_ctl cfg;	/* peer configuration block */
 	sockaddr_u srcadr;	/* address of remote host */
 	char *	hostname;	/* if non-NULL, remote name */
@@ -266,6 +272,7 @@ struct peer {
 	 */
 #ifdef REFCLOCK
 	struct refclockproc *procptr; /* refclock structure pointer */
+	struct peer *rc_link;	/* link pointer in refclock list */
 	bool	is_pps_driver;	/* is this the PPS driver? */
 	uint8_t	sstclktype;	/* clock type for system status word */
 #endif /* REFCLOCK */
@@ -306,6 +313,10 @@ struct peer {
 	l_fp	dst;		/* destination timestamp */
 	l_fp	org_ts;		/* origin real-timestamp */
 	l_fp	org_rand;	/* origin pseudo-timestamp */
+	l_fp	xl_t1;		/* org_ts of the exchange in rec/dst */
+	l_fp	xl_org;		/* interleaved request: T1 asked about */
+	l_fp	xl_rec;		/* interleaved request: T2 asked about */
+	l_fp	xl_dst;		/* interleaved request: T4, comes back in org */
 	double	offset;		/* peer clock offset */
 	double	delay;		/* peer roundtrip delay */
 	double	jitter;		/* peer jitter (squares) */
@@ -321,7 +332,8 @@ struct peer {
 #define end_clear_to_zero update
 
 	int	unreach;	/* watchdog counter */
-	int	throttle;	/* rate control */
+	int	throttle;	/* rate control, see peer_throttle() */
+	uptime_t	throttle_time;	/* when throttle was last settled */
 	uptime_t	outdate;	/* send time last packet */
 	uptime_t	nextdate;	/* send time next packet */
 
@@ -340,6 +352,7 @@ struct peer {
 	unsigned long	oldpkt;		/* old duplicate (BOGON1) */
 	unsigned long	seldisptoolarge; /* bad header (BOGON6, BOGON7) */
 	unsigned long	selbroken;	/* KoD received */
+	unsigned long	xleaved;	/* interleaved replies used */
 };
 
 /* pythonize-header: stop ignoring */
@@ -408,6 +421,7 @@ struct peer {
 #define FLAG_NTS_NOVAL   0x8000u   /* do not validate the server certificate */
 #define FLAG_TSTAMP_PPS	0x10000u   /* PPS source provides absolute timestamp */
 #define	FLAG_LOOKUP	0x20000u   /* needs DNS or NTS lookup */
+#define	FLAG_XLEAVE	0x40000u   /* interleaved client mode */
 
 /* FLAG_DNS and FLAG_NTS stay on.
  * FLAG_LOOKUP gets turned off when lookup succeeds.
@@ -535,12 +549,11 @@ struct pkt {
 /* pythonize-header: start ignoring */
 
 /*
- * To speed lookups, peers are hashed by the low order bits of the
- * remote IP address. These definitions relate to that.
+ * To speed lookups, peers are hashed by remote address, association ID
+ * and hostname.  The tables start at this many buckets and grow with
+ * the number of associations.
  */
 #define	NTP_HASH_SIZE		128
-#define	NTP_HASH_MASK		(NTP_HASH_SIZE-1)
-#define	NTP_HASH_ADDR(src)	(sock_hash(src) & NTP_HASH_MASK)
 
 /*
  * min, and max.  Makes it easier to transliterate the spec without
@@ -581,6 +594,7 @@ struct pkt {
 #define	PROTO_ORPHAN		26
 #define	PROTO_ORPHWAIT		27
 /* #define	PROTO_MODE7		28 was ntpdc */
+#define	PROTO_TXSTAMP		29
 
 /*
  * Configuration items for the loop filter
@@ -599,6 +613,7 @@ struct pkt {
 #define LOOP_FREQ		12	/* set initial frequency */
 #define	LOOP_LEAP		13	/* insert leap after second 23:59 */
 #define	LOOP_TICK		14	/* sim. low precision clock */
+#define	LOOP_ADJRATE		15	/* clock adjustments per second */
 
 /*
  * Configuration items for the stats printer
@@ -624,6 +639,8 @@ struct mon_data {
 	unsigned short	flags;		/* restrict flags */
 	uint8_t		vn_mode;	/* packet mode & version */
 	sockaddr_u	rmtadr;		/* address of remote host */
+	l_fp		xl_rx;		/* rec in our last reply */
+	l_fp		xl_tx;		/* when our last reply really left */
 };
 
 /*
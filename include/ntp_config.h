@@ -190,6 +190,8 @@ struct config_tree_tag {
 	int_fifo *	stats_list;
 	char *		stats_dir;
 	filegen_fifo *	filegen_opts;
+	attr_val_fifo *	rawstats_opts;
+	attr_val_fifo *	metrics_opts;
 
 	/* Access Control Configuration */
 	attr_val_fifo *	limit_opts;
@@ -9,6 +9,7 @@
 #define GUARD_NTP_FILEGEN_H
 
 #include "ntp_types.h"
+#include "ntp_stdlib.h"
 
 /*
  * supported file generation types
@@ -27,10 +28,71 @@
  */
 
 #define FGEN_FLAG_LINK		0x01 /* make a link to base name */
+#define FGEN_FLAG_BINARY	0x02 /* fixed-width records, if it has a schema */
 
 #define FGEN_FLAG_ENABLED	0x80 /* set this to really create files	  */
 				     /* without this, open is suppressed */
 
+/*
+ * Binary statistics files
+ *
+ * A binary file starts with a header naming its stream and describing
+ * each column of the records after it: a name, a type and an offset.
+ * Every record is the same size and starts with a 16-bit kind, zero
+ * for data.  Types are Python struct codes, plus three of our own:
+ *   'T'  an l_fp, as a 64-bit integer
+ *   'S'  a string, as the 32-bit id of an earlier definition
+ *   'x'  padding, never described
+ * A string is defined, before its first use in the file, by one or
+ * more records of kind FG_BIN_STRING and FG_BIN_MORE, each carrying
+ * the id and a piece of the text.  Numbers are in host byte order;
+ * the header says which that is.
+ */
+#define FG_BIN_MAGIC	"NTPSTATB"
+#define FG_BIN_VERSION	1
+#define FG_BIN_ORDER	0x01020304U
+
+#define FG_BIN_DATA	0
+#define FG_BIN_STRING	1	/* id, first piece of the text */
+#define FG_BIN_MORE	2	/* id, the next piece */
+
+struct fg_bin_header {
+	char		magic[8];
+	uint16_t	version;
+	uint16_t	size;		/* of the header, with columns */
+	uint16_t	recsize;
+	uint16_t	ncols;
+	uint32_t	order;		/* FG_BIN_ORDER */
+	uint32_t	reserved;
+	char		stream[16];
+	/* ncols struct fg_bin_column follow */
+};
+
+struct fg_bin_column {
+	char		name[12];
+	uint16_t	offset;
+	char		type;
+	uint8_t		reserved;
+};
+
+/* a string definition record, text follows the id */
+struct fg_bin_string {
+	uint16_t	kind;
+	uint16_t	len;		/* of the text in this record */
+	uint32_t	id;
+};
+
+typedef struct filegen_schema {
+	const char *	stream;
+	uint16_t	recsize;	/* a multiple of 8, at least 16 */
+	uint16_t	ncols;
+	const struct fg_bin_column *col;
+} FILEGEN_SCHEMA;
+
+#define FG_BIN_MAXSTR	8	/* 'S' columns in a record */
+
+struct filegen_strings;
+
 typedef struct filegen_tag {
 	FILE *	fp;	/* file referring to current generation */
 	char *	dir;	/* currently always statsdir */
@@ -40,9 +102,20 @@ typedef struct filegen_tag {
 	time_t	id_hi;	/* upper bound of ident value */
 	uint8_t	type;	/* type of file generation */
 	uint8_t	flag;	/* flags modifying processing of file generation */
+	bool	dirty;	/* written since the last flush */
+	bool	binary;	/* fp holds binary records */
+	const FILEGEN_SCHEMA *schema; /* binary layout, NULL if none */
+	struct filegen_strings *strings; /* defined in fp so far */
 } FILEGEN;
 
 extern	void	filegen_setup	(FILEGEN *, time_t);
+extern	bool	filegen_printf	(FILEGEN *, time_t, const char *, ...)
+			NTP_PRINTF(3, 4);
+extern	bool	filegen_write	(FILEGEN *, time_t, const void *,
+				 const char * const *);
+extern	uint64_t filegen_written(void);
+extern	uint64_t filegen_dropped(void);
+extern	void	filegen_sync	(void);
 extern	void	filegen_config	(FILEGEN *, const char *, const char *,
 				 unsigned int, unsigned int);
 extern	void	filegen_statsdir(void);
@@ -155,6 +155,17 @@ extern	char *	prettydate	(const l_fp);
 extern	char *	rfc3339date	(const l_fp);
 extern	char *	rfc3339time     (time_t);
 
+/*
+ * The same, formatting into the caller's buffer rather than one from
+ * lib_getbuf(); they return buf.  LIB_BUFLENGTH is always enough.
+ */
+extern	char *	dolfptoa_r	(l_fp, bool, short, bool, char *, size_t);
+extern	char *	mfptoa_r	(l_fp, short, char *, size_t);
+extern	char *	mfptoms_r	(l_fp, short, char *, size_t);
+extern	char *	prettydate_r	(const l_fp, char *, size_t);
+extern	char *	rfc3339date_r	(const l_fp, char *, size_t);
+extern	char *	rfc3339time_r	(time_t, char *, size_t);
+
 #ifdef ENABLE_FUZZ
 extern	void	set_sys_fuzz	(double);
 #endif
@@ -169,6 +180,13 @@ extern	bool	adj_systime	(double, int (*adjtime)(const struct timeval *, struct t
 #define	ulfptoms(fpv, ndec)	dolfptoa((fpv), false, (ndec), true)
 #define	umfptoa(lfp, ndec)	dolfptoa((lfp), false, (ndec), false)
 
+#define	lfptoa_r(fpv, ndec, buf, len)	mfptoa_r((fpv), (ndec), (buf), (len))
+#define	lfptoms_r(fpv, ndec, buf, len)	mfptoms_r((fpv), (ndec), (buf), (len))
+#define	ulfptoa_r(fpv, ndec, buf, len)	\
+	dolfptoa_r((fpv), false, (ndec), false, (buf), (len))
+#define	ulfptoms_r(fpv, ndec, buf, len)	\
+	dolfptoa_r((fpv), false, (ndec), true, (buf), (len))
+
 /*
  * Optional callback from libntp step_systime() to ntpd.  Optional
 *  because other libntp clients like ntpdate don't use it.
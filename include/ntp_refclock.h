@@ -73,8 +73,15 @@ struct refclockio {
 	int	fd;		/* file descriptor */
 	unsigned long	recvcount;	/* count of receive completions */
 	bool	active;		/* true when in use */
+	/* line mode, see refclock_linemode() */
+	void	(*clock_line) (struct peer *, char *, int, l_fp *);
+	char	*linebuf;	/* LINEBUF_SIZE bytes */
+	size_t	linelen;	/* partial line held from the last read */
+	double	chartime;	/* seconds per character, 0 if unknown */
 };
 
+#define	LINEBUF_SIZE	4096	/* line mode read buffer */
+
 /*
  * Structure for returning debugging info
  */
@@ -94,7 +101,8 @@ struct refclockbug {
  * Structure interface between the reference clock support
  * ntp_refclock.c and the driver utility routines
  */
-#define MAXSTAGE	60	/* max median filter stages  */
+#define MAXSTAGE	60	/* default median filter stages */
+#define NSTAGE_MAX	4096	/* max median filter stages */
 #define NSTAGE		5	/* default median filter stages */
 #define BMAX		128	/* max timecode length */
 #define MAXDIAL		60	/* max length of modem dial strings */
@@ -124,12 +132,14 @@ struct refclockproc {
 	uint32_t	yearstart;	/* beginning of year */
 	int	coderecv;	/* put pointer */
 	int	codeproc;	/* get pointer */
+	int	filtsize;	/* filter[] slots, one more than stages */
 	l_fp	lastref;	/* reference timestamp */
 	l_fp	lastrec;	/* receive timestamp */
 	double	offset;		/* mean offset */
 	double	disp;		/* sample dispersion */
 	double	jitter;		/* jitter (mean squares) */
-	double	filter[MAXSTAGE]; /* median filter */
+	double	*filter;	/* median filter */
+	struct filter_order *order; /* filter[] in ascending order */
 
 	/*
 	 * Configuration data
@@ -183,6 +193,7 @@ extern	void	refclock_control(sockaddr_u *,
 				 struct refclockstat *);
 extern	int	refclock_open	(char *, unsigned int, unsigned int);
 extern	void	refclock_timer	(struct peer *);
+extern	void	refclock_timers	(void);
 extern	void	refclock_transmit(struct peer *);
 extern 	bool	refclock_process(struct refclockproc *);
 extern 	bool	refclock_process_f(struct refclockproc *, double);
@@ -192,6 +203,12 @@ extern	void	refclock_report	(struct peer *, int);
 extern	char	*refclock_name	(const struct peer *);
 extern	int	refclock_gtlin	(struct recvbuf *, char *, int, l_fp *);
 extern	size_t	refclock_gtraw	(struct recvbuf *, char *, size_t, l_fp *);
+extern	double	refclock_chartime (unsigned int);
+extern	l_fp	refclock_bytetime (const struct refclockio *, l_fp, size_t);
+extern	void	refclock_linemode (struct refclockio *, unsigned int,
+				   void (*)(struct peer *, char *, int,
+					    l_fp *));
+extern	int	refclock_lines	(struct refclockio *, size_t, l_fp);
 extern	bool	indicate_refclock_packet(struct refclockio *,
 					 struct recvbuf *);
 
@@ -0,0 +1,56 @@
+/*
+ * ntp_shm.h - layout of the version 2 (ring) SHM refclock segment
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * The original SHM segment (struct shmTime in refclock_shm.c) holds a
+ * single sample, which ntpd looks at once a second, so anything a
+ * producer writes faster than that is lost.  The version 2 segment
+ * holds a ring of samples instead.
+ *
+ * There is one writer.  For sample number n it
+ *   1. sets seq in slot n % slots to 0,
+ *   2. fills in the rest of the slot,
+ *   3. sets seq to n + 1,
+ *   4. sets head to n + 1,
+ * with a memory barrier between each step.  A reader remembers how far
+ * it got, copies each slot up to head, and keeps the copy only if seq
+ * was n + 1 both before and after; otherwise the writer lapped it.
+ * Readers never write to the ring, so several can share one segment.
+ * All counters are free-running and wrap; use unsigned differences.
+ *
+ * A producer may also write a byte to a FIFO after each sample so ntpd
+ * picks it up at once rather than at its next once-a-second look.
+ */
+#ifndef GUARD_NTP_SHM_H
+#define GUARD_NTP_SHM_H
+
+#include <stdint.h>
+
+#define SHM_RING_KEY	0x4e545230	/* "NTR0", plus the unit number */
+#define SHM_RING_MAGIC	0x53484d32	/* "SHM2" */
+#define SHM_RING_VERSION 2
+#define SHM_RING_SLOTS	256		/* samples in the ring */
+
+struct shm_sample {
+	volatile uint32_t seq;	/* sample number + 1, 0 while writing */
+	int32_t		leap;	/* leap notification code, as in v1 */
+	int64_t		clock_sec;	/* reference clock time, POSIX */
+	int64_t		recv_sec;	/* system time it was received */
+	int32_t		clock_nsec;
+	int32_t		recv_nsec;
+	int32_t		precision;	/* log2 seconds */
+	int32_t		pad;
+};
+
+struct shm_ring {
+	uint32_t	magic;		/* SHM_RING_MAGIC */
+	uint32_t	version;	/* SHM_RING_VERSION */
+	uint32_t	slots;		/* SHM_RING_SLOTS */
+	uint32_t	sample_size;	/* sizeof(struct shm_sample) */
+	volatile uint32_t head;		/* samples written so far */
+	uint32_t	pad[11];	/* keep the ring off head's line */
+	struct shm_sample sample[SHM_RING_SLOTS];
+};
+
+#endif /* GUARD_NTP_SHM_H */
@@ -0,0 +1,170 @@
+/*
+ * ntp_shmstats.h - layout of ntpd's shared-memory statistics segment
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * With "enable shmstats", ntpd keeps its system, I/O, protocol, MRU,
+ * NTS and per-association counters in a POSIX shared-memory object
+ * and refreshes them once a second.  A monitor on the same host maps
+ * it read-only and copies out what it wants, which costs ntpd
+ * nothing: no mode 6 packets, no sockets, no formatting.
+ *
+ * The segment is a header, one struct shmstats_sys and peer_slots
+ * struct shmstats_peer, at the offsets and strides the header gives.
+ * There is one writer.  It gathers an update privately, makes seq
+ * odd, copies the update in, then makes seq even again, with a memory
+ * barrier either side.  A reader copies what it wants and keeps the
+ * copy only if seq was the same even number before and after;
+ * otherwise it backs off and tries again.  time is when the last
+ * update was made: if it stops moving, ntpd has stopped.
+ *
+ * New fields only ever go on the end of a structure, with the sizes
+ * in the header growing to match, so older readers keep working.
+ * Anything else that changes bumps SHMSTATS_VERSION.  pylib/shmstats.py
+ * knows this layout too; keep the two in step.
+ */
+#ifndef GUARD_NTP_SHMSTATS_H
+#define GUARD_NTP_SHMSTATS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SHMSTATS_NAME		"/ntpd-stats"
+#define SHMSTATS_MAGIC		0x4e545354	/* "NTST" */
+#define SHMSTATS_VERSION	1
+#define SHMSTATS_PEERS		256		/* association slots */
+
+struct shmstats_head {
+	uint32_t	magic;		/* SHMSTATS_MAGIC */
+	uint32_t	version;	/* SHMSTATS_VERSION */
+	uint32_t	head_size;	/* sizeof(struct shmstats_head) */
+	uint32_t	sys_size;	/* sizeof(struct shmstats_sys) */
+	uint32_t	peer_size;	/* sizeof(struct shmstats_peer) */
+	uint32_t	peer_slots;	/* SHMSTATS_PEERS */
+	volatile uint32_t seq;		/* odd while being written */
+	uint32_t	peer_count;	/* slots in use */
+	int64_t		time;		/* POSIX time of the last update */
+	uint64_t	pad[3];
+};
+
+/*
+ * Everything is 8 bytes wide so the layout is the same for every ABI.
+ * Counters are free-running; gauges are as ntpq would show them.
+ */
+struct shmstats_sys {
+	/* system variables */
+	uint64_t	uptime;		/* s since ntpd started */
+	int64_t		stratum;
+	int64_t		leap;		/* 3 when unsynchronized */
+	int64_t		precision;	/* log2 s */
+	double		rootdelay;	/* s */
+	double		rootdisp;	/* s */
+	double		rootdist;	/* s */
+	uint64_t	sys_peer;	/* association ID, 0 for none */
+	uint64_t	associations;
+
+	/* the loop filter */
+	double		offset;		/* s */
+	double		sys_jitter;	/* s */
+	double		clock_jitter;	/* s */
+	double		frequency;	/* ppm */
+	double		wander;		/* ppm */
+	int64_t		tc;		/* time constant, log2 s */
+
+	/* stat_proto_total */
+	uint64_t	proto_received;
+	uint64_t	proto_processed;
+	uint64_t	proto_restricted;
+	uint64_t	proto_newversion;
+	uint64_t	proto_oldversion;
+	uint64_t	proto_badlength;
+	uint64_t	proto_badauth;
+	uint64_t	proto_declined;
+	uint64_t	proto_limited;
+	uint64_t	proto_kodsent;
+
+	/* pkt_count */
+	uint64_t	io_received;
+	uint64_t	io_dropped;
+	uint64_t	io_ignored;
+	uint64_t	io_sent;
+	uint64_t	io_sendfailed;
+	uint64_t	io_wakeups;
+	uint64_t	io_goodwakeups;
+
+	/* mon_data */
+	uint64_t	mru_entries;
+	uint64_t	mru_peak_entries;
+	uint64_t	mru_hash_slots;
+	uint64_t	mru_max_entries;
+	uint64_t	mru_bytes;
+	int64_t		mru_oldest_age;	/* s */
+	uint64_t	mru_exists;
+	uint64_t	mru_new;
+	uint64_t	mru_recycleold;
+	uint64_t	mru_recyclefull;
+	uint64_t	mru_none;
+
+	/* NTS, all 0 when built without it */
+	uint64_t	nts_client_send;
+	uint64_t	nts_client_recv_good;
+	uint64_t	nts_client_recv_bad;
+	uint64_t	nts_server_send;
+	uint64_t	nts_server_recv_good;
+	uint64_t	nts_server_recv_bad;
+	uint64_t	nts_cookie_make;
+	uint64_t	nts_cookie_decode;
+	uint64_t	nts_cookie_decode_old;
+	uint64_t	nts_cookie_decode_too_old;
+	uint64_t	nts_cookie_decode_error;
+	uint64_t	nts_ke_serves_good;
+	uint64_t	nts_ke_serves_bad;
+	uint64_t	nts_ke_probes_good;
+	uint64_t	nts_ke_probes_bad;
+};
+
+struct shmstats_peer {
+	char		address[64];	/* as socktoa() gives it, scope and all */
+	char		name[64];	/* hostname or refclock name */
+	uint64_t	assoc;
+	int64_t		stratum;
+	uint64_t	reach;
+	int64_t		poll;		/* log2 s */
+	uint64_t	selection;	/* 6 for the system peer */
+	double		offset;		/* s */
+	double		delay;		/* s */
+	double		disp;		/* s */
+	double		jitter;		/* s */
+	uint64_t	sent;
+	uint64_t	received;
+	uint64_t	processed;
+	uint64_t	badauth;
+};
+
+/* a mapped segment, from shmstats_create() or shmstats_open() */
+struct shmstats {
+	struct shmstats_head *	head;
+	size_t			size;
+	struct shmstats_sys *	sys;
+	char *			peers;		/* peer_size apart */
+};
+
+#define SHMSTATS_PEER(s, i) \
+	((struct shmstats_peer *)((s)->peers + (size_t)(i) * (s)->head->peer_size))
+
+/* writer, in libntp/shmstats.c */
+extern	bool	shmstats_create	(struct shmstats *, const char *);
+extern	void	shmstats_begin	(struct shmstats *);
+extern	void	shmstats_end	(struct shmstats *);
+extern	void	shmstats_remove	(struct shmstats *, const char *);
+
+/* reader */
+extern	bool	shmstats_open	(struct shmstats *, const char *);
+extern	bool	shmstats_read	(const struct shmstats *,
+				 struct shmstats_head *,
+				 struct shmstats_sys *,
+				 struct shmstats_peer *, int *);
+extern	void	shmstats_close	(struct shmstats *);
+
+#endif /* GUARD_NTP_SHMSTATS_H */
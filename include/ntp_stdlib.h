@@ -34,6 +34,10 @@ extern	void	init_logging	(const char *, uint32_t, int);
 extern	int	change_logfile	(const char *, bool);
 extern	void	check_logfile	(void);
 extern	void	setup_logfile	(const char *);
+extern	bool	msyslog_queue	(bool);
+extern	uint64_t msyslog_written	(void);
+extern	uint64_t msyslog_repeated	(void);
+extern	uint64_t msyslog_dropped	(void);
 
 extern	int	clocktime	(int, int, int, int, int, time_t, uint32_t, uint32_t *, uint32_t *);
 extern	void	init_network	(void);
@@ -103,6 +107,7 @@ extern	const char * sockporttoa(const sockaddr_u *);
 extern	const char * sockporttoa_r(const sockaddr_u *sock, char *buf, size_t buflen);
 extern	unsigned int	sock_hash(const sockaddr_u *) __attribute__((pure));
 extern	const char *refid_str	(uint32_t, int);
+extern	const char *refid_str_r	(uint32_t, int, char *buf, size_t buflen);
 
 extern	int	decodenetnum	(const char *, sockaddr_u *);
 
@@ -120,7 +125,6 @@ extern char *	ntp_optarg;		/* global argument pointer */
 extern int	ntp_optind;		/* global argv index */
 
 /* lib_strbuf.c */
-extern  void    getbuf_init (void);
 extern bool	ipv4_works;
 extern bool	ipv6_works;
 
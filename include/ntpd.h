@@ -110,16 +110,34 @@ extern  uint64_t handler_calls_count(void);
 extern  uint64_t handler_pkts_count(void);
 extern  uptime_t counter_reset_time(void);
 
+/* Transmit timestamps: kernel stamp minus the xmt we wrote */
+struct txstamp_counters {
+	uint64_t	count;		/* server replies stamped */
+	double		sum;		/* total delta, s */
+	double		avg;		/* running average delta, s */
+	double		max;		/* largest delta, s */
+};
+extern	void	io_txstamps	(bool);
+extern	void	io_add_timer	(int);
+extern	void	txstamp_match	(endpt *, uint32_t, l_fp);
+extern	void	txstamp_tag	(endpt *, mon_entry *, associd_t, bool);
+extern	const struct txstamp_counters *txstamp_counts(bool);
+extern	uint64_t txstamp_unmatched_count(void);
+
 /* ntp_loopfilter.c */
 extern	void	init_loopfilter(void);
 extern	int	local_clock(struct peer *, double);
-extern	void	adj_host_clock(void);
+extern	void	adj_host_clock(int);
 extern	void	loop_config(int, double);
 extern	void	select_loop(int);
 extern	void	huffpuff(void);
 extern	unsigned int	sys_tai;
 extern	int	freq_cnt;
 
+/* ntp_metrics.c */
+extern	void	metrics_config	(int, const char *, int);
+extern	void	metrics_timer	(void);
+
 /* ntp_monitor.c */
 extern	void	init_mon(void);
 extern	void	mon_setup(int);
@@ -152,6 +170,9 @@ extern	void	unpeer		(struct peer *);
 extern	void	clear_all	(void);
 extern	int	score_all	(struct peer *);
 extern	void	peer_cleanup	(void);
+extern	void	poll_schedule	(struct peer *, uptime_t);
+extern	void	poll_collect	(uptime_t);
+extern	struct peer *poll_next	(void);
 
 /* ntp_proto.c */
 extern	void	transmit	(struct peer *);
@@ -187,6 +208,7 @@ extern void set_use_stattime(uptime_t stattime);
 extern uptime_t	use_stattime;		/* time since usestats reset */
 
 extern	void	poll_update	(struct peer *, uint8_t);
+extern	int	peer_throttle	(struct peer *);
 
 extern	void	clock_filter	(struct peer *, double, double, double);
 extern	void	init_proto	(const bool);
@@ -204,10 +226,43 @@ extern	void	hack_restrict	(int, sockaddr_u *, sockaddr_u *,
 extern	void	restrict_source		(struct peer *);
 extern	void	unrestrict_source	(struct peer *);
 
+/* ntp_select.c */
+/*
+ * peer_select groups statistics for a peer used by clock_select() and
+ * select_cluster().
+ */
+typedef struct peer_select_tag {
+	struct peer *	peer;
+	double		synch;	/* sync distance */
+	double		error;	/* jitter */
+	double		seljit;	/* selection jitter */
+} peer_select;
+
+/*
+ * Candidate arrays for clock_select(), kept between calls.
+ */
+struct select_list {
+	peer_select *	peers;		/* candidates */
+	struct endpoint *endpoint;	/* two interval ends per candidate */
+	int *		level;		/* select_intersect() scratch */
+	int		size;		/* candidates there is room for */
+};
+
+extern	void	select_grow	(struct select_list *, int);
+extern	void	select_intersect(struct select_list *, int, double *,
+				 double *);
+extern	int	select_cluster	(peer_select *, int, int, int);
+
+/* ntp_shmstats.c */
+extern	void	shmstats_config	(bool);
+extern	void	shmstats_timer	(void);
+
 /* ntp_timer.c */
 extern	void	init_timer	(void);
 extern	void	reinit_timer	(void);
 extern	void	timer		(void);
+extern	void	timer_expired	(void);
+extern	int	timer_ticks	(void);
 extern	void	timer_clr_stats (void);
 extern	void	timer_interfacetimeout (uptime_t);
 extern	int	interface_interval;
@@ -228,6 +283,16 @@ extern	void	record_raw_stats (
   struct recvbuf *rbufp,
   unsigned int flag,
   unsigned int outcount);
+extern	void	rawstats_sample	(unsigned int);
+extern	void	rawstats_reservoir (unsigned int, unsigned int);
+extern	void	rawstats_include (const sockaddr_u *, unsigned int);
+extern	void	rawstats_timer	(void);
+extern	void	rawstats_flush	(void);
+extern	uint64_t rawstats_filtered;	/* not from an included peer */
+extern	uint64_t rawstats_sampled;	/* left out by sampling */
+#define	RAWSTATS_KEEP		100	/* default reservoir size */
+#define	RAWSTATS_INTERVAL	60	/* default reservoir interval, s */
+#define	RAWSTATS_KEEP_MAX	4096
 
 extern void record_ref_stats(
     const struct peer *peer,
@@ -252,6 +317,9 @@ extern	void	check_cert_file	(void);
 /* packetstamp.c */
 extern void	enable_packetstamps(int, sockaddr_u *);
 extern l_fp	fetch_packetstamp(struct msghdr *);
+extern bool	enable_txstamps(int, sockaddr_u *, bool);
+extern bool	txstamps_supported(void);
+extern void	fetch_txstamps(endpt *);
 
 /*
  * Signals we catch for debugging.
@@ -296,6 +364,7 @@ struct ntp_loop_data {
   double clock_max_back;  /* max backward offset before step (s) */
   double clock_max_fwd;   /* max forward offset before step (s) */
   double clock_phi;       /* dispersion rate (s/s) */
+  int    adj_rate;        /* adj_host_clock() calls per second */
 };
 extern struct ntp_loop_data loop_data;
 
@@ -404,6 +473,21 @@ extern struct system_variables sys_vars;
 extern l_fp	sys_authdelay;		/* authentication delay */
 extern int	sys_minsane;		/* minimum candidates */
 
+/*
+ * Server reply latency, kernel receive timestamp to sendpkt() return.
+ * Bucket 0 is < 1 us, bucket n is [2^(n-1), 2^n) us,
+ * the last bucket catches everything bigger.
+ */
+#define LAT_BUCKETS	24
+enum lat_auth {LAT_NONE, LAT_SYMMETRIC, LAT_NTS, LAT_AUTHS};
+struct latency_hist {
+	uint64_t count[LAT_BUCKETS];
+};
+/* [auth][0 normal, 1 KoD] */
+extern struct latency_hist serve_latency[LAT_AUTHS][2];
+extern uptime_t serve_latency_reset;
+extern void	serve_latency_clr_stats(void);
+
 /* Signalling: Set by signal handlers */
 struct signals_detected {
 	bool sawALRM;
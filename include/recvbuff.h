@@ -48,6 +48,7 @@ struct recvbuf {
 	int mac_len;
 	bool extens_present;
 	struct ntspacket_t ntspacket;
+	struct mon_data *	mon;	/* MRU entry, NULL if none */
 #ifdef REFCLOCK
 	struct peer *	recv_peer;
 #endif /* REFCLOCK */
@@ -149,6 +149,7 @@ assertion_failed(
         /* Is recursion an issue? */
 
 	termlogit = true; /* insist log to terminal */
+	(void)msyslog_queue(false);	/* nothing is left queued at abort() */
 
 	msyslog(LOG_ERR, "ERR: %s:%d: %s(%s) failed",
 		file, line, assertion_typetotext(type), cond);
@@ -14,155 +14,143 @@
 #include "lib_strbuf.h"
 #include "ntp_stdlib.h"
 
+/* the most fraction digits asked for, counting msec's three */
+#define LFP_MAXDEC	14
+
+static const uint64_t pow10[LFP_MAXDEC + 1] = {
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+	10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+	100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+	100000000000000ULL
+};
+
+static const char digitpairs[] =
+	"00010203040506070809" "10111213141516171819"
+	"20212223242526272829" "30313233343536373839"
+	"40414243444546474849" "50515253545556575859"
+	"60616263646566676869" "70717273747576777879"
+	"80818283848586878889" "90919293949596979899";
+
+/*
+ * put_digits - write val in decimal ending just before end, two
+ * digits at a time, zero filled to at least width.  Returns the start.
+ */
+static char *
+put_digits(
+	char *		end,
+	uint64_t	val,
+	int		width
+	)
+{
+	char *	cp = end;
+
+	while (val >= 100) {
+		unsigned int pair = (unsigned int)(val % 100);
+
+		val /= 100;
+		*--cp = digitpairs[2 * pair + 1];
+		*--cp = digitpairs[2 * pair];
+	}
+	if (val >= 10) {
+		*--cp = digitpairs[2 * val + 1];
+		*--cp = digitpairs[2 * val];
+	} else {
+		*--cp = (char)('0' + val);
+	}
+	while (end - cp < width)
+		*--cp = '0';
+	return cp;
+}
+
+/*
+ * dolfptoa_r - format into buf, of buflen bytes, cutting the number
+ * short if it doesn't fit
+ *
+ * The fraction is scaled to dec decimal places and rounded half up
+ * with 64-bit multiplies, nine digits at a time, so the digits come
+ * out exactly as the old digit-at-a-time multiply by ten gave them.
+ */
 char *
-dolfptoa(
+dolfptoa_r(
 	l_fp lfp,
 	bool neg,
 	short ndec,
-	bool msec
+	bool msec,
+	char *buf,
+	size_t buflen
 	)
 {
-	uint32_t fpi = lfpuint(lfp);
+	uint64_t ipart = lfpuint(lfp);
+	uint64_t fpart;
 	uint32_t fpv = lfpfrac(lfp);
-	uint8_t *cp, *cpend, *cpdec;
-	int dec;
-	uint8_t cbuf[24];
-	char *buf, *bp;
-
-	/*
-	 * Get a string buffer before starting
-	 */
-	buf = lib_getbuf();
-
-	/*
-	 * Zero the character buffer
-	 */
-	ZERO(cbuf);
-
-	/*
-	 * Work on the integral part. This should work reasonable on
-	 * all machines with 32 bit arithmetic. Please note that 32 bits
-	 * can *always* be represented with at most 10 decimal digits,
-	 * including a possible rounding from the fractional part.
-	 */
-	cp = cpend = cpdec = &cbuf[10];
-	for (dec = cp - cbuf; dec > 0 && fpi != 0; dec--) {
-		/* can add another digit */
-		uint32_t digit;
-
-		digit  = fpi;
-		fpi   /= 10U;
-		/*
-		 * This should be able to be replaced by [digit -= fpi * 10].
-		 * It is being left as is at the moment for subtle bug avoidance.
-		 */
-		digit -= (fpi << 3) + (fpi << 1); /* i*10 */
-		*--cp  = (uint8_t)digit;
-	}
+	int dec, fdec;
+	char cbuf[2 + 20 + LFP_MAXDEC];
+	char *cp, *cpend;
+	size_t len;
+
+	if (0 == buflen)
+		return buf;
+
+	dec = (ndec < 0) ? 0 : ndec;
+	if (msec)
+		dec += 3;
+	if (dec > LFP_MAXDEC)
+		dec = LFP_MAXDEC;
+
+	/* fpart = round(fpv * 10^dec / 2^32) */
+	if (dec <= 9) {
+		fpart = (fpv * pow10[dec] + 0x80000000U) >> 32;
+	} else {
+		uint64_t q = fpv * pow10[9];
 
-	/*
-	 * Done that, now deal with the problem of the fraction.  First
-	 * determine the number of decimal places.
-	 */
-	dec = ndec;
-	if (dec < 0) {
-		dec = 0;
-	}
-	if (msec) {
-		dec   += 3;
-		cpdec += 3;
+		fpart = (q >> 32) * pow10[dec - 9] +
+			(((q & 0xffffffffU) * pow10[dec - 9] +
+			  0x80000000U) >> 32);
 	}
-	if (dec > (long)sizeof(cbuf) - (cpend - cbuf))
-		dec = (long)sizeof(cbuf) - (cpend - cbuf);
-
-	/*
-	 * If there's a fraction to deal with, do so.
-	 */
-	for (/*NOP*/;  dec > 0 && fpv != 0;  dec--)  {
-		uint32_t digit, tmph, tmpl;
-
-		/* FIXME - get rid of this ugly kludge! */
-#define M_ADD(r_i, r_f, a_i, a_f)	/* r += a */ \
-		do { \
-			uint32_t add_t = (r_f); \
-			(r_f) += (a_f); \
-			(r_i) += (a_i) + ((uint32_t)(r_f) < add_t); \
-		} while (false)
-
-#define	M_LSHIFT(v_i, v_f)		/* v <<= 1 */ \
-		do { \
-			(v_i) = ((uint32_t)(v_i) << 1) | ((uint32_t)(v_f) >> 31);	\
-			(v_f) = ((uint32_t)(v_f) << 1); \
-		} while (false)
-
-		/*
-		 * The scheme here is to multiply the fraction
-		 * (0.1234...) by ten.  This moves a junk of BCD into
-		 * the units part.  record that and iterate.
-		 * multiply by shift/add in two dwords.
-		 */
-		digit = 0;
-		M_LSHIFT(digit, fpv);
-		tmph = digit;
-		tmpl = fpv;
-		M_LSHIFT(digit, fpv);
-		M_LSHIFT(digit, fpv);
-		M_ADD(digit, fpv, tmph, tmpl);
-#undef M_ADD
-#undef M_LSHIFT
-		*cpend++ = (uint8_t)digit;
+	if (fpart == pow10[dec]) {
+		fpart = 0;
+		ipart++;
 	}
 
-	/* decide whether to round or simply extend by zeros */
-	if (dec > 0) {
-		/* only '0' digits left -- just reposition end */
-		cpend += dec;
-	} else {
-		/* some bits remain in 'fpv'; do round */
-		uint8_t *tp    = cpend;
-		int     carry = ((fpv & 0x80000000) != 0);
-
-		for (dec = tp - cbuf;  carry && dec > 0;  dec--) {
-			*--tp += 1;
-			if (*tp == 10)
-				*tp = 0;
-			else
-				carry = false;
-		}
-
-		if (tp < cp) /* rounding from 999 to 1000 or similar? */
-			cp = tp;
+	/* milliseconds take three digits from the fraction */
+	fdec = dec;
+	if (msec) {
+		fdec -= 3;
+		ipart = ipart * 1000 + fpart / pow10[fdec];
+		fpart %= pow10[fdec];
 	}
 
-	/*
-	 * We've now got the fraction in cbuf[], with cp pointing at
-	 * the first character, cpend pointing past the last, and
-	 * cpdec pointing at the first character past the decimal.
-	 * Remove leading zeros, then format the number into the
-	 * buffer.
-	 */
-	while (cp < cpdec && *cp == 0)
-		cp++;
-	if (cp >= cpdec)
-		cp = cpdec - 1;
-
-	bp = buf;
-	if (neg)
-		*bp++ = '-';
-	while (cp < cpend) {
-		if (cp == cpdec)
-			*bp++ = '.';
-		*bp++ = (char)(*cp++) + '0';
+	cp = cpend = cbuf + sizeof(cbuf);
+	if (fdec > 0) {
+		cp = put_digits(cp, fpart, fdec);
+		*--cp = '.';
 	}
-	*bp = '\0';
+	cp = put_digits(cp, ipart, 1);
+	if (neg)
+		*--cp = '-';
+
+	len = (size_t)(cpend - cp);
+	if (len >= buflen)
+		len = buflen - 1;
+	memcpy(buf, cp, len);
+	buf[len] = '\0';
 
-	/*
-	 * Done!
-	 */
 	return buf;
 }
 
 
+char *
+dolfptoa(
+	l_fp lfp,
+	bool neg,
+	short ndec,
+	bool msec
+	)
+{
+	return dolfptoa_r(lfp, neg, ndec, msec, lib_getbuf(), LIB_BUFLENGTH);
+}
+
+
 char *
 mfptoa(
 	l_fp	lfp,
@@ -195,3 +183,37 @@ mfptoms(
 }
 
 
+char *
+mfptoa_r(
+	l_fp	lfp,
+	short	ndec,
+	char *	buf,
+	size_t	buflen
+	)
+{
+	bool	isneg = L_ISNEG(lfp);
+
+	if (isneg) {
+		L_NEG(lfp);
+	}
+
+	return dolfptoa_r(lfp, isneg, ndec, false, buf, buflen);
+}
+
+
+char *
+mfptoms_r(
+	l_fp	lfp,
+	short	ndec,
+	char *	buf,
+	size_t	buflen
+	)
+{
+	bool	isneg = L_ISNEG(lfp);
+
+	if (isneg) {
+		L_NEG(lfp);
+	}
+
+	return dolfptoa_r(lfp, isneg, ndec, true, buf, buflen);
+}
@@ -12,6 +12,12 @@
 #include <stdio.h>
 #include <string.h>
 
+#if defined(HAVE_STDATOMIC_H)
+# include <pthread.h>
+# include <signal.h>
+# include <stdatomic.h>
+#endif /* HAVE_STDATOMIC_H */
+
 #include "ntp.h"
 #include "ntp_debug.h"
 #include "ntp_stdlib.h"
@@ -38,19 +44,25 @@ extern	char *	progname;
 
 /* Declare the local functions */
 #define TIMESTAMP_LEN  128
-static void	humanlogtime(char buf[TIMESTAMP_LEN]);
-static void	addto_syslog	(int, const char *);
+#define MSYSLOG_BUFLEN 1024	/* longest message, with NUL */
+static void	humanlogtime(char buf[TIMESTAMP_LEN], time_t);
+static void	addto_syslog	(int, const char *, time_t);
+static void	log_queue_drain	(void);
+
+#if defined(HAVE_STDATOMIC_H)
+static atomic_uint_least64_t log_written;
+#else
+static uint64_t	log_written;
+#endif /* HAVE_STDATOMIC_H */
 
 
 /* We don't want to clutter up the log with the year and day of the week,
    etc.; just the minimal date and time.  */
 static void
-humanlogtime(char buf[TIMESTAMP_LEN])
+humanlogtime(char buf[TIMESTAMP_LEN], time_t cursec)
 {
-	time_t		cursec;
 	struct tm	tmbuf, *tm;
 
-	cursec = time(NULL);
 	tm = localtime_r(&cursec, &tmbuf);
 	if (!tm) {
 		strlcpy(buf, "-- --- --:--:--", TIMESTAMP_LEN);
@@ -78,12 +90,14 @@ humanlogtime(char buf[TIMESTAMP_LEN])
 /*
  * addto_syslog()
  * This routine adds the contents of a buffer to the syslog or an
- * application-specific logfile.
+ * application-specific logfile.  when is the time the message was
+ * made, which may be a little while ago if it was queued.
  */
 static void
 addto_syslog(
 	int		level,
-	const char *	msg
+	const char *	msg,
+	time_t		when
 	)
 {
 	static char *	prevcall_progname;
@@ -109,6 +123,7 @@ addto_syslog(
 		}
 	}
 
+	log_written++;
 	log_to_term = termlogit;
 	log_to_file = false;
 	if (syslogit)
@@ -125,7 +140,7 @@ addto_syslog(
 
 	/* syslog() adds the timestamp, name, and pid */
 	if (msyslog_include_timestamp) {
-		humanlogtime(tbuf);
+		humanlogtime(tbuf, when);
 		human_time = tbuf;
 	} else	/* suppress gcc pot. uninit. warning */
 		human_time = NULL;
@@ -175,6 +190,391 @@ addto_syslog(
 }
 
 
+#if defined(HAVE_STDATOMIC_H)
+
+#define LOGQ_SLOTS	1024	/* messages; a power of two */
+#define LOGQ_REPORT	30	/* seconds between repeat and drop reports */
+
+/*
+ * The log queue.  Any thread may add a message without taking a lock:
+ * it claims a slot by moving head on, fills it in, then publishes it
+ * by setting its seq.  One writer thread takes them off at tail, in
+ * order, and does the blocking work of syslog() or writing the file.
+ * A slot is free for claiming at head when its seq equals head, and
+ * ready for writing at tail when it equals tail + 1.
+ */
+struct log_slot {
+	atomic_size_t	seq;
+	int		level;
+	time_t		when;
+	char		msg[MSYSLOG_BUFLEN];
+};
+
+static struct {
+	struct log_slot *slot;
+	atomic_size_t	head;		/* messages ever claimed */
+	atomic_size_t	tail;		/* messages ever written */
+	atomic_bool	on;		/* msyslog() queues */
+	atomic_bool	idle;		/* writer is or is about to wait */
+	atomic_bool	stop;
+	atomic_uint_least64_t dropped;
+	atomic_uint_least64_t repeated;
+	pthread_t	thread;
+	pthread_cond_t	wake;		/* for the writer */
+	pthread_cond_t	drained;	/* for log_queue_drain() */
+} log_q;
+
+/* held by the writer while it writes, and to switch log files */
+static pthread_mutex_t	log_lock = PTHREAD_MUTEX_INITIALIZER;
+
+#define LOG_LOCK()	pthread_mutex_lock(&log_lock)
+#define LOG_UNLOCK()	pthread_mutex_unlock(&log_lock)
+
+/* writer thread only: the last message written, to fold repeats */
+static struct {
+	int		level;
+	unsigned long	repeats;
+	time_t		since;		/* when repeats were last reported */
+	uint64_t	dropped;	/* drops last reported */
+	time_t		dropped_at;
+	char		msg[MSYSLOG_BUFLEN];
+} log_last;
+
+/* say how often the last message came again, if it did */
+static void
+log_repeats(
+	time_t	now
+	)
+{
+	char	buf[64];
+
+	if (0 == log_last.repeats)
+		return;
+	snprintf(buf, sizeof(buf), "LOG: last message repeated %lu times",
+		 log_last.repeats);
+	addto_syslog(log_last.level, buf, now);
+	log_last.repeats = 0;
+	log_last.since = now;
+}
+
+/* say how many messages were lost to a full queue, now and then */
+static void
+log_drops(
+	time_t	now,
+	bool	idle
+	)
+{
+	char		buf[80];
+	uint64_t	dropped;
+
+	dropped = atomic_load_explicit(&log_q.dropped, memory_order_relaxed);
+	if (dropped == log_last.dropped ||
+	    (!idle && now - log_last.dropped_at < LOGQ_REPORT))
+		return;
+	snprintf(buf, sizeof(buf),
+		 "LOG: %llu messages dropped, log queue full",
+		 (unsigned long long)(dropped - log_last.dropped));
+	addto_syslog(LOG_WARNING, buf, now);
+	log_last.dropped = dropped;
+	log_last.dropped_at = now;
+}
+
+/*
+ * Write one message from the queue.  A run of the same message is
+ * written once, then counted, with the count reported when something
+ * else comes along or every LOGQ_REPORT seconds, as syslogd does.
+ */
+static void
+log_write(
+	struct log_slot *	s
+	)
+{
+	if (s->level == log_last.level &&
+	    0 == strcmp(s->msg, log_last.msg)) {
+		log_last.repeats++;
+		atomic_fetch_add_explicit(&log_q.repeated, 1,
+					  memory_order_relaxed);
+		if (s->when - log_last.since >= LOGQ_REPORT)
+			log_repeats(s->when);
+		return;
+	}
+	log_repeats(s->when);
+	addto_syslog(s->level, s->msg, s->when);
+	log_last.level = s->level;
+	log_last.since = s->when;
+	strlcpy(log_last.msg, s->msg, sizeof(log_last.msg));
+}
+
+/* write out what is ready at tail; called with log_lock held */
+static bool
+log_queue_pop(void)
+{
+	struct log_slot *s;
+	size_t		tail;
+
+	tail = atomic_load_explicit(&log_q.tail, memory_order_relaxed);
+	s = &log_q.slot[tail & (LOGQ_SLOTS - 1)];
+	if (atomic_load(&s->seq) != tail + 1)
+		return false;
+	log_write(s);
+	atomic_store(&s->seq, tail + LOGQ_SLOTS);
+	atomic_store(&log_q.tail, tail + 1);
+	return true;
+}
+
+static void *
+log_writer(
+	void *	arg
+	)
+{
+	struct timespec	until;
+	size_t		tail;
+
+	UNUSED_ARG(arg);
+	LOG_LOCK();
+	for (;;) {
+		if (log_queue_pop()) {
+			log_drops(time(NULL), false);
+			/* let change_logfile() in */
+			LOG_UNLOCK();
+			LOG_LOCK();
+			continue;
+		}
+		log_drops(time(NULL), true);
+		pthread_cond_broadcast(&log_q.drained);
+		if (atomic_load(&log_q.stop))
+			break;
+		/*
+		 * Say we are going to sleep, then look once more, so a
+		 * message queued in between either is seen here or sees
+		 * idle and wakes us.  While repeats are being counted,
+		 * wake in time to report them.
+		 */
+		atomic_store(&log_q.idle, true);
+		tail = atomic_load_explicit(&log_q.tail, memory_order_relaxed);
+		if (atomic_load(&log_q.slot[tail & (LOGQ_SLOTS - 1)].seq) !=
+		    tail + 1 && !atomic_load(&log_q.stop)) {
+			if (0 == log_last.repeats) {
+				pthread_cond_wait(&log_q.wake, &log_lock);
+			} else if (time(NULL) - log_last.since >= LOGQ_REPORT) {
+				log_repeats(time(NULL));
+			} else {
+				until.tv_sec = log_last.since + LOGQ_REPORT;
+				until.tv_nsec = 0;
+				pthread_cond_timedwait(&log_q.wake, &log_lock,
+						       &until);
+			}
+		}
+		atomic_store(&log_q.idle, false);
+	}
+	log_repeats(time(NULL));
+	LOG_UNLOCK();
+	return NULL;
+}
+
+/*
+ * Add a message to the queue.  Returns false, having counted the
+ * drop, if it is full.
+ */
+static bool
+log_queue_put(
+	int		level,
+	const char *	fmt,
+	va_list		ap
+	)
+{
+	struct log_slot *s;
+	size_t		pos, seq;
+
+	pos = atomic_load_explicit(&log_q.head, memory_order_relaxed);
+	for (;;) {
+		s = &log_q.slot[pos & (LOGQ_SLOTS - 1)];
+		seq = atomic_load_explicit(&s->seq, memory_order_acquire);
+		if (seq == pos) {
+			if (atomic_compare_exchange_weak_explicit(
+				    &log_q.head, &pos, pos + 1,
+				    memory_order_relaxed,
+				    memory_order_relaxed))
+				break;
+		} else if ((ptrdiff_t)(seq - pos) < 0) {
+			/* the writer hasn't freed it yet */
+			atomic_fetch_add_explicit(&log_q.dropped, 1,
+						  memory_order_relaxed);
+			return false;
+		} else {
+			/* another thread claimed it first */
+			pos = atomic_load_explicit(&log_q.head,
+						   memory_order_relaxed);
+		}
+	}
+	s->level = level;
+	s->when = time(NULL);
+	vsnprintf(s->msg, sizeof(s->msg), fmt, ap);
+	atomic_store(&s->seq, pos + 1);
+	if (atomic_load(&log_q.idle)) {
+		LOG_LOCK();
+		pthread_cond_signal(&log_q.wake);
+		LOG_UNLOCK();
+	}
+	return true;
+}
+
+/* wait until the writer has caught up with what is queued */
+static void
+log_queue_drain(void)
+{
+	if (!atomic_load(&log_q.on) ||
+	    pthread_equal(pthread_self(), log_q.thread))
+		return;
+	LOG_LOCK();
+	while (atomic_load(&log_q.tail) != atomic_load(&log_q.head) &&
+	       !atomic_load(&log_q.stop)) {
+		pthread_cond_signal(&log_q.wake);
+		pthread_cond_wait(&log_q.drained, &log_lock);
+	}
+	LOG_UNLOCK();
+}
+
+static void
+log_queue_stop(void)
+{
+	(void)msyslog_queue(false);
+}
+
+/*
+ * msyslog_queue - turn queued logging on or off
+ *
+ * With it on, msyslog() only formats the message and queues it, and a
+ * thread of its own does the writing, so no caller waits on syslog()
+ * or the disk.  When the queue is full, messages are dropped and
+ * counted.  Turning it off writes out what is queued first.  Returns
+ * whether it is on.
+ */
+bool
+msyslog_queue(
+	bool	on
+	)
+{
+	static bool	registered;
+	sigset_t	block_mask, saved_sig_mask;
+	size_t		i;
+	int		rc;
+
+	if (on == atomic_load(&log_q.on))
+		return on;
+	if (!on) {
+		atomic_store(&log_q.on, false);
+		if (pthread_equal(pthread_self(), log_q.thread))
+			return false;	/* dying in the writer, don't wait */
+		atomic_store(&log_q.stop, true);
+		LOG_LOCK();
+		pthread_cond_signal(&log_q.wake);
+		LOG_UNLOCK();
+		pthread_join(log_q.thread, NULL);
+		/* anything that got in as the writer stopped */
+		LOG_LOCK();
+		while (log_queue_pop())
+			continue;
+		log_repeats(time(NULL));
+		LOG_UNLOCK();
+		/*
+		 * The slots, head and tail are kept as they are: a late
+		 * caller may still be in a slot, and turning the queue
+		 * on again carries on from there.
+		 */
+		return false;
+	}
+
+	if (NULL == log_q.slot) {
+		log_q.slot = emalloc_zero(LOGQ_SLOTS * sizeof(*log_q.slot));
+		for (i = 0; i < LOGQ_SLOTS; i++)
+			atomic_init(&log_q.slot[i].seq, i);
+		pthread_cond_init(&log_q.wake, NULL);
+		pthread_cond_init(&log_q.drained, NULL);
+	}
+	atomic_store(&log_q.stop, false);
+	log_last.msg[0] = '\0';
+	log_last.repeats = 0;
+	log_last.dropped = atomic_load(&log_q.dropped);
+	/* signals are for the main thread */
+	sigfillset(&block_mask);
+	pthread_sigmask(SIG_BLOCK, &block_mask, &saved_sig_mask);
+	rc = pthread_create(&log_q.thread, NULL, log_writer, NULL);
+	pthread_sigmask(SIG_SETMASK, &saved_sig_mask, NULL);
+	if (rc) {
+		msyslog(LOG_ERR, "LOG: can't start log writer: %s",
+			strerror(rc));
+		return false;
+	}
+	atomic_store(&log_q.on, true);
+	if (!registered) {
+		registered = true;
+		atexit(log_queue_stop);
+	}
+	return true;
+}
+
+uint64_t
+msyslog_written(void)
+{
+	return atomic_load_explicit(&log_written, memory_order_relaxed);
+}
+
+uint64_t
+msyslog_repeated(void)
+{
+	return atomic_load_explicit(&log_q.repeated, memory_order_relaxed);
+}
+
+uint64_t
+msyslog_dropped(void)
+{
+	return atomic_load_explicit(&log_q.dropped, memory_order_relaxed);
+}
+
+#else /* !HAVE_STDATOMIC_H */
+
+#define LOG_LOCK()	do {} while (false)
+#define LOG_UNLOCK()	do {} while (false)
+
+static void
+log_queue_drain(void)
+{
+}
+
+bool
+msyslog_queue(
+	bool	on
+	)
+{
+	if (on)
+		msyslog(LOG_WARNING,
+			"LOG: queued logging needs <stdatomic.h>, "
+			"logging directly");
+	return false;
+}
+
+uint64_t
+msyslog_written(void)
+{
+	return log_written;
+}
+
+uint64_t
+msyslog_repeated(void)
+{
+	return 0;
+}
+
+uint64_t
+msyslog_dropped(void)
+{
+	return 0;
+}
+
+#endif /* HAVE_STDATOMIC_H */
+
+
 void
 msyslog(
 	int		level,
@@ -182,13 +582,20 @@ msyslog(
 	...
 	)
 {
-	char	buf[1024];
+	char	buf[MSYSLOG_BUFLEN];
 	va_list	ap;
 
 	va_start(ap, fmt);
+#if defined(HAVE_STDATOMIC_H)
+	if (atomic_load_explicit(&log_q.on, memory_order_relaxed)) {
+		log_queue_put(level, fmt, ap);
+		va_end(ap);
+		return;
+	}
+#endif /* HAVE_STDATOMIC_H */
 	vsnprintf(buf, sizeof(buf), fmt, ap);
 	va_end(ap);
-	addto_syslog(level, buf);
+	addto_syslog(level, buf, time(NULL));
 }
 
 
@@ -339,6 +746,9 @@ change_logfile(
 		msyslog(LOG_NOTICE, "LOG: switching logging to file %s",
 			abs_fname);
 
+	/* what is queued goes to the old log */
+	log_queue_drain();
+	LOG_LOCK();
 	if (syslog_file != NULL &&
 	    syslog_file != stderr && syslog_file != stdout &&
 	    fileno(syslog_file) != fileno(new_file)) {
@@ -359,6 +769,7 @@ change_logfile(
 		syslog_abs_fname = abs_fname;
 	}
 	syslogit = false;
+	LOG_UNLOCK();
 
 	return 0;
 }
@@ -430,14 +841,21 @@ check_logfile(void)
 	 * newsyslog on FreeBSD puts a "logfile turned over" message there.
 	 * This seems to work.
 	 */
+	log_queue_drain();
+	LOG_LOCK();
 	if (ftell(syslog_file) == ftell(new_file)) {
+		LOG_UNLOCK();
 		fclose(new_file);
 		return;
 	}
+	LOG_UNLOCK();
 
 	msyslog(LOG_INFO, "LOG: check_logfile: closing old file");
+	log_queue_drain();
+	LOG_LOCK();
 	fclose(syslog_file);
 	syslog_file = new_file;
+	LOG_UNLOCK();
 	msyslog(LOG_INFO, "LOG: check_logfile: using %s", syslog_fname);
 }
 
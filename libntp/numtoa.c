@@ -5,8 +5,10 @@
 
 #include <sys/types.h>
 #include <netinet/in.h>		/* ntohl */
+#include <arpa/inet.h>		/* inet_ntop */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "ntp_fp.h"
 #include "lib_strbuf.h"
@@ -19,23 +21,37 @@ refid_str(
 	int	stratum
 	)
 {
-	char *	text;
+	return refid_str_r(refid, stratum, lib_getbuf(), LIB_BUFLENGTH);
+}
+
+const char *
+refid_str_r(
+	uint32_t	refid,
+	int	stratum,
+	char *	buf,
+	size_t	buflen
+	)
+{
+	char	text[INET_ADDRSTRLEN];
 	size_t	tlen;
 
 	if (stratum > 1) {
 		struct in_addr in4;
 		in4.s_addr = refid;
-		return inet_ntoa(in4);
+		/* inet_ntop() won't cut it short, so strlcpy() does */
+		if (NULL == inet_ntop(AF_INET, &in4, text, sizeof(text)))
+			text[0] = '\0';
+		strlcpy(buf, text, buflen);
+		return buf;
 	}
 
-	text = lib_getbuf();
 	text[0] = '.';
 	memcpy(&text[1], &refid, sizeof(refid));
 	text[1 + sizeof(refid)] = '\0';
 	tlen = strlen(text);
 	text[tlen] = '.';
 	text[tlen + 1] = '\0';
+	strlcpy(buf, text, buflen);
 
-	return text;
+	return buf;
 }
-
@@ -115,21 +115,26 @@ get_struct_tm(
 	return tm;
 }
 
+/*
+ * common_prettydate - format ts into bp, with the raw timestamp in hex
+ * in front if hex
+ */
 static char *
 common_prettydate(
-	const l_fp ts
+	const l_fp ts,
+	bool	hex,
+	char *	bp,
+	size_t	len
 	)
 {
-	static const char pfmt[] =
-	    "%08lx.%08lx %04d-%02d-%02dT%02d:%02d:%02d.%03u";
+	static const char pfmt[] = "%04d-%02d-%02dT%02d:%02d:%02d.%03uZ";
 
-	char	    *bp;
 	struct tm   *tm, tmbuf;
 	unsigned int	     msec;
 	uint32_t	     ntps;
 	time64_t	     sec;
-
-	bp = lib_getbuf();
+	char *		     cp;
+	size_t		     n;
 
 	/* get & fix milliseconds */
 	ntps = lfpuint(ts);
@@ -138,6 +143,17 @@ common_prettydate(
 		msec -= 1000U;
 		ntps++;
 	}
+
+	cp = bp;
+	if (hex) {
+		snprintf(bp, len, "%08lx.%08lx ",
+			 (unsigned long)lfpuint(ts),
+			 (unsigned long)lfpfrac(ts));
+		n = strlen(bp);
+		cp += n;
+		len -= n;
+	}
+
 	sec = ntpcal_ntp_to_time(ntps, RELEASE_DATE);
 	tm  = get_struct_tm(&sec, &tmbuf);
 	if (!tm) {
@@ -147,17 +163,13 @@ common_prettydate(
 		 */
 		struct calendar jd;
 		ntpcal_time_to_date(&jd, sec);
-		snprintf(bp, LIB_BUFLENGTH, pfmt,
-			 (unsigned long)lfpuint(ts), (unsigned long)lfpfrac(ts),
+		snprintf(cp, len, pfmt,
 			 jd.year, jd.month, jd.monthday,
 			 jd.hour, jd.minute, jd.second, msec);
-		strlcat(bp, "Z",  LIB_BUFLENGTH);
 	} else {
-		snprintf(bp, LIB_BUFLENGTH, pfmt,
-			 (unsigned long)lfpuint(ts), (unsigned long)lfpfrac(ts),
+		snprintf(cp, len, pfmt,
 			 1900 + tm->tm_year, tm->tm_mon+1, tm->tm_mday,
 			 tm->tm_hour, tm->tm_min, tm->tm_sec, msec);
-		strlcat(bp, "Z", LIB_BUFLENGTH);
 	}
 	return bp;
 }
@@ -168,7 +180,18 @@ prettydate(
 	const l_fp ts
 	)
 {
-	return common_prettydate(ts);
+	return common_prettydate(ts, true, lib_getbuf(), LIB_BUFLENGTH);
+}
+
+
+char *
+prettydate_r(
+	const l_fp ts,
+	char *	buf,
+	size_t	buflen
+	)
+{
+	return common_prettydate(ts, true, buf, buflen);
 }
 
 
@@ -177,7 +200,18 @@ rfc3339date(
 	const l_fp ts
 	)
 {
-	return common_prettydate(ts) + 18; /* skip past hex time */
+	return common_prettydate(ts, false, lib_getbuf(), LIB_BUFLENGTH);
+}
+
+
+char *
+rfc3339date_r(
+	const l_fp ts,
+	char *	buf,
+	size_t	buflen
+	)
+{
+	return common_prettydate(ts, false, buf, buflen);
 }
 
 
@@ -188,19 +222,28 @@ char * rfc3339time(
 	time_t	posix_stamp
 	)
 {
-	char *		buf;
+	return rfc3339time_r(posix_stamp, lib_getbuf(), LIB_BUFLENGTH);
+}
+
+
+char *
+rfc3339time_r(
+	time_t	posix_stamp,
+	char *	buf,
+	size_t	buflen
+	)
+{
 	struct tm tm, *tm2;
 
-	buf = lib_getbuf();
 	tm2 = gmtime_r(&posix_stamp, &tm);
 	if (tm2 == NULL || tm.tm_year > 9999)
-		snprintf(buf, LIB_BUFLENGTH, "rfc3339time: %ld: range error",
+		snprintf(buf, buflen, "rfc3339time: %ld: range error",
 			 (long)posix_stamp);
 	// if (ntpcal_ntp_to_date(&tm, (uint32_t)ntp_stamp, NULL) < 0)
 	//	snprintf(buf, LIB_BUFLENGTH, "ntpcal_ntp_to_date: %ld: range error",
 	//		 (long)ntp_stamp);
 	else
-		snprintf(buf, LIB_BUFLENGTH, "%04d-%02d-%02dT%02d:%02dZ",
+		snprintf(buf, buflen, "%04d-%02d-%02dT%02d:%02dZ",
 			tm.tm_year+1900, tm.tm_mon+1, tm.tm_mday,
 			tm.tm_hour, tm.tm_min);
 	return buf;
@@ -0,0 +1,287 @@
+/*
+ * shmstats.c - write and read the shared-memory statistics segment
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * See ntp_shmstats.h for the layout and the locking.  ntpd is the
+ * writer; anything that wants its statistics can be a reader.
+ */
+
+#include "config.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if defined(HAVE_STDATOMIC_H)
+# include <stdatomic.h>
+#endif /* HAVE_STDATOMIC_H */
+
+#include "ntp_shmstats.h"
+
+#define SHMSTATS_WAIT	1	/* s to wait for the writer to finish */
+#define SHMSTATS_SPINS	16	/* yields before sleeping between reads */
+
+static void
+barrier(void)
+{
+#if defined(HAVE_STDATOMIC_H)
+	atomic_thread_fence(memory_order_seq_cst);
+#else
+	__sync_synchronize();
+#endif /* HAVE_STDATOMIC_H */
+}
+
+/* point sys and peers at the right places for the header */
+static void
+shmstats_layout(
+	struct shmstats *	s
+	)
+{
+	s->sys = (struct shmstats_sys *)((char *)s->head + s->head->head_size);
+	s->peers = (char *)s->sys + s->head->sys_size;
+}
+
+/*
+ * shmstats_create - create the segment and map it for writing
+ *
+ * Anything already there is unlinked first, whether an earlier run
+ * left it or someone else made it, and the new one is created
+ * exclusively.  So nobody else can hold it open for writing, or
+ * shrink it under us.  Anyone may read it.  Returns false, with errno
+ * set, on failure.
+ */
+bool
+shmstats_create(
+	struct shmstats *	s,
+	const char *		name
+	)
+{
+	struct shmstats_head *head;
+	size_t		size;
+	int		fd, err;
+
+	size = sizeof(*head) + sizeof(struct shmstats_sys) +
+	       SHMSTATS_PEERS * sizeof(struct shmstats_peer);
+	shm_unlink(name);
+	fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+	if (-1 == fd)
+		return false;
+	if (-1 == fchmod(fd, 0644) || -1 == ftruncate(fd, (off_t)size)) {
+		err = errno;
+		close(fd);
+		errno = err;
+		return false;
+	}
+	head = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	err = errno;
+	close(fd);
+	if (MAP_FAILED == head) {
+		errno = err;
+		return false;
+	}
+
+	/* a new object is all zeros */
+	head->magic = SHMSTATS_MAGIC;
+	head->version = SHMSTATS_VERSION;
+	head->head_size = sizeof(*head);
+	head->sys_size = sizeof(struct shmstats_sys);
+	head->peer_size = sizeof(struct shmstats_peer);
+	head->peer_slots = SHMSTATS_PEERS;
+	barrier();
+
+	s->head = head;
+	s->size = size;
+	shmstats_layout(s);
+	return true;
+}
+
+/* shmstats_begin - start an update; readers will retry until the end */
+void
+shmstats_begin(
+	struct shmstats *	s
+	)
+{
+	s->head->seq++;
+	barrier();
+}
+
+void
+shmstats_end(
+	struct shmstats *	s
+	)
+{
+	barrier();
+	s->head->seq++;
+}
+
+/* shmstats_remove - unmap the segment and, given a name, unlink it */
+void
+shmstats_remove(
+	struct shmstats *	s,
+	const char *		name
+	)
+{
+	if (NULL != s->head)
+		munmap(s->head, s->size);
+	s->head = NULL;
+	if (NULL != name)
+		shm_unlink(name);
+}
+
+/*
+ * shmstats_open - map an existing segment for reading
+ *
+ * Returns false if there is none, or it isn't one we understand; errno
+ * is EPROTO in the latter case.
+ */
+bool
+shmstats_open(
+	struct shmstats *	s,
+	const char *		name
+	)
+{
+	struct shmstats_head *head;
+	struct stat	sb;
+	uint64_t	need;
+	int		fd, err;
+
+	fd = shm_open(name, O_RDONLY, 0);
+	if (-1 == fd)
+		return false;
+	if (-1 == fstat(fd, &sb)) {
+		err = errno;
+		close(fd);
+		errno = err;
+		return false;
+	}
+	if ((size_t)sb.st_size < sizeof(*head)) {
+		close(fd);
+		errno = EPROTO;
+		return false;
+	}
+	head = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	err = errno;
+	close(fd);
+	if (MAP_FAILED == head) {
+		errno = err;
+		return false;
+	}
+
+	need = (uint64_t)head->head_size + head->sys_size +
+	       (uint64_t)head->peer_slots * head->peer_size;
+	if (SHMSTATS_MAGIC != head->magic ||
+	    SHMSTATS_VERSION != head->version ||
+	    head->head_size < sizeof(*head) ||
+	    need > (uint64_t)sb.st_size) {
+		munmap(head, (size_t)sb.st_size);
+		errno = EPROTO;
+		return false;
+	}
+
+	s->head = head;
+	s->size = (size_t)sb.st_size;
+	shmstats_layout(s);
+	return true;
+}
+
+/* copy as much of an n-byte structure as we both know, zero the rest */
+static void
+shmstats_copy(
+	void *		dst,
+	size_t		dstlen,
+	const void *	src,
+	size_t		n
+	)
+{
+	if (n > dstlen)
+		n = dstlen;
+	memcpy(dst, src, n);
+	memset((char *)dst + n, 0, dstlen - n);
+}
+
+/*
+ * shmstats_read - take a consistent copy of the segment
+ *
+ * Any of head, sys and peers may be NULL.  *npeers is the room in
+ * peers on the way in and the number copied on the way out.  An
+ * update only takes ntpd a few microseconds, but it may be descheduled
+ * in the middle of one, so a reader that catches it yields, then
+ * sleeps, and tries again.  Returns false, with errno EAGAIN, if it
+ * still hasn't got a clean copy after SHMSTATS_WAIT seconds.
+ *
+ * That doesn't tell you whether ntpd is still running; the time in
+ * the header does.  If that is more than a few seconds old, ntpd has
+ * stopped updating the segment.
+ */
+bool
+shmstats_read(
+	const struct shmstats *	s,
+	struct shmstats_head *	head,
+	struct shmstats_sys *	sys,
+	struct shmstats_peer *	peers,
+	int *			npeers
+	)
+{
+	const struct shmstats_head *h = s->head;
+	static const struct timespec pause = { 0, 100000 };
+	struct timespec	now, deadline;
+	uint32_t	seq;
+	int		n, room, i;
+
+	room = (NULL != peers && NULL != npeers) ? *npeers : 0;
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	deadline.tv_sec += SHMSTATS_WAIT;
+	for (int tries = 0; ; tries++) {
+		if (tries > 0) {
+			clock_gettime(CLOCK_MONOTONIC, &now);
+			if (now.tv_sec > deadline.tv_sec ||
+			    (now.tv_sec == deadline.tv_sec &&
+			     now.tv_nsec >= deadline.tv_nsec))
+				break;
+			if (tries < SHMSTATS_SPINS)
+				sched_yield();
+			else
+				nanosleep(&pause, NULL);
+		}
+		seq = h->seq;
+		barrier();
+		if (seq & 1)
+			continue;
+		if (NULL != head)
+			memcpy(head, (const void *)h, sizeof(*head));
+		if (NULL != sys)
+			shmstats_copy(sys, sizeof(*sys), s->sys, h->sys_size);
+		n = (int)h->peer_count;
+		if (n > (int)h->peer_slots)
+			n = (int)h->peer_slots;
+		if (n > room)
+			n = room;
+		for (i = 0; i < n; i++)
+			shmstats_copy(&peers[i], sizeof(*peers),
+				      SHMSTATS_PEER(s, i), h->peer_size);
+		barrier();
+		if (seq != h->seq)
+			continue;
+		if (NULL != npeers)
+			*npeers = n;
+		if (NULL != head)
+			head->seq = seq;
+		return true;
+	}
+	errno = EAGAIN;
+	return false;
+}
+
+void
+shmstats_close(
+	struct shmstats *	s
+	)
+{
+	shmstats_remove(s, NULL);
+}
@@ -18,61 +18,209 @@
 #include "ntp.h"
 
 /*
- * socktoa - return a numeric host name from a sockaddr_storage structure
+ * The text forms are built by hand rather than with inet_ntop() and
+ * snprintf(), as socktoa() and sockporttoa() run for every entry of
+ * an MRU list dump and for most stats and log lines.  The output is
+ * what glibc's inet_ntop() gives: lowercase hex, the first longest
+ * run of two or more zero groups shortened to "::", and dotted quad
+ * for the last 32 bits of IPv4-mapped and IPv4-compatible addresses.
  */
-const char *
-socktoa(
-	const sockaddr_u *sock
+
+/* the most a sockporttoa() string can need, with its NUL */
+#define SOCKTXT_MAX	(sizeof("[ffff:ffff:ffff:ffff:ffff:ffff:255.255.255.255") \
+			 + sizeof("%18446744073709551615]:65535") - 1)
+
+static const char hexdigits[] = "0123456789abcdef";
+
+/* unsigned decimal at cp, returning the end */
+static char *
+put_udec(
+	char *		cp,
+	unsigned long	val
 	)
 {
-	char *buf = lib_getbuf();
-	socktoa_r(sock, buf, LIB_BUFLENGTH);
-	return buf;
+	char	rev[20];
+	int	n = 0;
+
+	do {
+		rev[n++] = (char)('0' + val % 10);
+		val /= 10;
+	} while (val != 0);
+	while (n > 0)
+		*cp++ = rev[--n];
+	return cp;
 }
 
-const char *
-socktoa_r(
-	const sockaddr_u *sock, char *buf, size_t buflen
+static char *
+put_inet4(
+	char *		cp,
+	const uint8_t *	a
+	)
+{
+	for (int i = 0; i < 4; i++) {
+		unsigned int o = a[i];
+
+		if (o >= 100) {
+			*cp++ = (char)('0' + o / 100);
+			o %= 100;
+			*cp++ = (char)('0' + o / 10);
+		} else if (o >= 10) {
+			*cp++ = (char)('0' + o / 10);
+		}
+		*cp++ = (char)('0' + o % 10);
+		*cp++ = '.';
+	}
+	return cp - 1;
+}
+
+static char *
+put_inet6(
+	char *		cp,
+	const uint8_t *	a
+	)
+{
+	unsigned int	w[8];
+	int		base = -1, len = 0;
+	int		i, run;
+
+	for (i = 0; i < 8; i++)
+		w[i] = ((unsigned int)a[2 * i] << 8) | a[2 * i + 1];
+	for (i = 0; i < 8; i += run ? run : 1) {
+		for (run = 0; i + run < 8 && 0 == w[i + run]; run++)
+			continue;
+		if (run > len) {
+			base = i;
+			len = run;
+		}
+	}
+	if (len < 2)
+		base = -1;
+
+	for (i = 0; i < 8; i++) {
+		unsigned int v = w[i];
+
+		if (i == base) {
+			*cp++ = ':';
+			i += len - 1;
+			if (8 == base + len)
+				*cp++ = ':';
+			continue;
+		}
+		if (i != 0)
+			*cp++ = ':';
+		if (6 == i && 0 == base &&
+		    (6 == len || (5 == len && 0xffff == w[5])))
+			return put_inet4(cp, a + 12);
+		if (v >= 0x1000)
+			*cp++ = hexdigits[v >> 12];
+		if (v >= 0x100)
+			*cp++ = hexdigits[(v >> 8) & 0xf];
+		if (v >= 0x10)
+			*cp++ = hexdigits[(v >> 4) & 0xf];
+		*cp++ = hexdigits[v & 0xf];
+	}
+	return cp;
+}
+
+/*
+ * put_sock - the address, and the port if wanted, at cp, which has
+ * room for SOCKTXT_MAX characters.  Returns the end, or NULL for a
+ * family we don't know.
+ */
+static char *
+put_sock(
+	char *			cp,
+	const sockaddr_u *	sock,
+	bool			port
 	)
 {
-	int		saved_errno;
 	unsigned long	scope;
 
-	saved_errno = errno;
+	switch (AF(sock)) {
 
+	case AF_INET:
+	case AF_UNSPEC:
+		cp = put_inet4(cp, (const void *)PSOCK_ADDR4(sock));
+		break;
+
+	case AF_INET6:
+		if (port)
+			*cp++ = '[';
+		cp = put_inet6(cp, (const void *)PSOCK_ADDR6(sock));
+		scope = SCOPE_VAR(sock);
+		if (0 != scope) {
+			*cp++ = '%';
+			cp = put_udec(cp, scope);
+		}
+		if (port)
+			*cp++ = ']';
+		break;
+
+	default:
+		return NULL;
+	}
+	if (port) {
+		*cp++ = ':';
+		cp = put_udec(cp, SRCPORT(sock));
+	}
+	*cp = '\0';
+	return cp;
+}
+
+static const char *
+socktxt_r(
+	const sockaddr_u *sock, bool port, char *buf, size_t buflen
+	)
+{
+	char	tmp[SOCKTXT_MAX];
+	char *	cp;
+	int	saved_errno;
+
+	if (0 == buflen)
+		return buf;
 	if (NULL == sock) {
 		strlcpy(buf, "(null)", buflen);
-	} else {
-		switch(AF(sock)) {
-
-		case AF_INET:
-		case AF_UNSPEC:
-			inet_ntop(AF_INET, PSOCK_ADDR4(sock), buf, buflen);
-			break;
-
-		case AF_INET6:
-			inet_ntop(AF_INET6, PSOCK_ADDR6(sock), buf, buflen);
-			scope = SCOPE_VAR(sock);
-			if (0 != scope && !strchr(buf, '%')) {
-				char buf2[LIB_BUFLENGTH];
-				snprintf(buf2, sizeof(buf2), "%s%%%lu",
-					 buf, scope);
-				buf2[LIB_BUFLENGTH - 1] = '\0';
-				strlcpy(buf, buf2, buflen);
-			}
-			break;
-
-		default:
+		return buf;
+	}
+	cp = (buflen >= sizeof(tmp)) ? buf : tmp;
+	if (NULL == put_sock(cp, sock, port)) {
+		saved_errno = errno;
+		if (port)
+			snprintf(buf, buflen,
+				 "(socktoa unknown family %d):%hu",
+				 AF(sock), SRCPORT(sock));
+		else
 			snprintf(buf, buflen,
 				 "(socktoa unknown family %d)",
 				 AF(sock));
-		}
+		errno = saved_errno;
+	} else if (cp == tmp) {
+		strlcpy(buf, tmp, buflen);
 	}
-	errno = saved_errno;
+	return buf;
+}
 
+/*
+ * socktoa - return a numeric host name from a sockaddr_storage structure
+ */
+const char *
+socktoa(
+	const sockaddr_u *sock
+	)
+{
+	char *buf = lib_getbuf();
+	socktoa_r(sock, buf, LIB_BUFLENGTH);
 	return buf;
 }
 
+const char *
+socktoa_r(
+	const sockaddr_u *sock, char *buf, size_t buflen
+	)
+{
+	return socktxt_r(sock, false, buf, buflen);
+}
+
 
 const char *
 sockporttoa(
@@ -89,19 +237,7 @@ sockporttoa_r(
 	const sockaddr_u *sock, char *buf, size_t buflen
 	)
 {
-	int saved_errno;
-        char buf2[LIB_BUFLENGTH];
-
-	saved_errno = errno;
-	socktoa_r(sock, buf2, sizeof(buf2));
-	snprintf(buf, buflen,
-		 (IS_IPV6(sock))
-		     ? "[%s]:%hu"
-		     : "%s:%hu",
-		 buf2, SRCPORT(sock));
-	errno = saved_errno;
-
-	return buf;
+	return socktxt_r(sock, true, buf, buflen);
 }
 
 
@@ -150,5 +286,18 @@ sock_hash(
 		hashVal = 37 * hashVal + pch[j];
 	}
 
+	/*
+	 * Callers use the low bits as a table index.  On its own the
+	 * loop above maps neighbouring addresses onto a narrow range
+	 * of values (the last two octets only add 37*c+d, so 10000
+	 * consecutive IPv4 addresses give under 1700 of them), so mix
+	 * every input bit into the low ones.
+	 */
+	hashVal ^= hashVal >> 16;
+	hashVal *= 0x85ebca6bU;
+	hashVal ^= hashVal >> 13;
+	hashVal *= 0xc2b2ae35U;
+	hashVal ^= hashVal >> 16;
+
 	return hashVal;
 }
@@ -1180,6 +1180,7 @@ usage: cv [ assocID ] [ name=value[,...] ]
             ("selbroken", "bad reference time:   ", NTP_INT),
             ("candidate", "candidate order:      ", NTP_INT),
             ("ntscookies", "count of nts cookies: ", NTP_INT),
+            ("xleaved", "interleaved replies:  ", NTP_INT),
         )
         if not line:
             self.warn("usage: pstats assocID")
@@ -1555,6 +1556,13 @@ usage: kerninfo
         sysstats = (
             ("ss_uptime", "uptime:               ", NTP_UPTIME),
             ("ss_numctlreq", "control requests:     ", NTP_INT),
+            ("stats_written", "stats records written:", NTP_INT),
+            ("stats_dropped", "stats records dropped:", NTP_INT),
+            ("rawstats_filtered", "rawstats filtered:    ", NTP_INT),
+            ("rawstats_sampled", "rawstats sampled out: ", NTP_INT),
+            ("log_written", "log messages written: ", NTP_INT),
+            ("log_repeated", "log repeats folded:   ", NTP_INT),
+            ("log_dropped", "log messages dropped: ", NTP_INT),
         )
         sysstats2 = (
             ("ss_reset", "sysstats reset:       ", NTP_UPTIME),
@@ -1695,6 +1703,106 @@ function: display network input and output counters
 usage: iostats
 """)
 
+# FIXME: This table should move to ntpd
+#          so the answers track when ntpd is updated
+    def do_txstamps(self, _line):
+        "display transmit timestamp statistics"
+        txstamps = (
+            ("iostats_reset", "time since reset:      ", NTP_UPTIME),
+            ("txs_unmatched", "unmatched stamps:      ", NTP_INT),
+            ("txs_count", "replies stamped:       ", NTP_PACKETS),
+            ("txs_mean", "mean tx - xmt:         ", NTP_FLOAT),
+            ("txs_avg", "recent tx - xmt:       ", NTP_FLOAT),
+            ("txs_max", "max tx - xmt:          ", NTP_FLOAT),
+            ("txs_auth_count", "auth replies stamped:  ", NTP_PACKETS),
+            ("txs_auth_mean", "auth mean tx - xmt:    ", NTP_FLOAT),
+            ("txs_auth_avg", "auth recent tx - xmt:  ", NTP_FLOAT),
+            ("txs_auth_max", "auth max tx - xmt:     ", NTP_FLOAT),
+        )
+        self.collect_display(associd=0, variables=txstamps,
+                             decodestatus=False)
+
+    def help_txstamps(self):
+        self.say("""\
+function: display transmit timestamp statistics, the kernel's
+          transmit time of server replies minus the transmit timestamp
+          written into them, in milliseconds (see enable txstamp)
+usage: txstamps
+""")
+
+    def do_latency(self, _line):
+        "display server reply latency histograms"
+        classes = (
+            ("lat_none", "none"),
+            ("lat_symm", "symm"),
+            ("lat_nts", "nts"),
+            ("lat_none_kod", "none/kod"),
+            ("lat_symm_kod", "symm/kod"),
+            ("lat_nts_kod", "nts/kod"),
+        )
+        try:
+            queried = self.session.readvar(
+                0, ["lat_reset"] + [c[0] for c in classes], raw=True)
+        except ntp.packet.ControlException as e:
+            self.warn(e.message)
+            return
+        except IOError as e:
+            self.warn(e.strerror)
+            return
+        if self.rawmode:
+            self.say(self.session.response)
+            return
+        hists = []
+        for (name, _) in classes:
+            value = queried.get(name, ("", ""))[0]
+            try:
+                hists.append([int(x) for x in str(value).split()])
+            except ValueError:
+                hists.append([])
+        depth = max([len(h) for h in hists] + [1])
+
+        def bucket_top(i):
+            "upper bound of bucket i as a short string"
+            us = 2 ** i
+            if us < 1000:
+                return "%dus" % us
+            if us < 1000000:
+                return "%.4gms" % (us / 1e3)
+            return "%.4gs" % (us / 1e6)
+
+        if "lat_reset" in queried:
+            self.say("time since reset: %s\n"
+                     % ntp.util.periodize(queried["lat_reset"][0])[1])
+        self.say("%-12s" % "latency" +
+                 "".join(["%10s" % c[1] for c in classes]) + "\n")
+        for i in range(depth):
+            label = "<" + bucket_top(i)
+            self.say("%-12s" % label +
+                     "".join(["%10d" % (h[i] if i < len(h) else 0)
+                              for h in hists]) + "\n")
+        for pct in (50, 90, 99):
+            row = "%-12s" % ("p%d" % pct)
+            for h in hists:
+                total = sum(h)
+                bound = "-"
+                if total:
+                    seen = 0
+                    for (i, n) in enumerate(h):
+                        seen += n
+                        if seen * 100 >= total * pct:
+                            bound = bucket_top(i)
+                            break
+                row += "%10s" % bound
+            self.say(row + "\n")
+
+    def help_latency(self):
+        self.say("""\
+function: display server reply latency histograms, from receive
+          timestamp to transmit, by authentication and KoD; the
+          percentile rows are bucket upper bounds
+usage: latency
+""")
+
 # FIXME: This table should move to ntpd
 #          so the answers track when ntpd is updated
     def do_timerstats(self, line):
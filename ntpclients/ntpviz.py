@@ -8,6 +8,7 @@ ntpviz [-d LOGDIR]
        [-c | --clip]
        [-e endtime]
        [-g]
+       [-j JOBS | --jobs JOBS]
        [-n name]
        [-N | --nice]
        [-o OUTDIR]
@@ -44,7 +45,11 @@ import binascii
 import collections
 import csv
 import datetime
+import errno
+import hashlib
 import math
+import multiprocessing
+import operator
 import re
 import os
 import socket
@@ -178,8 +183,15 @@ class RunningStats(object):
             # no data??
             return
 
-        self.mu = sum(values) / self.num
-        self.variance = sum(pow((v-self.mu), 2) for v in values) / self.num
+        numpy = ntp.statfiles.numpy
+        if numpy is not None:
+            values = numpy.asarray(values, dtype=float)
+            self.mu = float(values.sum()) / self.num
+            self.variance = float(((values - self.mu) ** 2).sum()) / self.num
+        else:
+            self.mu = sum(values) / self.num
+            dev = [v - self.mu for v in values]
+            self.variance = sum(map(operator.mul, dev, dev)) / self.num
         self.sigma = math.sqrt(self.variance)
 
         if math.isnan(self.sigma) or 1e-12 >= abs(self.sigma):
@@ -188,11 +200,16 @@ class RunningStats(object):
             self.kurtosis = float('nan')
             return
 
-        m3 = 0
-        m4 = 0
-        for val in values:
-            m3 += pow(val - self.sigma, 3)
-            m4 += pow(val - self.sigma, 4)
+        if numpy is not None:
+            dev = values - self.sigma
+            dev2 = dev * dev
+            m3 = float((dev2 * dev).sum())
+            m4 = float((dev2 * dev2).sum())
+        else:
+            dev = [v - self.sigma for v in values]
+            dev2 = list(map(operator.mul, dev, dev))
+            m3 = sum(map(operator.mul, dev2, dev))
+            m4 = sum(map(operator.mul, dev2, dev2))
 
         self.skewness = m3 / (self.num * pow(self.sigma, 3))
         self.kurtosis = m4 / (self.num * pow(self.sigma, 4))
@@ -200,6 +217,21 @@ class RunningStats(object):
 # end standard deviation class
 
 
+class SortedValues(object):
+    """Sorted values of one column, shared by every plot of it, with
+    their RunningStats worked out the first time they are wanted."""
+
+    def __init__(self, values):
+        self.values = values
+        self.__running = None
+
+    def running(self):
+        "RunningStats of the values"
+        if self.__running is None:
+            self.__running = RunningStats(self.values)
+        return self.__running
+
+
 # class for calced values
 class VizStats(ntp.statfiles.NTPStats):
     "Class for calculated values"
@@ -244,7 +276,12 @@ class VizStats(ntp.statfiles.NTPStats):
 
     def __init__(self, values, title, freq=0, units=''):
 
-        values.sort()
+        if isinstance(values, SortedValues):
+            sts = values.running()
+            values = values.values
+        else:
+            values.sort()
+            sts = RunningStats(values)
         self.percs = self.percentiles((100, 99, 95, 50, 5, 1, 0), values)
 
         # find the target for autoranging
@@ -297,7 +334,6 @@ class VizStats(ntp.statfiles.NTPStats):
                 # go to nanosec
                 self.unit = "ns"
 
-        sts = RunningStats(values)
         self.percs["mu"] = sts.mu
         self.percs["pstd"] = sts.sigma
 
@@ -391,21 +427,9 @@ def gnuplot_fmt(min_val, max_val):
 # RMS frequency jitter - Deviation from root-mean-square linear approximation?
 # Investigate.
 
-def gnuplot(template, outfile=None):
-    "Run a specified gnuplot program."
-
-    if not template:
-        # silently ignore empty plots
-        return ''
-
-    if outfile is None:
-        out = None
-    else:
-        if 2 <= args.debug_level:
-            sys.stderr.write("ntpviz: INFO: sending plot output "
-                             "to %s\n" % outfile)
-        out = open(outfile, "w", encoding='utf-8')
-    ##
+def gnuplot_start(template, out):
+    """Start gnuplot on a program, output to out, returning the process
+    and the name of the file the program is in."""
 
     # can be 30% faster to write to a tmp file than to pipe to gnuplot
     # bonus, we can keep the plot file for debug.
@@ -421,28 +445,143 @@ def gnuplot(template, outfile=None):
 
     # shell=True is a security hazard, do not use
     try:
-        rcode = subprocess.call(['gnuplot', tmp_file.name], stdout=out)
+        proc = subprocess.Popen(['gnuplot', tmp_file.name], stdout=out)
     except OSError as e:
-        if e.errno == os.errno.ENOENT:
+        if e.errno == errno.ENOENT:
             # gnuplot not found
             sys.stderr.write("ntpviz: ERROR: gnuplot not found in path\n")
         else:
             # Something else went wrong while trying to run gnuplot
             sys.stderr.write("ntpviz: ERROR: gnuplot failed\n")
         raise SystemExit(1)
+    return (proc, tmp_file.name)
+
 
+def gnuplot_done(rcode, plotfile):
+    "Report how a gnuplot run went, and clean up after it."
     if 0 != rcode:
         sys.stderr.write("ntpviz: WARNING: plot returned %s\n" % rcode)
-        sys.stderr.write("ntpviz: WARNING: plot file %s\n" % tmp_file.name)
+        sys.stderr.write("ntpviz: WARNING: plot file %s\n" % plotfile)
     elif 2 <= args.debug_level:
-        sys.stderr.write("ntpviz: INFO: plot file %s\n" % tmp_file.name)
+        sys.stderr.write("ntpviz: INFO: plot file %s\n" % plotfile)
     else:
         # remove tmp file
-        os.remove(tmp_file.name)
+        os.remove(plotfile)
 
+
+def gnuplot(template, outfile=None):
+    "Run a specified gnuplot program."
+
+    if not template:
+        # silently ignore empty plots
+        return ''
+
+    if outfile is None:
+        out = None
+    else:
+        if 2 <= args.debug_level:
+            sys.stderr.write("ntpviz: INFO: sending plot output "
+                             "to %s\n" % outfile)
+        out = open(outfile, "w", encoding='utf-8')
+    ##
+
+    (proc, plotfile) = gnuplot_start(template, out)
+    rcode = proc.wait()
+    if out is not None:
+        out.close()
+    gnuplot_done(rcode, plotfile)
     return rcode
 
 
+class PlotJobs:
+    """Render plots into a directory, with up to jobs gnuplots running
+    at once while the next plots are worked out.
+
+    A digest of each plot's program, which carries its data, is kept
+    in the directory.  A plot whose image is there and whose program
+    is unchanged since that image was made is not rendered again, so
+    a run over inputs that have not changed is cheap, and one that was
+    interrupted picks up where it stopped."""
+
+    Manifest = ".ntpviz-plots"
+
+    def __init__(self, outdir, jobs=1):
+        self.outdir = outdir
+        self.jobs = max(1, jobs)
+        self.running = []
+        self.rendered = 0
+        self.skipped = 0
+        self.digests = {}
+        try:
+            with open(os.path.join(outdir, self.Manifest), "r") as fp:
+                for line in fp:
+                    fields = line.split()
+                    if 2 == len(fields):
+                        self.digests[fields[1]] = fields[0]
+        except IOError:
+            pass
+
+    def __save(self):
+        # an image is only listed once it is complete
+        manifest = os.path.join(self.outdir, self.Manifest)
+        with open(manifest + ".tmp", "w") as fp:
+            for name in sorted(self.digests):
+                fp.write("%s  %s\n" % (self.digests[name], name))
+        os.rename(manifest + ".tmp", manifest)
+
+    def __reap(self, block):
+        "Finish the jobs that are done, waiting for one if block."
+        done = [job for job in self.running if job[0].poll() is not None]
+        if not done and block:
+            self.running[0][0].wait()
+            done = [self.running[0]]
+        for job in done:
+            (proc, plotfile, out, name, digest) = job
+            self.running.remove(job)
+            out.close()
+            gnuplot_done(proc.returncode, plotfile)
+            if 0 == proc.returncode:
+                self.digests[name] = digest
+                self.rendered += 1
+        if done:
+            self.__save()
+
+    def submit(self, template, imagename):
+        "Render a plot to imagename, in the background if jobs allow."
+        if not template:
+            # silently ignore empty plots
+            return
+        digest = hashlib.sha1(template.encode('utf-8')).hexdigest()
+        outfile = os.path.join(self.outdir, imagename)
+        if self.digests.get(imagename) == digest and \
+           os.path.exists(outfile):
+            if 2 <= args.debug_level:
+                sys.stderr.write("ntpviz: INFO: %s is unchanged\n" % outfile)
+            self.skipped += 1
+            return
+        if imagename in self.digests:
+            # the old image is about to be clobbered
+            del self.digests[imagename]
+            self.__save()
+        self.__reap(False)
+        while self.jobs <= len(self.running):
+            self.__reap(True)
+        if 2 <= args.debug_level:
+            sys.stderr.write("ntpviz: INFO: sending plot output "
+                             "to %s\n" % outfile)
+        out = open(outfile, "w", encoding='utf-8')
+        (proc, plotfile) = gnuplot_start(template, out)
+        self.running.append((proc, plotfile, out, imagename, digest))
+
+    def wait(self):
+        "Wait for all the plots to be rendered."
+        while self.running:
+            self.__reap(True)
+        if 1 <= args.debug_level:
+            sys.stderr.write("ntpviz: INFO: %d plots rendered, %d unchanged\n"
+                             % (self.rendered, self.skipped))
+
+
 class NTPViz(ntp.statfiles.NTPStats):
     "Class for visualizing statistics from a single server."
 
@@ -459,16 +598,77 @@ set lmargin 10
 set rmargin 10
 """
 
+    # the fields of each stem that plots use
+    Fields = {"loopstats": (2, 3, 4, 5),
+              "peerstats": (4, 5, 7),
+              "temps": (3,),
+              "gpsd": (3, 4)}
+
     def __init__(self, statsdir,
                  sitename=None, period=None, starttime=None, endtime=None):
+        # each stem is read when a plot first needs it, as numbers
         ntp.statfiles.NTPStats.__init__(self, statsdir=statsdir,
                                         sitename=sitename,
                                         period=period,
                                         starttime=starttime,
-                                        endtime=endtime)
+                                        endtime=endtime,
+                                        streaming=True)
+        self.__columns = {}
+
+    def columns(self, stem, split=False):
+        """The numeric columns plots use from a stem, read in one pass
+        and kept; with split, a dictionary of them by source."""
+        key = (stem, split)
+        if key not in self.__columns:
+            self.__columns[key] = ntp.statfiles.StatColumns.read(
+                getattr(self, stem), self.Fields[stem], 2 if split else None)
+        return self.__columns[key]
+
+    @staticmethod
+    def prefetch(statlist, stems, jobs):
+        """Read the columns of the given (stem, split) pairs of every
+        site on up to jobs processes at once.  Workers are forked, so
+        they start with everything already known about the sites, and
+        send back only the packed columns."""
+        tasks = [(site, stem, split)
+                 for site in range(len(statlist))
+                 for (stem, split) in stems]
+        jobs = min(jobs, len(tasks))
+        if jobs < 2:
+            return
+        # the pool forks its workers when it is made
+        prefetching[:] = statlist
+        try:
+            try:
+                pool = multiprocessing.get_context("fork").Pool(jobs)
+            except AttributeError:
+                # Python 2 always forks
+                pool = multiprocessing.Pool(jobs)
+            try:
+                results = pool.map(prefetch_columns, tasks, 1)
+            finally:
+                pool.close()
+                pool.join()
+        except ValueError:
+            # no fork here, so each plot reads what it needs
+            return
+        finally:
+            del prefetching[:]
+        for ((site, stem, split), columns) in zip(tasks, results):
+            statlist[site].__columns[(stem, split)] = columns
 
     def plot_slice(self, rows, item1, item2=None):
         "slice 0,item1, maybe item2, from rows, ready for gnuplot"
+        if isinstance(rows, ntp.statfiles.StatColumns):
+            # values come back sorted, and are shared with other plots
+            fields = (item1, item2) if item2 else (item1,)
+            ret = [rows.plot(*fields)]
+            for field in fields:
+                ret.append(rows.memo(
+                    ("viz", field) + fields,
+                    lambda: SortedValues(rows.sorted(field, fields))))
+            return tuple(ret)
+
         # speed up by only sending gnuplot the data it will actually use
         # WARNING: this is hot code, only modify if you profile
         # since we are looping the data, get the values too
@@ -485,9 +685,10 @@ set rmargin 10
                         # more than 2,200 seconds between points
                         # data loss, add a break in the plot line
                         plot_data += '\n'
-                    # fields: time, fld1, and fld2
-                    plot_data += row[1] + ' ' + row[item1] + ' ' \
-                        + row[item2] + '\n'
+                    # fields: time, fld1, and fld2; numbers from
+                    # binary files print as they would have been read
+                    plot_data += '%s %s %s\n' % (row[1], row[item1],
+                                                  row[item2])
                     last_time = row[0]
                 except IndexError:
                     continue
@@ -505,7 +706,7 @@ set rmargin 10
                         # data loss, add a break in the plot line
                         plot_data += '\n'
                     # fields: time, fld
-                    plot_data += row[1] + ' ' + row[item1] + '\n'
+                    plot_data += '%s %s\n' % (row[1], row[item1])
                     last_time = row[0]
                 except IndexError:
                     pass
@@ -523,13 +724,14 @@ set rmargin 10
 
     def local_offset_gnuplot(self):
         "Generate gnuplot code graphing local clock loop statistics"
-        if not self.loopstats:
+        loopstats = self.columns("loopstats")
+        if not loopstats:
             sys.stderr.write("ntpviz: WARNING: no loopstats to graph\n")
             return ''
 
         # speed up by only sending gnuplot the data it will actually use
         # fields: time, time offset, freq offset
-        (plot_data, values, values_f) = self.plot_slice(self.loopstats, 2, 3)
+        (plot_data, values, values_f) = self.plot_slice(loopstats, 2, 3)
 
         # compute clock offset
         stats = VizStats(values, "Local Clock Time Offset")
@@ -586,11 +788,12 @@ file.</p>
 
     def local_freq_temps_plot(self):
         "Generate gnuplot code graphing local frequency and temps"
-        if not self.loopstats:
+        loopstats = self.columns("loopstats")
+        if not loopstats:
             sys.stderr.write("ntpviz: WARNING: no loopstats to graph\n")
             return ''
 
-        tempsmap = self.tempssplit()
+        tempsmap = self.columns("temps", split=True)
         tempslist = list(tempsmap.keys())
         tempslist.sort()
         if not tempsmap or not tempslist:
@@ -599,7 +802,7 @@ file.</p>
 
         # speed up by only sending gnuplot the data it will actually use
         # fields: time, freq offset
-        (plot_data, values_f) = self.plot_slice(self.loopstats, 3)
+        (plot_data, values_f) = self.plot_slice(loopstats, 3)
 
         # compute frequency offset
         stats_f = VizStats(values_f, "Local Clock Frequency Offset", freq=1)
@@ -680,7 +883,7 @@ file, and field 3 from the tempstats log file.</p>
     def local_temps_gnuplot(self):
         "Generate gnuplot code graphing local temperature statistics"
         sitename = self.sitename
-        tempsmap = self.tempssplit()
+        tempsmap = self.columns("temps", split=True)
         tempslist = list(tempsmap.keys())
         tempslist.sort()
 
@@ -742,7 +945,7 @@ component of frequency drift.</p>
     def local_gps_gnuplot(self):
         "Generate gnuplot code graphing local GPS statistics"
         sitename = self.sitename
-        gpsmap = self.gpssplit()
+        gpsmap = self.columns("gpsd", split=True)
         gpslist = list(gpsmap.keys())
         gpslist.sort()
 
@@ -824,7 +1027,8 @@ impossible.</p>
 
     def local_error_gnuplot(self):
         "Plot the local clock frequency error."
-        if not self.loopstats:
+        loopstats = self.columns("loopstats")
+        if not loopstats:
             sys.stderr.write("ntpviz: WARNING: no loopstats to graph\n")
             return ''
 
@@ -832,7 +1036,7 @@ impossible.</p>
 
         # speed up by only sending gnuplot the data it will actually use
         # fields: time, freq error
-        (plot_data, values) = self.plot_slice(self.loopstats, 3)
+        (plot_data, values) = self.plot_slice(loopstats, 3)
 
         # compute frequency offset
         stats = VizStats(values, "Local Clock Frequency Offset", freq=1,)
@@ -883,13 +1087,14 @@ line at 0ppm.  Expected values of 99%-1% percentiles: 0.4ppm</p>
 
     def loopstats_gnuplot(self, fld, title, legend, freq):
         "Generate gnuplot code of a given loopstats field"
-        if not self.loopstats:
+        loopstats = self.columns("loopstats")
+        if not loopstats:
             sys.stderr.write("ntpviz: WARNING: no loopstats to graph\n")
             return ''
 
         # speed up by only sending gnuplot the data it will actually use
         # fields: time, fld
-        (plot_data, values) = self.plot_slice(self.loopstats, fld)
+        (plot_data, values) = self.plot_slice(loopstats, fld)
 
         # process the values
         stats = VizStats(values, title, freq=freq)
@@ -961,7 +1166,7 @@ plot \
     def peerstats_gnuplot(self, peerlist, fld, title, ptype):
         "Plot a specified field from peerstats."
 
-        peerdict = self.peersplit()
+        peerdict = self.columns("peerstats", split=True)
         if not peerlist:
             peerlist = list(peerdict.keys())
             if not peerlist:
@@ -1185,14 +1390,15 @@ plot \
 
     def local_offset_histogram_gnuplot(self):
         "Plot a histogram of clock offset values from loopstats."
-        if not self.loopstats:
+        loopstats = self.columns("loopstats")
+        if not loopstats:
             sys.stderr.write("ntpviz: WARNING: no loopstats to graph\n")
             return ''
 
         # TODO normalize to 0 to 100?
 
         # grab and sort the values, no need for the timestamp, etc.
-        values = [float(row[2]) for row in self.loopstats]
+        values = self.plot_slice(loopstats, 2)[1]
         stats = VizStats(values, 'Local Clock Offset')
         out = stats.percs
         out["fmt_x"] = stats.percs["fmt"]
@@ -1210,12 +1416,19 @@ plot \
             rnd1 = 9        # round to 1 ns boxes
             out['boxwidth'] = S_PER_NS
 
-        # Python 2.6  has no collections.Counter(), so fake it.
-        cnt = collections.defaultdict(int)
-        for value in values:
-            # put into buckets
-            # for a +/- 50 microSec range that is 1,000 buckets to plot
-            cnt[round(value, rnd1)] += 1
+        # put into buckets
+        # for a +/- 50 microSec range that is 1,000 buckets to plot
+        numpy = ntp.statfiles.numpy
+        if numpy is not None:
+            (keys, counts) = numpy.unique(numpy.round(values.values, rnd1),
+                                          return_counts=True)
+            cnt = zip(keys.tolist(), counts.tolist())
+        else:
+            # Python 2.6  has no collections.Counter(), so fake it.
+            cnt = collections.defaultdict(int)
+            for value in values.values:
+                cnt[round(value, rnd1)] += 1
+            cnt = cnt.items()
 
         sigma = True
         if args.clip:
@@ -1272,7 +1485,7 @@ plot \
  "-" using ($1 * %(multiplier)s):2 title "histogram" with boxes
 ''' % out
 
-        histogram_data = ["%s %s\n" % (k, v) for k, v in cnt.items()]
+        histogram_data = ["%s %s\n" % (k, v) for k, v in cnt]
 
         exp = """\
 <p>The clock offsets of the local clock as a histogram.</p>
@@ -1292,6 +1505,16 @@ plot \
 # of such objects, not a single one.
 
 
+# the sites being prefetched, left where forked workers find them
+prefetching = []
+
+
+def prefetch_columns(task):
+    "Read one stem of one site, in a worker process."
+    (site, stem, split) = task
+    return prefetching[site].columns(stem, split)
+
+
 def local_offset_multiplot(statlist):
     "Plot comparative local offsets for a list of NTPViz objects."
 
@@ -1318,7 +1541,7 @@ plot \\
     for stats in statlist:
         # speed up by only sending gnuplot the data it will actually use
         # fields: time, offset
-        pt = stats.plot_slice(stats.loopstats, 2)
+        pt = stats.plot_slice(stats.columns("loopstats"), 2)
         plot_data += pt[0]
 
     ret = {'html': '', 'stats': []}
@@ -1428,6 +1651,11 @@ Python by ESR, concept and gnuplot code by Dan Drown.
                         action="store_true",
                         dest='generate',
                         help="Run through gnuplot to make plot images")
+    parser.add_argument('-j', '--jobs',
+                        default=multiprocessing.cpu_count(),
+                        dest='jobs',
+                        help="how many plots to work on at once",
+                        type=int)
     parser.add_argument('-n', '--name',
                         default=socket.getfqdn(),
                         dest='sitename',
@@ -1942,8 +2170,14 @@ ntpviz</a>, part of the <a href="https://www.ntpsec.org/">NTPsec project</a>
             pass
 
     if len(statlist) > 1:
-        index_buffer += local_offset_multiplot(statlist)
+        NTPViz.prefetch(statlist, [("loopstats", False)], args.jobs)
+        imagepairs = [("local-offset-multiplot",
+                       local_offset_multiplot(statlist))]
     else:
+        NTPViz.prefetch(statlist, [("loopstats", False),
+                                   ("peerstats", True),
+                                   ("temps", True),
+                                   ("gpsd", True)], args.jobs)
         # imagepairs in the order of the html entries
         imagepairs = [
             ("local-offset", stats.local_offset_gnuplot()),
@@ -1958,7 +2192,7 @@ ntpviz</a>, part of the <a href="https://www.ntpsec.org/">NTPsec project</a>
             ("peer-offsets", stats.peer_offsets_gnuplot()),
         ]
 
-        peerlist = list(stats.peersplit().keys())
+        peerlist = list(stats.columns("peerstats", split=True).keys())
         # sort for output order stability
         peerlist.sort()
         for key in peerlist:
@@ -1971,31 +2205,33 @@ ntpviz</a>, part of the <a href="https://www.ntpsec.org/">NTPsec project</a>
             imagepairs.append(("peer-jitter-" + key,
                                stats.peer_jitters_gnuplot([key])))
 
-        stats = []
-        for (imagename, image) in imagepairs:
-            if not image:
-                continue
-            if 1 <= args.debug_level:
-                sys.stderr.write("ntpviz: plotting %s\n" % image['title'])
-            stats.append(image['stats'])
-            # give each H2 an unique ID.
-            div_id = image['title'].lower().replace(' ', '_').replace(':', '_')
+    # plots render while the rest are worked out
+    jobs = PlotJobs(args.outdir, args.jobs)
+    stats = []
+    for (imagename, image) in imagepairs:
+        if not image:
+            continue
+        if 1 <= args.debug_level:
+            sys.stderr.write("ntpviz: plotting %s\n" % image['title'])
+        stats.append(image['stats'])
+        # give each H2 an unique ID.
+        div_id = image['title'].lower().replace(' ', '_').replace(':', '_')
 
-            index_buffer += """\
+        index_buffer += """\
 <div id="%s">\n<h2><a class="section" href="#%s">%s</a></h2>
 """ % (div_id, div_id, image['title'])
 
-            div_name = imagename.replace('-', ' ')
-            # Windows hates colons in filename
-            imagename = imagename.replace(':', '-')
-            index_buffer += imagewrapper % (imagename, div_name)
-
-            if image['html']:
-                index_buffer += "<div>\n%s</div>\n" % image['html']
-            index_buffer += "<br><br>\n"
-            gnuplot(image['plot'], os.path.join(args.outdir,
-                    imagename + args.img_ext))
-            index_buffer += "</div>\n"
+        div_name = imagename.replace('-', ' ')
+        # Windows hates colons in filename
+        imagename = imagename.replace(':', '-')
+        index_buffer += imagewrapper % (imagename, div_name)
+
+        if image['html']:
+            index_buffer += "<div>\n%s</div>\n" % image['html']
+        index_buffer += "<br><br>\n"
+        jobs.submit(image['plot'], imagename + args.img_ext)
+        index_buffer += "</div>\n"
+    jobs.wait()
 
     # dump stats
     csvs = []
@@ -57,6 +57,7 @@ struct key_tok ntp_keywords[] = {
 { "rlimit",		T_Rlimit,		FOLLBY_TOKEN },
 { "server",		T_Server,		FOLLBY_STRING },
 { "setvar",		T_Setvar,		FOLLBY_STRING },
+{ "stages",		T_Stages,		FOLLBY_TOKEN },
 { "statistics",		T_Statistics,		FOLLBY_TOKEN },
 { "statsdir",		T_Statsdir,		FOLLBY_STRING },
 { "sys",		T_Sys,			FOLLBY_TOKEN },
@@ -88,6 +89,7 @@ struct key_tok ntp_keywords[] = {
 { "noselect",		T_Noselect,		FOLLBY_TOKEN },
 { "true",		T_True,			FOLLBY_TOKEN },
 { "prefer",		T_Prefer,		FOLLBY_TOKEN },
+{ "xleave",		T_Xleave,		FOLLBY_TOKEN },
 { "subtype",		T_Subtype,		FOLLBY_TOKEN },
 { "version",		T_Version,		FOLLBY_TOKEN },
 /*** MONITORING COMMANDS ***/
@@ -100,9 +102,11 @@ struct key_tok ntp_keywords[] = {
 { "sysstats", 		T_Sysstats,		FOLLBY_TOKEN },
 { "usestats",		T_Usestats,		FOLLBY_TOKEN },
 /* filegen_option */
+{ "binary",		T_Binary,		FOLLBY_TOKEN },
 { "file",		T_File,			FOLLBY_STRING },
 { "link",		T_Link,			FOLLBY_TOKEN },
 { "nolink",		T_Nolink,		FOLLBY_TOKEN },
+{ "text",		T_Text,			FOLLBY_TOKEN },
 { "type",		T_Type,			FOLLBY_TOKEN },
 /* filegen_type */
 { "age",		T_Age,			FOLLBY_TOKEN },
@@ -112,6 +116,13 @@ struct key_tok ntp_keywords[] = {
 { "pid",		T_Pid,			FOLLBY_TOKEN },
 { "week",		T_Week,			FOLLBY_TOKEN },
 { "year",		T_Year,			FOLLBY_TOKEN },
+/* rawstats_option */
+{ "interval",		T_Interval,		FOLLBY_TOKEN },
+{ "reservoir",		T_Reservoir,		FOLLBY_TOKEN },
+{ "sample",		T_Sample,		FOLLBY_TOKEN },
+/* metrics_option */
+{ "metrics",		T_Metrics,		FOLLBY_TOKEN },
+{ "port",		T_Port,			FOLLBY_TOKEN },
 /*** ORPHAN MODE COMMANDS ***/
 /* tos_option */
 { "minclock",		T_Minclock,		FOLLBY_TOKEN },
@@ -170,13 +181,17 @@ struct key_tok ntp_keywords[] = {
 { "auth",		T_Auth,			FOLLBY_TOKEN },
 { "calibrate",		T_Calibrate,		FOLLBY_TOKEN },
 { "kernel",		T_Kernel,		FOLLBY_TOKEN },
+{ "logqueue",		T_Logqueue,		FOLLBY_TOKEN },
 { "ntp",		T_Ntp,			FOLLBY_TOKEN },
+{ "shmstats",		T_Shmstats,		FOLLBY_TOKEN },
 { "stats",		T_Stats,		FOLLBY_TOKEN },
+{ "txstamp",		T_Txstamp,		FOLLBY_TOKEN },
 /* rlimit_option */
 { "memlock",		T_Memlock,		FOLLBY_TOKEN },
 { "stacksize",		T_Stacksize,		FOLLBY_TOKEN },
 { "filenum",		T_Filenum,		FOLLBY_TOKEN },
 /* tinker_option */
+{ "adjrate",		T_Adjrate,		FOLLBY_TOKEN },
 { "step",		T_Step,			FOLLBY_TOKEN },
 { "stepback",		T_Stepback,		FOLLBY_TOKEN },
 { "stepfwd",		T_Stepfwd,		FOLLBY_TOKEN },
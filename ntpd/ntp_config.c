@@ -236,6 +236,8 @@ static void destroy_addr_opts_fifo(addr_opts_fifo *);
 
 static void config_logconfig(config_tree *);
 static void config_monitor(config_tree *);
+static void config_rawstats(config_tree *);
+static void config_metrics(config_tree *);
 static void config_rlimit(config_tree *);
 static void config_system_opts(config_tree *);
 static void config_tinker(config_tree *);
@@ -624,6 +626,10 @@ create_peer_node(
 			case T_True:
 				my_node->ctl.flags |= FLAG_TRUE;
 				break;
+
+			case T_Xleave:
+				my_node->ctl.flags |= FLAG_XLEAVE;
+				break;
 			}
 			break;
 
@@ -715,6 +721,19 @@ create_peer_node(
 			my_node->ctl.baud = option->value.u;
 			break;
 
+		case T_Stages:
+			if (option->value.i < 2 ||
+			    option->value.i > NSTAGE_MAX) {
+				msyslog(LOG_ERR,
+					"CONFIG: stages: must be 2 to %d",
+					NSTAGE_MAX);
+				errflag = true;
+			} else {
+				my_node->ctl.stages =
+					(uint32_t)option->value.i;
+			}
+			break;
+
 			/*
 			 * Past this point are options the old syntax
 			 * handled in fudge processing. They're parsed
@@ -1393,6 +1412,14 @@ config_monitor(
 					filegen_flag &= ~FGEN_FLAG_LINK;
 					break;
 
+				case T_Binary:
+					filegen_flag |= FGEN_FLAG_BINARY;
+					break;
+
+				case T_Text:
+					filegen_flag &= ~FGEN_FLAG_BINARY;
+					break;
+
 				case T_Enable:
 					filegen_flag |= FGEN_FLAG_ENABLED;
 					break;
@@ -1419,6 +1446,146 @@ config_monitor(
 		filegen_config(filegen, statsdir, filegen_file,
 			       (unsigned int)filegen_type, (unsigned int)filegen_flag);
 	}
+
+	config_rawstats(ptree);
+	config_metrics(ptree);
+}
+
+
+/*
+ * config_rawstats - volume controls for rawstats on busy servers
+ */
+static void
+config_rawstats(
+	config_tree *ptree
+	)
+{
+	attr_val *	my_opt;
+	sockaddr_u	addr;
+	char *		slash;
+	char *		end;
+	unsigned long	bits;
+	int		keep = -1;
+	int		interval = -1;
+
+	my_opt = HEAD_PFIFO(ptree->rawstats_opts);
+	for (; my_opt != NULL; my_opt = my_opt->link) {
+		switch (my_opt->attr) {
+
+		case T_Sample:
+			if (my_opt->value.i < 1) {
+				msyslog(LOG_ERR,
+					"CONFIG: rawstats sample %d out of range, ignored",
+					my_opt->value.i);
+				break;
+			}
+			rawstats_sample((unsigned int)my_opt->value.i);
+			break;
+
+		case T_Reservoir:
+			keep = my_opt->value.i;
+			break;
+
+		case T_Interval:
+			interval = my_opt->value.i;
+			break;
+
+		case T_Peer:
+			/* address, optionally followed by /prefix-length */
+			slash = strchr(my_opt->value.s, '/');
+			if (NULL != slash)
+				*slash++ = '\0';
+			ZERO_SOCK(&addr);
+			if (1 != getnetnum(my_opt->value.s, &addr)) {
+				msyslog(LOG_ERR,
+					"CONFIG: rawstats peer %s is not a numeric address, ignored",
+					my_opt->value.s);
+				break;
+			}
+			bits = IS_IPV4(&addr) ? 32 : 128;
+			if (NULL != slash) {
+				unsigned long max = bits;
+
+				bits = strtoul(slash, &end, 10);
+				if (end == slash || '\0' != *end || bits > max) {
+					msyslog(LOG_ERR,
+						"CONFIG: rawstats peer %s/%s has a bad prefix length, ignored",
+						my_opt->value.s, slash);
+					break;
+				}
+			}
+			rawstats_include(&addr, (unsigned int)bits);
+			break;
+
+		default:
+			msyslog(LOG_ERR,
+				"CONFIG: Unknown rawstats option token %d",
+				my_opt->attr);
+			exit(1);
+		}
+	}
+	if (keep >= 0 || interval >= 0) {
+		if (keep < 0)
+			keep = RAWSTATS_KEEP;
+		if (interval < 1)
+			interval = RAWSTATS_INTERVAL;
+		rawstats_reservoir((unsigned int)keep, (unsigned int)interval);
+	}
+}
+
+
+/*
+ * config_metrics - where to serve the OpenMetrics text, and how often
+ * to refresh it
+ */
+static void
+config_metrics(
+	config_tree *ptree
+	)
+{
+	attr_val *	my_opt;
+	const char *	path = NULL;
+	int		port = 0;
+	int		interval = 0;
+
+	my_opt = HEAD_PFIFO(ptree->metrics_opts);
+	if (NULL == my_opt)
+		return;
+	for (; my_opt != NULL; my_opt = my_opt->link) {
+		switch (my_opt->attr) {
+
+		case T_Port:
+			if (my_opt->value.i < 1 || my_opt->value.i > 65535) {
+				msyslog(LOG_ERR,
+					"CONFIG: metrics port %d out of range, ignored",
+					my_opt->value.i);
+				break;
+			}
+			port = my_opt->value.i;
+			break;
+
+		case T_Path:
+			path = my_opt->value.s;
+			break;
+
+		case T_Interval:
+			if (my_opt->value.i < 1) {
+				msyslog(LOG_ERR,
+					"CONFIG: metrics interval %d out of range, ignored",
+					my_opt->value.i);
+				break;
+			}
+			interval = my_opt->value.i;
+			break;
+
+		default:
+			msyslog(LOG_ERR,
+				"CONFIG: Unknown metrics option token %d",
+				my_opt->attr);
+			exit(1);
+		}
+	}
+	metrics_config(port, path, interval);
 }
 
 
@@ -1434,6 +1601,8 @@ free_config_monitor(
 
 	FREE_INT_FIFO(ptree->stats_list);
 	FREE_FILEGEN_FIFO(ptree->filegen_opts);
+	FREE_ATTR_VAL_FIFO(ptree->rawstats_opts);
+	FREE_ATTR_VAL_FIFO(ptree->metrics_opts);
 }
 
 
@@ -1868,6 +2037,10 @@ config_tinker(
 			INSIST(0);
 			break;
 
+		case T_Adjrate:
+			item = LOOP_ADJRATE;
+			break;
+
 		case T_Allan:
 			item = LOOP_ALLAN;
 			break;
@@ -2183,14 +2356,26 @@ apply_enable_disable(
 			proto_config(PROTO_MONITOR, (unsigned long)enable, 0.);
 			break;
 
+		case T_Logqueue:
+			msyslog_queue(enable);
+			break;
+
 		case T_Ntp:
 			proto_config(PROTO_NTP, (unsigned long)enable, 0.);
 			break;
 
+		case T_Shmstats:
+			shmstats_config(enable);
+			break;
+
 		case T_Stats:
 			proto_config(PROTO_FILEGEN, (unsigned long)enable, 0.);
 			break;
 
+		case T_Txstamp:
+			proto_config(PROTO_TXSTAMP, (unsigned long)enable, 0.);
+			break;
+
 		}
 	}
 }
@@ -2777,6 +2962,7 @@ config_peers(
 					peer->cfg.path = curr_peer->ctl.path;
 					peer->cfg.ppspath = curr_peer->ctl.ppspath;
 					peer->cfg.baud = curr_peer->ctl.baud;
+					peer->cfg.stages = curr_peer->ctl.stages;
 					if (refclock_newpeer(clktype,
 							     unit,
 							     peer))
@@ -2947,6 +3133,7 @@ config_reset_counters(
 
 		case T_Io:
 			io_clr_stats();
+			serve_latency_clr_stats();
 			break;
 
 		case T_Mem:
@@ -22,6 +22,7 @@
 #include "ntp_stdlib.h"
 #include "ntp_config.h"
 #include "ntp_assert.h"
+#include "ntp_filegen.h"
 #include "ntp_leapsec.h"
 #include "lib_strbuf.h"
 #include "ntp_syscall.h"
@@ -74,6 +75,7 @@ static	void	ctl_putts	(const char *, l_fp *);
 static	void	ctl_putadr	(const char *, refid_t, sockaddr_u *);
 static	void	ctl_putrefid	(const char *, refid_t);
 static	void	ctl_putarray	(const char *, double *, int);
+static	void	ctl_puthist	(const char *, const struct latency_hist *);
 static	void	ctl_putsys	(int);
 static	void	ctl_putpeer	(int, struct peer *);
 static	void	ctl_puttime	(const char *, time_t);
@@ -372,38 +374,84 @@ static const struct ctl_var sys_var[] = {
 	{ CS_SS_KODSENT_R,	RO, "ss_kodsent_r" },
 #define	CS_SS_PROCESSED_R		117
 	{ CS_SS_PROCESSED_R,	RO, "ss_processed_r" },
+#define	CS_LAT_RESET		118
+	{ CS_LAT_RESET,		RO, "lat_reset" },
+#define	CS_LAT_NONE		119
+	{ CS_LAT_NONE,		RO, "lat_none" },
+#define	CS_LAT_SYMM		120
+	{ CS_LAT_SYMM,		RO, "lat_symm" },
+#define	CS_LAT_NTS		121
+	{ CS_LAT_NTS,		RO, "lat_nts" },
+#define	CS_LAT_NONE_KOD		122
+	{ CS_LAT_NONE_KOD,	RO, "lat_none_kod" },
+#define	CS_LAT_SYMM_KOD		123
+	{ CS_LAT_SYMM_KOD,	RO, "lat_symm_kod" },
+#define	CS_LAT_NTS_KOD		124
+	{ CS_LAT_NTS_KOD,	RO, "lat_nts_kod" },
+#define	CS_TXS_UNMATCHED	125
+	{ CS_TXS_UNMATCHED,	RO, "txs_unmatched" },
+#define	CS_TXS_COUNT		126
+	{ CS_TXS_COUNT,		RO, "txs_count" },
+#define	CS_TXS_MEAN		127
+	{ CS_TXS_MEAN,		RO, "txs_mean" },
+#define	CS_TXS_AVG		128
+	{ CS_TXS_AVG,		RO, "txs_avg" },
+#define	CS_TXS_MAX		129
+	{ CS_TXS_MAX,		RO, "txs_max" },
+#define	CS_TXS_AUTH_COUNT	130
+	{ CS_TXS_AUTH_COUNT,	RO, "txs_auth_count" },
+#define	CS_TXS_AUTH_MEAN	131
+	{ CS_TXS_AUTH_MEAN,	RO, "txs_auth_mean" },
+#define	CS_TXS_AUTH_AVG		132
+	{ CS_TXS_AUTH_AVG,	RO, "txs_auth_avg" },
+#define	CS_TXS_AUTH_MAX		133
+	{ CS_TXS_AUTH_MAX,	RO, "txs_auth_max" },
+#define	CS_STATS_WRITTEN	134
+	{ CS_STATS_WRITTEN,	RO, "stats_written" },
+#define	CS_STATS_DROPPED	135
+	{ CS_STATS_DROPPED,	RO, "stats_dropped" },
+#define	CS_RAWSTATS_FILTERED	136
+	{ CS_RAWSTATS_FILTERED,	RO, "rawstats_filtered" },
+#define	CS_RAWSTATS_SAMPLED	137
+	{ CS_RAWSTATS_SAMPLED,	RO, "rawstats_sampled" },
+#define	CS_LOG_WRITTEN		138
+	{ CS_LOG_WRITTEN,	RO, "log_written" },
+#define	CS_LOG_REPEATED		139
+	{ CS_LOG_REPEATED,	RO, "log_repeated" },
+#define	CS_LOG_DROPPED		140
+	{ CS_LOG_DROPPED,	RO, "log_dropped" },
 #ifndef DISABLE_NTS
-#define CS_nts_client_send	118
+#define CS_nts_client_send	141
 	{ CS_nts_client_send,		RO, "nts_client_send" },
-#define CS_nts_client_recv_good	119
+#define CS_nts_client_recv_good	142
 	{ CS_nts_client_recv_good,	RO, "nts_client_recv_good" },
-#define CS_nts_client_recv_bad	120
+#define CS_nts_client_recv_bad	143
 	{ CS_nts_client_recv_bad,	RO, "nts_client_recv_bad" },
-#define CS_nts_server_send	121
+#define CS_nts_server_send	144
 	{ CS_nts_server_send,		RO, "nts_server_send" },
-#define CS_nts_server_recv_good	122
+#define CS_nts_server_recv_good	145
 	{ CS_nts_server_recv_good,	RO, "nts_server_recv_good" },
-#define CS_nts_server_recv_bad	123
+#define CS_nts_server_recv_bad	146
 	{ CS_nts_server_recv_bad,	RO, "nts_server_recv_bad" },
 
-#define CS_nts_cookie_make		124
+#define CS_nts_cookie_make		147
 	{ CS_nts_cookie_make,		RO, "nts_cookie_make" },
-#define CS_nts_cookie_decode		125
+#define CS_nts_cookie_decode		148
 	{ CS_nts_cookie_decode,		RO, "nts_cookie_decode" },
-#define CS_nts_cookie_decode_old	126
+#define CS_nts_cookie_decode_old	149
 	{ CS_nts_cookie_decode_old,	RO, "nts_cookie_decode_old" },
-#define CS_nts_cookie_decode_too_old	127
+#define CS_nts_cookie_decode_too_old	150
 	{ CS_nts_cookie_decode_too_old,	RO, "nts_cookie_decode_too_old" },
-#define CS_nts_cookie_decode_error	128
+#define CS_nts_cookie_decode_error	151
 	{ CS_nts_cookie_decode_error,	RO, "nts_cookie_decode_error" },
 
-#define CS_nts_ke_serves_good	129
+#define CS_nts_ke_serves_good	152
 	{ CS_nts_ke_serves_good,	RO, "nts_ke_serves_good" },
-#define CS_nts_ke_serves_bad	130
+#define CS_nts_ke_serves_bad	153
 	{ CS_nts_ke_serves_bad,		RO, "nts_ke_serves_bad" },
-#define CS_nts_ke_probes_good	131
+#define CS_nts_ke_probes_good	154
 	{ CS_nts_ke_probes_good,	RO, "nts_ke_probes_good" },
-#define CS_nts_ke_probes_bad	132
+#define CS_nts_ke_probes_bad	155
 	{ CS_nts_ke_probes_bad,		RO, "nts_ke_probes_bad" },
 #endif
 #define	CS_MAXCODE		((sizeof(sys_var)/sizeof(sys_var[0])) - 1)
@@ -522,6 +570,8 @@ static const struct ctl_var peer_var[] = {
 	/* new in NTPsec */
 #define	CP_NTSCOOKIES		49
 	{ CP_NTSCOOKIES, RO|DEF, "ntscookies" },
+#define	CP_XLEAVED		50
+	{ CP_XLEAVED,	RO, "xleaved" },
 #define	CP_MAXCODE		((sizeof(peer_var)/sizeof(peer_var[0])) - 1)
 	{ 0,		EOV, "" }
 };
@@ -1327,6 +1377,33 @@ ctl_putarray(
 }
 
 
+/*
+ * ctl_puthist - write a latency histogram as a quoted list of
+ *		 bucket counts, trailing empty buckets omitted
+ */
+static void
+ctl_puthist(
+	const char *tag,
+	const struct latency_hist *hist
+	)
+{
+	char buffer[LAT_BUCKETS * 21];
+	char buf[22];
+	int last, i;
+
+	for (last = LAT_BUCKETS - 1; last > 0; last--)
+		if (hist->count[last] != 0)
+			break;
+	buffer[0] = '\0';
+	for (i = 0; i <= last; i++) {
+		snprintf(buf, sizeof(buf), "%s%" PRIu64,
+			 (i == 0) ? "" : " ", hist->count[i]);
+		strlcat(buffer, buf, sizeof(buffer));
+	}
+	ctl_putstr(tag, buffer, strlen(buffer));
+}
+
+
 #define CASE_DBL(number, variable)	case number: \
 		ctl_putdbl(CV_NAME, variable); \
 		break
@@ -1631,6 +1708,61 @@ ctl_putsys(
 		ctl_putuint(sys_var[varid].text, stat_total_processed());
 		break;
 
+	CASE_UINT(CS_LAT_RESET, current_time - serve_latency_reset);
+
+	case CS_LAT_NONE:
+	case CS_LAT_SYMM:
+	case CS_LAT_NTS:
+		ctl_puthist(sys_var[varid].text,
+			    &serve_latency[varid - CS_LAT_NONE][0]);
+		break;
+
+	case CS_LAT_NONE_KOD:
+	case CS_LAT_SYMM_KOD:
+	case CS_LAT_NTS_KOD:
+		ctl_puthist(sys_var[varid].text,
+			    &serve_latency[varid - CS_LAT_NONE_KOD][1]);
+		break;
+
+	CASE_UINT(CS_TXS_UNMATCHED, txstamp_unmatched_count());
+
+	case CS_TXS_COUNT:
+	case CS_TXS_AUTH_COUNT:
+		ctl_putuint(sys_var[varid].text,
+			    txstamp_counts(CS_TXS_AUTH_COUNT == varid)->count);
+		break;
+
+	case CS_TXS_MEAN:
+	case CS_TXS_AUTH_MEAN: {
+		const struct txstamp_counters *tc =
+			txstamp_counts(CS_TXS_AUTH_MEAN == varid);
+		dtemp = (tc->count > 0) ? tc->sum / tc->count : 0;
+		ctl_putdbl6(sys_var[varid].text, dtemp * MS_PER_S);
+		break;
+	}
+
+	CASE_DBL6(CS_TXS_AVG, txstamp_counts(false)->avg * MS_PER_S);
+
+	CASE_DBL6(CS_TXS_AUTH_AVG, txstamp_counts(true)->avg * MS_PER_S);
+
+	CASE_DBL6(CS_TXS_MAX, txstamp_counts(false)->max * MS_PER_S);
+
+	CASE_DBL6(CS_TXS_AUTH_MAX, txstamp_counts(true)->max * MS_PER_S);
+
+	CASE_UINT(CS_STATS_WRITTEN, filegen_written());
+
+	CASE_UINT(CS_STATS_DROPPED, filegen_dropped());
+
+	CASE_UINT(CS_RAWSTATS_FILTERED, rawstats_filtered);
+
+	CASE_UINT(CS_RAWSTATS_SAMPLED, rawstats_sampled);
+
+	CASE_UINT(CS_LOG_WRITTEN, msyslog_written());
+
+	CASE_UINT(CS_LOG_REPEATED, msyslog_repeated());
+
+	CASE_UINT(CS_LOG_DROPPED, msyslog_dropped());
+
 	case CS_AUTHDELAY:
 		dtemp = lfptod(sys_authdelay);
 		ctl_putdbl(sys_var[varid].text, dtemp * MS_PER_S);
@@ -1936,7 +2068,7 @@ ctl_putpeer(
 				: 0);
 		break;
 
-	CASE_UINT(CP_RATE, p->throttle);
+	CASE_UINT(CP_RATE, peer_throttle(p));
 
 	CASE_UINT(CP_LEAP, p->leap);
 
@@ -2054,6 +2186,8 @@ ctl_putpeer(
 
 	CASE_INT(CP_NTSCOOKIES, p->nts_state.count);
 
+	CASE_UINT(CP_XLEAVED, p->xleaved);
+
 	default:
 		break;
 	}
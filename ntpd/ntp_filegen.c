@@ -11,10 +11,18 @@
 
 #include "config.h"
 
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
 #include <stdio.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <string.h>
+#include <time.h>
+
+#if defined(HAVE_STDATOMIC_H)
+# include <stdatomic.h>
+#endif /* HAVE_STDATOMIC_H */
 
 #include "ntpd.h"
 #include "ntp_io.h"
@@ -30,6 +38,24 @@
  * to generating files using file generations
  *
  * the generation of a file is changed according to file generation type
+ *
+ * Records are not written where they are made.  filegen_printf()
+ * formats each one into a ring shared with a writer thread, which
+ * opens, rotates, writes and flushes the files, so a slow disk holds
+ * up that thread rather than packet processing.  The ring has one
+ * producer, the main thread, and one consumer, and neither locks it.
+ * If it fills, records are dropped and counted.  The FILEGEN fields
+ * the writer uses are guarded by filegen_lock, which the writer only
+ * holds while draining a batch; waking the writer takes a lock of its
+ * own that is never held over I/O.  Without <stdatomic.h> records are written
+ * straight away, as they always used to be.
+ *
+ * A generation with a schema can be kept in the binary format that
+ * ntp_filegen.h describes instead of as text.  filegen_write() queues
+ * such a record with its strings alongside, and the writer swaps each
+ * string for its id in the file, defining it first if it is new.  A
+ * file found in the other format when a generation is opened is moved
+ * aside, the way a stray file in the way of the link is.
  */
 
 
@@ -43,10 +69,23 @@ static	void	filegen_open	(FILEGEN *, const time_t);
 static	int	valid_fileref	(const char *, const char *)
 			         __attribute__((pure));
 static	void	filegen_init	(const char *, const char *, FILEGEN *);
+static	void	filegen_strings_free	(FILEGEN *);
+static	void	filegen_emit	(FILEGEN *, const char *,
+				 const char * const *);
 #ifdef	DEBUG
 static	void	filegen_uninit		(FILEGEN *);
 #endif	/* DEBUG */
 
+/*
+ * filegen registry
+ */
+
+static struct filegen_entry {
+	char *			name;
+	FILEGEN *		filegen;
+	struct filegen_entry *	next;
+} *filegen_registry = NULL;
+
 
 /*
  * filegen_init
@@ -66,6 +105,10 @@ filegen_init(
 	fgp->id_hi = 0;
 	fgp->type = FILEGEN_DAY;
 	fgp->flag = FGEN_FLAG_LINK; /* not yet enabled !!*/
+	fgp->dirty = false;
+	fgp->binary = false;
+	fgp->schema = NULL;
+	fgp->strings = NULL;
 }
 
 
@@ -80,10 +123,220 @@ filegen_uninit(
 {
 	free(fgp->dir);
 	free(fgp->fname);
+	filegen_strings_free(fgp);
 }
 #endif
 
 
+/*
+ * Binary files
+ */
+
+#define FG_BIN_MAXREC	256		/* longest record */
+#define FG_BIN_MAXHDR	(sizeof(struct fg_bin_header) + \
+			 32 * sizeof(struct fg_bin_column))
+#define FG_STR_MAX	4096		/* ids per table before starting over */
+
+/* the strings defined in the current generation, by id */
+struct filegen_strings {
+	uint32_t	count;		/* ids given out */
+	uint32_t	mask;		/* slots less one */
+	struct fg_str_slot {
+		char *		str;	/* NULL if free */
+		uint32_t	id;
+	} *		slot;
+};
+
+static void
+filegen_strings_free(
+	FILEGEN *	gen
+	)
+{
+	struct filegen_strings *t = gen->strings;
+	uint32_t	i;
+
+	if (NULL == t)
+		return;
+	for (i = 0; i <= t->mask; i++)
+		free(t->slot[i].str);
+	free(t->slot);
+	free(t);
+	gen->strings = NULL;
+}
+
+static uint32_t
+filegen_strhash(
+	const char *	str
+	)
+{
+	uint32_t	h = 2166136261U;	/* FNV-1a */
+
+	while ('\0' != *str)
+		h = (h ^ (uint8_t)*str++) * 16777619U;
+	return h;
+}
+
+/* write the records defining string id as str */
+static void
+filegen_define(
+	FILEGEN *	gen,
+	uint32_t	id,
+	const char *	str
+	)
+{
+	char		buf[FG_BIN_MAXREC];
+	struct fg_bin_string def;
+	size_t		len, room, n;
+
+	len = strlen(str);
+	room = gen->schema->recsize - sizeof(def);
+	def.kind = FG_BIN_STRING;
+	def.id = id;
+	do {
+		n = min(len, room);
+		def.len = (uint16_t)n;
+		memset(buf, 0, gen->schema->recsize);
+		memcpy(buf, &def, sizeof(def));
+		memcpy(buf + sizeof(def), str, n);
+		fwrite(buf, 1, gen->schema->recsize, gen->fp);
+		def.kind = FG_BIN_MORE;
+		str += n;
+		len -= n;
+	} while (len > 0);
+}
+
+/* the id of str in the current generation, defining it if need be */
+static uint32_t
+filegen_string(
+	FILEGEN *	gen,
+	const char *	str
+	)
+{
+	struct filegen_strings *t = gen->strings;
+	struct fg_str_slot *old;
+	uint32_t	h, i, j, oldmask;
+
+	/*
+	 * Start over now and then, so a stream of one-off strings
+	 * can't grow the table for ever; the reader takes the latest
+	 * definition of an id.
+	 */
+	if (NULL == t || t->count >= FG_STR_MAX) {
+		filegen_strings_free(gen);
+		t = emalloc_zero(sizeof(*t));
+		t->mask = 63;
+		t->slot = emalloc_zero((t->mask + 1) * sizeof(*t->slot));
+		gen->strings = t;
+	}
+
+	h = filegen_strhash(str);
+	for (i = h & t->mask; NULL != t->slot[i].str; i = (i + 1) & t->mask)
+		if (!strcmp(t->slot[i].str, str))
+			return t->slot[i].id;
+
+	t->slot[i].str = estrdup(str);
+	t->slot[i].id = t->count++;
+	filegen_define(gen, t->slot[i].id, str);
+	h = t->slot[i].id;
+
+	/* keep it no more than half full */
+	if (2 * t->count > t->mask) {
+		old = t->slot;
+		oldmask = t->mask;
+		t->mask = 2 * oldmask + 1;
+		t->slot = emalloc_zero((t->mask + 1) * sizeof(*t->slot));
+		for (j = 0; j <= oldmask; j++) {
+			if (NULL == old[j].str)
+				continue;
+			i = filegen_strhash(old[j].str) & t->mask;
+			while (NULL != t->slot[i].str)
+				i = (i + 1) & t->mask;
+			t->slot[i] = old[j];
+		}
+		free(old);
+	}
+	return h;
+}
+
+/* write one data record; str holds a string for each 'S' column */
+static void
+filegen_emit(
+	FILEGEN *		gen,
+	const char *		rec,
+	const char * const *	str
+	)
+{
+	const FILEGEN_SCHEMA *sc = gen->schema;
+	char		buf[FG_BIN_MAXREC];
+	uint16_t	kind = FG_BIN_DATA;
+	uint32_t	id;
+	int		i, n = 0;
+
+	memcpy(buf, rec, sc->recsize);
+	memcpy(buf, &kind, sizeof(kind));
+	for (i = 0; i < sc->ncols; i++) {
+		if ('S' != sc->col[i].type)
+			continue;
+		id = filegen_string(gen, str[n++]);
+		memcpy(buf + sc->col[i].offset, &id, sizeof(id));
+	}
+	fwrite(buf, 1, sc->recsize, gen->fp);
+}
+
+/* build the header for sc in buf, returning its size */
+static size_t
+filegen_header(
+	const FILEGEN_SCHEMA *	sc,
+	char *			buf
+	)
+{
+	struct fg_bin_header hdr;
+	size_t		size;
+
+	size = sizeof(hdr) + sc->ncols * sizeof(*sc->col);
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, FG_BIN_MAGIC, sizeof(hdr.magic));
+	hdr.version = FG_BIN_VERSION;
+	hdr.size = (uint16_t)size;
+	hdr.recsize = sc->recsize;
+	hdr.ncols = sc->ncols;
+	hdr.order = FG_BIN_ORDER;
+	strlcpy(hdr.stream, sc->stream, sizeof(hdr.stream));
+	memcpy(buf, &hdr, sizeof(hdr));
+	memcpy(buf + sizeof(hdr), sc->col, sc->ncols * sizeof(*sc->col));
+	return size;
+}
+
+/*
+ * Could records in the format wanted be appended to the file?  Yes if
+ * it is missing or empty, or starts with the header they would have.
+ */
+static bool
+filegen_format_ok(
+	const char *		name,
+	const FILEGEN_SCHEMA *	sc	/* NULL for text */
+	)
+{
+	char		want[FG_BIN_MAXHDR];
+	char		got[sizeof(want)];
+	size_t		size, n;
+	FILE *		fp;
+
+	fp = fopen(name, "rb");
+	if (NULL == fp)
+		return true;
+	size = (NULL != sc) ? filegen_header(sc, want)
+			    : strlen(FG_BIN_MAGIC);
+	n = fread(got, 1, size, fp);
+	fclose(fp);
+	if (0 == n)
+		return true;
+	if (NULL != sc)
+		return n == size && !memcmp(got, want, size);
+	return n < size || memcmp(got, FG_BIN_MAGIC, size);
+}
+
+
 /*
  * open a file generation according to the current settings of gen
  * will also provide a link to basename if requested to do so
@@ -102,6 +355,13 @@ filegen_open(
 	unsigned int len, suflen;
 	FILE *fp;
 	struct tm tm;
+	const FILEGEN_SCHEMA *sc;
+	char hdr[FG_BIN_MAXHDR];
+	struct stat fst;
+	/*
+	 * try to resolve name collisions
+	 */
+	static unsigned long conflicts = 0;
 
 	/* get basic filename in buffer, leave room for extensions */
 	len = strlen(gen->dir) + strlen(gen->fname) + 65;
@@ -204,10 +464,6 @@ filegen_open(
 		 * if FGEN_FLAG_LINK is set create a link
 		 */
 		struct stat stats;
-		/*
-		 * try to resolve name collisions
-		 */
-		static unsigned long conflicts = 0;
 
 #ifndef	S_ISREG
 #define	S_ISREG(mode)	(((mode) & S_IFREG) == S_IFREG)
@@ -264,6 +520,24 @@ filegen_open(
 		}
 	}
 
+	/*
+	 * don't mix binary records and text in one file
+	 */
+	sc = (gen->flag & FGEN_FLAG_BINARY) ? gen->schema : NULL;
+	if (!filegen_format_ok(fullname, sc)) {
+		savename = emalloc(len);
+		snprintf(savename, len, "%s%c%dC%lu",
+			 fullname, SUFFIX_SEP, (int)getpid(), conflicts++);
+		if (rename(fullname, savename) != 0)
+			msyslog(LOG_ERR, "LOG: couldn't save %s: %s",
+				fullname, strerror(errno));
+		else
+			msyslog(LOG_NOTICE,
+				"LOG: %s was in another format, saved as %s",
+				fullname, savename);
+		free(savename);
+	}
+
 	/*
 	 * now, try to open new file generation...
 	 */
@@ -290,6 +564,11 @@ filegen_open(
 			gen->fp = NULL;
 		}
 		gen->fp = fp;
+		gen->binary = (NULL != sc);
+		filegen_strings_free(gen);
+		if (NULL != sc && 0 == fstat(fileno(fp), &fst) &&
+		    0 == fst.st_size)
+			fwrite(hdr, 1, filegen_header(sc, hdr), fp);
 
 		if (gen->flag & FGEN_FLAG_LINK) {
 			/*
@@ -371,6 +650,431 @@ filegen_setup(
 }
 
 
+#if defined(HAVE_STDATOMIC_H)
+
+#define FG_RINGSIZE	(1U << 18)	/* bytes; a power of two */
+#define FG_MAXREC	1024		/* longest record text, with NUL */
+#define FG_ALIGN	32		/* no less than sizeof(struct fg_rec) */
+
+/*
+ * a record in the ring, followed by its text, or for a binary record
+ * by the record and its strings, each with a NUL
+ */
+struct fg_rec {
+	FILEGEN *	gen;	/* NULL to skip to the start of the ring */
+	time_t		stamp;
+	uint32_t	len;	/* text, without the NUL */
+	uint32_t	size;	/* the whole record, padded */
+	bool		binary;
+};
+
+static struct {
+	char *		buf;
+	atomic_size_t	head;		/* bytes ever queued */
+	atomic_size_t	tail;		/* bytes ever written */
+	atomic_bool	idle;		/* writer is or is about to wait */
+	atomic_bool	stop;
+	atomic_uint_least64_t written;
+	uint64_t	dropped;	/* main thread only */
+	bool		started;
+	pthread_t	thread;
+	pthread_cond_t	wake;
+} fg_ring;
+
+/*
+ * filegen_lock keeps filegen_config() off the files while the writer
+ * is at them.  fg_wake_lock only ever covers the writer deciding to
+ * sleep, never I/O, so the main thread can take it to wake the writer
+ * without waiting on a disk.
+ */
+static pthread_mutex_t	filegen_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t	fg_wake_lock = PTHREAD_MUTEX_INITIALIZER;
+
+#define FG_LOCK()	pthread_mutex_lock(&filegen_lock)
+#define FG_UNLOCK()	pthread_mutex_unlock(&filegen_lock)
+
+/* one pass over what has been queued; called with filegen_lock held */
+static void
+filegen_drain(
+	size_t	tail,
+	size_t	head
+	)
+{
+	struct filegen_entry *f;
+	struct fg_rec *	rec;
+	const char *	str[FG_BIN_MAXSTR];
+	const char *	cp;
+	int		i;
+	uint64_t	n = 0;
+
+	while (tail != head) {
+		rec = (struct fg_rec *)(fg_ring.buf + (tail & (FG_RINGSIZE - 1)));
+		tail += rec->size;
+		if (NULL == rec->gen)
+			continue;
+		filegen_setup(rec->gen, rec->stamp);
+		/* a record queued before a format change is lost */
+		if (NULL != rec->gen->fp && rec->binary == rec->gen->binary) {
+			if (rec->binary) {
+				cp = (const char *)(rec + 1) +
+				     rec->gen->schema->recsize;
+				for (i = 0; i < FG_BIN_MAXSTR; i++) {
+					str[i] = cp;
+					cp += strlen(cp) + 1;
+				}
+				filegen_emit(rec->gen,
+					     (const char *)(rec + 1), str);
+			} else {
+				fwrite(rec + 1, 1, rec->len, rec->gen->fp);
+			}
+			rec->gen->dirty = true;
+		}
+		n++;
+	}
+	atomic_store(&fg_ring.tail, tail);
+	atomic_fetch_add_explicit(&fg_ring.written, n, memory_order_relaxed);
+
+	/* one flush per file per batch */
+	for (f = filegen_registry; f != NULL; f = f->next)
+		if (f->filegen->dirty) {
+			if (NULL != f->filegen->fp)
+				fflush(f->filegen->fp);
+			f->filegen->dirty = false;
+		}
+}
+
+static void *
+filegen_writer(
+	void *	arg
+	)
+{
+	size_t	head, tail;
+
+	UNUSED_ARG(arg);
+	for (;;) {
+		tail = atomic_load_explicit(&fg_ring.tail,
+					    memory_order_relaxed);
+		head = atomic_load(&fg_ring.head);
+		if (head != tail) {
+			FG_LOCK();
+			filegen_drain(tail, head);
+			FG_UNLOCK();
+			continue;
+		}
+		if (atomic_load(&fg_ring.stop))
+			break;
+		/*
+		 * Say we are going to sleep, then look once more, so a
+		 * record queued in between either is seen here or sees
+		 * idle and wakes us.
+		 */
+		pthread_mutex_lock(&fg_wake_lock);
+		atomic_store(&fg_ring.idle, true);
+		if (atomic_load(&fg_ring.head) == tail &&
+		    !atomic_load(&fg_ring.stop))
+			pthread_cond_wait(&fg_ring.wake, &fg_wake_lock);
+		atomic_store(&fg_ring.idle, false);
+		pthread_mutex_unlock(&fg_wake_lock);
+	}
+	return NULL;
+}
+
+/* write out whatever is queued and stop the writer, at exit */
+static void
+filegen_writer_stop(void)
+{
+	atomic_store(&fg_ring.stop, true);
+	pthread_mutex_lock(&fg_wake_lock);
+	pthread_cond_signal(&fg_ring.wake);
+	pthread_mutex_unlock(&fg_wake_lock);
+	pthread_join(fg_ring.thread, NULL);
+}
+
+static bool
+filegen_writer_start(void)
+{
+	sigset_t	block_mask, saved_sig_mask;
+	int		rc;
+
+	fg_ring.buf = emalloc(FG_RINGSIZE);
+	pthread_cond_init(&fg_ring.wake, NULL);
+	/* signals are for the main thread */
+	sigfillset(&block_mask);
+	pthread_sigmask(SIG_BLOCK, &block_mask, &saved_sig_mask);
+	rc = pthread_create(&fg_ring.thread, NULL, filegen_writer, NULL);
+	pthread_sigmask(SIG_SETMASK, &saved_sig_mask, NULL);
+	if (rc) {
+		msyslog(LOG_ERR, "LOG: can't start statistics writer: %s",
+			strerror(rc));
+		free(fg_ring.buf);
+		fg_ring.buf = NULL;
+		return false;
+	}
+	atexit(filegen_writer_stop);
+	return true;
+}
+
+/*
+ * Find room in the ring for a record of up to FG_MAXREC bytes.
+ * Returns NULL, having counted the drop, if there is none.  Only the
+ * main thread may call this, and it must call filegen_commit() next.
+ */
+static struct fg_rec *
+filegen_reserve(
+	FILEGEN *	gen
+	)
+{
+	struct fg_rec *	rec;
+	size_t		head, used, contig, size;
+
+	if (!(gen->flag & FGEN_FLAG_ENABLED))
+		return NULL;
+	if (!fg_ring.started) {
+		fg_ring.started = true;
+		if (!filegen_writer_start())
+			return NULL;
+	}
+	if (NULL == fg_ring.buf)
+		return NULL;
+
+	head = atomic_load_explicit(&fg_ring.head, memory_order_relaxed);
+	used = head - atomic_load(&fg_ring.tail);
+	contig = FG_RINGSIZE - (head & (FG_RINGSIZE - 1));
+	size = sizeof(*rec) + FG_MAXREC;
+
+	/* records don't wrap, so skip the end of the ring if need be */
+	if (contig < size) {
+		if (used + contig + size > FG_RINGSIZE) {
+			fg_ring.dropped++;
+			return NULL;
+		}
+		rec = (struct fg_rec *)(fg_ring.buf +
+					(head & (FG_RINGSIZE - 1)));
+		rec->gen = NULL;
+		rec->size = (uint32_t)contig;
+		head += contig;
+		used += contig;
+	}
+	if (used + size > FG_RINGSIZE) {
+		fg_ring.dropped++;
+		if (head != atomic_load_explicit(&fg_ring.head,
+						 memory_order_relaxed))
+			atomic_store(&fg_ring.head, head);
+		return NULL;
+	}
+	/* publish any skip now, the record goes after it */
+	if (head != atomic_load_explicit(&fg_ring.head, memory_order_relaxed))
+		atomic_store(&fg_ring.head, head);
+	return (struct fg_rec *)(fg_ring.buf + (head & (FG_RINGSIZE - 1)));
+}
+
+/* hand a record filled in after filegen_reserve() to the writer */
+static void
+filegen_commit(
+	struct fg_rec *	rec,
+	FILEGEN *	gen,
+	time_t		now,
+	size_t		len,
+	bool		binary
+	)
+{
+	size_t		head;
+
+	rec->gen = gen;
+	rec->stamp = now;
+	rec->len = (uint32_t)len;
+	rec->binary = binary;
+	rec->size = (uint32_t)((sizeof(*rec) + len + FG_ALIGN) &
+			       ~(size_t)(FG_ALIGN - 1));
+	head = atomic_load_explicit(&fg_ring.head, memory_order_relaxed);
+	atomic_store(&fg_ring.head, head + rec->size);
+
+	if (atomic_exchange(&fg_ring.idle, false)) {
+		pthread_mutex_lock(&fg_wake_lock);
+		pthread_cond_signal(&fg_ring.wake);
+		pthread_mutex_unlock(&fg_wake_lock);
+	}
+}
+
+/*
+ * queue a record for the current generation of gen at time 'now'
+ *
+ * Returns false if gen is disabled or the record was dropped.  Only
+ * the main thread may call this.
+ */
+bool
+filegen_printf(
+	FILEGEN *	gen,
+	time_t		now,
+	const char *	fmt,
+	...
+	)
+{
+	struct fg_rec *	rec;
+	va_list		ap;
+	int		len;
+
+	rec = filegen_reserve(gen);
+	if (NULL == rec)
+		return false;
+	va_start(ap, fmt);
+	len = vsnprintf((char *)(rec + 1), FG_MAXREC, fmt, ap);
+	va_end(ap);
+	if (len < 0) {
+		len = 0;
+	} else if (len >= FG_MAXREC) {
+		/* cut short, but still a line of its own */
+		len = FG_MAXREC - 1;
+		if ('\n' == fmt[strlen(fmt) - 1])
+			((char *)(rec + 1))[len - 1] = '\n';
+	}
+	filegen_commit(rec, gen, now, (size_t)len, false);
+	return true;
+}
+
+/*
+ * queue a binary record, laid out as gen's schema says, with a string
+ * for each of its 'S' columns in order
+ *
+ * Returns false if gen is disabled or the record was dropped.  Only
+ * the main thread may call this.
+ */
+bool
+filegen_write(
+	FILEGEN *		gen,
+	time_t			now,
+	const void *		data,
+	const char * const *	str
+	)
+{
+	const FILEGEN_SCHEMA *sc = gen->schema;
+	struct fg_rec *	rec;
+	char *		cp;
+	size_t		len, n;
+	int		i, nstr = 0;
+
+	if (NULL == sc)
+		return false;
+	rec = filegen_reserve(gen);
+	if (NULL == rec)
+		return false;
+	cp = (char *)(rec + 1);
+	memcpy(cp, data, sc->recsize);
+	len = sc->recsize;
+	for (i = 0; i < sc->ncols; i++)
+		if ('S' == sc->col[i].type)
+			nstr++;
+	/* the writer expects FG_BIN_MAXSTR of them, so pad with "" */
+	for (i = 0; i < FG_BIN_MAXSTR; i++) {
+		n = (i < nstr) ? strlen(str[i]) : 0;
+		n = min(n, FG_MAXREC - (FG_BIN_MAXSTR - i) - len);
+		memcpy(cp + len, (i < nstr) ? str[i] : "", n);
+		cp[len + n] = '\0';
+		len += n + 1;
+	}
+	filegen_commit(rec, gen, now, len, true);
+	return true;
+}
+
+uint64_t
+filegen_written(void)
+{
+	return atomic_load_explicit(&fg_ring.written, memory_order_relaxed);
+}
+
+uint64_t
+filegen_dropped(void)
+{
+	return fg_ring.dropped;
+}
+
+/*
+ * wait until the writer has written all that is queued
+ *
+ * For the few places that must queue more than the ring holds and
+ * can afford to wait on the disk, such as shutdown.  Only the main
+ * thread may call this.
+ */
+void
+filegen_sync(void)
+{
+	static const struct timespec pause = { 0, 1000000 };
+
+	if (NULL == fg_ring.buf)
+		return;
+	while (atomic_load(&fg_ring.tail) !=
+	       atomic_load_explicit(&fg_ring.head, memory_order_relaxed))
+		nanosleep(&pause, NULL);
+}
+
+#else /* !HAVE_STDATOMIC_H */
+
+static uint64_t fg_written;
+
+#define FG_LOCK()	do {} while (0)
+#define FG_UNLOCK()	do {} while (0)
+
+bool
+filegen_printf(
+	FILEGEN *	gen,
+	time_t		now,
+	const char *	fmt,
+	...
+	)
+{
+	va_list	ap;
+
+	filegen_setup(gen, now);
+	if (NULL == gen->fp)
+		return false;
+	va_start(ap, fmt);
+	vfprintf(gen->fp, fmt, ap);
+	va_end(ap);
+	fflush(gen->fp);
+	fg_written++;
+	return true;
+}
+
+bool
+filegen_write(
+	FILEGEN *		gen,
+	time_t			now,
+	const void *		data,
+	const char * const *	str
+	)
+{
+	if (NULL == gen->schema)
+		return false;
+	filegen_setup(gen, now);
+	if (NULL == gen->fp || !gen->binary)
+		return false;
+	filegen_emit(gen, data, str);
+	fflush(gen->fp);
+	fg_written++;
+	return true;
+}
+
+uint64_t
+filegen_written(void)
+{
+	return fg_written;
+}
+
+uint64_t
+filegen_dropped(void)
+{
+	return 0;
+}
+
+void
+filegen_sync(void)
+{
+	/* nothing is ever queued */
+}
+
+#endif /* HAVE_STDATOMIC_H */
+
+
 /*
  * change settings for filegen files
  */
@@ -400,6 +1104,7 @@ filegen_config(
 		return;
 }
 
+	FG_LOCK();
 	if (NULL != gen->fp) {
 		fclose(gen->fp);
 		gen->fp = NULL;
@@ -439,6 +1144,7 @@ filegen_config(
 	if (file_existed) {
 		filegen_setup(gen, time(NULL));
 	}
+	FG_UNLOCK();
 }
 
 
@@ -486,17 +1192,6 @@ valid_fileref(
 }
 
 
-/*
- * filegen registry
- */
-
-static struct filegen_entry {
-	char *			name;
-	FILEGEN *		filegen;
-	struct filegen_entry *	next;
-} *filegen_registry = NULL;
-
-
 FILEGEN *
 filegen_get(
 	const char *	name
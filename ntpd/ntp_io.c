@@ -100,6 +100,29 @@ struct packet_counters {
 };
 volatile struct packet_counters pkt_count;
 
+/*
+ * Transmit timestamp bookkeeping.  Each endpoint with transmit
+ * timestamps enabled remembers its last TXSTAMP_SLOTS sends,
+ * indexed by the kernel's datagram count, so the stamps that
+ * come back on the error queue can be matched to what we wrote,
+ * and handed to the MRU entry or peer doing interleaved mode.
+ */
+#define	TXSTAMP_SLOTS	256
+#define	TXSTAMP_AVG	16	/* running average time constant */
+enum txstamp_kind {TXS_SKIP, TXS_PLAIN, TXS_AUTH};
+struct txstamp_slot {
+	uint32_t	key;		/* kernel datagram count */
+	uint8_t		kind;		/* enum txstamp_kind */
+	associd_t	assoc;		/* interleaved peer, or 0 */
+	l_fp		xmt;		/* transmit timestamp written */
+	mon_entry *	mon;		/* interleaved client, or NULL */
+	l_fp		rx;		/* mon->xl_rx when sent */
+};
+static bool	txstamps_on;		/* enable txstamp */
+static bool	txstamps_used;		/* ever on, so drain the queue */
+static struct txstamp_counters txstamp_count[2]; /* [plain, auth] */
+static uint64_t	txstamp_unmatched;	/* stamps we had no send for */
+
 /*
  * Interface stuff
  */
@@ -107,6 +130,8 @@ struct ntp_io_data io_data;
 static int ninterfaces;			/* total # of interfaces */
 
 extern  SOCKET  open_socket     (sockaddr_u *, bool, endpt *);
+static	void	txstamp_arm	(endpt *, SOCKET, bool);
+static	void	txstamp_sent	(endpt *, void *, unsigned int);
 
 static bool
 netaddr_eqprefix(const isc_netaddr_t *, const isc_netaddr_t *,
@@ -141,6 +166,9 @@ static	struct refclockio *refio;
  */
 static fd_set activefds;
 static int maxactivefd;
+#ifdef HAVE_SYS_TIMERFD_H
+static int timer_fd = -1;	/* the timer tick */
+#endif
 
 /*
  * bit alternating value to detect verified interfaces during an update cycle
@@ -256,6 +284,7 @@ static int	read_network_packet	(SOCKET, endpt *);
 static void input_handler (fd_set *);
 #ifdef REFCLOCK
 static int	read_refclock_packet	(SOCKET, struct refclockio *);
+static int	read_refclock_lines	(SOCKET, struct refclockio *);
 #endif
 
 /*
@@ -741,6 +770,7 @@ delete_interface(
 	endpt *ep
 	)
 {
+	free(ep->txring);
 	free(ep);
 }
 
@@ -1981,6 +2011,8 @@ open_socket(
 	}
 
 	enable_packetstamps(fd, addr);
+	if (txstamps_on)
+		txstamp_arm(interf, fd, true);
 
 	DPRINT(4, ("bind(%d) AF_INET%s, addr %s%%%u#%d, flags 0x%x\n",
 		   fd, IS_IPV6(addr) ? "6" : "", socktoa(addr),
@@ -2036,13 +2068,177 @@ sendpkt(
 	if (cc == -1) {
 		src->notsent++;
 		pkt_count.notsent++;
+		/* may or may not have used up a kernel datagram id */
+		if (NULL != src->txring)
+			txstamp_arm(src, src->fd, true);
 	} else	{
 		src->sent++;
 		pkt_count.sent++;
+		if (NULL != src->txring)
+			txstamp_sent(src, pkt, len);
+	}
+}
+
+
+/*
+ * txstamp_arm - turn transmit timestamps on or off for an endpoint.
+ * Arming an armed endpoint drains its queue and starts over,
+ * which is how we resynchronize with the kernel's datagram count.
+ */
+static void
+txstamp_arm(
+	endpt *	ep,
+	SOCKET	fd,
+	bool	on
+	)
+{
+	if (NULL != ep->txring) {
+		fetch_txstamps(ep);
+		enable_txstamps(fd, &ep->sin, false);
+	}
+	if (on && enable_txstamps(fd, &ep->sin, true)) {
+		if (NULL == ep->txring)
+			ep->txring = emalloc(TXSTAMP_SLOTS *
+					     sizeof(*ep->txring));
+		memset(ep->txring, '\0',
+		       TXSTAMP_SLOTS * sizeof(*ep->txring));
+		ep->txkey = 0;
+		txstamps_used = true;
+	} else {
+		free(ep->txring);
+		ep->txring = NULL;
 	}
 }
 
 
+/*
+ * io_txstamps - enable or disable transmit timestamps (enable txstamp)
+ */
+void
+io_txstamps(
+	bool	on
+	)
+{
+	endpt *	ep;
+
+	if (on == txstamps_on)
+		return;
+	if (on && !txstamps_supported())
+		msyslog(LOG_WARNING,
+			"CONFIG: transmit timestamps not supported here");
+	txstamps_on = on;
+	for (ep = io_data.ep_list; ep != NULL; ep = ep->elink)
+		if (INVALID_SOCKET != ep->fd)
+			txstamp_arm(ep, ep->fd, on);
+}
+
+
+/*
+ * txstamp_sent - remember a send until its transmit timestamp shows up
+ */
+static void
+txstamp_sent(
+	endpt *		ep,
+	void *		pkt,
+	unsigned int	len
+	)
+{
+	struct txstamp_slot *slot;
+	const struct pkt *xpkt = pkt;
+
+	slot = &ep->txring[ep->txkey % TXSTAMP_SLOTS];
+	slot->key = ep->txkey++;
+	slot->kind = TXS_SKIP;
+	slot->assoc = 0;
+	slot->mon = NULL;
+	if (len < LEN_PKT_NOMAC)
+		return;
+	slot->xmt = lfpinit_u(ntohl(xpkt->xmt.l_ui), ntohl(xpkt->xmt.l_uf));
+	/* Server replies only, KoDs just echo the client's xmt */
+	if (MODE_SERVER != PKT_MODE(xpkt->li_vn_mode) ||
+	    (xpkt->xmt.l_ui == xpkt->org.l_ui &&
+	     xpkt->xmt.l_uf == xpkt->org.l_uf))
+		return;
+	slot->kind = (LEN_PKT_NOMAC == len) ? TXS_PLAIN : TXS_AUTH;
+}
+
+
+/*
+ * txstamp_tag - say who wants the transmit timestamp of the
+ * packet just sent on ep.  An interleaved reply carries an old
+ * transmit timestamp, so it is left out of the statistics.
+ */
+void
+txstamp_tag(
+	endpt *		ep,
+	mon_entry *	mon,
+	associd_t	assoc,
+	bool		xleaved
+	)
+{
+	struct txstamp_slot *slot;
+
+	if (NULL == ep || NULL == ep->txring)
+		return;
+	slot = &ep->txring[(ep->txkey - 1) % TXSTAMP_SLOTS];
+	if (slot->key != ep->txkey - 1)
+		return;		/* send failed and we re-armed */
+	if (xleaved)
+		slot->kind = TXS_SKIP;
+	slot->assoc = assoc;
+	slot->mon = mon;
+	if (NULL != mon)
+		slot->rx = mon->xl_rx;
+}
+
+
+/*
+ * txstamp_match - account for a transmit timestamp from the kernel
+ */
+void
+txstamp_match(
+	endpt *		ep,
+	uint32_t	key,
+	l_fp		stamp
+	)
+{
+	struct txstamp_slot *slot;
+	struct txstamp_counters *tc;
+	struct peer *peer;
+	double	delta;
+
+	if (NULL == ep->txring)
+		return;
+	slot = &ep->txring[key % TXSTAMP_SLOTS];
+	if (slot->key != key) {
+		txstamp_unmatched++;
+		return;
+	}
+	if (TXS_SKIP != slot->kind) {
+		tc = &txstamp_count[(TXS_AUTH == slot->kind) ? 1 : 0];
+		delta = lfptod(stamp - slot->xmt);
+		if (0 == tc->count++)
+			tc->avg = delta;
+		else
+			tc->avg += (delta - tc->avg) / TXSTAMP_AVG;
+		tc->sum += delta;
+		if (delta > tc->max)
+			tc->max = delta;
+	}
+	/* MRU entries get recycled, so check it's still that reply */
+	if (NULL != slot->mon && slot->mon->xl_rx == slot->rx)
+		slot->mon->xl_tx = stamp;
+	if (0 != slot->assoc) {
+		peer = findpeerbyassoc(slot->assoc);
+		if (NULL != peer && peer->org_rand == slot->xmt)
+			peer->org_ts = stamp;
+	}
+	slot->kind = TXS_SKIP;
+	slot->assoc = 0;
+	slot->mon = NULL;
+}
+
+
 
 #ifdef REFCLOCK
 /*
@@ -2065,6 +2261,9 @@ read_refclock_packet(
 	struct recvbuf *	rb;
 	l_fp			ts;
 
+	if (NULL != rp->clock_line)
+		return read_refclock_lines(fd, rp);
+
 	/* Could read earlier in normal case,
 	 * but too early gets wrong time if data arrives
 	 * while we are busy processing other packets.
@@ -2118,6 +2317,38 @@ read_refclock_packet(
 
 	return (int)buflen;
 }
+
+
+/*
+ * read_refclock_lines - read a line mode refclock
+ *
+ * Reads as much as fits into the clock's line buffer and lets
+ * refclock_lines() deal it out, so no recvbuf is involved.
+ */
+static int
+read_refclock_lines(
+	SOCKET			fd,
+	struct refclockio *	rp
+	)
+{
+	ssize_t			buflen;
+	int			lines;
+	l_fp			ts;
+
+	get_systime(&ts);
+	do {
+		buflen = read(fd, rp->linebuf + rp->linelen,
+			      LINEBUF_SIZE - rp->linelen);
+	} while (buflen < 0 && EINTR == errno);
+	if (buflen <= 0)
+		return (int)buflen;
+
+	lines = refclock_lines(rp, (size_t)buflen, ts);
+	rp->recvcount += (unsigned long)lines;
+	// FIXME: should have separate slot for refclock packets
+	pkt_count.received += (unsigned long)lines;
+	return (int)buflen;
+}
 #endif	/* REFCLOCK */
 
 /*
@@ -2248,6 +2479,20 @@ read_network_packet(
 	return (buflen);
 }
 
+#ifdef HAVE_SYS_TIMERFD_H
+/*
+ * io_add_timer - have io_handler() wait on the timer tick too
+ */
+void
+io_add_timer(
+	int	fd
+	)
+{
+	timer_fd = fd;
+	maintain_activefds(fd, false);
+}
+#endif
+
 /*
  * attempt to handle io
  */
@@ -2261,7 +2506,8 @@ io_handler(void)
 
 	/*
 	 * Use select() on all input fd's for unlimited
-	 * time.  select() will terminate on SIGALARM or on the
+	 * time.  select() will terminate on the timer tick (the
+	 * timerfd or SIGALRM), on other signals or on the
 	 * reception of input.
 	 */
 	pthread_sigmask(SIG_BLOCK, &blockMask, &runMask);
@@ -2276,6 +2522,14 @@ io_handler(void)
 	}
 	pthread_sigmask(SIG_SETMASK, &runMask, NULL);
 
+#ifdef HAVE_SYS_TIMERFD_H
+	if (nfound > 0 && timer_fd >= 0 && FD_ISSET(timer_fd, &rdfdes)) {
+		timer_expired();
+		FD_CLR(timer_fd, &rdfdes);
+		if (0 == --nfound)
+			return;
+	}
+#endif
 	if (nfound > 0) {
 		input_handler(&rdfdes);
 	} else if (nfound == -1 && errno != EINTR) {
@@ -2367,6 +2621,8 @@ input_handler(
 	 */
 	for (ep = io_data.ep_list; ep != NULL; ep = ep->elink) {
 		fd = ep->fd;
+		if (FD_ISSET(fd, fds) && txstamps_used)
+			fetch_txstamps(ep);
 		if (FD_ISSET(fd, fds))
 			do {
 				++select_count;
@@ -2737,6 +2993,27 @@ io_clr_stats(void)
 	pkt_count.handler_calls = 0;
 	pkt_count.handler_pkts = 0;
 	pkt_count.io_timereset = current_time;
+
+	memset(txstamp_count, 0, sizeof(txstamp_count));
+	txstamp_unmatched = 0;
+}
+
+/*
+ * txstamp_counts - return transmit timestamp statistics
+ */
+const struct txstamp_counters *
+txstamp_counts(
+	bool	auth
+	)
+{
+	return &txstamp_count[auth ? 1 : 0];
+}
+
+/*
+ * txstamp_unmatched_count - return the number of unmatched stamps
+ */
+uint64_t txstamp_unmatched_count(void) {
+  return txstamp_unmatched;
 }
 
 /*
@@ -2855,6 +3132,9 @@ io_closeclock(
 		close_and_delete_fd_from_list(rio->fd);
 	}
 	rio->fd = -1;
+	free(rio->linebuf);
+	rio->linebuf = NULL;
+	rio->linelen = 0;
 }
 #endif	/* REFCLOCK */
 
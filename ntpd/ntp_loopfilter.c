@@ -44,6 +44,7 @@
 #define	CLOCK_ALLAN	11	/* Allan intercept (log2 s) */
 #define CLOCK_LIMIT	30	/* poll-adjust threshold */
 #define CLOCK_PGATE	4.	/* poll-adjust gate */
+#define	CLOCK_MAXRATE	100	/* max adj_host_clock() calls per second */
 /* #define PPS_MAXAGE	120	* kernel pps signal timeout (s) UNUSED */
 
 /*
@@ -109,7 +110,8 @@ double	clock_phi = CLOCK_PHI;	/* dispersion rate (s/s) */
 struct ntp_loop_data loop_data = {
 	.clock_max_back = CLOCK_MAX, /* step threshold */
 	.clock_max_fwd =  CLOCK_MAX, /* step threshold */
-	.clock_phi = CLOCK_PHI       /* dispersion rate (s/s) */
+	.clock_phi = CLOCK_PHI,      /* dispersion rate (s/s) */
+	.adj_rate = 1                /* adjustments per second */
 };
 
 /*
@@ -893,18 +895,21 @@ local_clock(
 
 
 /*
- * adj_host_clock - Called once every second to update the local clock.
+ * adj_host_clock - Called rate times every second to update the local
+ * clock.  Each call does 1/rate of a second's worth of slewing.
  *
  * If lockclock is on the only thing this routine does is increment the
  * sys_rootdisp variable.
  */
 void
 adj_host_clock(
-	void
+	int	rate		/* calls per second */
 	)
 {
+	static int ticks;	/* calls into the current second */
 	double	offset_adj;
 	double	freq_adj;
+	double	tick = 1. / rate;
 
 	/*
 	 * Update the dispersion since the last update. In contrast to
@@ -914,7 +919,7 @@ adj_host_clock(
 	 * would be counterproductive. During the startup clamp period, the
 	 * time constant is clamped at 2.
 	 */
-	sys_vars.sys_rootdisp += loop_data.clock_phi;
+	sys_vars.sys_rootdisp += loop_data.clock_phi * tick;
 	if (loop_data.lockclock || !clock_ctl.ntp_enable || clock_ctl.mode_ntpdate)
 		return;
 	/*
@@ -927,7 +932,10 @@ adj_host_clock(
 		offset_adj = 0.;
 	} else if (freq_cnt > 0) {
 		offset_adj = clock_offset / (CLOCK_PLL * ULOGTOD(1));
-		freq_cnt--;
+		if (++ticks >= rate) {
+			ticks = 0;
+			freq_cnt--;
+		}
 	} else if (clock_ctl.pll_control && clock_ctl.kern_enable) {
 		offset_adj = 0.;
 	} else {
@@ -951,6 +959,9 @@ adj_host_clock(
 	} else if (offset_adj + freq_adj < -NTP_MAXFREQ) {
 		offset_adj = -NTP_MAXFREQ - freq_adj;
 	}
+	/* rates per second above, this call covers one tick */
+	offset_adj *= tick;
+	freq_adj *= tick;
 
 	clock_offset -= offset_adj;
 	/*
@@ -1267,6 +1278,14 @@ loop_config(
 		}
 		break;
 
+	case LOOP_ADJRATE:	/* adjustments per second (adjrate) */
+		if (freq < 1)
+			freq = 1;
+		else if (freq > CLOCK_MAXRATE)
+			freq = CLOCK_MAXRATE;
+		loop_data.adj_rate = (int)freq;
+		break;
+
 #ifdef ENABLE_FUZZ
 	case LOOP_TICK:		/* tick increment (tick) */
 		set_sys_tick_precision(freq);
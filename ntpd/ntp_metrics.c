@@ -0,0 +1,793 @@
+/*
+ * ntp_metrics.c - serve ntpd's counters as OpenMetrics text
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Scrapers used to get these by running ntpq, which costs a burst of
+ * mode 6 packets through process_control() on the main thread every
+ * time.  Instead, once every "metrics interval" seconds the main
+ * thread writes everything out as OpenMetrics text and publishes it,
+ * and a thread of its own answers HTTP GETs on the loopback port
+ * and/or UNIX socket given by "metrics port" and "metrics path" with
+ * whatever was last published.
+ *
+ * A snapshot is reference counted.  metrics_lock only covers taking
+ * or dropping a reference, never formatting or sending, and the main
+ * thread only ever tries it: if the server thread happens to hold it,
+ * the new snapshot waits for the next tick.  So a slow or stuck
+ * scraper can't hold up packet processing.
+ */
+
+#include "config.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+
+#include "ntpd.h"
+#include "ntp_stdlib.h"
+#include "timespecops.h"
+#ifdef REFCLOCK
+#include "ntp_refclock.h"
+#endif
+#ifndef DISABLE_NTS
+#include "nts.h"
+#endif
+
+#define METRICS_INTERVAL	1	/* default refresh, s */
+#define METRICS_MAXFD		3	/* IPv4, IPv6 and UNIX listeners */
+#define METRICS_REQLEN		2048	/* longest request we read */
+#define METRICS_TIMEOUT		2	/* per-connection time limit, s */
+
+struct metrics_snap {
+	int		refs;		/* under metrics_lock */
+	size_t		len;
+	char		text[];
+};
+
+/* text being built, grows as needed */
+struct mtext {
+	char *		buf;
+	size_t		len;
+	size_t		size;
+};
+
+static pthread_mutex_t	metrics_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct metrics_snap *metrics_cur;	/* under metrics_lock */
+static struct metrics_snap *metrics_next;	/* not yet published */
+
+static int		metrics_fd[METRICS_MAXFD];
+static int		metrics_nfd;
+static char *		metrics_path;		/* to unlink at exit */
+static int		metrics_interval = METRICS_INTERVAL;
+static uptime_t		metrics_due;
+static bool		metrics_started;
+
+static void	mt_printf	(struct mtext *, const char *, ...)
+			NTP_PRINTF(2, 3);
+
+/* ------------------------------------------------------------------ */
+/* Formatting, main thread only */
+
+static void
+mt_printf(
+	struct mtext *	mt,
+	const char *	fmt,
+	...
+	)
+{
+	va_list	ap;
+	int	n;
+
+	for (;;) {
+		va_start(ap, fmt);
+		n = vsnprintf(mt->buf + mt->len, mt->size - mt->len, fmt, ap);
+		va_end(ap);
+		if (n < 0)
+			return;
+		if ((size_t)n < mt->size - mt->len) {
+			mt->len += (size_t)n;
+			return;
+		}
+		mt->size = 2 * mt->size + (size_t)n;
+		mt->buf = erealloc(mt->buf, mt->size);
+	}
+}
+
+static void
+mt_family(
+	struct mtext *	mt,
+	const char *	name,
+	const char *	type,
+	const char *	help
+	)
+{
+	mt_printf(mt, "# TYPE ntpd_%s %s\n# HELP ntpd_%s %s\n",
+		  name, type, name, help);
+}
+
+static void
+mt_counter(
+	struct mtext *	mt,
+	const char *	name,
+	const char *	help,
+	uint64_t	val
+	)
+{
+	mt_family(mt, name, "counter", help);
+	mt_printf(mt, "ntpd_%s_total %" PRIu64 "\n", name, val);
+}
+
+static void
+mt_gauge(
+	struct mtext *	mt,
+	const char *	name,
+	const char *	help,
+	double		val
+	)
+{
+	mt_family(mt, name, "gauge", help);
+	mt_printf(mt, "ntpd_%s %.9g\n", name, val);
+}
+
+/* label values must have \, " and newline escaped */
+static void
+mt_label(
+	char *		buf,
+	size_t		len,
+	const char *	str
+	)
+{
+	char *	cp = buf;
+	char *	end = buf + len - 3;
+
+	for (; *str != '\0' && cp < end; str++) {
+		if ('\\' == *str || '"' == *str) {
+			*cp++ = '\\';
+			*cp++ = *str;
+		} else if ('\n' == *str) {
+			*cp++ = '\\';
+			*cp++ = 'n';
+		} else {
+			*cp++ = *str;
+		}
+	}
+	*cp = '\0';
+}
+
+static void
+put_system(
+	struct mtext *	mt
+	)
+{
+	mt_gauge(mt, "uptime_seconds", "Time since ntpd started",
+		 (double)current_time);
+	mt_gauge(mt, "stratum", "System stratum", sys_vars.sys_stratum);
+	mt_gauge(mt, "leap", "Leap indicator, 3 when unsynchronized",
+		 sys_vars.sys_leap);
+	mt_gauge(mt, "root_delay_seconds",
+		 "Round trip delay to the primary source",
+		 sys_vars.sys_rootdelay);
+	mt_gauge(mt, "root_dispersion_seconds",
+		 "Dispersion to the primary source", sys_vars.sys_rootdisp);
+	mt_gauge(mt, "root_distance_seconds",
+		 "Synchronization distance to the primary source",
+		 sys_vars.sys_rootdist);
+	mt_gauge(mt, "sys_peer",
+		 "Association ID of the system peer, 0 for none",
+		 (NULL != sys_vars.sys_peer) ? sys_vars.sys_peer->associd : 0);
+	mt_gauge(mt, "associations", "Mobilized associations",
+		 peer_associations);
+
+	/* the loop filter */
+	mt_gauge(mt, "offset_seconds", "Last clock offset",
+		 clkstate.last_offset);
+	mt_gauge(mt, "system_jitter_seconds", "Combined jitter of sources",
+		 clkstate.sys_jitter);
+	mt_gauge(mt, "clock_jitter_seconds", "Clock jitter",
+		 clkstate.clock_jitter);
+	mt_gauge(mt, "frequency_ppm", "Clock frequency correction",
+		 loop_data.drift_comp * US_PER_S);
+	mt_gauge(mt, "clock_wander_ppm", "Clock frequency wander",
+		 loop_data.clock_stability * US_PER_S);
+	mt_gauge(mt, "time_constant", "Loop time constant, log2 s",
+		 clkstate.sys_poll);
+}
+
+static void
+put_counters(
+	struct mtext *	mt
+	)
+{
+	l_fp now;
+
+	/* stat_proto_total */
+	mt_counter(mt, "proto_received", "Packets received",
+		   stat_total_received());
+	mt_counter(mt, "proto_processed", "Packets for this host",
+		   stat_total_processed());
+	mt_counter(mt, "proto_restricted", "Packets restricted",
+		   stat_total_restricted());
+	mt_counter(mt, "proto_newversion", "Current version packets",
+		   stat_total_newversion());
+	mt_counter(mt, "proto_oldversion", "Old version packets",
+		   stat_total_oldversion());
+	mt_counter(mt, "proto_badlength", "Packets of bad length or format",
+		   stat_total_badlength());
+	mt_counter(mt, "proto_badauth", "Packets failing authentication",
+		   stat_total_badauth());
+	mt_counter(mt, "proto_declined", "Packets declined",
+		   stat_total_declined());
+	mt_counter(mt, "proto_limited", "Packets over the rate limit",
+		   stat_total_limitrejected());
+	mt_counter(mt, "proto_kodsent", "Kiss-o'-Death packets sent",
+		   stat_total_kodsent());
+
+	/* pkt_count */
+	mt_counter(mt, "io_received", "Packets received by the I/O layer",
+		   received_count());
+	mt_counter(mt, "io_dropped", "Packets dropped on reception",
+		   dropped_count());
+	mt_counter(mt, "io_ignored", "Packets received on a wildcard",
+		   ignored_count());
+	mt_counter(mt, "io_sent", "Packets sent", sent_count());
+	mt_counter(mt, "io_sendfailed", "Packets that could not be sent",
+		   notsent_count());
+	mt_counter(mt, "io_wakeups", "I/O handler calls",
+		   handler_calls_count());
+	mt_counter(mt, "io_goodwakeups", "I/O handler calls with a packet",
+		   handler_pkts_count());
+
+	/* mon_data */
+	mt_gauge(mt, "mru_entries", "Entries in the MRU list",
+		 (double)mon_data.mru_entries);
+	mt_gauge(mt, "mru_peak_entries", "Most entries the MRU list has had",
+		 (double)mon_data.mru_peakentries);
+	mt_gauge(mt, "mru_hash_slots", "MRU hash slots in use",
+		 (double)mon_data.mru_hashslots);
+	mt_gauge(mt, "mru_max_entries", "MRU list size limit",
+		 (double)mon_data.mru_maxdepth);
+	mt_gauge(mt, "mru_bytes", "Memory used by the MRU list",
+		 (double)(mon_data.mru_entries * sizeof(mon_entry)));
+	get_systime(&now);
+	mt_gauge(mt, "mru_oldest_age_seconds", "Age of the oldest MRU entry",
+		 mon_get_oldest_age(now));
+	mt_counter(mt, "mru_exists", "MRU lookups finding an entry",
+		   mon_data.mru_exists);
+	mt_counter(mt, "mru_new", "MRU entries allocated", mon_data.mru_new);
+	mt_counter(mt, "mru_recycleold", "MRU entries recycled for age",
+		   mon_data.mru_recycleold);
+	mt_counter(mt, "mru_recyclefull", "MRU entries recycled when full",
+		   mon_data.mru_recyclefull);
+	mt_counter(mt, "mru_none", "MRU entries that could not be had",
+		   mon_data.mru_none);
+
+#ifndef DISABLE_NTS
+	mt_counter(mt, "nts_client_send", "NTS client requests sent",
+		   nts_client_send);
+	mt_counter(mt, "nts_client_recv_good", "Good NTS client replies",
+		   nts_client_recv_good);
+	mt_counter(mt, "nts_client_recv_bad", "Bad NTS client replies",
+		   nts_client_recv_bad);
+	mt_counter(mt, "nts_server_send", "NTS server replies sent",
+		   nts_server_send);
+	mt_counter(mt, "nts_server_recv_good", "Good NTS server requests",
+		   nts_server_recv_good);
+	mt_counter(mt, "nts_server_recv_bad", "Bad NTS server requests",
+		   nts_server_recv_bad);
+	mt_counter(mt, "nts_cookie_make", "NTS cookies made",
+		   nts_cookie_make);
+	mt_counter(mt, "nts_cookie_decode", "NTS cookies decoded",
+		   nts_cookie_decode);
+	mt_counter(mt, "nts_cookie_decode_old",
+		   "NTS cookies decoded with the previous key",
+		   nts_cookie_decode_old);
+	mt_counter(mt, "nts_cookie_decode_too_old",
+		   "NTS cookies too old to decode",
+		   nts_cookie_decode_too_old);
+	mt_counter(mt, "nts_cookie_decode_error",
+		   "NTS cookies that failed to decode",
+		   nts_cookie_decode_error);
+	mt_counter(mt, "nts_ke_serves_good", "Good NTS-KE sessions served",
+		   nts_ke_serves_good);
+	mt_counter(mt, "nts_ke_serves_bad", "Bad NTS-KE sessions served",
+		   nts_ke_serves_bad);
+	mt_counter(mt, "nts_ke_probes_good", "Good NTS-KE client probes",
+		   nts_ke_probes_good);
+	mt_counter(mt, "nts_ke_probes_bad", "Bad NTS-KE client probes",
+		   nts_ke_probes_bad);
+#endif
+}
+
+/*
+ * Per-association values.  Each family is written out in one piece,
+ * as OpenMetrics wants, so the peer list is walked once per row.
+ */
+enum { PM_OFFSET, PM_DELAY, PM_DISPERSION, PM_JITTER, PM_STRATUM,
+	PM_REACH, PM_POLL, PM_SELECTION, PM_SENT, PM_RECEIVED,
+	PM_PROCESSED, PM_BADAUTH, PM_COUNT };
+
+static const struct peer_metric {
+	const char *	name;
+	bool		counter;
+	const char *	help;
+} peer_metric[PM_COUNT] = {
+	{ "peer_offset_seconds",	false, "Offset of the source" },
+	{ "peer_delay_seconds",		false, "Round trip delay to the source" },
+	{ "peer_dispersion_seconds",	false, "Dispersion of the source" },
+	{ "peer_jitter_seconds",	false, "Jitter of the source" },
+	{ "peer_stratum",		false, "Stratum of the source" },
+	{ "peer_reach",			false, "Reachability register" },
+	{ "peer_poll",			false, "Poll interval, log2 s" },
+	{ "peer_selection",		false,
+	  "Selection status, 6 for the system peer" },
+	{ "peer_sent",			true,  "Packets sent to the source" },
+	{ "peer_received",		true,  "Packets received from the source" },
+	{ "peer_processed",		true,  "Packets from the source processed" },
+	{ "peer_badauth",		true,
+	  "Packets from the source failing authentication" },
+};
+
+static double
+peer_value(
+	const struct peer *	p,
+	int			which
+	)
+{
+	switch (which) {
+	case PM_OFFSET:		return p->offset;
+	case PM_DELAY:		return p->delay;
+	case PM_DISPERSION:	return p->disp;
+	case PM_JITTER:		return p->jitter;
+	case PM_STRATUM:	return p->stratum;
+	case PM_REACH:		return p->reach;
+	case PM_POLL:		return p->hpoll;
+	case PM_SELECTION:	return p->status;
+	case PM_SENT:		return (double)p->sent;
+	case PM_RECEIVED:	return (double)p->received;
+	case PM_PROCESSED:	return (double)p->processed;
+	case PM_BADAUTH:	return (double)p->badauth;
+	default:		return 0;
+	}
+}
+
+static void
+put_peers(
+	struct mtext *	mt
+	)
+{
+	struct peer *	p;
+	char		(*labels)[160];
+	char		name[64];
+	const char *	src;
+	int		n = 0, i;
+
+	for (p = peer_list; p != NULL; p = p->p_link)
+		n++;
+	if (0 == n)
+		return;
+
+	labels = emalloc((size_t)n * sizeof(*labels));
+	for (p = peer_list, i = 0; p != NULL; p = p->p_link, i++) {
+		src = socktoa(&p->srcadr);
+#ifdef REFCLOCK
+		if (IS_PEER_REFCLOCK(p))
+			src = refclock_name(p);
+#endif
+		if (NULL != p->hostname)
+			src = p->hostname;
+		mt_label(name, sizeof(name), src);
+		snprintf(labels[i], sizeof(labels[i]),
+			 "assoc=\"%u\",address=\"%s\",name=\"%s\"",
+			 p->associd, socktoa(&p->srcadr), name);
+	}
+
+	for (int m = 0; m < PM_COUNT; m++) {
+		mt_family(mt, peer_metric[m].name,
+			  peer_metric[m].counter ? "counter" : "gauge",
+			  peer_metric[m].help);
+		for (p = peer_list, i = 0; p != NULL; p = p->p_link, i++)
+			mt_printf(mt, "ntpd_%s%s{%s} %.9g\n",
+				  peer_metric[m].name,
+				  peer_metric[m].counter ? "_total" : "",
+				  labels[i], peer_value(p, m));
+	}
+	free(labels);
+}
+
+static struct metrics_snap *
+metrics_render(void)
+{
+	struct metrics_snap *snap;
+	struct mtext mt;
+
+	mt.size = 16384;
+	mt.buf = emalloc(mt.size);
+	mt.len = 0;
+	put_system(&mt);
+	put_counters(&mt);
+	put_peers(&mt);
+	mt_printf(&mt, "# EOF\n");
+
+	snap = emalloc(sizeof(*snap) + mt.len);
+	snap->refs = 1;
+	snap->len = mt.len;
+	memcpy(snap->text, mt.buf, mt.len);
+	free(mt.buf);
+	return snap;
+}
+
+/* drop a reference, for the server thread */
+static void
+metrics_release(
+	struct metrics_snap *	snap
+	)
+{
+	bool	last;
+
+	if (NULL == snap)
+		return;
+	pthread_mutex_lock(&metrics_lock);
+	last = (0 == --snap->refs);
+	pthread_mutex_unlock(&metrics_lock);
+	if (last)
+		free(snap);
+}
+
+/* ------------------------------------------------------------------ */
+/* The server thread */
+
+/*
+ * metrics_wait - wait until fd is ready for events or the connection's
+ * deadline passes.  The deadline covers the whole connection, so a
+ * client trickling bytes can't keep the other scrapers waiting.
+ */
+static bool
+metrics_wait(
+	int			fd,
+	short			events,
+	const struct timespec *	deadline
+	)
+{
+	struct pollfd	pfd;
+	struct timespec	now;
+	int64_t		ms;
+	int		n;
+
+	for (;;) {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		ms = (deadline->tv_sec - now.tv_sec) * MS_PER_S +
+		     (deadline->tv_nsec - now.tv_nsec) / (NS_PER_S / MS_PER_S);
+		if (ms <= 0)
+			return false;
+		pfd.fd = fd;
+		pfd.events = events;
+		n = poll(&pfd, 1, (int)ms);
+		if (n < 0 && EINTR == errno)
+			continue;
+		return (n > 0);
+	}
+}
+
+static void
+metrics_write(
+	int			fd,
+	const char *		buf,
+	size_t			len,
+	const struct timespec *	deadline
+	)
+{
+	ssize_t	n;
+
+	while (len > 0) {
+		if (!metrics_wait(fd, POLLOUT, deadline))
+			return;
+		n = send(fd, buf, len, MSG_NOSIGNAL | MSG_DONTWAIT);
+		if (n < 0 && (EINTR == errno || EAGAIN == errno ||
+			      EWOULDBLOCK == errno))
+			continue;
+		if (n <= 0)
+			return;
+		buf += n;
+		len -= (size_t)n;
+	}
+}
+
+static void
+metrics_reply(
+	int		fd,
+	const char *	status,
+	const char *	type,
+	const char *	body,
+	size_t		len,
+	bool		head,
+	const struct timespec *deadline
+	)
+{
+	char	hdr[256];
+	int	n;
+
+	n = snprintf(hdr, sizeof(hdr),
+		     "HTTP/1.0 %s\r\n"
+		     "Content-Type: %s\r\n"
+		     "Content-Length: %zu\r\n"
+		     "Connection: close\r\n\r\n",
+		     status, type, len);
+	metrics_write(fd, hdr, (size_t)n, deadline);
+	if (!head)
+		metrics_write(fd, body, len, deadline);
+}
+
+static void
+metrics_serve(
+	int	fd
+	)
+{
+	static const char plain[] = "text/plain; charset=utf-8";
+	struct metrics_snap *snap;
+	struct timespec deadline;
+	char	req[METRICS_REQLEN];
+	size_t	got = 0;
+	ssize_t	n;
+	char	*path, *end;
+	bool	head;
+
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	deadline.tv_sec += METRICS_TIMEOUT;
+
+	/* the request line is all we look at, but read the headers */
+	for (;;) {
+		if (!metrics_wait(fd, POLLIN, &deadline))
+			return;
+		n = recv(fd, req + got, sizeof(req) - 1 - got, MSG_DONTWAIT);
+		if (n < 0 && (EINTR == errno || EAGAIN == errno ||
+			      EWOULDBLOCK == errno))
+			continue;
+		if (n <= 0)
+			break;
+		got += (size_t)n;
+		req[got] = '\0';
+		if (strstr(req, "\r\n\r\n") || strstr(req, "\n\n") ||
+		    got == sizeof(req) - 1)
+			break;
+	}
+	req[got] = '\0';
+
+	head = (0 == strncmp(req, "HEAD ", 5));
+	if (!head && 0 != strncmp(req, "GET ", 4)) {
+		metrics_reply(fd, "405 Method Not Allowed", plain,
+			      "GET only\n", 9, false, &deadline);
+		return;
+	}
+	path = req + (head ? 5 : 4);
+	end = path + strcspn(path, " ?\r\n");
+	*end = '\0';
+	if (0 != strcmp(path, "/metrics") && 0 != strcmp(path, "/")) {
+		metrics_reply(fd, "404 Not Found", plain,
+			      "try /metrics\n", 13, head, &deadline);
+		return;
+	}
+
+	pthread_mutex_lock(&metrics_lock);
+	snap = metrics_cur;
+	if (NULL != snap)
+		snap->refs++;
+	pthread_mutex_unlock(&metrics_lock);
+	if (NULL == snap) {
+		metrics_reply(fd, "503 Service Unavailable", plain,
+			      "not ready\n", 10, head, &deadline);
+		return;
+	}
+	metrics_reply(fd, "200 OK",
+		      "application/openmetrics-text; version=1.0.0; "
+		      "charset=utf-8",
+		      snap->text, snap->len, head, &deadline);
+	metrics_release(snap);
+}
+
+static void *
+metrics_server(
+	void *	arg
+	)
+{
+	struct pollfd	pfd[METRICS_MAXFD];
+	int		fd;
+
+	UNUSED_ARG(arg);
+	for (int i = 0; i < metrics_nfd; i++) {
+		pfd[i].fd = metrics_fd[i];
+		pfd[i].events = POLLIN;
+	}
+	for (;;) {
+		if (poll(pfd, (nfds_t)metrics_nfd, -1) < 0) {
+			if (EINTR == errno)
+				continue;
+			msyslog(LOG_ERR, "METRICS: poll: %s", strerror(errno));
+			return NULL;
+		}
+		for (int i = 0; i < metrics_nfd; i++) {
+			if (!(pfd[i].revents & POLLIN))
+				continue;
+			fd = accept(pfd[i].fd, NULL, NULL);
+			if (fd < 0)
+				continue;
+			metrics_serve(fd);
+			close(fd);
+		}
+	}
+}
+
+static void
+metrics_start(void)
+{
+	sigset_t	block_mask, saved_sig_mask;
+	pthread_t	thread;
+	int		rc;
+
+	/* signals are for the main thread */
+	sigfillset(&block_mask);
+	pthread_sigmask(SIG_BLOCK, &block_mask, &saved_sig_mask);
+	rc = pthread_create(&thread, NULL, metrics_server, NULL);
+	pthread_sigmask(SIG_SETMASK, &saved_sig_mask, NULL);
+	if (rc) {
+		msyslog(LOG_ERR, "METRICS: can't start server: %s",
+			strerror(rc));
+		return;
+	}
+	pthread_detach(thread);
+}
+
+/* ------------------------------------------------------------------ */
+/* Setup */
+
+static void
+metrics_cleanup(void)
+{
+	if (NULL != metrics_path)
+		unlink(metrics_path);
+}
+
+static bool
+metrics_listen(
+	int			family,
+	const struct sockaddr *	sa,
+	socklen_t		salen,
+	const char *		what
+	)
+{
+	int	fd, on = 1;
+
+	if (metrics_nfd >= METRICS_MAXFD)
+		return false;
+	fd = socket(family, SOCK_STREAM, 0);
+	if (fd < 0) {
+		msyslog(LOG_ERR, "METRICS: socket for %s: %s", what,
+			strerror(errno));
+		return false;
+	}
+	if (AF_UNIX != family)
+		setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+	if (AF_INET6 == family)
+		setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &on, sizeof(on));
+	if (bind(fd, sa, salen) < 0 || listen(fd, 8) < 0) {
+		msyslog(LOG_ERR, "METRICS: can't listen on %s: %s", what,
+			strerror(errno));
+		close(fd);
+		return false;
+	}
+	metrics_fd[metrics_nfd++] = fd;
+	msyslog(LOG_INFO, "METRICS: serving on %s", what);
+	return true;
+}
+
+/*
+ * metrics_config - open the listeners.  Called while reading the
+ * configuration, before root is given up; the thread waits for the
+ * first metrics_timer().  A port of 0 and no path only sets the
+ * refresh interval.
+ */
+void
+metrics_config(
+	int		port,
+	const char *	path,
+	int		interval
+	)
+{
+	char	what[64];
+
+	if (interval > 0)
+		metrics_interval = interval;
+	if (metrics_started || metrics_nfd > 0) {
+		if (0 != port || NULL != path)
+			msyslog(LOG_ERR,
+				"METRICS: already serving, new endpoints ignored");
+		return;
+	}
+
+	if (0 != port) {
+		struct sockaddr_in sin;
+		struct sockaddr_in6 sin6;
+
+		ZERO(sin);
+		sin.sin_family = AF_INET;
+		sin.sin_port = htons((uint16_t)port);
+		sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		snprintf(what, sizeof(what), "127.0.0.1:%d", port);
+		(void)metrics_listen(AF_INET, (struct sockaddr *)&sin,
+				     sizeof(sin), what);
+
+		ZERO(sin6);
+		sin6.sin6_family = AF_INET6;
+		sin6.sin6_port = htons((uint16_t)port);
+		sin6.sin6_addr = in6addr_loopback;
+		snprintf(what, sizeof(what), "[::1]:%d", port);
+		(void)metrics_listen(AF_INET6, (struct sockaddr *)&sin6,
+				     sizeof(sin6), what);
+	}
+
+	if (NULL != path) {
+		struct sockaddr_un sun;
+
+		if (strlen(path) >= sizeof(sun.sun_path)) {
+			msyslog(LOG_ERR, "METRICS: path %s is too long",
+				path);
+		} else {
+			ZERO(sun);
+			sun.sun_family = AF_UNIX;
+			strlcpy(sun.sun_path, path, sizeof(sun.sun_path));
+			/* a socket left by an earlier run */
+			unlink(path);
+			if (metrics_listen(AF_UNIX, (struct sockaddr *)&sun,
+					   sizeof(sun), path)) {
+				metrics_path = estrdup(path);
+				atexit(metrics_cleanup);
+			}
+		}
+	}
+}
+
+/*
+ * metrics_timer - publish a fresh snapshot when one is due, called
+ * once a second
+ */
+void
+metrics_timer(void)
+{
+	struct metrics_snap *old;
+	bool last;
+
+	if (0 == metrics_nfd)
+		return;
+	if (!metrics_started) {
+		metrics_started = true;
+		metrics_start();
+	}
+	if (NULL == metrics_next) {
+		if (current_time < metrics_due)
+			return;
+		metrics_due = current_time + (uptime_t)metrics_interval;
+		metrics_next = metrics_render();
+	}
+
+	/* a scraper is taking a reference right now; try next second */
+	if (0 != pthread_mutex_trylock(&metrics_lock))
+		return;
+	old = metrics_cur;
+	last = (NULL != old && 0 == --old->refs);
+	metrics_cur = metrics_next;
+	metrics_next = NULL;
+	pthread_mutex_unlock(&metrics_lock);
+	if (last)
+		free(old);
+}
@@ -341,6 +341,7 @@ ntp_monitor(
 	uint8_t		li_vn_mode;
 	float		since_last;	/* seconds since last packet */
 
+	rbufp->mon = NULL;
 	if (mon_data.mon_enabled == MON_OFF)
 		return ~(RES_LIMITED | RES_KOD) & flags;
 
@@ -394,6 +395,7 @@ ntp_monitor(
 		}
 
 		mon->flags = restrict_mask;
+		rbufp->mon = mon;
 		return mon->flags;
 	}
 
@@ -474,6 +476,8 @@ ntp_monitor(
 	memcpy(&mon->rmtadr, &rbufp->recv_srcadr, sizeof(mon->rmtadr));
 	mon->vn_mode = VN_MODE(version, mode);
 	mon->lcladr = rbufp->dstadr;
+	mon->xl_rx = 0;
+	mon->xl_tx = 0;
 
 	/*
 	 * Drop him into front of the hash table. Also put him on top of
@@ -483,6 +487,7 @@ ntp_monitor(
 		mon_data.mru_hashslots++;
 	LINK_SLIST(mon_data.mon_hash[hash], mon, hash_next);
 	LINK_DLIST(mon_data.mon_mru_list, mon, mru);
+	rbufp->mon = mon;
 
 	return mon->flags;
 }
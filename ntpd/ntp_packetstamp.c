@@ -14,6 +14,11 @@
 #include "ntp_stdlib.h"
 #include "timespecops.h"
 
+#ifdef HAVE_LINUX_NET_TSTAMP_H
+# include <linux/net_tstamp.h>
+# include <linux/errqueue.h>	/* needs struct timespec */
+#endif
+
 /* We handle 3 flavors of timestamp:
  * SO_TIMESTAMPNS/SCM_TIMESTAMPNS  Linux (maybe others)
  * SO_TS_CLOCK/SCM_REALTIME        FreeBSD
@@ -95,6 +100,124 @@ enable_packetstamps(
 }
 
 
+/*
+ * Transmit timestamps.
+ *
+ * Linux can tell us when a datagram was actually handed to the
+ * driver.  The stamp comes back on the socket error queue
+ * tagged with the count of datagrams previously sent on
+ * that socket (SOF_TIMESTAMPING_OPT_ID), which sendpkt()
+ * tracks in endpt->txkey.  Other systems don't get this.
+ */
+#if defined(HAVE_LINUX_NET_TSTAMP_H) && defined(SO_TIMESTAMPING)
+# define USE_TXSTAMPS
+#endif
+
+/* txstamps_supported - can enable_txstamps() ever work here? */
+bool
+txstamps_supported(void)
+{
+#ifdef USE_TXSTAMPS
+	return true;
+#else
+	return false;
+#endif
+}
+
+/*
+ * enable_txstamps - turn transmit timestamps on or off for a socket.
+ * Turning them on restarts the kernel's datagram count at 0.
+ */
+bool
+enable_txstamps(
+	int		fd,
+	sockaddr_u *	addr,
+	bool		on
+	)
+{
+#ifdef USE_TXSTAMPS
+	int	flags = 0;
+
+	if (on) {
+		flags = SOF_TIMESTAMPING_TX_SOFTWARE |
+			SOF_TIMESTAMPING_SOFTWARE |
+			SOF_TIMESTAMPING_OPT_ID |
+			SOF_TIMESTAMPING_OPT_TSONLY;
+#ifdef SOF_TIMESTAMPING_OPT_RX_FILTER
+		/* keep receive side to the one SO_TIMESTAMPNS cmsg */
+		flags |= SOF_TIMESTAMPING_OPT_RX_FILTER;
+#endif
+	}
+	if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING,
+		       (const void *)&flags, sizeof(flags))) {
+		msyslog(LOG_ERR,
+			"IO: setsockopt SO_TIMESTAMPING fails on address %s: %s",
+			socktoa(addr), strerror(errno));
+		return false;
+	}
+	DPRINT(4, ("setsockopt SO_TIMESTAMPING 0x%x on fd %d address %s\n",
+		   (unsigned)flags, fd, socktoa(addr)));
+	return true;
+#else
+	/* io_txstamps() has already said so, once */
+	UNUSED_ARG(fd);
+	UNUSED_ARG(addr);
+	UNUSED_ARG(on);
+	return false;
+#endif
+}
+
+
+/*
+ * fetch_txstamps - drain the transmit timestamps queued on a socket
+ */
+void
+fetch_txstamps(
+	endpt *	ep
+	)
+{
+#ifdef USE_TXSTAMPS
+	struct msghdr		msghdr;
+	struct cmsghdr *	cmsghdr;
+	struct scm_timestamping *tss;
+	struct sock_extended_err *serr;
+	char			control[256];
+
+	for (;;) {
+		memset(&msghdr, '\0', sizeof(msghdr));
+		msghdr.msg_control    = (void *)&control;
+		msghdr.msg_controllen = sizeof(control);
+		if (recvmsg(ep->fd, &msghdr, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+			break;
+		tss = NULL;
+		serr = NULL;
+		for (cmsghdr = CMSG_FIRSTHDR(&msghdr); NULL != cmsghdr;
+		     cmsghdr = CMSG_NXTHDR(&msghdr, cmsghdr)) {
+			if (SOL_SOCKET == cmsghdr->cmsg_level &&
+			    SCM_TIMESTAMPING == cmsghdr->cmsg_type)
+				tss = (struct scm_timestamping *)
+				    CMSG_DATA(cmsghdr);
+			else if ((IPPROTO_IP == cmsghdr->cmsg_level &&
+				  IP_RECVERR == cmsghdr->cmsg_type) ||
+				 (IPPROTO_IPV6 == cmsghdr->cmsg_level &&
+				  IPV6_RECVERR == cmsghdr->cmsg_type))
+				serr = (struct sock_extended_err *)
+				    CMSG_DATA(cmsghdr);
+		}
+		if (NULL == tss || NULL == serr ||
+		    SO_EE_ORIGIN_TIMESTAMPING != serr->ee_origin ||
+		    SCM_TSTAMP_SND != serr->ee_info)
+			continue;
+		/* ts[0] is the software stamp */
+		txstamp_match(ep, serr->ee_data,
+			      tspec_stamp_to_lfp(tss->ts[0]));
+	}
+#else
+	UNUSED_ARG(ep);
+#endif
+}
+
+
 /*
  * extract timestamps from control message buffer
  */
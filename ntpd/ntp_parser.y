@@ -50,6 +50,7 @@
 }
 
 /* Terminals (do not appear left of colon) */
+%token	<Integer>	T_Adjrate
 %token	<Integer>	T_Aead
 %token	<Integer>	T_Age
 %token	<Integer>	T_All
@@ -60,6 +61,7 @@
 %token	<Integer>	T_Average
 %token	<Integer>	T_Baud
 %token	<Integer>	T_Bias
+%token	<Integer>	T_Binary
 %token	<Integer>	T_Burst
 %token	<Integer>	T_Calibrate
 %token	<Integer>	T_Ca
@@ -106,6 +108,7 @@
 %token	<Integer>	T_Includefile
 %token	<Integer>	T_Integer		/* Not a token, used as tag */
 %token	<Integer>	T_Interface
+%token	<Integer>	T_Interval
 %token	<Integer>	T_Intrange		/* Not a token, used as tag */
 %token	<Integer>	T_Io
 %token	<Integer>	T_Ipv4
@@ -125,6 +128,7 @@
 %token	<Integer>	T_Listen
 %token	<Integer>	T_Logconfig
 %token	<Integer>	T_Logfile
+%token	<Integer>	T_Logqueue
 %token	<Integer>	T_Loopstats
 %token	<Integer>	T_Mask
 %token	<Integer>	T_Maxage
@@ -138,6 +142,7 @@
 %token	<Integer>	T_Mdnstries
 %token	<Integer>	T_Mem
 %token	<Integer>	T_Memlock
+%token	<Integer>	T_Metrics
 %token	<Integer>	T_Minage
 %token	<Integer>	T_Minclock
 %token	<Integer>	T_Mindepth
@@ -176,6 +181,7 @@
 %token	<Integer>	T_Pid
 %token	<Integer>	T_Pidfile
 %token	<Integer>	T_Pool
+%token	<Integer>	T_Port
 %token	<Integer>	T_Ppspath
 %token	<Integer>	T_Prefer
 %token	<Integer>	T_Protostats
@@ -184,14 +190,18 @@
 %token	<Integer>	T_Refid
 %token	<Integer>	T_Requestkey
 %token	<Integer>	T_Require
+%token	<Integer>	T_Reservoir
 %token	<Integer>	T_Reset
 %token	<Integer>	T_Restrict
 %token	<Integer>	T_Rlimit
+%token	<Integer>	T_Sample
 %token	<Integer>	T_Saveconfigdir
 %token	<Integer>	T_Server
 %token	<Integer>	T_Setvar
+%token	<Integer>	T_Shmstats
 %token	<Integer>	T_Source
 %token	<Integer>	T_Stacksize
+%token	<Integer>	T_Stages
 %token	<Integer>	T_Statistics
 %token	<Integer>	T_Stats
 %token	<Integer>	T_Statsdir
@@ -210,11 +220,13 @@
 %token	<Integer>	T_Timer
 %token	<Integer>	T_Timingstats
 %token	<Integer>	T_Tinker
+%token	<Integer>	T_Text
 %token	<Integer>	T_Tlsciphers
 %token	<Integer>	T_Tlsciphersuites
 %token	<Integer>	T_Tos
 %token	<Integer>	T_True
 %token	<Integer>	T_Trustedkey
+%token	<Integer>	T_Txstamp
 %token	<Integer>	T_Type
 %token	<Integer>	T_U_int			/* Not a token */
 %token	<Integer>	T_Unit
@@ -226,6 +238,7 @@
 %token	<Integer>	T_WanderThreshold	/* Not a token, used as tag */
 %token	<Integer>	T_Week
 %token	<Integer>	T_Wildcard
+%token	<Integer>	T_Xleave
 %token	<Integer>	T_Year
 %token	<Integer>	T_Flag			/* Not a token, used as tag */
 %token	<Integer>	T_EOC
@@ -246,6 +259,7 @@
 %type	<Attr_val>	filegen_option
 %type	<Attr_val_fifo>	filegen_option_list
 %type	<Integer>	filegen_type
+%type	<Integer>	binary_text
 %type	<Attr_val>	fudge_factor
 %type	<Integer>	fudge_factor_bool_keyword
 %type	<Integer>	fudge_factor_dbl_keyword
@@ -264,6 +278,8 @@
 %type	<Integer>	misc_cmd_int_keyword
 %type	<Integer>	misc_cmd_str_keyword
 %type	<Integer>	misc_cmd_str_lcl_keyword
+%type	<Attr_val>	metrics_option
+%type	<Attr_val_fifo>	metrics_option_list
 %type	<Attr_val>	mru_option
 %type	<Integer>	mru_option_keyword
 %type	<Attr_val_fifo>	mru_option_list
@@ -273,6 +289,9 @@
 %type	<Attr_val>	option_flag
 %type	<Integer>	option_flag_keyword
 %type	<Attr_val_fifo>	option_list
+%type	<Attr_val>	rawstats_option
+%type	<Integer>	rawstats_option_keyword
+%type	<Attr_val_fifo>	rawstats_option_list
 %type	<Attr_val>	option_boolean
 %type	<Integer>	option_bool_keyword
 %type	<Attr_val>	option_double
@@ -423,6 +442,7 @@ option_flag_keyword
 	|	T_Nts
 	|	T_Prefer
 	|	T_True
+	|	T_Xleave
 	;
 
 option_int
@@ -451,6 +471,7 @@ option_int_keyword
 	|	T_Version
 	|	T_Baud
 	|	T_Holdover
+	|	T_Stages
 	;
 
 option_double
@@ -632,6 +653,10 @@ monitoring_command
 			fgn = create_filegen_node($2, $3);
 			APPEND_G_FIFO(cfgt.filegen_opts, fgn);
 		}
+	|	T_Rawstats rawstats_option_list
+			{ CONCAT_G_FIFOS(cfgt.rawstats_opts, $2); }
+	|	T_Metrics metrics_option_list
+			{ CONCAT_G_FIFOS(cfgt.metrics_opts, $2); }
 	;
 
 stats_list
@@ -703,6 +728,15 @@ filegen_option
 				yyerror(err);
 			}
 		}
+	|	binary_text
+		{
+			if (lex_from_file()) {
+				$$ = create_attr_ival(T_Flag, $1);
+			} else {
+				$$ = NULL;
+				yyerror("filegen format remote config ignored");
+			}
+		}
 	|	enable_disable
 			{ $$ = create_attr_ival(T_Flag, $1); }
 	;
@@ -712,11 +746,79 @@ link_nolink
 	|	T_Nolink
 	;
 
+binary_text
+	:	T_Binary
+	|	T_Text
+	;
+
 enable_disable
 	:	T_Enable
 	|	T_Disable
 	;
 
+rawstats_option_list
+	:	rawstats_option_list rawstats_option
+		{
+			$$ = $1;
+			APPEND_G_FIFO($$, $2);
+		}
+	|	rawstats_option
+		{
+			$$ = NULL;
+			APPEND_G_FIFO($$, $1);
+		}
+	;
+
+rawstats_option
+	:	rawstats_option_keyword T_Integer
+			{ $$ = create_attr_ival($1, $2); }
+	|	T_Peer T_String
+			{ $$ = create_attr_sval($1, $2); }
+	;
+
+rawstats_option_keyword
+	:	T_Sample
+	|	T_Reservoir
+	|	T_Interval
+	;
+
+metrics_option_list
+	:	metrics_option_list metrics_option
+		{
+			$$ = $1;
+			APPEND_G_FIFO($$, $2);
+		}
+	|	metrics_option
+		{
+			$$ = NULL;
+			APPEND_G_FIFO($$, $1);
+		}
+	;
+
+metrics_option
+	:	T_Port T_Integer
+		{
+			if (lex_from_file()) {
+				$$ = create_attr_ival($1, $2);
+			} else {
+				$$ = NULL;
+				yyerror("metrics port remote config ignored");
+			}
+		}
+	|	T_Path T_String
+		{
+			if (lex_from_file()) {
+				$$ = create_attr_sval($1, $2);
+			} else {
+				$$ = NULL;
+				YYFREE($2);
+				yyerror("metrics path remote config ignored");
+			}
+		}
+	|	T_Interval T_Integer
+			{ $$ = create_attr_ival($1, $2); }
+	;
+
 filegen_type
 	:	T_None
 	|	T_Pid
@@ -1058,7 +1160,10 @@ system_option_flag_keyword
 	;
 
 system_option_local_flag_keyword
-	:	T_Stats
+	:	T_Logqueue
+	|	T_Shmstats
+	|	T_Stats
+	|	T_Txstamp
 	;
 
 /* Tinker Commands
@@ -1089,7 +1194,8 @@ tinker_option
 	;
 
 tinker_option_keyword
-	:	T_Allan
+	:	T_Adjrate
+	|	T_Allan
 	|	T_Dispersion
 	|	T_Freq
 	|	T_Huffpuff
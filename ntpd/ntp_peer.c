@@ -3,6 +3,8 @@
  */
 #include "config.h"
 
+#include <ctype.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <sys/types.h>
 
@@ -18,8 +20,11 @@
  *
  * - peer_list is a single list with all peers, suitable for scanning
  *   operations over all peers.
- * - peer_adr_hash is an array of lists indexed by hashed peer address.
- * - peer_aid_hash is an array of lists indexed by hashed associd.
+ * - peer_hash is an array of lists indexed by hashed peer address.
+ * - assoc_hash is an array of lists indexed by hashed associd.
+ * - name_hash is an array of lists indexed by hashed hostname.
+ * - poll_heap is a binary min-heap ordered by nextdate, so the timer
+ *   only has to look at the peers that are actually due.
  *
  * They also maintain a free list of peer structures, peer_free.
  *
@@ -29,16 +34,48 @@
  * demobilizes the association and deallocates the structure.
  */
 /*
- * Peer hash tables
+ * Peer hash tables.  Each starts out with NTP_HASH_SIZE buckets,
+ * doubles when it averages more than NTP_HASH_LOAD peers a bucket
+ * and halves again when it gets sparse, so lookups stay short from
+ * a handful of servers up to thousands of associations.
  */
-static struct peer *peer_hash[NTP_HASH_SIZE];	/* peer hash table */
-static int	peer_hash_count[NTP_HASH_SIZE];	/* peers in each bucket */
-static struct peer *assoc_hash[NTP_HASH_SIZE];	/* association ID hash table */
-static int	assoc_hash_count[NTP_HASH_SIZE];/* peers in each bucket */
+struct peer_table {
+	struct peer **	bucket;		/* the chains */
+	unsigned int	size;		/* buckets, power of 2 */
+	unsigned int	count;		/* peers in the table */
+	size_t		link;		/* offset of the chain pointer */
+	unsigned int	(*key)(const struct peer *);
+};
+
+#define	NTP_HASH_LOAD	1		/* peers per bucket before growing */
+#define	CHAIN(t, p)	(*(struct peer **)(void *)((char *)(p) + (t)->link))
+
+static unsigned int	addr_key(const struct peer *);
+static unsigned int	assoc_key(const struct peer *);
+static unsigned int	name_key(const struct peer *);
+
+static struct peer_table peer_hash =		/* peer hash table */
+	{ NULL, 0, 0, offsetof(struct peer, adr_link), addr_key };
+static struct peer_table assoc_hash =		/* association ID hash table */
+	{ NULL, 0, 0, offsetof(struct peer, aid_link), assoc_key };
+static struct peer_table name_hash =		/* hostname hash table */
+	{ NULL, 0, 0, offsetof(struct peer, name_link), name_key };
 struct peer *peer_list;				/* peer structures list */
 static struct peer *peer_free;			/* peer structures free list */
 static int	peer_free_count;		/* count of free structures */
 
+/*
+ * Poll queue.  Every peer is in poll_heap except while it is being
+ * dispatched by the timer: poll_collect() moves the due ones to
+ * poll_due, poll_next() hands them out one by one and puts the
+ * previous one back unless it already got rescheduled.
+ */
+static struct peer **poll_heap;		/* min-heap on nextdate */
+static int	poll_count;			/* peers in poll_heap */
+static int	poll_size;			/* allocated slots */
+static struct peer *poll_due;			/* collected, not dispatched */
+static struct peer *poll_current;		/* last one handed out */
+
 /*
  * Association ID.  We initialize this value randomly, then assign a new
  * value every time an association is mobilized.
@@ -70,9 +107,17 @@ static struct peer *	findexistingpeer_name(const char *, unsigned short,
 static struct peer *	findexistingpeer_addr(sockaddr_u *,
 					      struct peer *, int);
 static void		free_peer(struct peer *);
+static unsigned int	hostname_hash(const char *);
+static struct peer *	table_head(struct peer_table *, unsigned int);
+static void		table_add(struct peer_table *, struct peer *);
+static bool		table_del(struct peer_table *, struct peer *);
+static void		table_resize(struct peer_table *, unsigned int);
 static void		getmorepeermem(void);
 static	void		peer_reset	(struct peer *);
 static int		score(struct peer *);
+static void		poll_insert(struct peer *);
+static void		poll_remove(struct peer *);
+static void		poll_sift(int);
 
 
 /*
@@ -134,11 +179,11 @@ findexistingpeer_name(
 	struct peer *p;
 
 	if (NULL == start_peer) {
-		p = peer_list;
+		p = table_head(&name_hash, hostname_hash(hostname));
 	} else {
-		p = start_peer->p_link;
+		p = start_peer->name_link;
 	}
-	for (; p != NULL; p = p->p_link) {
+	for (; p != NULL; p = p->name_link) {
 		if (p->hostname != NULL
 		    && (-1 == mode || p->hmode == mode)
 		    && (AF_UNSPEC == hname_fam
@@ -175,7 +220,7 @@ findexistingpeer_addr(
 	 * address.
 	 */
 	if (NULL == start_peer)
-		peer = peer_hash[NTP_HASH_ADDR(addr)];
+		peer = table_head(&peer_hash, sock_hash(addr));
 	else
 		peer = start_peer->adr_link;
 
@@ -226,12 +271,11 @@ findpeer(
 {
 	struct peer *	p;
 	sockaddr_u *	srcadr;
-	unsigned int	hash;
 
 	findpeer_calls++;
 	srcadr = &rbufp->recv_srcadr;
-	hash = NTP_HASH_ADDR(srcadr);
-        for (p = peer_hash[hash]; p != NULL; p = p->adr_link) {
+        for (p = table_head(&peer_hash, sock_hash(srcadr)); p != NULL;
+	     p = p->adr_link) {
                 /* [Classic Bug 3072] ensure interface of peer matches */
                 if (p->dstadr != rbufp->dstadr) continue;
 
@@ -253,11 +297,9 @@ findpeerbyassoc(
 	)
 {
 	struct peer *p;
-	unsigned int hash;
 
 	assocpeer_calls++;
-	hash = assoc & NTP_HASH_MASK;
-	for (p = assoc_hash[hash]; p != NULL; p = p->aid_link) {
+	for (p = table_head(&assoc_hash, assoc); p != NULL; p = p->aid_link) {
 		if (assoc == p->associd)
 			break;
 	}
@@ -365,34 +407,21 @@ free_peer(
 	)
 {
 	struct peer *	unlinked;
-	int		hash;
 
 
-	if ((MDF_UCAST & p->cast_flags) && !(FLAG_LOOKUP & p->cfg.flags)) {
-		hash = NTP_HASH_ADDR(&p->srcadr);
-		peer_hash_count[hash]--;
-
-		UNLINK_SLIST(unlinked, peer_hash[hash], p, adr_link,
-			     struct peer);
-		if (NULL == unlinked) {
-			peer_hash_count[hash]++;
-			msyslog(LOG_ERR, "ERR: peer %s not in address table!",
-				socktoa(&p->srcadr));
-		}
-	}
+	if ((MDF_UCAST & p->cast_flags) && !(FLAG_LOOKUP & p->cfg.flags))
+		peer_del_hash(p);
 
 	/* Remove him from the association hash as well. */
-	hash = p->associd & NTP_HASH_MASK;
-	assoc_hash_count[hash]--;
-
-	UNLINK_SLIST(unlinked, assoc_hash[hash], p, aid_link,
-		     struct peer);
-	if (NULL == unlinked) {
-		assoc_hash_count[hash]++;
+	if (!table_del(&assoc_hash, p))
 		msyslog(LOG_ERR,
 			"ERR: peer %s not in association ID table!",
 			socktoa(&p->srcadr));
-	}
+
+	/* and the hostname hash */
+	if (p->hostname != NULL && !table_del(&name_hash, p))
+		msyslog(LOG_ERR, "ERR: peer %s not in hostname table!",
+			p->hostname);
 
 	/* Remove him from the overall list. */
 	UNLINK_SLIST(unlinked, peer_list, p, p_link,
@@ -401,6 +430,15 @@ free_peer(
 		msyslog(LOG_ERR, "ERR: %s not in peer list!",
 			socktoa(&p->srcadr));
 
+	/* and from the poll queue, wherever he is in it */
+	if (p->pollidx)
+		poll_remove(p);
+	else
+		UNLINK_SLIST(unlinked, poll_due, p, due_link,
+			     struct peer);
+	if (p == poll_current)
+		poll_current = NULL;
+
 	if (p->hostname != NULL)
 		free(p->hostname);
 
@@ -551,7 +589,6 @@ newpeer(
 	)
 {
 	struct peer *	peer;
-	unsigned int	hash;
 	const char *	name;	/* for error messages */
 
 	if (NULL != hostname) {
@@ -692,9 +729,9 @@ newpeer(
 		peer_add_hash(peer);
 		restrict_source(peer);
 	}
-	hash = peer->associd & NTP_HASH_MASK;
-	LINK_SLIST(assoc_hash[hash], peer, aid_link);
-	assoc_hash_count[hash]++;
+	table_add(&assoc_hash, peer);
+	if (peer->hostname != NULL)
+		table_add(&name_hash, peer);
 	LINK_SLIST(peer_list, peer, p_link);
 
 	mprintf_event(PEVNT_MOBIL, peer, "assoc %d", peer->associd);
@@ -707,27 +744,154 @@ newpeer(
 
 void peer_del_hash (struct peer *peer)
 {
-        unsigned int hash;
-        struct peer *unlinked;
-
-        hash = NTP_HASH_ADDR(&peer->srcadr);
-        peer_hash_count[hash]--;
-
-        UNLINK_SLIST(unlinked, peer_hash[hash], peer, adr_link, struct peer);
-        if (NULL == unlinked) {
-            peer_hash_count[hash]++;
+        if (!table_del(&peer_hash, peer))
             msyslog(LOG_ERR, "ERR: peer %s not in address table!",
                 socktoa(&peer->srcadr));
-        }
 }
 
 void peer_add_hash (struct peer *peer)
 {
-	unsigned int	hash;
+	table_add(&peer_hash, peer);
+}
+
+
+static unsigned int
+addr_key(
+	const struct peer *	p
+	)
+{
+	return sock_hash(&p->srcadr);
+}
+
+
+static unsigned int
+assoc_key(
+	const struct peer *	p
+	)
+{
+	return p->associd;
+}
+
+
+static unsigned int
+name_key(
+	const struct peer *	p
+	)
+{
+	return hostname_hash(p->hostname);
+}
+
+
+/*
+ * hostname_hash - hash a hostname, ignoring case like the lookups do
+ */
+static unsigned int
+hostname_hash(
+	const char *	name
+	)
+{
+	unsigned int hashVal = 0;
+
+	for (; *name != '\0'; name++)
+		hashVal = 37 * hashVal + (unsigned char)tolower((unsigned char)*name);
+	return hashVal;
+}
+
+
+/*
+ * table_head - first peer in the chain key hashes to
+ */
+static struct peer *
+table_head(
+	struct peer_table *	t,
+	unsigned int		key
+	)
+{
+	if (0 == t->size)
+		return NULL;
+	return t->bucket[key & (t->size - 1)];
+}
+
+
+static void
+table_add(
+	struct peer_table *	t,
+	struct peer *		p
+	)
+{
+	struct peer **	head;
+
+	if (0 == t->size)
+		table_resize(t, NTP_HASH_SIZE);
+	else if (t->count >= NTP_HASH_LOAD * t->size)
+		table_resize(t, 2 * t->size);
+	head = &t->bucket[t->key(p) & (t->size - 1)];
+	CHAIN(t, p) = *head;
+	*head = p;
+	t->count++;
+}
 
-	hash = NTP_HASH_ADDR(&peer->srcadr);
-	LINK_SLIST(peer_hash[hash], peer, adr_link);
-	peer_hash_count[hash]++;
+
+/*
+ * table_del - unlink a peer, false if it wasn't there
+ */
+static bool
+table_del(
+	struct peer_table *	t,
+	struct peer *		p
+	)
+{
+	struct peer **	pp;
+
+	if (0 == t->size)
+		return false;
+	pp = &t->bucket[t->key(p) & (t->size - 1)];
+	while (*pp != NULL && *pp != p)
+		pp = &CHAIN(t, *pp);
+	if (NULL == *pp)
+		return false;
+	*pp = CHAIN(t, p);
+	CHAIN(t, p) = NULL;
+	t->count--;
+	if (t->size > NTP_HASH_SIZE && t->count < t->size / 8)
+		table_resize(t, t->size / 2);
+	return true;
+}
+
+
+/*
+ * table_resize - move every chain over to size buckets
+ *
+ * Peers that land in the same bucket keep their relative order, so
+ * lookups still find the most recent association first.
+ */
+static void
+table_resize(
+	struct peer_table *	t,
+	unsigned int		size
+	)
+{
+	struct peer **	bucket;
+	struct peer **	tail;
+	struct peer *	p;
+	struct peer *	next;
+	unsigned int	i;
+
+	bucket = emalloc_zero(size * sizeof(*bucket));
+	for (i = 0; i < t->size; i++) {
+		for (p = t->bucket[i]; p != NULL; p = next) {
+			next = CHAIN(t, p);
+			tail = &bucket[t->key(p) & (size - 1)];
+			while (*tail != NULL)
+				tail = &CHAIN(t, *tail);
+			CHAIN(t, p) = NULL;
+			*tail = p;
+		}
+	}
+	free(t->bucket);
+	t->bucket = bucket;
+	t->size = size;
+	DPRINT(2, ("table_resize: %u peers, %u buckets\n", t->count, size));
 }
 
 /*
@@ -765,6 +929,7 @@ peer_reset(
 	peer->oldpkt = 0;
 	peer->seldisptoolarge = 0;
 	peer->selbroken = 0;
+	peer->xleaved = 0;
 }
 
 
@@ -799,3 +964,137 @@ void peer_cleanup(void) {
 		unpeer(peer);
 	}
 }
+
+
+/*
+ * poll_sift - restore heap order around slot i after its key changed
+ */
+static void
+poll_sift(
+	int	i
+	)
+{
+	struct peer *	p = poll_heap[i];
+	int		child;
+
+	while (i > 0 &&
+	       poll_heap[(i - 1) / 2]->nextdate > p->nextdate) {
+		poll_heap[i] = poll_heap[(i - 1) / 2];
+		poll_heap[i]->pollidx = i + 1;
+		i = (i - 1) / 2;
+	}
+	for (;;) {
+		child = 2 * i + 1;
+		if (child >= poll_count)
+			break;
+		if (child + 1 < poll_count &&
+		    poll_heap[child + 1]->nextdate <
+		    poll_heap[child]->nextdate)
+			child++;
+		if (poll_heap[child]->nextdate >= p->nextdate)
+			break;
+		poll_heap[i] = poll_heap[child];
+		poll_heap[i]->pollidx = i + 1;
+		i = child;
+	}
+	poll_heap[i] = p;
+	p->pollidx = i + 1;
+}
+
+
+static void
+poll_insert(
+	struct peer *	p
+	)
+{
+	if (poll_count == poll_size) {
+		poll_size = poll_size ? 2 * poll_size : INIT_PEER_ALLOC;
+		poll_heap = erealloc(poll_heap,
+				     (size_t)poll_size * sizeof(*poll_heap));
+	}
+	poll_heap[poll_count++] = p;
+	poll_sift(poll_count - 1);
+}
+
+
+static void
+poll_remove(
+	struct peer *	p
+	)
+{
+	int i = p->pollidx - 1;
+
+	p->pollidx = 0;
+	if (--poll_count == i)
+		return;
+	poll_heap[i] = poll_heap[poll_count];
+	poll_sift(i);
+}
+
+
+/*
+ * poll_schedule - set the time of the next poll for a peer
+ *
+ * All changes to nextdate have to go through here.
+ */
+void
+poll_schedule(
+	struct peer *	p,
+	uptime_t	when
+	)
+{
+	struct peer *	unlinked;
+
+	p->nextdate = when;
+	if (p->pollidx) {
+		poll_sift(p->pollidx - 1);
+		return;
+	}
+	/* collected but not yet dispatched, this is the new plan */
+	UNLINK_SLIST(unlinked, poll_due, p, due_link, struct peer);
+	UNUSED_LOCAL(unlinked);
+	poll_insert(p);
+}
+
+
+/*
+ * poll_collect - take every peer due at or before now off the heap
+ */
+void
+poll_collect(
+	uptime_t	now
+	)
+{
+	struct peer **	tail = &poll_due;
+	struct peer *	p;
+
+	while (*tail != NULL)
+		tail = &(*tail)->due_link;
+	while (poll_count > 0 && poll_heap[0]->nextdate <= now) {
+		p = poll_heap[0];
+		poll_remove(p);
+		p->due_link = NULL;
+		*tail = p;
+		tail = &p->due_link;
+	}
+}
+
+
+/*
+ * poll_next - next collected peer to dispatch, NULL when done
+ *
+ * A peer that didn't reschedule itself keeps its old nextdate and
+ * will be collected again on the next tick.
+ */
+struct peer *
+poll_next(void)
+{
+	if (poll_current != NULL && !poll_current->pollidx)
+		poll_insert(poll_current);
+	poll_current = poll_due;
+	if (poll_current != NULL) {
+		poll_due = poll_current->due_link;
+		poll_current->due_link = NULL;
+	}
+	return poll_current;
+}
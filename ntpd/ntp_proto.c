@@ -78,17 +78,6 @@ static inline l_fp_w htonl_fp(l_fp lfp) {
 #define	STRATUM_TO_PKT(s)	((uint8_t)(((s) == (STRATUM_UNSPEC)) ?\
 				(STRATUM_PKT_UNSPEC) : (s)))
 
-/*
- * peer_select groups statistics for a peer used by clock_select() and
- * clock_cluster().
- */
-typedef struct peer_select_tag {
-	struct peer *	peer;
-	double		synch;	/* sync distance */
-	double		error;	/* jitter */
-	double		seljit;	/* selection jitter */
-} peer_select;
-
 /*
  * System variables are declared here. Unless specified otherwise, all
  * times are in seconds.
@@ -115,6 +104,8 @@ bool leap_sec_in_progress;
  * Nonspecified system state variables
  */
 l_fp	sys_authdelay;		/* authentication delay */
+struct latency_hist serve_latency[LAT_AUTHS][2]; /* reply latency */
+uptime_t serve_latency_reset;	/* time serve_latency cleared */
 double	sys_mindist = MINDISTANCE; /* minimum distance (s) */
 static double	sys_maxdist = MAXDISTANCE; /* selection threshold */
 double	sys_maxdisp = MAXDISPERSE; /* maximum dispersion */
@@ -215,6 +206,8 @@ static	void	measure_precision(const bool);
 static	double	measure_tick_fuzz(void);
 #endif
 static	void	peer_xmit	(struct peer *);
+static	void	serve_latency_add(struct recvbuf *, int, bool,
+				  struct timespec);
 static	int	peer_unfit	(struct peer *);
 static	double	root_distance	(struct peer *);
 #ifndef DISABLE_NTS
@@ -502,6 +495,8 @@ handle_procpkt(
 	)
 {
 	unsigned int outcount = peer->outcount;
+	bool xleaved = false;
+	l_fp t1, t2, t4;
 
 	peer->flash &= ~PKT_BOGON_MASK;
 
@@ -522,6 +517,9 @@ handle_procpkt(
 		rawstats_filter(peer, rbufp, BOGON3, outcount);
 		peer->bogusorg++;
 		return;
+	} else if(peer->xl_dst != 0 && rbufp->pkt.org == peer->xl_dst) {
+		/* Interleaved reply, about the previous exchange */
+		xleaved = true;
 	} else if(rbufp->pkt.org != peer->org_rand) {
 		rawstats_filter(peer, rbufp, BOGON2, outcount);
 		peer->bogusorg++;
@@ -543,6 +541,7 @@ handle_procpkt(
 			report_event(PEVNT_RATE, peer, NULL);
 			peer->burst = peer->retry = 0;
 			peer->throttle = (NTP_SHIFT + 1) * (1 << peer->cfg.minpoll);
+			peer->throttle_time = current_time;
 			if (rbufp->pkt.ppoll > peer->cfg.minpoll)
 			    peer->cfg.minpoll = min(peer->ppoll, 10);
 			poll_update(peer, min(rbufp->pkt.ppoll, 10));
@@ -563,6 +562,26 @@ handle_procpkt(
 		return;
 	}
 
+	/* An interleaved reply's xmt goes with the T1, T2 and T4
+	   of the exchange before this one, saved when we sent.
+	   The server can't have sent that reply before receiving
+	   the request it answered.
+	*/
+	if (xleaved) {
+		t1 = peer->xl_org;
+		t2 = peer->xl_rec;
+		t4 = peer->xl_dst;
+		if (rbufp->pkt.xmt < t2) {
+			rawstats_filter(peer, rbufp, BOGON2, outcount);
+			peer->bogusorg++;
+			return;
+		}
+	} else {
+		t1 = peer->org_ts;
+		t2 = rbufp->pkt.rec;
+		t4 = rbufp->recv_time;
+	}
+
         /* Compute theta (peer offset), delta (peer distance), and epsilon
 	   (peer dispersion) statistics. The timestamps may be large but
 	   the difference between them should be small, so it's important
@@ -571,13 +590,13 @@ handle_procpkt(
 	*/
 
 	const double t34 =
-	    (rbufp->pkt.xmt >= rbufp->recv_time) ?
-	    scalbn((double)(rbufp->pkt.xmt - rbufp->recv_time), -32) :
-	    -scalbn((double)(rbufp->recv_time - rbufp->pkt.xmt), -32);
+	    (rbufp->pkt.xmt >= t4) ?
+	    scalbn((double)(rbufp->pkt.xmt - t4), -32) :
+	    -scalbn((double)(t4 - rbufp->pkt.xmt), -32);
 	const double t21 =
-	    (rbufp->pkt.rec >= peer->org_ts) ?
-	    scalbn((double)(rbufp->pkt.rec - peer->org_ts), -32) :
-	    -scalbn((double)(peer->org_ts - rbufp->pkt.rec), -32);
+	    (t2 >= t1) ?
+	    scalbn((double)(t2 - t1), -32) :
+	    -scalbn((double)(t1 - t2), -32);
 	const double theta = (t21 + t34) / 2.;
 	const double delta = fabs(t21 - t34);
 	const double epsilon = LOGTOD(sys_vars.sys_precision) +
@@ -611,6 +630,9 @@ handle_procpkt(
 	peer->rec = rbufp->pkt.rec;
 	peer->xmt = rbufp->pkt.xmt;
 	peer->dst = rbufp->recv_time;
+	peer->xl_t1 = peer->org_ts;
+	if (xleaved)
+		peer->xleaved++;
 
 	/* Record good packet */
 	record_raw_stats(peer, rbufp, 0, outcount);
@@ -626,7 +648,7 @@ handle_procpkt(
 		else
 			peer->burst = NTP_IBURST - 1;
 		if (peer->burst > 0)
-			peer->nextdate = current_time;
+			poll_schedule(peer, current_time);
 	}
 	poll_update(peer, peer->hpoll);
 
@@ -835,7 +857,7 @@ transmit(
 		     sys_survivors < sys_minclock))
 			if (!dns_probe(peer)) {
 			    /* DNS thread busy, try again soon */
-			    peer->nextdate = current_time;
+			    poll_schedule(peer, current_time);
 			    return;
                      }
 		poll_update(peer, hpoll);
@@ -846,7 +868,7 @@ transmit(
 	if (peer->cfg.flags & FLAG_LOOKUP) {
 		peer->outdate = current_time;
 		if (!dns_probe(peer)) {
-			peer->nextdate = current_time;
+			poll_schedule(peer, current_time);
 			return;
 		}
 		poll_update(peer, hpoll);
@@ -1125,6 +1147,31 @@ clock_update(
 }
 
 
+/*
+ * peer_throttle - current value of the rate control bucket
+ *
+ * The bucket drains by one every second.  Rather than having the
+ * timer touch every peer every second, the drain is settled here
+ * whenever somebody looks at it.
+ */
+int
+peer_throttle(
+	struct peer *peer	/* peer structure pointer */
+	)
+{
+	uptime_t elapsed = current_time - peer->throttle_time;
+
+	if (peer->throttle > 0) {
+		if (elapsed >= (uptime_t)peer->throttle)
+			peer->throttle = 0;
+		else
+			peer->throttle -= (int)elapsed;
+	}
+	peer->throttle_time = current_time;
+	return peer->throttle;
+}
+
+
 /*
  * poll_update - update peer poll interval
  */
@@ -1167,17 +1214,17 @@ poll_update(
 	 * slink away. If called from the poll process, delay 1 s for a
 	 * reference clock, otherwise 2 s.
 	 */
-	utemp = current_time + (unsigned long)max(peer->throttle - (NTP_SHIFT - 1) *
+	utemp = current_time + (unsigned long)max(peer_throttle(peer) - (NTP_SHIFT - 1) *
 	    (1 << peer->cfg.minpoll), rstrct.ntp_minpkt);
 	if (peer->burst > 0) {
 		if (peer->nextdate > current_time)
 			return;
 #ifdef REFCLOCK
 		else if (peer->cfg.flags & FLAG_REFCLOCK)
-			peer->nextdate = current_time + RESP_DELAY;
+			poll_schedule(peer, current_time + RESP_DELAY);
 #endif /* REFCLOCK */
 		else
-			peer->nextdate = utemp;
+			poll_schedule(peer, utemp);
 
 	/*
 	 * The ordinary case. If a retry, use minpoll; if unreachable,
@@ -1204,12 +1251,11 @@ poll_update(
 			next = ((0x1000UL | (random() & 0x0ff)) <<
 			    hpoll) >> 12;
 		next += peer->outdate;
-		if (next > utemp)
-			peer->nextdate = next;
-		else
-			peer->nextdate = utemp;
+		if (next < utemp)
+			next = utemp;
 		if (peer->throttle > (1 << peer->cfg.minpoll))
-			peer->nextdate += (unsigned long)rstrct.ntp_minpkt;
+			next += (unsigned long)rstrct.ntp_minpkt;
+		poll_schedule(peer, next);
 	}
 	DPRINT(2, ("poll_update: at %u %s poll %d burst %d retry %d head %d early %u next %u\n",
 		   current_time, socktoa(&peer->srcadr), peer->hpoll,
@@ -1264,9 +1310,10 @@ peer_clear(
 	 * randomize the first poll over the minimum poll interval to
 	 * avoid implosion.
 	 */
-	peer->nextdate = peer->update = peer->outdate = current_time;
+	peer->update = peer->outdate = current_time;
 	if (initializing1) {
-		peer->nextdate += (unsigned long)peer_associations;
+		poll_schedule(peer,
+			      current_time + (unsigned long)peer_associations);
 	} else {
 	    /*
 	     * Randomizing the next poll interval used to be done with
@@ -1279,7 +1326,8 @@ peer_clear(
 	     * association ID fits the bill.
 	     */
 	    unsigned int pseudorand = peer->associd ^ sock_hash(&peer->srcadr);
-	    peer->nextdate += (pseudorand % (1 << peer->cfg.minpoll));
+	    poll_schedule(peer,
+			  current_time + (pseudorand % (1 << peer->cfg.minpoll)));
 	}
 	DPRINT(1, ("peer_clear: at %u next %u associd %d refid %s\n",
 		   current_time, peer->nextdate, peer->associd,
@@ -1480,15 +1528,13 @@ void
 clock_select(void)
 {
 	struct peer *peer;
-	int	i, j, k, n;
+	int	i, j;
 	int	nlist, nl2;
-	int	allow;
 	int	speer;
-	double	d, e, f, g;
+	double	e, f;
 	double	high, low;
 	double	speermet;
 	double	orphmet = 2.0 * UINT32_MAX; /* 2x is greater than */
-	struct endpoint endp;
 	struct peer *osys_peer;
 	struct peer *sys_prefer = NULL;	/* prefer peer */
 	struct peer *typesystem = NULL;
@@ -1498,18 +1544,10 @@ clock_select(void)
 	struct peer *typelocal = NULL;
 	struct peer *typepps = NULL;
 #endif /* REFCLOCK */
-	static struct endpoint *endpoint = NULL;
-	static int *indx = NULL;
-	static peer_select *peers = NULL;
-	static unsigned int endpoint_size = 0;
-	static unsigned int peers_size = 0;
-	static unsigned int indx_size = 0;
-	size_t octets;
+	static struct select_list cand;
+	struct endpoint *endpoint;
+	peer_select *peers;
 
-	/*
-	 * Initialize and create endpoint, index and peer lists big
-	 * enough to handle all associations.
-	 */
 	osys_peer = sys_vars.sys_peer;
 	sys_survivors = 0;
 	if (loop_data.lockclock) {
@@ -1519,20 +1557,13 @@ clock_select(void)
 	}
 
 	/*
-	 * Allocate dynamic space depending on the number of
-	 * associations.
+	 * The candidate arrays persist and grow as candidates are
+	 * added, so there is no need to count the associations first.
+	 * There is always room for the one fallback survivor.
 	 */
-	nlist = 1;
-	for (peer = peer_list; peer != NULL; peer = peer->p_link) {
-		nlist++;
-	}
-	endpoint_size = ALIGNED_SIZE((unsigned int)nlist * 2 * sizeof(*endpoint));
-	peers_size = ALIGNED_SIZE((unsigned int)nlist * sizeof(*peers));
-	indx_size = ALIGNED_SIZE((unsigned int)nlist * 2 * sizeof(*indx));
-	octets = endpoint_size + peers_size + indx_size;
-	endpoint = erealloc(endpoint, octets);
-	peers = INC_ALIGNED_PTR(endpoint, endpoint_size);
-	indx = INC_ALIGNED_PTR(peers, peers_size);
+	select_grow(&cand, 1);
+	endpoint = cand.endpoint;
+	peers = cand.peers;
 
 	/*
 	 * Initially, we populate the island with all the rifraff peers
@@ -1623,6 +1654,11 @@ clock_select(void)
 		 * idol.
 		 */
 		peer->new_status = CTL_PST_SEL_SANE;
+		if (nlist >= cand.size) {
+			select_grow(&cand, nlist + 1);
+			endpoint = cand.endpoint;
+			peers = cand.peers;
+		}
 		f = root_distance(peer);
 		peers[nlist].peer = peer;
 		peers[nlist].error = peer->jitter;
@@ -1642,89 +1678,12 @@ clock_select(void)
 		nl2++;
 	}
 	/*
-	 * Construct sorted indx[] of endpoint[] indexes ordered by
-	 * offset.
+	 * Cleave the truechimers from the falsetickers.  The original
+	 * algorithm was described in Keith Marzullo's dissertation, but
+	 * has been modified for better accuracy.  See select_intersect()
+	 * for the details.
 	 */
-	for (i = 0; i < nl2; i++) {
-		indx[i] = i;
-	}
-	for (i = 0; i < nl2; i++) {
-		endp = endpoint[indx[i]];
-		e = endp.val;
-		k = i;
-		for (j = i + 1; j < nl2; j++) {
-			endp = endpoint[indx[j]];
-			if (endp.val < e) {
-				e = endp.val;
-				k = j;
-			}
-		}
-		if (k != i) {
-			j = indx[k];
-			indx[k] = indx[i];
-			indx[i] = j;
-		}
-	}
-	for (i = 0; i < nl2; i++)
-		DPRINT(3, ("select: endpoint %2d %.6f\n",
-			   endpoint[indx[i]].type, endpoint[indx[i]].val));
-
-	/*
-	 * This is the actual algorithm that cleaves the truechimers
-	 * from the falsetickers. The original algorithm was described
-	 * in Keith Marzullo's dissertation, but has been modified for
-	 * better accuracy.
-	 *
-	 * Briefly put, we first assume there are no falsetickers, then
-	 * scan the candidate list first from the low end upwards and
-	 * then from the high end downwards. The scans stop when the
-	 * number of intersections equals the number of candidates less
-	 * the number of falsetickers. If this doesn't happen for a
-	 * given number of falsetickers, we bump the number of
-	 * falsetickers and try again. If the number of falsetickers
-	 * becomes equal to or greater than half the number of
-	 * candidates, the Albanians have won the Byzantine wars and
-	 * correct synchronization is not possible.
-	 *
-	 * Here, nlist is the number of candidates and allow is the
-	 * number of falsetickers. Upon exit, the truechimers are the
-	 * survivors with offsets not less than low and not greater than
-	 * high. There may be none of them.
-	 */
-	low = 1e9;
-	high = -1e9;
-	for (allow = 0; 2 * allow < nlist; allow++) {
-
-		/*
-		 * Bound the interval (low, high) as the smallest
-		 * interval containing points from the most sources.
-		 */
-		n = 0;
-		for (i = 0; i < nl2; i++) {
-			low = endpoint[indx[i]].val;
-			n -= endpoint[indx[i]].type;
-			if (n >= nlist - allow) {
-				break;
-}
-		}
-		n = 0;
-		for (j = nl2 - 1; j >= 0; j--) {
-			high = endpoint[indx[j]].val;
-			n += endpoint[indx[j]].type;
-			if (n >= nlist - allow) {
-				break;
-}
-		}
-
-		/*
-		 * If an interval containing truechimers is found, stop.
-		 * If not, increase the number of falsetickers and go
-		 * around again.
-		 */
-		if (high > low) {
-			break;
-}
-	}
+	select_intersect(&cand, nlist, &low, &high);
 
 	/*
 	 * Clustering algorithm. Whittle candidate list of falsetickers,
@@ -1810,42 +1769,7 @@ clock_select(void)
 	 * jitter. Stop if we are about to discard a TRUE or PREFER
 	 * peer, who of course have the immunity idol.
 	 */
-	while (1) {
-		d = 1e9; // Minimum peer jitter
-		e = -1e9; // Worst peer select jitter * synch
-		g = 0; // Worst peer select jitter
-		k = 0; // Index of the worst peer
-		for (i = 0; i < nlist; i++) {
-			if (peers[i].error < d) {
-				d = peers[i].error;
-			}
-			peers[i].seljit = 0;
-			if (nlist > 1) {
-				f = 0;
-				for (j = 0; j < nlist; j++)
-					f += DIFF(peers[j].peer->offset,
-					    peers[i].peer->offset);
-				peers[i].seljit = SQRT(f / (nlist - 1));
-			}
-			if (peers[i].seljit * peers[i].synch > e) {
-				g = peers[i].seljit;
-				e = peers[i].seljit * peers[i].synch;
-				k = i;
-			}
-		}
-		if (nlist <= max(1, sys_minclock) || g <= d ||
-		    ((FLAG_TRUE | FLAG_PREFER) & peers[k].peer->cfg.flags))
-			break;
-
-		DPRINT(3, ("select: drop %s seljit %.6f jit %.6f\n",
-			   socktoa(&peers[k].peer->srcadr), g, d));
-		if (nlist > sys_maxclock)
-			peers[k].peer->new_status = CTL_PST_SEL_EXCESS;
-		for (j = k + 1; j < nlist; j++) {
-			peers[j - 1] = peers[j];
-		}
-		nlist--;
-	}
+	nlist = select_cluster(peers, nlist, sys_minclock, sys_maxclock);
 
 	/*
 	 * What remains is a list usually not greater than sys_minclock
@@ -2122,6 +2046,20 @@ peer_xmit(
 		xpkt.reftime = htonl_fp(0);
 		xpkt.org = htonl_fp(0);
 		xpkt.rec = htonl_fp(0);
+		peer->xl_dst = 0;
+		if ((FLAG_XLEAVE & peer->cfg.flags) && 0 != peer->xl_t1) {
+			/*
+			 * Interleaved mode: send back the server's rec
+			 * and our dst from the last good reply.  If the
+			 * server still has that exchange, it answers with
+			 * when its reply really left and our dst in org.
+			 */
+			peer->xl_org = peer->xl_t1;
+			peer->xl_rec = peer->rec;
+			peer->xl_dst = peer->dst;
+			xpkt.org = htonl_fp(peer->rec);
+			xpkt.rec = htonl_fp(peer->dst);
+		}
 		ntp_RAND_bytes((unsigned char *)&peer->org_rand,
 			sizeof(peer->org_rand));
 		get_systime(&peer->org_ts);	/* as late as possible */
@@ -2170,11 +2108,13 @@ peer_xmit(
 	}
 
 	sendpkt(&peer->srcadr, peer->dstadr, &xpkt, sendlen);
+	if (FLAG_XLEAVE & peer->cfg.flags)
+		txstamp_tag(peer->dstadr, NULL, peer->associd, false);
 
 	peer->sent++;
         peer->outcount++;
         peer->bogons = 0;
-	peer->throttle += (1 << peer->cfg.minpoll) - 2;
+	peer->throttle = peer_throttle(peer) + (1 << peer->cfg.minpoll) - 2;
 	DPRINT(1, ("transmit: at %u %s->%s mode %d keyid %08x len %u\n",
 		   current_time, peer->dstadr ?
 		   socktoa(&peer->dstadr->sin) : "-",
@@ -2207,6 +2147,9 @@ fast_xmit(
 	l_fp	xmt_tx;
 	struct timespec	start, finish;
 	size_t	sendlen;
+	int	lat_auth = LAT_NONE;
+	mon_entry *mon = NULL;	/* for interleaved mode */
+	bool	xleaved = false;
 
 	/*
 	 * Initialize transmit packet header fields from the receive
@@ -2296,6 +2239,20 @@ fast_xmit(
 		xpkt.org.l_ui = htonl(rbufp->pkt.xmt >> 32);
 		xpkt.org.l_uf = htonl(rbufp->pkt.xmt & 0xFFFFFFFF);
 
+		/*
+		 * Interleaved mode: if the client's org is the rec we
+		 * put in our last reply, it wants to know when that
+		 * reply really left.  Send that in xmt, and its rec
+		 * back in org so it can tell this from a basic reply.
+		 */
+		mon = rbufp->mon;
+		if (NULL != mon && 0 != mon->xl_tx &&
+		    0 != rbufp->pkt.org && rbufp->pkt.org == mon->xl_rx) {
+			xleaved = true;
+			xpkt.org.l_ui = htonl(rbufp->pkt.rec >> 32);
+			xpkt.org.l_uf = htonl(rbufp->pkt.rec & 0xFFFFFFFF);
+		}
+
 #ifdef ENABLE_LEAP_SMEAR
 		this_recv_time = rbufp->recv_time;
 		if (leap_smear.in_progress)
@@ -2305,7 +2262,10 @@ fast_xmit(
 		xpkt.rec = htonl_fp(rbufp->recv_time);
 #endif
 
-		get_systime(&xmt_tx);
+		if (xleaved)
+			xmt_tx = mon->xl_tx;
+		else
+			get_systime(&xmt_tx);
 #ifdef ENABLE_LEAP_SMEAR
 		if (leap_smear.in_progress)
 			leap_smear_add_offs(&xmt_tx);
@@ -2336,8 +2296,10 @@ fast_xmit(
 #ifndef DISABLE_NTS
 	  sendlen += extens_server_send(&rbufp->ntspacket, &xpkt);
 #endif
+	  lat_auth = LAT_NTS;
         } else if (NULL != auth) {
 	  sendlen += (size_t)authencrypt(auth, (uint32_t *)&xpkt, (int)sendlen);
+	  lat_auth = LAT_SYMMETRIC;
         }
 	if (sendlen > rbufp->recv_length) {
 	  /* About to send a response that is bigger than the request.
@@ -2347,9 +2309,20 @@ fast_xmit(
 	  maybe_log_junk("DDoS", rbufp);	/* needs a counter */
 	  return;
 	}
+	if (NULL != mon) {
+		mon->xl_rx = lfpinit_u(ntohl(xpkt.rec.l_ui),
+				       ntohl(xpkt.rec.l_uf));
+		mon->xl_tx = 0;
+	}
 	sendpkt(&rbufp->recv_srcadr, rbufp->dstadr, &xpkt, (int)sendlen);
 	clock_gettime(CLOCK_REALTIME, &finish);
 	sys_authdelay = tspec_to_d(sub_tspec(finish, start));
+	serve_latency_add(rbufp, lat_auth, (flags & RES_KOD), finish);
+	if (NULL != mon) {
+		/* Only a kernel stamp is worth interleaving, a time
+		 * taken here is worse than the xmt we just sent. */
+		txstamp_tag(rbufp->dstadr, mon, 0, xleaved);
+	}
 	/* Previous versions of this code had separate DPRINT-s so it
 	 * could print the key on the auth case.  That requires separate
 	 * sendpkt-s on each branch or the DPRINT pollutes the timing. */
@@ -2359,6 +2332,51 @@ fast_xmit(
 }
 
 
+/*
+ * serve_latency_add - count a reply in the latency histograms.
+ * This runs for every reply, so keep it cheap.
+ */
+static void
+serve_latency_add(
+	struct recvbuf *rbufp,	/* request, for the receive timestamp */
+	int	auth,		/* LAT_NONE, LAT_SYMMETRIC, LAT_NTS */
+	bool	kod,		/* reply was a KoD */
+	struct timespec	sent	/* sendpkt() return time */
+	)
+{
+	l_fp	delta;
+	uint64_t us = 0;
+	int	bucket = 0;
+
+	delta = tspec_stamp_to_lfp(sent) - rbufp->recv_time;
+	if ((int64_t)delta >= (int64_t)((l_fp)1 << 44)) {
+		/* an hour or more, so the clock was stepped; the top
+		 * bucket already starts at a few seconds */
+		bucket = LAT_BUCKETS - 1;
+	} else if ((int64_t)delta > 0) {
+		/* under 2^12 s, so 20 bits of fraction times US_PER_S
+		 * fits in 64 */
+		us = ((delta >> 12) * US_PER_S) >> 20;
+	}
+	while (us > 0 && bucket < LAT_BUCKETS - 1) {
+		us >>= 1;
+		bucket++;
+	}
+	serve_latency[auth][kod ? 1 : 0].count[bucket]++;
+}
+
+
+/*
+ * serve_latency_clr_stats - clear the reply latency histograms
+ */
+void
+serve_latency_clr_stats(void)
+{
+	memset(serve_latency, 0, sizeof(serve_latency));
+	serve_latency_reset = current_time;
+}
+
+
 /*
  * dns_take_server - process DNS query for server.
  */
@@ -2413,7 +2431,7 @@ dns_take_server(
 	peer_refresh_interface(server);
 
 	server->hpoll = server->cfg.minpoll;
-	server->nextdate = current_time;
+	poll_schedule(server, current_time);
 	peer_xmit(server);
 	if (server->cfg.flags & FLAG_IBURST)
 	  server->retry = NTP_RETRY;
@@ -2519,7 +2537,7 @@ void dns_take_status(struct peer* peer, DNS_Status status) {
 	if (0 == hpoll)
 		return; /* hpoll already in use by new server */
 	peer->hpoll = hpoll;
-	peer->nextdate = current_time + (1U << hpoll);
+	poll_schedule(peer, current_time + (1U << hpoll));
 }
 
 #ifndef DISABLE_NTS
@@ -2540,7 +2558,7 @@ static void restart_nts_ke(struct peer *peer) {
 		hpoll = 12;	/* 4096, a bit over an hour */
 	peer->ppoll = NTP_MAXPOLL_UNK;
 	peer->hpoll = hpoll;
-	peer->nextdate = current_time + (1U << hpoll);
+	poll_schedule(peer, current_time + (1U << hpoll));
 	peer->cfg.flags |= FLAG_LOOKUP;
 };
 #endif
@@ -2885,6 +2903,10 @@ proto_config(
 		stats_control = (bool)value;
 		break;
 
+	case PROTO_TXSTAMP:	/* transmit timestamps (txstamp) */
+		io_txstamps((bool)value);
+		break;
+
 	/*
 	 * tos command - arguments are double, sometimes cast to int
 	 */
@@ -5,6 +5,7 @@
 
 #include "ntpd.h"
 #include "ntp_io.h"
+#include "ntp_lists.h"
 #include "ntp_tty.h"
 #include "ntp_refclock.h"
 #include "ntp_stdlib.h"
@@ -27,10 +28,24 @@
 #endif /* HAVE_PPSAPI */
 
 
-#define SAMPLE(x)	pp->coderecv = (pp->coderecv + 1) % MAXSTAGE; \
-			pp->filter[pp->coderecv] = (x); \
-			if (pp->coderecv == pp->codeproc) \
-				pp->codeproc = (pp->codeproc + 1) % MAXSTAGE;
+/*
+ * The samples waiting in the filter[] ring are also kept in ascending
+ * order in a skip list threaded through the ring slots, so that
+ * refclock_sample() doesn't have to sort them at every poll.  Slot
+ * filtsize is the list head.  Node heights come from the trailing
+ * zero bits of an insertion count rather than from a random number
+ * generator; they are still independent of the sample values, which
+ * is what keeps the expected search O(log n).
+ */
+#define SKIP_LEVELS	12	/* log2(NSTAGE_MAX) */
+
+struct filter_order {
+	int		count;		/* samples in the list */
+	int		levels;		/* levels in use */
+	unsigned int	seq;		/* insertions, for node heights */
+	int		(*next)[SKIP_LEVELS]; /* filtsize + 1 nodes */
+	double		*sorted;	/* refclock_sample() scratch */
+};
 
 #define TTY	struct termios
 
@@ -65,11 +80,16 @@
 /* #define LF		0x0a	* ASCII LF UNUSED */
 
 bool	cal_enable;		/* enable refclock calibrate */
+static struct peer *refclock_list;	/* running clocks, for the timer */
 
 /*
  * Forward declarations
  */
-static int refclock_cmpl_fp (const void *, const void *);
+static void filter_add (struct refclockproc *, double);
+static void filter_clear (struct refclockproc *);
+static void filter_insert (struct refclockproc *, int);
+static void filter_remove (struct refclockproc *, int);
+static void filter_sync (struct refclockproc *);
 static int refclock_sample (struct refclockproc *);
 static bool refclock_setup (int, unsigned int, unsigned int);
 
@@ -188,6 +208,14 @@ refclock_newpeer(
 	 */
 	pp = emalloc_zero(sizeof(*pp));
 	peer->procptr = pp;
+	pp->filtsize = (peer->cfg.stages ? (int)peer->cfg.stages : MAXSTAGE) + 1;
+	pp->filter = emalloc_zero((size_t)pp->filtsize * sizeof(*pp->filter));
+	pp->order = emalloc_zero(sizeof(*pp->order));
+	pp->order->next = emalloc((size_t)(pp->filtsize + 1) *
+				  sizeof(*pp->order->next));
+	pp->order->sorted = emalloc((size_t)pp->filtsize *
+				    sizeof(*pp->order->sorted));
+	filter_clear(pp);
 
 	/*
 	 * Initialize structures
@@ -216,6 +244,7 @@ refclock_newpeer(
 		return false;
 	}
 	peer->refid = pp->refid;
+	LINK_SLIST(refclock_list, peer, rc_link);
 	return true;
 }
 
@@ -228,12 +257,16 @@ refclock_unpeer(
 	struct peer *peer	/* peer structure pointer */
 	)
 {
+	struct peer *unlinked;
+
 	/*
 	 * Wiggle the driver to release its resources, then give back
 	 * the interface structure.
 	 */
 	if (NULL == peer->procptr)
 		return;
+	UNLINK_SLIST(unlinked, refclock_list, peer, rc_link, struct peer);
+	UNUSED_LOCAL(unlinked);
 
 	/* There's a standard shutdown sequence if user didn't declare one */
 	if (peer->procptr->conf->clock_shutdown)
@@ -244,6 +277,10 @@ refclock_unpeer(
 		if (-1 != peer->procptr->io.fd)
 			io_closeclock(&peer->procptr->io);
 	}
+	free(peer->procptr->order->next);
+	free(peer->procptr->order->sorted);
+	free(peer->procptr->order);
+	free(peer->procptr->filter);
 	free(peer->procptr);
 	peer->procptr = NULL;
 }
@@ -269,6 +306,22 @@ refclock_timer(
 }
 
 
+/*
+ * refclock_timers - run refclock_timer() on every running clock
+ */
+void
+refclock_timers(void)
+{
+	struct peer *p;
+	struct peer *next_peer;
+
+	for (p = refclock_list; p != NULL; p = next_peer) {
+		next_peer = p->rc_link;
+		refclock_timer(p);
+	}
+}
+
+
 /*
  * refclock_transmit - simulate the transmit procedure
  *
@@ -326,24 +379,142 @@ refclock_transmit(
 
 
 /*
- * Compare two doubles - used with qsort()
+ * filter_before - skip list order: by value, ties by slot
  */
-static int
-refclock_cmpl_fp(
-	const void *p1,
-	const void *p2
+static inline bool
+filter_before(
+	const struct refclockproc *pp,
+	int	a,
+	int	b
+	)
+{
+	return pp->filter[a] < pp->filter[b] ||
+	       (!(pp->filter[a] > pp->filter[b]) && a < b);
+}
+
+
+/*
+ * filter_clear - empty the skip list
+ */
+static void
+filter_clear(
+	struct refclockproc *pp
+	)
+{
+	struct filter_order *fo = pp->order;
+	int	l;
+
+	for (l = 0; l < SKIP_LEVELS; l++)
+		fo->next[pp->filtsize][l] = -1;
+	fo->levels = 1;
+	fo->count = 0;
+}
+
+
+/*
+ * filter_insert - add ring slot to the skip list
+ */
+static void
+filter_insert(
+	struct refclockproc *pp,
+	int	slot
 	)
 {
-	const double *dp1 = (const double *)p1;
-	const double *dp2 = (const double *)p2;
+	struct filter_order *fo = pp->order;
+	int	update[SKIP_LEVELS];
+	int	height, l, n, x;
+
+	x = pp->filtsize;
+	for (l = fo->levels - 1; l >= 0; l--) {
+		while ((n = fo->next[x][l]) >= 0 &&
+		       filter_before(pp, n, slot))
+			x = n;
+		update[l] = x;
+	}
+	fo->seq++;
+	for (height = 1; height < SKIP_LEVELS &&
+	     !(fo->seq & (1U << (height - 1))); height++)
+		continue;
+	for (; fo->levels < height; fo->levels++)
+		update[fo->levels] = pp->filtsize;
+	for (l = 0; l < height; l++) {
+		fo->next[slot][l] = fo->next[update[l]][l];
+		fo->next[update[l]][l] = slot;
+	}
+	fo->count++;
+}
 
-	if (*dp1 < *dp2) {
-		return COMPARE_LESSTHAN;
+
+/*
+ * filter_remove - take ring slot out of the skip list
+ *
+ * Must be called before the slot is overwritten.
+ */
+static void
+filter_remove(
+	struct refclockproc *pp,
+	int	slot
+	)
+{
+	struct filter_order *fo = pp->order;
+	int	l, n, x;
+
+	x = pp->filtsize;
+	for (l = fo->levels - 1; l >= 0; l--) {
+		while ((n = fo->next[x][l]) >= 0 &&
+		       filter_before(pp, n, slot))
+			x = n;
+		if (n == slot)
+			fo->next[x][l] = fo->next[slot][l];
 	}
-	if (*dp1 > *dp2) {
-		return COMPARE_GREATERTHAN;
+	fo->count--;
+}
+
+
+/*
+ * filter_sync - rebuild the skip list if a driver has reset the ring
+ *
+ * Several drivers discard pending samples by setting codeproc or
+ * coderecv directly.  That always leaves the ring holding fewer
+ * samples than the list, so comparing the counts is enough to notice.
+ */
+static void
+filter_sync(
+	struct refclockproc *pp
+	)
+{
+	int	n, slot;
+
+	n = (pp->coderecv - pp->codeproc + pp->filtsize) % pp->filtsize;
+	if (n == pp->order->count)
+		return;
+	filter_clear(pp);
+	for (slot = pp->codeproc; slot != pp->coderecv; ) {
+		slot = (slot + 1) % pp->filtsize;
+		filter_insert(pp, slot);
 	}
-	return COMPARE_EQUAL;
+}
+
+
+/*
+ * filter_add - put a sample in the median filter
+ *
+ * If the ring is full the oldest sample is quietly discarded.
+ */
+static void
+filter_add(
+	struct refclockproc *pp,
+	double	offset
+	)
+{
+	filter_sync(pp);
+	pp->coderecv = (pp->coderecv + 1) % pp->filtsize;
+	if (pp->coderecv == pp->codeproc) {
+		pp->codeproc = (pp->codeproc + 1) % pp->filtsize;
+		filter_remove(pp, pp->codeproc);
+	}
+	pp->filter[pp->coderecv] = offset;
+	filter_insert(pp, pp->coderecv);
 }
 
 
@@ -369,7 +540,7 @@ refclock_process_offset(
 	lftemp = lasttim;
 	lftemp -= lastrec;
 	doffset = lfptod(lftemp);
-	SAMPLE(doffset + fudge);
+	filter_add(pp, doffset + fudge);
 }
 
 
@@ -445,25 +616,24 @@ refclock_sample(
 	)
 {
 	size_t	i, j, k, m, n;
-	double	off[MAXSTAGE];
+	double	*off = pp->order->sorted;
 	double	offset;
+	int	slot;
 
 	/*
-	 * Copy the raw offsets and sort into ascending order. Don't do
-	 * anything if the buffer is empty.
+	 * Take the raw offsets in ascending order off the skip list
+	 * and empty the buffer. Don't do anything if it is empty.
 	 */
+	filter_sync(pp);
 	n = 0;
-	while (pp->codeproc != pp->coderecv) {
-		pp->codeproc = (pp->codeproc + 1) % MAXSTAGE;
-		off[n] = pp->filter[pp->codeproc];
-		n++;
-	}
+	for (slot = pp->order->next[pp->filtsize][0]; slot >= 0;
+	     slot = pp->order->next[slot][0])
+		off[n++] = pp->filter[slot];
+	filter_clear(pp);
+	pp->codeproc = pp->coderecv;
 	if (n == 0)
 		return (0);
 
-	if (n > 1)
-		qsort(off, n, sizeof(off[0]), refclock_cmpl_fp);
-
 	/*
 	 * Reject the furthest from the median of the samples until
 	 * approximately 60 percent of the samples remain.
@@ -643,6 +813,153 @@ refclock_gtraw(
 }
 
 
+/*
+ * refclock_chartime - seconds per character at a serial port speed
+ *
+ * The speed is a termios code, as for refclock_open(), or the plain
+ * bit rate some drivers pass on from the baud option.  Every framing
+ * the drivers use, 8N1 and the 7O1 of the HP receivers, takes ten bit
+ * times per character.  Returns 0 for speeds not listed here.
+ */
+double
+refclock_chartime(
+	unsigned int	speed	/* serial port speed (code) */
+	)
+{
+	static const struct {
+		unsigned int	code;
+		unsigned int	bps;
+	} speeds[] = {
+		{ B300, 300 }, { B600, 600 }, { B1200, 1200 },
+		{ B2400, 2400 }, { B4800, 4800 }, { B9600, 9600 },
+		{ B19200, 19200 }, { B38400, 38400 },
+#ifdef B57600
+		{ B57600, 57600 },
+#endif
+#ifdef B115200
+		{ B115200, 115200 },
+#endif
+#ifdef B230400
+		{ B230400, 230400 },
+#endif
+#ifdef B460800
+		{ B460800, 460800 },
+#endif
+#ifdef B921600
+		{ B921600, 921600 },
+#endif
+	};
+
+	for (size_t i = 0; i < COUNTOF(speeds); i++)
+		if (speeds[i].code == speed || speeds[i].bps == speed)
+			return 10.0 / speeds[i].bps;
+	return 0;
+}
+
+
+/*
+ * refclock_bytetime - when a byte arrived
+ *
+ * ts is when a read returned, and after is the number of bytes that
+ * read delivered behind the one of interest.  Those took after
+ * character times to come down the line, so the byte arrived that much
+ * earlier than the last one.
+ */
+l_fp
+refclock_bytetime(
+	const struct refclockio *rio,	/* I/O structure */
+	l_fp	ts,			/* read timestamp */
+	size_t	after			/* bytes behind this one */
+	)
+{
+	if (after > 0 && rio->chartime > 0)
+		ts -= dtolfp(rio->chartime * after);
+	return ts;
+}
+
+
+/*
+ * refclock_linemode - hand the driver whole lines
+ *
+ * Instead of one recvbuf per read, and in canonical mode one read per
+ * line, the I/O code reads whatever the port has into a buffer of its
+ * own and refclock_lines() passes each complete line to the line
+ * routine given here.  The port must be opened with LDISC_RAW.  Each
+ * line comes with the arrival time of its terminator, worked back from
+ * the read time at the given port speed, so lines that queued up while
+ * ntpd was busy still get their own timestamps.
+ */
+void
+refclock_linemode(
+	struct refclockio *rio,		/* I/O structure */
+	unsigned int	speed,		/* serial port speed (code) */
+	void		(*line)(struct peer *, char *, int, l_fp *)
+	)
+{
+	if (NULL == rio->linebuf)
+		rio->linebuf = emalloc(LINEBUF_SIZE);
+	rio->linelen = 0;
+	rio->chartime = refclock_chartime(speed);
+	rio->clock_line = line;
+}
+
+
+/*
+ * refclock_lines - split freshly read data into lines
+ *
+ * The I/O code has appended len bytes, read at ts, to rio->linebuf.
+ * Lines end in CR or LF.  Each is groomed in place the way
+ * refclock_gtlin() does it and passed on; empty ones are dropped.  A
+ * trailing partial line is kept for next time, unless it fills the
+ * whole buffer.  Returns the number of lines passed on.
+ */
+int
+refclock_lines(
+	struct refclockio *rio,		/* I/O structure */
+	size_t	len,			/* bytes just read */
+	l_fp	ts			/* when they were read */
+	)
+{
+	char	*sp, *dp, *line, *end;
+	l_fp	lts;
+	int	count = 0;
+
+	line = rio->linebuf;
+	sp = line + rio->linelen;	/* no terminator before here */
+	end = sp + len;
+	dp = sp;
+	for (; sp != end; sp++) {
+		char c = *sp & 0x7f;
+
+		if ('\r' == c || '\n' == c) {
+			*dp = '\0';
+			if (dp != line) {
+				lts = refclock_bytetime(rio, ts,
+					(size_t)(end - sp) - 1);
+				DPRINT(2, ("refclock_lines: fd %d time %s "
+					   "timecode %d %s\n", rio->fd,
+					   ulfptoa(lts, 6), (int)(dp - line),
+					   line));
+				(*rio->clock_line)(rio->srcclock, line,
+						   (int)(dp - line), &lts);
+				count++;
+			}
+			line = dp = sp + 1;
+		} else if (c >= 0x20 && c < 0x7f) {
+			*dp++ = c;
+		}
+	}
+	rio->linelen = (size_t)(dp - line);
+	if (LINEBUF_SIZE == end - rio->linebuf && line == rio->linebuf) {
+		DPRINT(1, ("refclock_lines: fd %d dropped %zu bytes "
+			   "without a line end\n", rio->fd, rio->linelen));
+		rio->linelen = 0;
+	}
+	memmove(rio->linebuf, line, rio->linelen);
+	return count;
+}
+
+
 /*
  * indicate_refclock_packet()
  *
@@ -1078,7 +1395,7 @@ refclock_catcher(
 	if (dtemp > .5) {
 		dtemp -= 1.;
 	}
-	SAMPLE(-dtemp + pp->fudgetime1);
+	filter_add(pp, -dtemp + pp->fudgetime1);
 	DPRINT(2, ("refclock_pps: %u %f %f\n", current_time,
 		   dtemp, pp->fudgetime1));
 	return PPS_OK;
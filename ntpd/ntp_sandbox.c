@@ -389,7 +389,10 @@ int scmp_sc[] = {
 	SCMP_SYS(time),		/* not in ARM */
 #endif
 	SCMP_SYS(sysinfo),
-#ifdef HAVE_TIMER_CREATE
+#ifdef HAVE_SYS_TIMERFD_H
+	SCMP_SYS(timerfd_create),
+	SCMP_SYS(timerfd_settime),
+#elif defined(HAVE_TIMER_CREATE)
 	SCMP_SYS(timer_create),
 	SCMP_SYS(timer_gettime),
 	SCMP_SYS(timer_settime),
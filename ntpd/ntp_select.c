@@ -0,0 +1,236 @@
+/*
+ * ntp_select.c - the intersection and clustering steps of clock_select()
+ *
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * These are kept apart from the rest of ntp_proto.c so the test suite
+ * can replay candidate lists through them.  Both used to be quadratic
+ * or worse in the number of candidates, which hurts with hundreds of
+ * associations: the endpoints were put in order with a selection
+ * sort, the intersection was rescanned once for every falseticker
+ * allowed, and every clustering round computed the select jitter of
+ * each survivor against every other survivor.
+ */
+#include "config.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ntpd.h"
+#include "ntp_stdlib.h"
+
+static int	endpoint_cmp	(const void *, const void *);
+
+/*
+ * select_grow - make room for at least count candidates
+ *
+ * The arrays are kept from one clock_select() to the next and only
+ * ever grow, doubling each time, so steady state costs nothing.
+ */
+void
+select_grow(
+	struct select_list *	sl,
+	int			count
+	)
+{
+	int	size;
+
+	if (count <= sl->size)
+		return;
+	size = (sl->size > 0) ? sl->size : 16;
+	while (size < count)
+		size *= 2;
+	sl->peers = erealloc(sl->peers, (size_t)size * sizeof(*sl->peers));
+	sl->endpoint = erealloc(sl->endpoint,
+				2 * (size_t)size * sizeof(*sl->endpoint));
+	sl->level = erealloc(sl->level,
+			     2 * ((size_t)size + 1) * sizeof(*sl->level));
+	sl->size = size;
+}
+
+
+/*
+ * endpoint_cmp - qsort() order for select_intersect()
+ *
+ * Where a lower and an upper end fall on the same offset, the lower
+ * end sorts first so the two intervals count as overlapping.
+ */
+static int
+endpoint_cmp(
+	const void *	a,
+	const void *	b
+	)
+{
+	const struct endpoint *ea = a;
+	const struct endpoint *eb = b;
+
+	if (ea->val < eb->val)
+		return -1;
+	if (ea->val > eb->val)
+		return 1;
+	return ea->type - eb->type;
+}
+
+
+/*
+ * select_intersect - find the interval agreed on by the most candidates
+ *
+ * Marzullo's algorithm as modified for NTP.  On entry the first
+ * 2 * nlist endpoints hold each candidate's lower end (type -1) and
+ * upper end (type 1).  We first assume there are no falsetickers,
+ * then scan the endpoints from the low end upwards and from the high
+ * end downwards.  The scans stop when the number of intersections
+ * equals the number of candidates less the number of falsetickers.
+ * If this doesn't happen for a given number of falsetickers, we bump
+ * the number of falsetickers and try again.  If the number of
+ * falsetickers becomes equal to or greater than half the number of
+ * candidates, the Albanians have won the Byzantine wars and correct
+ * synchronization is not possible.
+ *
+ * Rather than rescanning for each count of falsetickers, one pass in
+ * each direction records where the running count first reaches each
+ * level, which is where every one of those scans would stop.  With
+ * the sort that makes the whole thing O(n log n).
+ *
+ * On return the truechimers are the candidates whose intervals reach
+ * into [low, high].  If high <= low there are none.
+ */
+void
+select_intersect(
+	struct select_list *	sl,
+	int			nlist,
+	double *		lowp,
+	double *		highp
+	)
+{
+	struct endpoint *endp = sl->endpoint;
+	int *	lowlevel = sl->level;		/* nlist + 1 entries */
+	int *	highlevel = sl->level + nlist + 1;
+	int	nl2 = 2 * nlist;
+	int	allow, i, n, top, want;
+	int	lowtop, hightop;
+	double	low = 1e9, high = -1e9;
+
+	qsort(endp, (size_t)nl2, sizeof(*endp), endpoint_cmp);
+	for (i = 0; i < nl2; i++)
+		DPRINT(3, ("select: endpoint %2d %.6f\n",
+			   endp[i].type, endp[i].val));
+
+	/* lowlevel[n] is the first endpoint where n intervals overlap */
+	n = top = 0;
+	for (i = 0; i < nl2; i++) {
+		n -= endp[i].type;
+		if (n > top)
+			lowlevel[top = n] = i;
+	}
+	lowtop = top;
+
+	/* and highlevel[n] the same coming down from the top */
+	n = top = 0;
+	for (i = nl2 - 1; i >= 0; i--) {
+		n += endp[i].type;
+		if (n > top)
+			highlevel[top = n] = i;
+	}
+	hightop = top;
+
+	/*
+	 * Here, nlist is the number of candidates and allow is the
+	 * number of falsetickers.  A scan that never gets enough
+	 * overlaps ends at the far endpoint.
+	 */
+	for (allow = 0; 2 * allow < nlist; allow++) {
+		want = nlist - allow;
+		low = (want <= lowtop) ? endp[lowlevel[want]].val
+				       : endp[nl2 - 1].val;
+		high = (want <= hightop) ? endp[highlevel[want]].val
+					 : endp[0].val;
+
+		/*
+		 * If an interval containing truechimers is found, stop.
+		 * If not, increase the number of falsetickers and go
+		 * around again.
+		 */
+		if (high > low)
+			break;
+	}
+	*lowp = low;
+	*highp = high;
+}
+
+
+/*
+ * select_cluster - vote outliers off the island
+ *
+ * Drop the survivor with the largest select jitter weighted by root
+ * distance as long as there are more than minclock survivors and
+ * the select jitter of the worst is greater than the minimum peer
+ * jitter.  Stop if we are about to discard a TRUE or PREFER peer,
+ * who of course have the immunity idol.  Candidates dropped while
+ * there are more than maxclock of them are marked as excess.
+ *
+ * The select jitter of a survivor is the RMS of its offset from all
+ * the others.  Summing the squares about the mean once per round,
+ *
+ *	sum (o[j] - o[i])^2 = sum (o[j] - mean)^2 + n * (o[i] - mean)^2
+ *
+ * gives every survivor's in O(n) instead of O(n^2).
+ *
+ * Returns the number of survivors, which stay in their original
+ * order at the front of peers[] with seljit filled in.
+ */
+int
+select_cluster(
+	peer_select *	peers,
+	int		nlist,
+	int		minclock,
+	int		maxclock
+	)
+{
+	double	d, e, f, g, mean, var;
+	int	i, k;
+
+	while (1) {
+		mean = var = 0;
+		if (nlist > 1) {
+			for (i = 0; i < nlist; i++)
+				mean += peers[i].peer->offset;
+			mean /= nlist;
+			for (i = 0; i < nlist; i++)
+				var += SQUARE(peers[i].peer->offset - mean);
+		}
+
+		d = 1e9;	/* Minimum peer jitter */
+		e = -1e9;	/* Worst peer select jitter * synch */
+		g = 0;		/* Worst peer select jitter */
+		k = 0;		/* Index of the worst peer */
+		for (i = 0; i < nlist; i++) {
+			if (peers[i].error < d)
+				d = peers[i].error;
+			peers[i].seljit = 0;
+			if (nlist > 1) {
+				f = var + nlist *
+				    SQUARE(peers[i].peer->offset - mean);
+				peers[i].seljit = SQRT(f / (nlist - 1));
+			}
+			if (peers[i].seljit * peers[i].synch > e) {
+				g = peers[i].seljit;
+				e = peers[i].seljit * peers[i].synch;
+				k = i;
+			}
+		}
+		if (nlist <= max(1, minclock) || g <= d ||
+		    ((FLAG_TRUE | FLAG_PREFER) & peers[k].peer->cfg.flags))
+			break;
+
+		DPRINT(3, ("select: drop %s seljit %.6f jit %.6f\n",
+			   socktoa(&peers[k].peer->srcadr), g, d));
+		if (nlist > maxclock)
+			peers[k].peer->new_status = CTL_PST_SEL_EXCESS;
+		memmove(&peers[k], &peers[k + 1],
+			(size_t)(nlist - k - 1) * sizeof(*peers));
+		nlist--;
+	}
+	return nlist;
+}
@@ -0,0 +1,205 @@
+/*
+ * ntp_shmstats.c - keep ntpd's statistics in shared memory
+ * Copyright the NTPsec project contributors
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * With "enable shmstats" the segment described in ntp_shmstats.h is
+ * filled in once a second from the same places ntpq and the metrics
+ * server get their numbers.  It is only ever written here, on the
+ * main thread, so monitors reading it never cost ntpd anything.
+ */
+
+#include "config.h"
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+#include "ntpd.h"
+#include "ntp_shmstats.h"
+#include "ntp_stdlib.h"
+#include "timespecops.h"
+#ifdef REFCLOCK
+#include "ntp_refclock.h"
+#endif
+#ifndef DISABLE_NTS
+#include "nts.h"
+#endif
+
+static struct shmstats	shmstats;
+static bool		shmstats_atexit;
+
+/* an update is put together here, then copied in all at once */
+static struct shmstats_sys	stage_sys;
+static struct shmstats_peer	stage_peers[SHMSTATS_PEERS];
+
+static void
+fill_system(
+	struct shmstats_sys *	s
+	)
+{
+	l_fp now;
+
+	s->uptime = current_time;
+	s->stratum = sys_vars.sys_stratum;
+	s->leap = sys_vars.sys_leap;
+	s->precision = sys_vars.sys_precision;
+	s->rootdelay = sys_vars.sys_rootdelay;
+	s->rootdisp = sys_vars.sys_rootdisp;
+	s->rootdist = sys_vars.sys_rootdist;
+	s->sys_peer = (NULL != sys_vars.sys_peer) ?
+	    sys_vars.sys_peer->associd : 0;
+	s->associations = (uint64_t)peer_associations;
+
+	s->offset = clkstate.last_offset;
+	s->sys_jitter = clkstate.sys_jitter;
+	s->clock_jitter = clkstate.clock_jitter;
+	s->frequency = loop_data.drift_comp * US_PER_S;
+	s->wander = loop_data.clock_stability * US_PER_S;
+	s->tc = clkstate.sys_poll;
+
+	s->proto_received = stat_total_received();
+	s->proto_processed = stat_total_processed();
+	s->proto_restricted = stat_total_restricted();
+	s->proto_newversion = stat_total_newversion();
+	s->proto_oldversion = stat_total_oldversion();
+	s->proto_badlength = stat_total_badlength();
+	s->proto_badauth = stat_total_badauth();
+	s->proto_declined = stat_total_declined();
+	s->proto_limited = stat_total_limitrejected();
+	s->proto_kodsent = stat_total_kodsent();
+
+	s->io_received = received_count();
+	s->io_dropped = dropped_count();
+	s->io_ignored = ignored_count();
+	s->io_sent = sent_count();
+	s->io_sendfailed = notsent_count();
+	s->io_wakeups = handler_calls_count();
+	s->io_goodwakeups = handler_pkts_count();
+
+	s->mru_entries = mon_data.mru_entries;
+	s->mru_peak_entries = mon_data.mru_peakentries;
+	s->mru_hash_slots = mon_data.mru_hashslots;
+	s->mru_max_entries = mon_data.mru_maxdepth;
+	s->mru_bytes = mon_data.mru_entries * sizeof(mon_entry);
+	get_systime(&now);
+	s->mru_oldest_age = mon_get_oldest_age(now);
+	s->mru_exists = mon_data.mru_exists;
+	s->mru_new = mon_data.mru_new;
+	s->mru_recycleold = mon_data.mru_recycleold;
+	s->mru_recyclefull = mon_data.mru_recyclefull;
+	s->mru_none = mon_data.mru_none;
+
+#ifndef DISABLE_NTS
+	s->nts_client_send = nts_client_send;
+	s->nts_client_recv_good = nts_client_recv_good;
+	s->nts_client_recv_bad = nts_client_recv_bad;
+	s->nts_server_send = nts_server_send;
+	s->nts_server_recv_good = nts_server_recv_good;
+	s->nts_server_recv_bad = nts_server_recv_bad;
+	s->nts_cookie_make = nts_cookie_make;
+	s->nts_cookie_decode = nts_cookie_decode;
+	s->nts_cookie_decode_old = nts_cookie_decode_old;
+	s->nts_cookie_decode_too_old = nts_cookie_decode_too_old;
+	s->nts_cookie_decode_error = nts_cookie_decode_error;
+	s->nts_ke_serves_good = nts_ke_serves_good;
+	s->nts_ke_serves_bad = nts_ke_serves_bad;
+	s->nts_ke_probes_good = nts_ke_probes_good;
+	s->nts_ke_probes_bad = nts_ke_probes_bad;
+#endif
+}
+
+static void
+fill_peer(
+	struct shmstats_peer *	s,
+	struct peer *		p
+	)
+{
+	const char *name = NULL;
+
+	strlcpy(s->address, socktoa(&p->srcadr), sizeof(s->address));
+#ifdef REFCLOCK
+	if (IS_PEER_REFCLOCK(p))
+		name = refclock_name(p);
+#endif
+	if (NULL != p->hostname)
+		name = p->hostname;
+	strlcpy(s->name, (NULL != name) ? name : "", sizeof(s->name));
+	s->assoc = p->associd;
+	s->stratum = p->stratum;
+	s->reach = p->reach;
+	s->poll = p->hpoll;
+	s->selection = p->status;
+	s->offset = p->offset;
+	s->delay = p->delay;
+	s->disp = p->disp;
+	s->jitter = p->jitter;
+	s->sent = p->sent;
+	s->received = p->received;
+	s->processed = p->processed;
+	s->badauth = p->badauth;
+}
+
+static void
+shmstats_cleanup(void)
+{
+	/* fails once root is given up; the next run replaces it */
+	if (NULL != shmstats.head)
+		shmstats_remove(&shmstats, SHMSTATS_NAME);
+}
+
+/*
+ * shmstats_config - create or remove the segment.  Called while
+ * reading the configuration, before root is given up.
+ */
+void
+shmstats_config(
+	bool	enable
+	)
+{
+	if (!enable) {
+		if (NULL != shmstats.head)
+			shmstats_remove(&shmstats, SHMSTATS_NAME);
+		return;
+	}
+	if (NULL != shmstats.head)
+		return;
+	if (!shmstats_create(&shmstats, SHMSTATS_NAME)) {
+		msyslog(LOG_ERR, "SHMSTATS: can't create %s: %s",
+			SHMSTATS_NAME, strerror(errno));
+		return;
+	}
+	msyslog(LOG_INFO, "SHMSTATS: publishing in %s", SHMSTATS_NAME);
+	if (!shmstats_atexit) {
+		shmstats_atexit = true;
+		atexit(shmstats_cleanup);
+	}
+}
+
+/*
+ * shmstats_timer - bring the segment up to date, called once a second
+ *
+ * Everything is gathered first, so readers only have to wait out the
+ * copy.
+ */
+void
+shmstats_timer(void)
+{
+	struct peer *	p;
+	uint32_t	n = 0;
+
+	if (NULL == shmstats.head)
+		return;
+	fill_system(&stage_sys);
+	for (p = peer_list; p != NULL && n < SHMSTATS_PEERS; p = p->p_link) {
+		memset(&stage_peers[n], 0, sizeof(stage_peers[n]));
+		fill_peer(&stage_peers[n++], p);
+	}
+
+	shmstats_begin(&shmstats);
+	memcpy(shmstats.sys, &stage_sys, sizeof(stage_sys));
+	memcpy(shmstats.peers, stage_peers, n * sizeof(stage_peers[0]));
+	shmstats.head->peer_count = n;
+	shmstats.head->time = (int64_t)time(NULL);
+	shmstats_end(&shmstats);
+}
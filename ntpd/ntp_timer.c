@@ -8,6 +8,7 @@
 #include "ntp_stdlib.h"
 #include "ntp_calendar.h"
 #include "ntp_leapsec.h"
+#include "timespecops.h"
 
 #include <stdio.h>
 #include <signal.h>
@@ -15,7 +16,15 @@
 
 #include "ntp_syscall.h"
 
-#ifdef HAVE_TIMER_CREATE
+#ifdef HAVE_SYS_TIMERFD_H
+# include <sys/timerfd.h>
+/*
+ * With a timerfd the tick is just another descriptor in the I/O
+ * wait, no signal is involved.  It runs on CLOCK_MONOTONIC, so
+ * clock steps don't disturb it either.
+ */
+# define USE_TIMERFD
+#elif defined(HAVE_TIMER_CREATE)
 /* TC_ERR represents the timer_create() error return value. */
 # define	TC_ERR	(-1)
 #endif
@@ -26,13 +35,15 @@ static void check_leapsec(time_t, bool);
 
 /*
  * These routines provide support for the event timer.  The timer is
- * implemented by an interrupt routine which sets a flag once every
- * second, and a timer routine which is called when the mainline code
- * gets around to seeing the flag.  The timer routine dispatches the
- * clock adjustment code if its time has come, then searches the timer
- * queue for expiries which are dispatched to the transmit procedure.
- * Finally, we call the hourly procedure to do cleanup and print a
- * message.
+ * implemented by a timerfd in the I/O wait, which counts the ticks
+ * (or, lacking that, an interrupt routine which sets a flag every
+ * tick), and a timer routine which the mainline code calls once per
+ * tick when it gets around to seeing the flag.  There are
+ * loop_data.adj_rate ticks a second.  Every tick dispatches the clock
+ * adjustment code; once a second the timer routine also searches the
+ * timer queue for expiries which are dispatched to the transmit
+ * procedure.  Finally, we call the hourly procedure to do cleanup and
+ * print a message.
  */
 int interface_interval;     /* init_io() sets def. 300s */
 
@@ -62,15 +73,33 @@ uptime_t current_time;		/* seconds since startup */
 uptime_t timer_timereset;
 unsigned long timer_xmtcalls;
 
-static	void catchALRM (int);
+static	int	tick_rate;	/* ticks per second the timer runs at */
+static	int	tick_count;	/* ticks into the current second */
 
-#ifdef HAVE_TIMER_CREATE
-static timer_t timer_id;
+#ifdef USE_TIMERFD
+static int timer_fd = -1;
+/*
+ * Ticks the timerfd has counted that timer() hasn't run for yet.  A
+ * main loop stall is made up for afterwards, up to TIMER_CATCHUP
+ * seconds' worth; ticks past that are overruns.
+ */
+static uint64_t pending_ticks;
+#define	TIMER_CATCHUP	10
 typedef struct itimerspec intervaltimer;
 #define	itv_frac	tv_nsec
+#define	FRAC_PER_S	NS_PER_S
 #else
+static	void catchALRM (int);
+# ifdef HAVE_TIMER_CREATE
+static timer_t timer_id;
+typedef struct itimerspec intervaltimer;
+#define	itv_frac	tv_nsec
+#define	FRAC_PER_S	NS_PER_S
+# else
 typedef struct itimerval intervaltimer;
 #define	itv_frac	tv_usec
+#define	FRAC_PER_S	US_PER_S
+# endif
 #endif
 static intervaltimer itimer;
 
@@ -82,7 +111,10 @@ set_timer_or_die(void)
 	const char *	setfunc;
 	int		rc;
 
-#ifdef HAVE_TIMER_CREATE
+#ifdef USE_TIMERFD
+	setfunc = "timerfd_settime";
+	rc = timerfd_settime(timer_fd, 0, &itimer, NULL);
+#elif defined(HAVE_TIMER_CREATE)
 	setfunc = "timer_settime";
 	rc = timer_settime(timer_id, 0, &itimer, NULL);
 #else
@@ -97,18 +129,43 @@ set_timer_or_die(void)
 }
 
 
+/*
+ * set_tick_rate - (re)start the interval timer at rate ticks a second
+ */
+static void
+set_tick_rate(
+	int	rate
+	)
+{
+	tick_rate = rate;
+	tick_count = 0;
+	if (1 == rate) {
+		itimer.it_interval.tv_sec = (1 << EVENT_TIMEOUT);
+		itimer.it_interval.itv_frac = 0;
+	} else {
+		itimer.it_interval.tv_sec = 0;
+		itimer.it_interval.itv_frac = FRAC_PER_S / rate;
+	}
+	itimer.it_value = itimer.it_interval;
+	set_timer_or_die();
+}
+
+
 /*
  * reinit_timer - reinitialize interval timer after a clock step.
  */
 void
 reinit_timer(void)
 {
+#ifdef USE_TIMERFD
+	/* CLOCK_MONOTONIC doesn't care */
+#else
 	ZERO(itimer);
-#ifdef HAVE_TIMER_CREATE
+# ifdef HAVE_TIMER_CREATE
 	timer_gettime(timer_id, &itimer);
-#else
+# else
 	getitimer(ITIMER_REAL, &itimer);
-#endif
+# endif
 	if (itimer.it_value.tv_sec < 0 ||
 	    itimer.it_value.tv_sec > (1 << EVENT_TIMEOUT))
 		itimer.it_value.tv_sec = (1 << EVENT_TIMEOUT);
@@ -117,9 +174,59 @@ reinit_timer(void)
 	if (0 == itimer.it_value.tv_sec &&
 	    0 == itimer.it_value.itv_frac)
 		itimer.it_value.tv_sec = (1 << EVENT_TIMEOUT);
-	itimer.it_interval.tv_sec = (1 << EVENT_TIMEOUT);
-	itimer.it_interval.itv_frac = 0;
+	if (1 == tick_rate) {
+		itimer.it_interval.tv_sec = (1 << EVENT_TIMEOUT);
+		itimer.it_interval.itv_frac = 0;
+	} else {
+		itimer.it_interval.tv_sec = 0;
+		itimer.it_interval.itv_frac = FRAC_PER_S / tick_rate;
+		if (itimer.it_value.tv_sec > 0) {
+			itimer.it_value = itimer.it_interval;
+		}
+	}
 	set_timer_or_die();
+#endif
+}
+
+
+#ifdef USE_TIMERFD
+/*
+ * timer_expired - the timerfd is readable, note the tick(s)
+ */
+void
+timer_expired(void)
+{
+	uint64_t	ticks, most;
+
+	if (sizeof(ticks) != read(timer_fd, &ticks, sizeof(ticks)))
+		return;
+	most = (uint64_t)tick_rate * TIMER_CATCHUP;
+	pending_ticks += ticks;
+	if (pending_ticks > most) {
+		alarm_overflow += (unsigned long)(pending_ticks - most);
+		pending_ticks = most;
+	}
+	sig_flags.sawALRM = true;
+}
+#endif
+
+
+/*
+ * timer_ticks - how many times the main loop should call timer() now
+ * that sawALRM is set
+ */
+int
+timer_ticks(void)
+{
+#ifdef USE_TIMERFD
+	int	ticks = (int)pending_ticks;
+
+	pending_ticks = 0;
+	return ticks;
+#else
+	/* the signal can't count; a tick it missed is an overrun */
+	return 1;
+#endif
 }
 
 
@@ -134,6 +241,9 @@ init_timer(void)
 	 */
 	sig_flags.sawALRM = false;
 	alarm_overflow = 0;
+#ifdef USE_TIMERFD
+	pending_ticks = 0;
+#endif
 	adjust_timer = 1;
 	hour_timer = SECSPERHR;
 	leapf_timer = SECSPERDAY;
@@ -144,21 +254,27 @@ init_timer(void)
 	timer_timereset = 0;
 
 	/*
-	 * Set up the alarm interrupt.	The first comes 2**EVENT_TIMEOUT
-	 * seconds from now and they continue on every 2**EVENT_TIMEOUT
-	 * seconds.
+	 * Set up the tick.  The first comes one tick from now and they
+	 * continue on every tick, 2**EVENT_TIMEOUT seconds unless the
+	 * clock adjustment runs faster.
 	 */
-#ifdef HAVE_TIMER_CREATE
+#ifdef USE_TIMERFD
+	timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (-1 == timer_fd) {
+		msyslog(LOG_ERR, "ERR: timerfd_create failed, %s", strerror(errno));
+		exit(1);
+	}
+	io_add_timer(timer_fd);
+#else
+# ifdef HAVE_TIMER_CREATE
 	if (TC_ERR == timer_create(CLOCK_REALTIME, NULL, &timer_id)) {
 		msyslog(LOG_ERR, "ERR: timer_create failed, %s", strerror(errno));
 		exit(1);
 	}
-#endif
+# endif
 	signal_no_reset(SIGALRM, catchALRM);
-	itimer.it_interval.tv_sec =
-		itimer.it_value.tv_sec = (1 << EVENT_TIMEOUT);
-	itimer.it_interval.itv_frac = itimer.it_value.itv_frac = 0;
-	set_timer_or_die();
+#endif
+	set_tick_rate(loop_data.adj_rate);
 }
 
 
@@ -170,9 +286,17 @@ void
 timer(void)
 {
 	struct peer *	p;
-	struct peer *	next_peer;
 	time_t          now;
 
+	/*
+	 * The clock is slewed every tick, tick_rate times a second.
+	 */
+	if (++tick_count < tick_rate) {
+		adj_host_clock(tick_rate);
+		return;
+	}
+	tick_count = 0;
+
 	/*
 	 * The basic timerevent is one second.  This is used to adjust the
 	 * system clock in time and frequency, implement the kiss-o'-death
@@ -181,40 +305,32 @@ timer(void)
 	current_time++;
 	if (adjust_timer <= current_time) {
 		adjust_timer += 1;
-		adj_host_clock();
+		adj_host_clock(tick_rate);
 #ifdef REFCLOCK
-		for (p = peer_list; p != NULL; p = next_peer) {
-			next_peer = p->p_link;
-			if (FLAG_REFCLOCK & p->cfg.flags)
-				refclock_timer(p);
-		}
+		refclock_timers();
 #endif /* REFCLOCK */
 	}
+	if (tick_rate != loop_data.adj_rate)
+		set_tick_rate(loop_data.adj_rate);
 
 	/*
-	 * Now dispatch any peers whose event timer has expired. Be
-	 * careful here, since the peer structure might go away as the
-	 * result of the call.
+	 * Now dispatch any peers whose event timer has expired. The
+	 * poll queue hands out only those, so the cost here follows
+	 * the number of polls rather than the number of associations.
+	 * The peer structure might go away as the result of the call,
+	 * poll_next() copes with that.
+	 *
+	 * The rate control (throttle) used to be drained here for
+	 * every peer; peer_throttle() now does that on demand.
 	 */
-	for (p = peer_list; p != NULL; p = next_peer) {
-		next_peer = p->p_link;
-
-		/*
-		 * Restrain the non-burst packet rate not more
-		 * than one packet every 16 seconds. This is
-		 * usually tripped using iburst and minpoll of
-		 * 128 s or less.
-		 */
-		if (p->throttle > 0)
-			p->throttle--;
-		if (p->nextdate <= current_time) {
+	poll_collect(current_time);
+	while ((p = poll_next()) != NULL) {
 #ifdef REFCLOCK
-			if (FLAG_REFCLOCK & p->cfg.flags)
-				refclock_transmit(p);
-			else
+		if (FLAG_REFCLOCK & p->cfg.flags)
+			refclock_transmit(p);
+		else
 #endif	/* REFCLOCK */
-				transmit(p);
-		}
+			transmit(p);
 	}
 
 	/*
@@ -265,6 +381,14 @@ timer(void)
 		huffpuff();
 	}
 
+	/*
+	 * Write out the rawstats records sampled over the last interval,
+	 * and refresh what monitors read without asking us.
+	 */
+	rawstats_timer();
+	metrics_timer();
+	shmstats_timer();
+
 	/*
 	 * Interface update timer
 	 */
@@ -296,6 +420,7 @@ timer(void)
 }
 
 
+#ifndef USE_TIMERFD
 /*
  * catchALRM - tell the world we've been alarmed
  */
@@ -325,6 +450,7 @@ if (debug >= 4 && msg != NULL)
 	(void)(-1 == write(1, msg, strlen(msg)));
 # endif
 }
+#endif /* !USE_TIMERFD */
 
 
 void
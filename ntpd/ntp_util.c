@@ -14,6 +14,7 @@
 #include "ntpd.h"
 #include "timespecops.h"
 
+#include <stddef.h>
 #include <stdio.h>
 #include <libgen.h>
 #include <ctype.h>
@@ -64,6 +65,115 @@ static FILEGEN refstats;
 static FILEGEN sysstats;
 static FILEGEN usestats;
 
+/*
+ * Layouts for the streams that can be kept as binary records, see
+ * ntp_filegen.h.  Each starts with the record kind and keeps its
+ * members naturally aligned.  time is Unix time.
+ */
+#define FG_COL(s, m, t)	{ #m, offsetof(struct s, m), t, 0 }
+
+struct loopstats_rec {
+	uint16_t	kind;
+	int16_t		poll;		/* time constant (log2) */
+	float		wander;		/* PPM */
+	double		time;
+	double		offset;
+	double		freq;		/* PPM */
+	double		jitter;
+};
+
+static const struct fg_bin_column loopstats_cols[] = {
+	FG_COL(loopstats_rec, time, 'd'),
+	FG_COL(loopstats_rec, offset, 'd'),
+	FG_COL(loopstats_rec, freq, 'd'),
+	FG_COL(loopstats_rec, jitter, 'd'),
+	FG_COL(loopstats_rec, wander, 'f'),
+	FG_COL(loopstats_rec, poll, 'h'),
+};
+
+static const FILEGEN_SCHEMA loopstats_schema = {
+	"loopstats", sizeof(struct loopstats_rec),
+	COUNTOF(loopstats_cols), loopstats_cols
+};
+
+struct peerstats_rec {
+	uint16_t	kind;
+	uint16_t	status;
+	uint32_t	label;
+	double		time;
+	double		offset;
+	double		delay;
+	double		disp;
+	double		jitter;
+};
+
+static const struct fg_bin_column peerstats_cols[] = {
+	FG_COL(peerstats_rec, time, 'd'),
+	FG_COL(peerstats_rec, label, 'S'),
+	FG_COL(peerstats_rec, status, 'H'),
+	FG_COL(peerstats_rec, offset, 'd'),
+	FG_COL(peerstats_rec, delay, 'd'),
+	FG_COL(peerstats_rec, disp, 'd'),
+	FG_COL(peerstats_rec, jitter, 'd'),
+};
+
+static const FILEGEN_SCHEMA peerstats_schema = {
+	"peerstats", sizeof(struct peerstats_rec),
+	COUNTOF(peerstats_cols), peerstats_cols
+};
+
+struct rawstats_rec {
+	uint16_t	kind;
+	uint8_t		leap;
+	uint8_t		version;
+	uint8_t		mode;
+	uint8_t		stratum;
+	uint8_t		ppoll;
+	int8_t		precision;
+	uint32_t	label;
+	uint32_t	dstaddr;
+	double		time;
+	uint64_t	t1;		/* originate */
+	uint64_t	t2;		/* receive */
+	uint64_t	t3;		/* transmit */
+	uint64_t	t4;		/* destination */
+	double		rootdelay;
+	double		rootdisp;
+	uint32_t	refid;
+	uint32_t	outcount;
+	uint32_t	bogons;
+	uint32_t	flag;
+};
+
+static const struct fg_bin_column rawstats_cols[] = {
+	FG_COL(rawstats_rec, time, 'd'),
+	FG_COL(rawstats_rec, label, 'S'),
+	FG_COL(rawstats_rec, dstaddr, 'S'),
+	FG_COL(rawstats_rec, t1, 'T'),
+	FG_COL(rawstats_rec, t2, 'T'),
+	FG_COL(rawstats_rec, t3, 'T'),
+	FG_COL(rawstats_rec, t4, 'T'),
+	FG_COL(rawstats_rec, leap, 'B'),
+	FG_COL(rawstats_rec, version, 'B'),
+	FG_COL(rawstats_rec, mode, 'B'),
+	FG_COL(rawstats_rec, stratum, 'B'),
+	FG_COL(rawstats_rec, ppoll, 'B'),
+	FG_COL(rawstats_rec, precision, 'b'),
+	FG_COL(rawstats_rec, rootdelay, 'd'),
+	FG_COL(rawstats_rec, rootdisp, 'd'),
+	FG_COL(rawstats_rec, refid, 'S'),
+	FG_COL(rawstats_rec, outcount, 'I'),
+	FG_COL(rawstats_rec, bogons, 'I'),
+	FG_COL(rawstats_rec, flag, 'I'),
+};
+
+static const FILEGEN_SCHEMA rawstats_schema = {
+	"rawstats", sizeof(struct rawstats_rec),
+	COUNTOF(rawstats_cols), rawstats_cols
+};
+
+#undef FG_COL
+
 /*
  * This controls whether stats are written to the fileset. Provided
  * so that ntpq can turn off stats when the file system fills up.
@@ -131,6 +241,9 @@ init_util(void)
 	filegen_register(statsdir, "peerstats",	  &peerstats);
 	filegen_register(statsdir, "protostats",  &protostats);
 	filegen_register(statsdir, "usestats",	  &usestats);
+	loopstats.schema = &loopstats_schema;
+	peerstats.schema = &peerstats_schema;
+	rawstats.schema = &rawstats_schema;
 
 	/*
 	 * register with libntp ntp_set_tod() to call us back
@@ -406,15 +519,26 @@ record_peer_stats(
 		return;
 
 	clock_gettime(CLOCK_REALTIME, &now);
-	filegen_setup(&peerstats, now.tv_sec);
-	if (peerstats.fp != NULL) {
-		fprintf(peerstats.fp,
-		    "%s %s %x %.9f %.9f %.9f %.9f\n",
-		    timespec_to_MJDtime(&now),
-		    peerlabel(peer), (unsigned int)status, peer->offset,
-		    peer->delay, peer->disp, peer->jitter);
-		fflush(peerstats.fp);
+	if (peerstats.flag & FGEN_FLAG_BINARY) {
+		struct peerstats_rec rec;
+		const char *str[1];
+
+		ZERO(rec);
+		rec.status = (uint16_t)status;
+		rec.time = tspec_to_d(now);
+		rec.offset = peer->offset;
+		rec.delay = peer->delay;
+		rec.disp = peer->disp;
+		rec.jitter = peer->jitter;
+		str[0] = peerlabel(peer);
+		filegen_write(&peerstats, now.tv_sec, &rec, str);
+		return;
 	}
+	filegen_printf(&peerstats, now.tv_sec,
+	    "%s %s %x %.9f %.9f %.9f %.9f\n",
+	    timespec_to_MJDtime(&now),
+	    peerlabel(peer), (unsigned int)status, peer->offset,
+	    peer->delay, peer->disp, peer->jitter);
 }
 
 /*
@@ -444,14 +568,23 @@ record_loop_stats(
 		return;
 
 	clock_gettime(CLOCK_REALTIME, &now);
-	filegen_setup(&loopstats, now.tv_sec);
-	if (loopstats.fp != NULL) {
-		fprintf(loopstats.fp, "%s %.9f %.6f %.9f %.6f %d\n",
-		    timespec_to_MJDtime(&now),
-		    offset, freq * US_PER_S, jitter,
-		    wander * US_PER_S, spoll);
-		fflush(loopstats.fp);
+	if (loopstats.flag & FGEN_FLAG_BINARY) {
+		struct loopstats_rec rec;
+
+		ZERO(rec);
+		rec.poll = (int16_t)spoll;
+		rec.wander = (float)(wander * US_PER_S);
+		rec.time = tspec_to_d(now);
+		rec.offset = offset;
+		rec.freq = freq * US_PER_S;
+		rec.jitter = jitter;
+		filegen_write(&loopstats, now.tv_sec, &rec, NULL);
+		return;
 	}
+	filegen_printf(&loopstats, now.tv_sec, "%s %.9f %.6f %.9f %.6f %d\n",
+	    timespec_to_MJDtime(&now),
+	    offset, freq * US_PER_S, jitter,
+	    wander * US_PER_S, spoll);
 }
 
 
@@ -476,12 +609,8 @@ record_clock_stats(
 		return;
 
 	clock_gettime(CLOCK_REALTIME, &now);
-	filegen_setup(&clockstats, now.tv_sec);
-	if (clockstats.fp != NULL) {
-		fprintf(clockstats.fp, "%s %s %s\n",
-		    timespec_to_MJDtime(&now), peerlabel(peer), text);
-		fflush(clockstats.fp);
-	}
+	filegen_printf(&clockstats, now.tv_sec, "%s %s %s\n",
+	    timespec_to_MJDtime(&now), peerlabel(peer), text);
 }
 
 
@@ -509,6 +638,267 @@ mprintf_clock_stats(
 	return rc;
 }
 
+/*
+ * rawstats volume controls.  On a busy server rawstats can outweigh
+ * all the other statistics files together, so it can be cut down to
+ * the peers of interest, to one packet in every n, and to a uniform
+ * sample of fixed size from each interval (Algorithm R).  Whatever is
+ * left out is counted, so the sample can be scaled back up.
+ */
+struct rawstats_net {
+	sockaddr_u	addr;
+	unsigned int	bits;
+};
+
+struct raw_sample {
+	struct timespec	now;
+	uint64_t	seq;		/* arrival order in the interval */
+	struct rawstats_rec rec;
+	char		label[LIB_BUFLENGTH];
+	char		dstaddr[LIB_BUFLENGTH];
+	char		refid[LIB_BUFLENGTH];
+};
+
+/*
+ * A reservoir is written out over the following interval, at most
+ * RAWSTATS_BURST records a second, so the statistics writer's ring
+ * always has room for them.
+ */
+#define RAWSTATS_BURST	256
+
+uint64_t rawstats_filtered;
+uint64_t rawstats_sampled;
+
+static struct rawstats_net *rawstats_nets;
+static unsigned int	rawstats_nnets;
+static unsigned int	rawstats_every = 1;
+static uint64_t		rawstats_count;
+static struct raw_sample *rawstats_pool;
+static unsigned int	rawstats_keep;		/* 0: no reservoir */
+static unsigned int	rawstats_held;
+static uint64_t		rawstats_seen;
+static unsigned int	rawstats_interval = RAWSTATS_INTERVAL;
+static unsigned long	rawstats_due;
+static struct raw_sample *rawstats_out;		/* last interval's, sorted */
+static unsigned int	rawstats_outn;
+static unsigned int	rawstats_outi;		/* next to write */
+
+static void	rawstats_put (const struct raw_sample *);
+
+/*
+ * rawstats_sample - keep one packet in every n
+ */
+void
+rawstats_sample(
+	unsigned int	n
+	)
+{
+	rawstats_every = (n > 0) ? n : 1;
+	rawstats_count = 0;
+}
+
+
+/*
+ * rawstats_reservoir - keep at most keep packets a random pick of
+ * each interval seconds, 0 to write them as they come
+ */
+void
+rawstats_reservoir(
+	unsigned int	keep,
+	unsigned int	interval
+	)
+{
+	if (keep > RAWSTATS_KEEP_MAX) {
+		msyslog(LOG_WARNING,
+			"CONFIG: rawstats reservoir %u reduced to %d",
+			keep, RAWSTATS_KEEP_MAX);
+		keep = RAWSTATS_KEEP_MAX;
+	}
+	if (0 == interval)
+		interval = RAWSTATS_INTERVAL;
+	/* what can be written out before the next interval ends */
+	if (interval < RAWSTATS_KEEP_MAX / RAWSTATS_BURST &&
+	    keep > interval * RAWSTATS_BURST) {
+		msyslog(LOG_WARNING,
+			"CONFIG: rawstats reservoir %u reduced to %u for %u s",
+			keep, interval * RAWSTATS_BURST, interval);
+		keep = interval * RAWSTATS_BURST;
+	}
+	rawstats_flush();
+	free(rawstats_pool);
+	free(rawstats_out);
+	rawstats_pool = NULL;
+	rawstats_out = NULL;
+	rawstats_keep = keep;
+	if (keep > 0) {
+		rawstats_pool = emalloc_zero(keep * sizeof(*rawstats_pool));
+		rawstats_out = emalloc_zero(keep * sizeof(*rawstats_out));
+	}
+	rawstats_interval = interval;
+	rawstats_due = current_time + rawstats_interval;
+}
+
+
+/*
+ * rawstats_include - log only peers in addr/bits, and any others given
+ */
+void
+rawstats_include(
+	const sockaddr_u *addr,
+	unsigned int	bits
+	)
+{
+	struct rawstats_net *net;
+
+	rawstats_nets = erealloc(rawstats_nets,
+				 (rawstats_nnets + 1) * sizeof(*rawstats_nets));
+	net = &rawstats_nets[rawstats_nnets++];
+	net->addr = *addr;
+	net->bits = bits;
+}
+
+
+/* does the prefix in net cover addr? */
+static bool
+rawstats_match(
+	const struct rawstats_net *net,
+	const sockaddr_u *addr
+	)
+{
+	const uint8_t *a, *b;
+	unsigned int	bytes, rest;
+
+	if (AF(&net->addr) != AF(addr))
+		return false;
+	if (IS_IPV4(addr)) {
+		a = (const uint8_t *)&NSRCADR(&net->addr);
+		b = (const uint8_t *)&NSRCADR(addr);
+	} else {
+		a = NSRCADR6(&net->addr);
+		b = NSRCADR6(addr);
+	}
+	bytes = net->bits / 8;
+	rest = net->bits % 8;
+	if (memcmp(a, b, bytes))
+		return false;
+	return (0 == rest ||
+		0 == ((a[bytes] ^ b[bytes]) & (0xff00 >> rest)));
+}
+
+
+static int
+rawstats_seq_cmp(
+	const void *	p1,
+	const void *	p2
+	)
+{
+	const struct raw_sample *s1 = p1, *s2 = p2;
+
+	return (s1->seq > s2->seq) - (s1->seq < s2->seq);
+}
+
+
+/* write out up to RAWSTATS_BURST of the last interval's records */
+static void
+rawstats_drain(void)
+{
+	unsigned int	n;
+
+	n = min(rawstats_outn - rawstats_outi, RAWSTATS_BURST);
+	while (n-- > 0)
+		rawstats_put(&rawstats_out[rawstats_outi++]);
+}
+
+
+/* end an interval: queue what the reservoir holds, oldest first */
+static void
+rawstats_swap(void)
+{
+	struct raw_sample *t;
+
+	/* only if a second went missing */
+	while (rawstats_outi < rawstats_outn)
+		rawstats_drain();
+	if (rawstats_held > 1)
+		qsort(rawstats_pool, rawstats_held, sizeof(*rawstats_pool),
+		      rawstats_seq_cmp);
+	t = rawstats_out;
+	rawstats_out = rawstats_pool;
+	rawstats_pool = t;
+	rawstats_outn = rawstats_held;
+	rawstats_outi = 0;
+	rawstats_held = 0;
+	rawstats_seen = 0;
+}
+
+
+/*
+ * rawstats_flush - write out everything the reservoir holds, now
+ *
+ * This waits for the statistics writer, so it is for reconfiguring and
+ * for shutting down, not for the timer.
+ */
+void
+rawstats_flush(void)
+{
+	rawstats_swap();
+	while (rawstats_outi < rawstats_outn) {
+		rawstats_drain();
+		filegen_sync();
+	}
+}
+
+
+/*
+ * rawstats_timer - write out the reservoir, called once a second
+ */
+void
+rawstats_timer(void)
+{
+	if (0 == rawstats_keep)
+		return;
+	if (current_time >= rawstats_due) {
+		rawstats_swap();
+		rawstats_due = current_time + rawstats_interval;
+	}
+	rawstats_drain();
+}
+
+
+static void
+rawstats_put(
+	const struct raw_sample *s
+	)
+{
+	const struct rawstats_rec *rec = &s->rec;
+	const char *str[3];
+
+	if (rawstats.flag & FGEN_FLAG_BINARY) {
+		str[0] = s->label;
+		str[1] = s->dstaddr;
+		str[2] = s->refid;
+		filegen_write(&rawstats, s->now.tv_sec, rec, str);
+		return;
+	}
+
+	filegen_printf(&rawstats, s->now.tv_sec, "%s %s %s %s %s %s %s %d %d %d %d %d %d %.6f %.6f %s %u %u %x\n",
+	    timespec_to_MJDtime(&s->now),
+	    s->label, s->dstaddr,
+	    ulfptoa(rec->t1, 9), ulfptoa(rec->t2, 9),
+	    ulfptoa(rec->t3, 9), ulfptoa(rec->t4, 9),
+	    rec->leap,
+	    rec->version,
+	    rec->mode,
+	    rec->stratum,
+	    rec->ppoll,
+	    rec->precision,
+	    rec->rootdelay,
+	    rec->rootdisp,
+	    s->refid,
+	    rec->outcount, rec->bogons, rec->flag);
+}
+
+
 /*
  * record_raw_stats - write raw timestamps to file
  *
@@ -527,51 +917,81 @@ record_raw_stats(
   unsigned int flag,
   unsigned int outcount)
 {
-	struct timespec	now;
+	struct raw_sample sample, *s = &sample;
+	struct rawstats_rec *rec;
 	const sockaddr_u *dstaddr = peer->dstadr ? &peer->dstadr->sin : NULL;
-	/* This lies.  It shows the time we sent it rather than the
-	 * data from the packet which was probably random.
-	 * See data minimization in peer_xmit()
-	 * That's what code processing rawstats expects.
-	 */
-	l_fp	t1 = peer->org_ts;	/* originate timestamp */
-	l_fp	t2 = rbufp->pkt.rec;	/* receive timestamp */
-	l_fp	t3 = rbufp->pkt.xmt;	/* transmit timestamp */
-	l_fp	t4 = rbufp->recv_time;	/* destination timestamp */
 	int	stratum;
 	refid_t refid = *(const uint32_t*)rbufp->pkt.refid;
-	double rootdelay, rootdisp;
+	unsigned int i, slot;
 
-	if (!stats_control)
+	if (!stats_control || !(rawstats.flag & FGEN_FLAG_ENABLED))
 		return;
 
-	clock_gettime(CLOCK_REALTIME, &now);
-	filegen_setup(&rawstats, now.tv_sec);
-	if (rawstats.fp == NULL) return;
+	if (rawstats_nnets > 0) {
+		for (i = 0; i < rawstats_nnets; i++)
+			if (rawstats_match(&rawstats_nets[i], &peer->srcadr))
+				break;
+		if (i == rawstats_nnets) {
+			rawstats_filtered++;
+			return;
+		}
+	}
+	if (rawstats_every > 1 && 0 != rawstats_count++ % rawstats_every) {
+		rawstats_sampled++;
+		return;
+	}
+	if (rawstats_keep > 0) {
+		rawstats_seen++;
+		if (rawstats_held < rawstats_keep) {
+			slot = rawstats_held++;
+		} else {
+			/* one of the kept records or this one goes */
+			rawstats_sampled++;
+			slot = (unsigned int)((unsigned long)random() %
+					      rawstats_seen);
+			if (slot >= rawstats_keep)
+				return;
+		}
+		s = &rawstats_pool[slot];
+		s->seq = rawstats_seen;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &s->now);
 
 	/* copy of PKT_TO_STRATUM from ntp_proto.c */
 	stratum = rbufp->pkt.stratum;
 	if (stratum == STRATUM_PKT_UNSPEC) stratum = STRATUM_UNSPEC;
 
-	rootdelay = scalbn((double)rbufp->pkt.rootdelay, -16);
-	rootdisp = scalbn((double)rbufp->pkt.rootdisp, -16);
-
-	fprintf(rawstats.fp, "%s %s %s %s %s %s %s %d %d %d %d %d %d %.6f %.6f %s %u %u %x\n",
-	    timespec_to_MJDtime(&now),
-	    peerlabel(peer), dstaddr ?  socktoa(dstaddr) : "-",
-	    ulfptoa(t1, 9), ulfptoa(t2, 9),
-	    ulfptoa(t3, 9), ulfptoa(t4, 9),
-	    PKT_LEAP(rbufp->pkt.li_vn_mode),
-	    PKT_VERSION(rbufp->pkt.li_vn_mode),
-	    PKT_MODE(rbufp->pkt.li_vn_mode),
-	    stratum,
-	    rbufp->pkt.ppoll,
-	    rbufp->pkt.precision,
-	    rootdelay,
-	    rootdisp,
-	    refid_str(refid, stratum),
-	    outcount, peer->bogons, flag);
-	fflush(rawstats.fp);
+	/* This lies.  It shows the time we sent it rather than the
+	 * data from the packet which was probably random.
+	 * See data minimization in peer_xmit()
+	 * That's what code processing rawstats expects.
+	 */
+	rec = &s->rec;
+	ZERO(*rec);
+	rec->leap = PKT_LEAP(rbufp->pkt.li_vn_mode);
+	rec->version = PKT_VERSION(rbufp->pkt.li_vn_mode);
+	rec->mode = PKT_MODE(rbufp->pkt.li_vn_mode);
+	rec->stratum = (uint8_t)stratum;
+	rec->ppoll = rbufp->pkt.ppoll;
+	rec->precision = rbufp->pkt.precision;
+	rec->time = tspec_to_d(s->now);
+	rec->t1 = peer->org_ts;		/* originate timestamp */
+	rec->t2 = rbufp->pkt.rec;	/* receive timestamp */
+	rec->t3 = rbufp->pkt.xmt;	/* transmit timestamp */
+	rec->t4 = rbufp->recv_time;	/* destination timestamp */
+	rec->rootdelay = scalbn((double)rbufp->pkt.rootdelay, -16);
+	rec->rootdisp = scalbn((double)rbufp->pkt.rootdisp, -16);
+	rec->outcount = outcount;
+	rec->bogons = peer->bogons;
+	rec->flag = flag;
+	strlcpy(s->label, peerlabel(peer), sizeof(s->label));
+	strlcpy(s->dstaddr, dstaddr ? socktoa(dstaddr) : "-",
+		sizeof(s->dstaddr));
+	strlcpy(s->refid, refid_str(refid, stratum), sizeof(s->refid));
+
+	if (s == &sample)
+		rawstats_put(s);
 }
 
 /*
@@ -607,15 +1027,11 @@ void record_ref_stats(
         return;
 
     clock_gettime(CLOCK_REALTIME, &now);
-    filegen_setup(&refstats, now.tv_sec);
-    if (refstats.fp != NULL) {
-        fprintf(refstats.fp,
-            "%s %s %d %d %d  %.9f %.9f %.9f %.9f %.9f  %.9f %.9f %.9f\n",
-            timespec_to_MJDtime(&now), peerlabel(peer),
-            n, i, j,
-            t1, t2, t3, t4, t5, jitter, std_dev, std_dev_all);
-        fflush(refstats.fp);
-    }
+    filegen_printf(&refstats, now.tv_sec,
+        "%s %s %d %d %d  %.9f %.9f %.9f %.9f %.9f  %.9f %.9f %.9f\n",
+        timespec_to_MJDtime(&now), peerlabel(peer),
+        n, i, j,
+        t1, t2, t3, t4, t5, jitter, std_dev, std_dev_all);
 }
 
 
@@ -646,19 +1062,15 @@ record_sys_stats(void)
 		return;
 
 	clock_gettime(CLOCK_REALTIME, &now);
-	filegen_setup(&sysstats, now.tv_sec);
-	if (sysstats.fp != NULL) {
-		fprintf(sysstats.fp,
-		    "%s %u %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64
-		    " %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64 "\n",
-			timespec_to_MJDtime(&now), stat_stattime(),
-			stat_received(), stat_processed(), stat_newversion(),
-			stat_oldversion(), stat_restricted(), stat_badlength(),
-			stat_badauth(), stat_declined(), stat_limitrejected(),
-			stat_kodsent());
-		fflush(sysstats.fp);
+	if (filegen_printf(&sysstats, now.tv_sec,
+	    "%s %u %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64
+	    " %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64 "\n",
+		timespec_to_MJDtime(&now), stat_stattime(),
+		stat_received(), stat_processed(), stat_newversion(),
+		stat_oldversion(), stat_restricted(), stat_badlength(),
+		stat_badauth(), stat_declined(), stat_limitrejected(),
+		stat_kodsent()))
 		proto_clr_stats();
-	}
 }
 
 
@@ -682,8 +1094,7 @@ void record_use_stats(void)
 		return;
 
 	clock_gettime(CLOCK_REALTIME, &now);
-	filegen_setup(&usestats, now.tv_sec);
-	if (usestats.fp != NULL) {
+	if (usestats.flag & FGEN_FLAG_ENABLED) {
 		double utime, stimex; /* stime() is in time.h */
 		getrusage(RUSAGE_SELF, &usage);
 		utime = usage.ru_utime.tv_usec - oldusage.ru_utime.tv_usec;
@@ -692,7 +1103,7 @@ void record_use_stats(void)
 		stimex = usage.ru_stime.tv_usec - oldusage.ru_stime.tv_usec;
 		stimex /= 1E6;
 		stimex += usage.ru_stime.tv_sec - oldusage.ru_stime.tv_sec;
-		fprintf(usestats.fp,
+		if (!filegen_printf(&usestats, now.tv_sec,
 		    "%s %u %.3f %.3f %ld %ld %ld %ld %ld %ld %ld %ld %ld\n",
 		    timespec_to_MJDtime(&now), stat_use_stattime(),
 		    utime, stimex,
@@ -704,8 +1115,8 @@ void record_use_stats(void)
 		    usage.ru_nvcsw -    oldusage.ru_nvcsw,
 		    usage.ru_nivcsw -   oldusage.ru_nivcsw,
 		    usage.ru_nsignals - oldusage.ru_nsignals,
-		    usage.ru_maxrss );
-		fflush(usestats.fp);
+		    usage.ru_maxrss ))
+			return;
 		oldusage = usage;
 		set_use_stattime(current_time);
 	}
@@ -731,12 +1142,8 @@ record_proto_stats(
 		return;
 
 	clock_gettime(CLOCK_REALTIME, &now);
-	filegen_setup(&protostats, now.tv_sec);
-	if (protostats.fp != NULL) {
-		fprintf(protostats.fp, "%s %s\n",
-		    timespec_to_MJDtime(&now), str);
-		fflush(protostats.fp);
-	}
+	filegen_printf(&protostats, now.tv_sec, "%s %s\n",
+	    timespec_to_MJDtime(&now), str);
 }
 
 
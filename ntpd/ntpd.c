@@ -495,7 +495,6 @@ main(
 	saved_argv = argv;
 	progname = argv[0];
 
-	getbuf_init();
 	parse_cmdline_opts(argc, argv);
 # ifdef DEBUG
 	setvbuf(stdout, NULL, _IOLBF, 0);
@@ -943,10 +942,12 @@ static void mainloop(void)
 		if (sig_flags.sawALRM) {
 			/*
 			 * Out here, signals are unblocked.  Call timer routine
-			 * to process expiry.
+			 * to process expiry, once for every tick that passed
+			 * so a stall doesn't lose clock adjustment or time.
 			 */
 		    sig_flags.sawALRM = false;
-			timer();
+			for (int ticks = timer_ticks(); ticks > 0; ticks--)
+				timer();
 		}
 
 		if (sig_flags.sawDNS) {
@@ -1017,6 +1018,8 @@ finish_safe(
 		DNSServiceRefDeallocate(mdns);
 # endif
 	peer_cleanup();
+	/* before the statistics writer stops, at exit */
+	rawstats_flush();
 	exit(0);
 }
 
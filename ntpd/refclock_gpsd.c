@@ -65,27 +65,14 @@
 #include "ntp_debug.h"
 
 /* =====================================================================
- * Get the little JSMN library directly into our guts. Use the 'parent
- * link' feature for maximum speed.
+ * JSON parsing stuff. We only ever want a few top-level members of
+ * each record, so the scanner in gpsd_json.h picks those out in a
+ * single pass over the line instead of tokenizing all of it.
  */
-#define JSMN_STATIC
-#define JSMN_PARENT_LINKS
-#include "jsmn.h"
+#include "gpsd_json.h"
 
-/* =====================================================================
- * JSON parsing stuff
- */
-
-#define JSMN_MAXTOK	350
-#define INVALID_TOKEN (-1)
-
-typedef struct json_ctx {
-	char        * buf;
-	int           ntok;
-	jsmntok_t     tok[JSMN_MAXTOK];
-} json_ctx;
-
-typedef int tok_ref;
+typedef struct gpsd_json json_ctx;
+typedef enum gpsd_json_key json_key;
 
 /* We roll our own integer number parser.
  */
@@ -1144,94 +1131,14 @@ strtojint(
 
 /* ------------------------------------------------------------------ */
 
-static tok_ref
-json_token_skip(
-	const json_ctx * ctx,
-	tok_ref          tid)
-{
-	if (tid >= 0 && tid < ctx->ntok) {
-		int len = ctx->tok[tid].size;
-		/* For arrays and objects, the size is the number of
-		 * ITEMS in the compound. That's the number of objects in
-		 * the array, and the number of key/value pairs for
-		 * objects. In theory, the key must be a string, and we
-		 * could simply skip one token before skipping the
-		 * value, which can be anything. We're a bit paranoid
-		 * and lazy at the same time: We simply double the
-		 * number of tokens to skip and fall through into the
-		 * array processing when encountering an object.
-		 */
-		switch (ctx->tok[tid].type) {
-		case JSMN_OBJECT:
-			len *= 2;
-			/* FALLTHROUGH */
-		case JSMN_ARRAY:
-			for (++tid; len; --len)
-				tid = json_token_skip(ctx, tid);
-			break;
-
-                case JSMN_PRIMITIVE:
-                case JSMN_STRING:
-		default:
-			++tid;
-			break;
-		}
-		if (tid > ctx->ntok) { /* Impossible? Paranoia rulez. */
-			tid = ctx->ntok;
-		}
-	}
-	return tid;
-}
-
-/* ------------------------------------------------------------------ */
-
-static int
-json_object_lookup(
-	const json_ctx * ctx ,
-	tok_ref          tid ,
-	const char     * key ,
-	int              what)
-{
-	int len;
-
-	if (tid < 0 || tid >= ctx->ntok ||
-	    ctx->tok[tid].type != JSMN_OBJECT)
-		return INVALID_TOKEN;
-
-	len = ctx->tok[tid].size;
-	for (++tid; len && tid+1 < ctx->ntok; --len) {
-		if (ctx->tok[tid].type != JSMN_STRING) { /* Blooper! */
-			tid = json_token_skip(ctx, tid); /* skip key */
-			tid = json_token_skip(ctx, tid); /* skip val */
-		} else if (strcmp(key, ctx->buf + ctx->tok[tid].start)) {
-			tid = json_token_skip(ctx, tid+1); /* skip key+val */
-		} else if (what < 0 || what == (int)ctx->tok[tid+1].type) {
-			return tid + 1;
-		} else {
-			break;
-		}
-		/* if skipping ahead returned an error, bail out here. */
-		if (tid < 0) {
-			break;
-		}
-	}
-	return INVALID_TOKEN;
-}
-
-/* ------------------------------------------------------------------ */
-
 static const char*
 json_object_lookup_primitive(
 	const json_ctx * ctx,
-	tok_ref          tid,
-	const char     * key)
+	json_key         key)
 {
-	tid = json_object_lookup(ctx, tid, key, JSMN_PRIMITIVE);
-	if (INVALID_TOKEN  != tid) {
-		return ctx->buf + ctx->tok[tid].start;
-	} else {
-		return NULL;
-	}
+	if (GJT_PRIMITIVE == ctx->type[key])
+		return ctx->val[key];
+	return NULL;
 }
 /* ------------------------------------------------------------------ */
 /* look up a boolean value. This essentially returns a tribool:
@@ -1240,11 +1147,10 @@ json_object_lookup_primitive(
 static int
 json_object_lookup_bool(
 	const json_ctx * ctx,
-	tok_ref          tid,
-	const char     * key)
+	json_key         key)
 {
 	const char *cp;
-	cp  = json_object_lookup_primitive(ctx, tid, key);
+	cp  = json_object_lookup_primitive(ctx, key);
 	switch ( cp ? *cp : '\0') {
 	case 't': return  1;
 	case 'f': return  0;
@@ -1257,25 +1163,21 @@ json_object_lookup_bool(
 static const char*
 json_object_lookup_string(
 	const json_ctx * ctx,
-	tok_ref          tid,
-	const char     * key)
+	json_key         key)
 {
-	tid = json_object_lookup(ctx, tid, key, JSMN_STRING);
-	if (INVALID_TOKEN != tid)
-		return ctx->buf + ctx->tok[tid].start;
+	if (GJT_STRING == ctx->type[key])
+		return ctx->val[key];
 	return NULL;
 }
 
 static const char*
 json_object_lookup_string_default(
 	const json_ctx * ctx,
-	tok_ref          tid,
-	const char     * key,
+	json_key         key,
 	const char     * def)
 {
-	tid = json_object_lookup(ctx, tid, key, JSMN_STRING);
-	if (INVALID_TOKEN != tid)
-		return ctx->buf + ctx->tok[tid].start;
+	if (GJT_STRING == ctx->type[key])
+		return ctx->val[key];
 	return def;
 }
 
@@ -1284,14 +1186,13 @@ json_object_lookup_string_default(
 static json_int
 json_object_lookup_int(
 	const json_ctx * ctx,
-	tok_ref          tid,
-	const char     * key)
+	json_key         key)
 {
 	json_int     ret;
 	const char * cp;
 	char       * ep;
 
-	cp = json_object_lookup_primitive(ctx, tid, key);
+	cp = json_object_lookup_primitive(ctx, key);
 	if (NULL != cp) {
 		ret = strtojint(cp, &ep);
 		if (cp != ep && '\0' == *ep) {
@@ -1306,15 +1207,14 @@ json_object_lookup_int(
 static json_int
 json_object_lookup_int_default(
 	const json_ctx * ctx,
-	tok_ref          tid,
-	const char     * key,
+	json_key         key,
 	json_int         def)
 {
 	json_int     ret;
 	const char * cp;
 	char       * ep;
 
-	cp = json_object_lookup_primitive(ctx, tid, key);
+	cp = json_object_lookup_primitive(ctx, key);
 	if (NULL != cp) {
 		ret = strtojint(cp, &ep);
 		if (cp != ep && '\0' == *ep) {
@@ -1329,15 +1229,14 @@ json_object_lookup_int_default(
 static double
 json_object_lookup_float_default(
 	const json_ctx * ctx,
-	tok_ref          tid,
-	const char     * key,
+	json_key         key,
 	double           def)
 {
 	double       ret;
 	const char * cp;
 	char       * ep;
 
-	cp = json_object_lookup_primitive(ctx, tid, key);
+	cp = json_object_lookup_primitive(ctx, key);
 	if (NULL != cp) {
 		ret = strtod(cp, &ep);
 		if (cp != ep && '\0' == *ep) {
@@ -1347,37 +1246,6 @@ json_object_lookup_float_default(
 	return def;
 }
 
-/* ------------------------------------------------------------------ */
-
-static bool
-json_parse_record(
-	json_ctx * ctx,
-	char     * buf,
-	size_t     len)
-{
-	jsmn_parser jsm;
-	int         idx, rc;
-
-	jsmn_init(&jsm);
-	rc = jsmn_parse(&jsm, buf, len, ctx->tok, JSMN_MAXTOK);
-	if (rc <= 0)
-		return false;
-	ctx->buf  = buf;
-	ctx->ntok = rc;
-
-	if (JSMN_OBJECT != ctx->tok[0].type)
-		return false; /* not object!?! */
-
-	/* Make all tokens NUL terminated by overwriting the
-	 * terminator symbol. Makes string compares and number parsing a
-	 * lot easier!
-	 */
-	for (idx = 0; idx < ctx->ntok; ++idx)
-		if (ctx->tok[idx].end > ctx->tok[idx].start)
-			ctx->buf[ctx->tok[idx].end] = '\0';
-	return true;
-}
-
 
 /* =====================================================================
  * static local helpers
@@ -1386,16 +1254,16 @@ static bool
 get_binary_time(
 	l_fp       * const dest     ,
 	json_ctx   * const jctx     ,
-	const char * const time_name,
-	const char * const frac_name,
+	json_key           time_key ,
+	json_key           frac_key ,
 	long               fscale   )
 {
 	bool            retv = false;
 	struct timespec ts;
 
 	errno = 0;
-	ts.tv_sec  = (time_t)json_object_lookup_int(jctx, 0, time_name);
-	ts.tv_nsec = (long  )json_object_lookup_int(jctx, 0, frac_name);
+	ts.tv_sec  = (time_t)json_object_lookup_int(jctx, time_key);
+	ts.tv_nsec = (long  )json_object_lookup_int(jctx, frac_key);
 	if (0 == errno) {
 		ts.tv_nsec *= fscale;
 		*dest = tspec_stamp_to_lfp(ts);
@@ -1423,13 +1291,13 @@ process_watch(
 
 	UNUSED_ARG(rtime);
 
-	path = json_object_lookup_string(jctx, 0, "device");
+	path = json_object_lookup_string(jctx, GJ_DEVICE);
 	if (NULL == path || strcmp(path, up->device)) {
 		return;
 	}
 
-	if (json_object_lookup_bool(jctx, 0, "enable") > 0 &&
-	    json_object_lookup_bool(jctx, 0, "json"  ) > 0  )
+	if (json_object_lookup_bool(jctx, GJ_ENABLE) > 0 &&
+	    json_object_lookup_bool(jctx, GJ_JSON  ) > 0  )
 		up->fl_watch = true;
 	else
 		up->fl_watch = false;
@@ -1459,12 +1327,12 @@ process_version(
 
 	/* get protocol version number */
 	revision = json_object_lookup_string_default(
-		jctx, 0, "rev", "(unknown)");
+		jctx, GJ_REV, "(unknown)");
 	release  = json_object_lookup_string_default(
-		jctx, 0, "release", "(unknown)");
+		jctx, GJ_RELEASE, "(unknown)");
 	errno = 0;
-	pvhi = (uint16_t)json_object_lookup_int(jctx, 0, "proto_major");
-	pvlo = (uint16_t)json_object_lookup_int(jctx, 0, "proto_minor");
+	pvhi = (uint16_t)json_object_lookup_int(jctx, GJ_PROTO_MAJOR);
+	pvlo = (uint16_t)json_object_lookup_int(jctx, GJ_PROTO_MINOR);
 
 	if (0 == errno) {
 		if ( ! up->fl_vers)
@@ -1542,10 +1410,10 @@ process_tpv(
 	int          xlog2;
 
 	gps_mode = (int)json_object_lookup_int_default(
-		jctx, 0, "mode", 0);
+		jctx, GJ_MODE, 0);
 
 	gps_time = json_object_lookup_string(
-		jctx, 0, "time");
+		jctx, GJ_TIME);
 
 	/* accept time stamps only in 2d or 3d fix */
 	if (gps_mode < 2 || NULL == gps_time) {
@@ -1597,7 +1465,7 @@ process_tpv(
 	 * precision estimation, since it gets the proper value directly
 	 * from GPSD!)
 	 */
-	ept = json_object_lookup_float_default(jctx, 0, "ept", 2.0e-3);
+	ept = json_object_lookup_float_default(jctx, GJ_EPT, 2.0e-3);
 	ept = frexp(fabs(ept)*0.70710678, &xlog2); /* ~ sqrt(0.5) */
 	if (ept < 0.25)
 		xlog2 = INT_MIN;
@@ -1634,17 +1502,17 @@ process_pps(
 	 */
 	if (up->pf_nsec) {
 		if ( ! get_binary_time(&up->pps_recvt2, jctx,
-				       "clock_sec", "clock_nsec", 1))
+				       GJ_CLOCK_SEC, GJ_CLOCK_NSEC, 1))
 			goto fail;
 		if ( ! get_binary_time(&up->pps_stamp2, jctx,
-				       "real_sec", "real_nsec", 1))
+				       GJ_REAL_SEC, GJ_REAL_NSEC, 1))
 			goto fail;
 	} else {
 		if ( ! get_binary_time(&up->pps_recvt2, jctx,
-				       "clock_sec", "clock_musec", 1000))
+				       GJ_CLOCK_SEC, GJ_CLOCK_MUSEC, 1000))
 			goto fail;
 		if ( ! get_binary_time(&up->pps_stamp2, jctx,
-				       "real_sec", "real_musec", 1000))
+				       GJ_REAL_SEC, GJ_REAL_MUSEC, 1000))
 			goto fail;
 	}
 
@@ -1652,7 +1520,7 @@ process_pps(
 	 * not there, take the precision from the serial data.
 	 */
 	xlog2 = (int)json_object_lookup_int_default(
-			jctx, 0, "precision", up->ibt_prec);
+			jctx, GJ_PRECISION, up->ibt_prec);
 	up->pps_prec = clamped_precision(xlog2);
 
 	/* Get fudged receive times for primary & secondary unit */
@@ -1707,10 +1575,10 @@ process_toff(
 		return;
 
 	if ( ! get_binary_time(&up->ibt_recvt, jctx,
-			       "clock_sec", "clock_nsec", 1))
+			       GJ_CLOCK_SEC, GJ_CLOCK_NSEC, 1))
 			goto fail;
 	if ( ! get_binary_time(&up->ibt_stamp, jctx,
-			       "real_sec", "real_nsec", 1))
+			       GJ_REAL_SEC, GJ_REAL_NSEC, 1))
 			goto fail;
 	up->ibt_recvt -= up->ibt_fudge;
 	up->ibt_local = *rtime;
@@ -1746,17 +1614,15 @@ gpsd_parse(
 		   up->logname, ulfptoa(*rtime, 6),
 		   up->buflen, up->buffer));
 
-	/* See if we can grab anything potentially useful. JSMN does not
-	 * need a trailing NUL, but it needs the number of bytes to
-	 * process. */
-	if (!json_parse_record(&up->json_parse, up->buffer,
-                               (size_t)up->buflen)) {
+	/* See if we can grab anything potentially useful. The line was
+	 * NUL-terminated by gpsd_receive(). */
+	if (!gpsd_json_scan(&up->json_parse, up->buffer)) {
 		++up->tc_breply;
 		return;
 	}
 
 	/* Now dispatch over the objects we know */
-	clsid = json_object_lookup_string(&up->json_parse, 0, "class");
+	clsid = json_object_lookup_string(&up->json_parse, GJ_CLASS);
 	if (NULL == clsid) {
 		++up->tc_breply;
 		return;
@@ -31,6 +31,7 @@
 #include "ntp_refclock.h"
 #include "ntp_stdlib.h"
 #include "timespecops.h"
+#include "nmea_sentence.h"
 #include "PIVOT.h"
 
 #ifdef HAVE_PPSAPI
@@ -85,11 +86,6 @@
 #define NMEA_EXTLOG_MASK	0x00010000U
 #define NMEA_DATETRUST_MASK	0x02000000U
 
-#define NMEA_PROTO_IDLEN	5	/* tag name must be at least 5 chars */
-/* #define NMEA_PROTO_MINLEN 6 * min chars in sentence, excluding CS UNUSED */
-#define NMEA_PROTO_MAXLEN	80	/* max chars in sentence, excluding CS */
-#define NMEA_PROTO_FIELDS	32	/* not official; limit on fields per record */
-
 /*
  * We check the timecode format and decode its contents.  We only care
  * about a few of them, the most important being the $GPRMC format:
@@ -153,24 +149,6 @@
 #define	NAME		"NMEA"		/* shortname */
 #define	DESCRIPTION	"NMEA GPS Clock" /* who we are */
 
-/* NMEA sentence array indexes for those we use */
-#define NMEA_GPRMC	0	/* recommended min. nav. */
-#define NMEA_GPGGA	1	/* fix and quality */
-#define NMEA_GPGLL	2	/* geo. lat/long */
-#define NMEA_GPZDA	3	/* date/time */
-/*
- * $GPZDG is a proprietary sentence that violates the spec, by not
- * using $P and an assigned company identifier to prefix the sentence
- * identifier.	When used with this driver, the system needs to be
- * isolated from other NTP networks, as it operates in GPS time, not
- * UTC as is much more common.	GPS time is >15 seconds different from
- * UTC due to not respecting leap seconds since 1970 or so.  Other
- * than the different timebase, $GPZDG is similar to $GPZDA.
- */
-#define NMEA_GPZDG	4
-#define NMEA_PGRMF	5
-#define NMEA_ARRAY_SIZE (NMEA_PGRMF + 1)
-
 /*
  * Sentence selection mode bits
  */
@@ -191,22 +169,6 @@ static const uint32_t sentence_mode[NMEA_ARRAY_SIZE] =
 	USE_PGRMF
 };
 
-/* date formats we support */
-enum date_fmt {
-	DATE_1_DDMMYY,	/* use 1 field	with 2-digit year */
-	DATE_3_DDMMYYYY	/* use 3 fields with 4-digit year */
-};
-
-/* results for 'field_init()'
- *
- * Note: If a checksum is present, the checksum test must pass OK or the
- * sentence is tagged invalid.
- */
-#define CHECK_EMPTY  -1	/* no data			*/
-#define CHECK_INVALID 0	/* not a valid NMEA sentence	*/
-#define CHECK_VALID   1	/* valid but without checksum	*/
-#define CHECK_CSVALID 2	/* valid with checksum OK	*/
-
 /*
  * Unit control structure
  */
@@ -236,23 +198,12 @@ typedef struct {
 	uint8_t	cksum_type[NMEA_ARRAY_SIZE];
 } nmea_unit;
 
-/*
- * helper for faster field access
- */
-typedef struct {
-	char  *base;	/* buffer base		*/
-	char  *cptr;	/* current field ptr	*/
-	int    blen;	/* buffer length	*/
-	int    cidx;	/* current field index	*/
-} nmea_data;
-
-
 /*
  * Function prototypes
  */
 static	bool	nmea_start	(int, struct peer *);
 static	void	nmea_shutdown	(struct refclockproc *);
-static	void	nmea_receive	(struct recvbuf *);
+static	void	nmea_receive	(struct peer *, char *, int, l_fp *);
 static	void	nmea_poll	(int, struct peer *);
 #ifdef HAVE_PPSAPI
 static	void	nmea_control	(int, const struct refclockstat *,
@@ -264,14 +215,9 @@ static	void	nmea_control	(int, const struct refclockstat *,
 static	void	nmea_timer	(int, struct peer *);
 
 /* parsing helpers */
-static int	field_init	(nmea_data * data, char * cp, int len);
-static char *	field_parse	(nmea_data * data, int fn);
-static void	field_wipe	(nmea_data * data, ...);
+static void	field_wipe	(nmea_data * data, const int8_t * list);
 static uint8_t	parse_qual	(nmea_data * data, int idx,
-				 char tag, int inv);
-static bool	parse_time	(struct timespec *dt, nmea_data *, int idx);
-static bool	parse_date	(struct timespec *dt, nmea_data*,
-					int idx, enum date_fmt fmt);
+				 char tag, bool inv);
 static bool	kludge_day	(struct timespec *dt);
 static bool	fix_WNRO	(struct timespec *dt, int *wnro, \
 					const struct peer *peer);
@@ -460,7 +406,7 @@ nmea_start(
 	/* Allocate and initialize unit structure */
 	pp->unitptr = (void *)up;
 	pp->io.fd = -1;
-	pp->io.clock_recv = nmea_receive;
+	pp->io.clock_recv = NULL;
 	pp->io.srcclock = peer;
 	pp->io.datalen = 0;
 	/* force change detection on first valid message */
@@ -492,13 +438,14 @@ nmea_start(
 		path = device;
         }
 	/* Open serial port. */
-	pp->io.fd = refclock_open(path, baudrate, LDISC_STD);
+	pp->io.fd = refclock_open(path, baudrate, LDISC_RAW);
 
 	if (0 > pp->io.fd) {
 		msyslog(LOG_ERR, "REFCLOCK: %s NMEA device open(%s) failed",
 		    refclock_name(peer), path);
 		return false;
         }
+	refclock_linemode(&pp->io, baudrate, nmea_receive);
 
 	LOGIF(CLOCKINFO, (LOG_NOTICE, "%s serial %s open at %s bps",
 			  refclock_name(peer), path, baudtext));
@@ -792,7 +739,10 @@ refclock_ppsrelate(
 
 /*
  * -------------------------------------------------------------------
- * nmea_receive - receive data from the serial interface
+ * nmea_receive - receive a line from the serial interface
+ *
+ * The port is in line mode, so each sentence arrives on its own,
+ * groomed, with the arrival time of its line end.
  *
  * This is the workhorse for NMEA data evaluation:
  *
@@ -809,17 +759,20 @@ refclock_ppsrelate(
  */
 static void
 nmea_receive(
-	struct recvbuf * rbufp
+	struct peer	* peer,
+	char		* line,
+	int		  len,
+	l_fp		* ts
 	)
 {
 	/* declare & init control structure ptrs */
-	struct peer	    * const peer = rbufp->recv_peer;
 	struct refclockproc * const pp = peer->procptr;
 	nmea_unit	    * const up = (nmea_unit*)pp->unitptr;
 
 	/* Use these variables to hold data until we decide its worth keeping */
 	nmea_data rdata;
-	char 	  rd_lastcode[BMAX];
+	const struct nmea_layout * lay;
+	char 	* rd_lastcode;
 	l_fp 	  rd_timestamp, rd_reftime;
 	int	  rd_lencode;
 	double	  rd_fudge;
@@ -827,9 +780,8 @@ nmea_receive(
 	/* working stuff */
 	struct timespec date;	/* to keep & convert the time stamp */
 	/* results of sentence/date/time parsing */
-	uint8_t		sentence;	/* sentence tag */
+	int		sentence;	/* sentence tag */
 	int		checkres;
-	char *		cp;
 	bool		rc_date;
 	bool		rc_time;
 
@@ -839,15 +791,14 @@ nmea_receive(
 	rc_date = false;
 	rc_time = false;
 	/*
-	 * Read the timecode and timestamp, then initialise field
-	 * processing. The <CR><LF> at the NMEA line end is translated
-	 * to <LF><LF> by the terminal input routines on most systems,
-	 * and this gives us one spurious empty read per record which we
-	 * better ignore silently.
+	 * Take the timecode and timestamp, then initialise field
+	 * processing. Overlong lines are cut to BMAX - 1 characters,
+	 * as refclock_gtlin() did.
 	 */
-	rd_lencode = refclock_gtlin(rbufp, rd_lastcode,
-				    sizeof(rd_lastcode), &rd_timestamp);
-	checkres = field_init(&rdata, rd_lastcode, rd_lencode);
+	rd_lastcode = line;
+	rd_lencode = min(len, BMAX - 1);
+	rd_timestamp = *ts;
+	checkres = nmea_scan(&rdata, rd_lastcode, rd_lencode);
 	switch (checkres) {
 
 	case CHECK_INVALID:
@@ -870,27 +821,12 @@ nmea_receive(
 	/*
 	 * --> below this point we have a valid NMEA sentence <--
 	 *
-	 * Check sentence name. Skip first 2 chars (talker ID) in most
-	 * cases, to allow for $GLGGA and $GPGGA etc. Since the name
-	 * field has at least 5 chars we can simply shift the field
-	 * start.
+	 * Check sentence name.  The talker ID is ignored in most
+	 * cases, to allow for $GLGGA and $GPGGA etc.
 	 */
-	cp = field_parse(&rdata, 0);
-	if      (strncmp(cp + 2, "RMC,", 4) == 0) {
-		sentence = NMEA_GPRMC;
-	} else if (strncmp(cp + 2, "GGA,", 4) == 0) {
-		sentence = NMEA_GPGGA;
-	} else if (strncmp(cp + 2, "GLL,", 4) == 0) {
-		sentence = NMEA_GPGLL;
-	} else if (strncmp(cp + 2, "ZDA,", 4) == 0) {
-		sentence = NMEA_GPZDA;
-	} else if (strncmp(cp + 2, "ZDG,", 4) == 0) {
-		sentence = NMEA_GPZDG;
-	} else if (strncmp(cp,   "PGRMF,", 6) == 0) {
-		sentence = NMEA_PGRMF;
-	} else {
+	sentence = nmea_lookup(&rdata);
+	if (sentence < 0)
 		return;	/* not something we know about */
-	}
 
 	/* Eventually output delay measurement now. */
 	if (peer->cfg.mode & NMEA_DELAYMEAS_MASK) {
@@ -949,77 +885,40 @@ nmea_receive(
 
 	/*
 	 * Grab fields depending on clock string type and possibly wipe
-	 * sensitive data from the last timecode.
+	 * sensitive data from the last timecode.  A sentence without a
+	 * status field is assumed good, and one without a date gets
+	 * today's.
 	 */
-	switch (sentence) {
-
-	case NMEA_GPRMC:
-		/* Check quality byte, fetch data & time */
-		rc_time	 = parse_time(&date, &rdata, 1);
-		pp->leap = parse_qual(&rdata, 2, 'A', 0);
-		rc_date	 = parse_date(&date, &rdata, 9, DATE_1_DDMMYY);
-		fix_WNRO(&date, &up->wnro, peer);
-		if (CLK_FLAG4 & pp->sloppyclockflag)
-			field_wipe(&rdata, 3, 4, 5, 6, -1);
-		break;
-
-	case NMEA_GPGGA:
-		/* Check quality byte, fetch time only */
-		rc_time	 = parse_time(&date, &rdata, 1);
-		pp->leap = parse_qual(&rdata, 6, '0', 1);
-		rc_date	 = kludge_day(&date);
-		if (CLK_FLAG4 & pp->sloppyclockflag)
-			field_wipe(&rdata, 2, 4, -1);
-		break;
-
-	case NMEA_GPGLL:
-		/* Check quality byte, fetch time only */
-		rc_time	 = parse_time(&date, &rdata, 5);
-		pp->leap = parse_qual(&rdata, 6, 'A', 0);
-		rc_date	 = kludge_day(&date);
-		if (CLK_FLAG4 & pp->sloppyclockflag)
-			field_wipe(&rdata, 1, 3, -1);
-		break;
-
-	case NMEA_GPZDA:
-		/* No quality.	Assume best, fetch time & full date */
+	lay = &nmea_layout[sentence];
+	rc_time = nmea_parse_time(&date, nmea_field(&rdata, lay->time));
+	if (DATE_NONE == lay->datefmt) {
+		rc_date = kludge_day(&date);
+	} else {
+		rc_date = nmea_parse_date(&date, nmea_field(&rdata, lay->date),
+					  lay->datefmt);
+		if (lay->wnro)
+			fix_WNRO(&date, &up->wnro, peer);
+	}
+	if (lay->qual < 0)
 		pp->leap = LEAP_NOWARNING;
-		rc_time	 = parse_time(&date, &rdata, 1);
-		rc_date	 = parse_date(&date, &rdata, 2, DATE_3_DDMMYYYY);
-		fix_WNRO(&date, &up->wnro, peer);
-		break;
-
-	case NMEA_GPZDG:
-		/* Check quality byte, fetch time & full date */
-		rc_time	 = parse_time(&date, &rdata, 1);
-		rc_date	 = parse_date(&date, &rdata, 2, DATE_3_DDMMYYYY);
-		fix_WNRO(&date, &up->wnro, peer);
-		pp->leap = parse_qual(&rdata, 4, '0', 1);
+	else
+		pp->leap = parse_qual(&rdata, lay->qual, lay->tag, lay->inv);
+	if (NMEA_GPZDG == sentence)
 		date.tv_sec -= 1; /* GPZDG is following second */
-		break;
-
-	case NMEA_PGRMF:
-		/* Ignore week stuff.  Use date and time fields. 
-		 */
-		rc_time  = parse_time(&date, &rdata, 4);
-		rc_date  = parse_date(&date, &rdata, 3, DATE_1_DDMMYY);
-		pp->leap = parse_qual(&rdata, 11, '0', 1);
-		if (CLK_FLAG4 & pp->sloppyclockflag)
-			field_wipe(&rdata, 6, 8, -1);
-		break;
-
-	default:
-		INVARIANT(0);	/* Coverity 97123 */
-		return;
-	}
+	if ((CLK_FLAG4 & pp->sloppyclockflag) && lay->wipe[0] >= 0)
+		field_wipe(&rdata, lay->wipe);
 
 	/* Check sanity of time-of-day. */
 	if (!rc_time) {	/* no time or conversion error? */
+		DPRINT(1, ("%s invalid time code: '%.6s'\n",
+			   refclock_name(peer), nmea_field(&rdata, lay->time)));
 		checkres = CEVNT_BADTIME;
 		up->tally.malformed++;
 	}
 	/* Check sanity of date. */
 	else if (!rc_date) {/* no date or conversion error? */
+		DPRINT(1, ("%s invalid date code: '%.10s'\n",
+			   refclock_name(peer), nmea_field(&rdata, lay->date)));
 		checkres = CEVNT_BADDATE;
 		up->tally.malformed++;
 	}
@@ -1286,165 +1185,11 @@ gps_send(
 }
 #endif /* NMEA_WRITE_SUPPORT */
 
-/*
- * -------------------------------------------------------------------
- * helpers for faster field splitting
- * -------------------------------------------------------------------
- *
- * set up a field record, check syntax and verify checksum
- *
- * format is $XXXXX,1,2,3,4*ML
- *
- * 8-bit XOR of characters between $ and * noninclusive is transmitted
- * in last two chars M and L holding most and least significant nibbles
- * in hex representation such as:
- *
- *   $GPGLL,5057.970,N,00146.110,E,142451,A*27
- *   $GPVTG,089.0,T,,,15.2,N,,*7F
- *
- * Some other constraints:
- * + The field name must at least 5 upcase characters or digits and must
- *   start with a character.
- * + The checksum (if present) must be uppercase hex digits.
- * + The length of a sentence is limited to 80 characters (not including
- *   the final CR/LF nor the checksum, but including the leading '$')
- *
- * Return values:
- *  + CHECK_INVALID
- *	The data does not form a valid NMEA sentence or a checksum error
- *	occurred.
- *  + CHECK_VALID
- *	The data is a valid NMEA sentence but contains no checksum.
- *  + CHECK_CSVALID
- *	The data is a valid NMEA sentence and passed the checksum test.
- * -------------------------------------------------------------------
- */
-static int
-field_init(
-	nmea_data * data,	/* context structure		       */
-	char 	  * cptr,	/* start of raw data		       */
-	int	    dlen	/* data len, not counting trailing NUL */
-	)
-{
-	uint8_t cs_l;	/* checksum local computed	*/
-	uint8_t cs_r;	/* checksum remote given	*/
-	char * eptr;	/* buffer end end pointer	*/
-	char   tmp;	/* char buffer 			*/
-
-	cs_l = 0;
-	cs_r = 0;
-	/* some basic input constraints */
-	if (dlen < 0) {
-		dlen = 0;
-	}
-	eptr = cptr + dlen;
-	*eptr = '\0';
-
-	/* load data context */
-	data->base = cptr;
-	data->cptr = cptr;
-	data->cidx = 0;
-	data->blen = dlen;
-
-	/* syntax check follows here. check allowed character
-	 * sequences, updating the local computed checksum as we go.
-	 *
-	 * regex equiv: '^\$[A-Z][A-Z0-9]{4,}[^*]*(\*[0-9A-F]{2})?$'
-	 */
-
-	/* -*- start character: '^\$' */
-	if (*cptr == '\0') {
-		return CHECK_EMPTY;
-	}
-	if (*cptr++ != '$') {
-		return CHECK_INVALID;
-	}
-
-	/* -*- advance context beyond start character */
-	data->base++;
-	data->cptr++;
-	data->blen--;
-
-	/* -*- field name: '[A-Z][A-Z0-9]{4,},' */
-	if (*cptr < 'A' || *cptr > 'Z') {
-		return CHECK_INVALID;
-	}
-	cs_l ^= *cptr++;
-	while ((*cptr >= 'A' && *cptr <= 'Z') ||
-	       (*cptr >= '0' && *cptr <= '9')  )
-		cs_l ^= *cptr++;
-	if (*cptr != ',' || (cptr - data->base) < NMEA_PROTO_IDLEN) {
-		return CHECK_INVALID;
-}
-	cs_l ^= *cptr++;
-
-	/* -*- data: '[^*]*' */
-	while (*cptr && *cptr != '*')
-		cs_l ^= *cptr++;
-
-	/* -*- checksum field: (\*[0-9A-F]{2})?$ */
-	if (*cptr == '\0') {
-		return CHECK_VALID;
-}
-	if (*cptr != '*' || cptr != eptr - 3 ||
-	    (cptr - data->base) >= NMEA_PROTO_MAXLEN) {
-		return CHECK_INVALID;
-}
-
-	for (cptr++; (tmp = *cptr) != '\0'; cptr++) {
-		if (tmp >= '0' && tmp <= '9') {
-			cs_r = (cs_r << 4) + (tmp - '0');
-		} else if (tmp >= 'A' && tmp <= 'F') {
-			cs_r = (cs_r << 4) + (tmp - 'A' + 10);
-		} else {
-			break;
-}
-	}
-
-	/* -*- make sure we are at end of string and csum matches */
-	if (cptr != eptr || cs_l != cs_r)
-		return CHECK_INVALID;
-
-	return CHECK_CSVALID;
-}
-
-/*
- * -------------------------------------------------------------------
- * fetch a data field by index, zero being the name field. If this
- * function is called repeatedly with increasing indices, the total load
- * is O(n), n being the length of the string; if it is called with
- * decreasing indices, the total load is O(n^2). Try not to go backwards
- * too often.
- * -------------------------------------------------------------------
- */
-static char *
-field_parse(
-	nmea_data * data,
-	int 	    fn
-	)
-{
-	char tmp;
-
-	if (fn < data->cidx) {
-		data->cidx = 0;
-		data->cptr = data->base;
-	}
-	while ((fn > data->cidx) && (tmp = *data->cptr) != '\0') {
-		data->cidx += (tmp == ',');
-		data->cptr++;
-	}
-	return data->cptr;
-}
-
 /*
  * -------------------------------------------------------------------
  * Wipe (that is, overwrite with '_') data fields and the checksum in
- * the last timecode.  The list of field indices is given as integers
- * in a varargs list, preferably in ascending order, in any case
- * terminated by a negative field index.
- *
- * A maximum number of 8 fields can be overwritten at once to guard
- * against runaway (that is, unterminated) argument lists.
+ * the last timecode.  The list of field indices is an array ended by
+ * a negative index, which stands for the checksum.
  *
  * This function affects what a remote user can see with
  *
@@ -1458,22 +1203,17 @@ field_parse(
  */
 static void
 field_wipe(
-	nmea_data * data,
-	...
+	nmea_data    * data,
+	const int8_t * list	/* fields to nuke, -1 for checksum */
 	)
 {
-	va_list	va;		/* vararg index list */
-	int	fcnt;		/* safeguard against runaway arglist */
-	int	fidx;		/* field to nuke, or -1 for checksum */
+	int	fidx;
 	char  * cp;		/* overwrite destination */
 
-	fcnt = 8;
-	cp = NULL;
-	va_start(va, data);
 	do {
-		fidx = va_arg(va, int);
-		if (fidx >= 0 && fidx <= NMEA_PROTO_FIELDS) {
-			cp = field_parse(data, fidx);
+		fidx = *list++;
+		if (fidx >= 0) {
+			cp = nmea_field(data, fidx);
 		} else {
 			cp = data->base + data->blen;
 			if (data->blen >= 3 && cp[-3] == '*') {
@@ -1485,8 +1225,7 @@ field_wipe(
 				*cp = '_';
 			}
 		}
-	} while (fcnt-- && fidx >= 0);
-	va_end(va);
+	} while (fidx >= 0);
 }
 
 /*
@@ -1507,154 +1246,18 @@ parse_qual(
 	nmea_data * rd,
 	int         idx,
 	char        tag,
-	int         inv
+	bool        inv
 	)
 {
 	static const uint8_t table[2] =
 				{ LEAP_NOTINSYNC, LEAP_NOWARNING };
 	char * dp;
 
-	dp = field_parse(rd, idx);
+	dp = nmea_field(rd, idx);
 
 	return table[ *dp && ((*dp == tag) == !inv) ];
 }
 
-/*
- * -------------------------------------------------------------------
- * Parse a time stamp in HHMMSS[.sss] format with error checking.
- *
- * Add result to arg
- *
- * returns true on success, false on failure
- * -------------------------------------------------------------------
- */
-static bool
-parse_time(
-	struct timespec * dt,	/* result date+time */
-	nmea_data       * rd,
-	int		  idx
-	)
-{
-	static const unsigned long weight[4] = {
-		0, 100000000, 10000000, 1000000
-	};
-
-	int	rc;
-	unsigned int	h;
-	unsigned int	m;
-	unsigned int	s;
-	int	p1;
-	int	p2;
-	unsigned long	f;
-	char  * dp;
-
-	dp = field_parse(rd, idx);
-	rc = sscanf(dp, "%2u%2u%2u%n.%3lu%n", &h, &m, &s, &p1, &f, &p2);
-	if (rc < 3 || p1 != 6) {
-		DPRINT(1, ("nmea: invalid time code: '%.6s'\n", dp));
-		return false;
-	}
-
-	/* value sanity check */
-	if (h > 23 || m > 59 || s > 60) {
-		DPRINT(1, ("nmea: invalid time spec %02u:%02u:%02u\n",
-			   h, m, s));
-		return false;
-	}
-
-	dt->tv_sec += h*3600 + m*60 + s;
-	/* if we have a fraction, scale it up to nanoseconds. */
-	if (rc == 4) {
-		dt->tv_nsec += (f * weight[p2 - p1 - 1]);
-}
-
-	return true;
-}
-
-/*
- * -------------------------------------------------------------------
- * Parse a date string from an NMEA sentence. This could either be a
- * partial date in DDMMYY format in one field, or DD,MM,YYYY full date
- * spec spanning three fields. This function does some extensive error
- * checking to make sure the date string was consistent.
- *
- * Add result to arg
- *
- * returns true on success, false on failure
- * -------------------------------------------------------------------
- */
-static bool
-parse_date(
-	struct timespec * dt,	/* result pointer */
-	nmea_data       * rd,
-	int		  idx,
-	enum date_fmt	  fmt
-	)
-{
-	int		rc;
-	unsigned int	y;
-	unsigned int	m;
-	unsigned int	d;
-	int		p;
-	char  	      * dp;
-	struct tm	tm;
-
-	dp = field_parse(rd, idx);
-	switch (fmt) {
-
-	case DATE_1_DDMMYY:
-		rc = sscanf(dp, "%2u%2u%2u%n", &d, &m, &y, &p);
-		if (rc != 3 || p != 6) {
-			DPRINT(1, ("nmea: invalid date code: '%.6s'\n",
-				   dp));
-			return false;
-		}
-		if (y > 80) {
-			/* We know the time is now > 2000 but
-			 * GPS might be off by n*1024 weeks.
-			 * WNRO: Week Number Roll Over, ~20 years
-			 * Don't break that correction.
-			 *
-			 * GPS time started in 1980
-			 *   anything < 80 is from the next century.
-			 */
-			y += 1900;
-		} else {
-			y += 2000;
-		}
-		break;
-
-	case DATE_3_DDMMYYYY:
-		rc = sscanf(dp, "%2u,%2u,%4u%n", &d, &m, &y, &p);
-		if (rc != 3 || p != 10) {
-			DPRINT(1, ("nmea: invalid date code: '%.10s'\n",
-				   dp));
-			return false;
-		}
-		break;
-
-	default:
-		DPRINT(1, ("nmea: invalid parse format: %u\n", fmt));
-		return false;
-	}
-
-	/* value sanity check */
-	if (d < 1 || d > 31 || m < 1 || m > 12) {
-		DPRINT(1, ("nmea: invalid date spec (YMD) %04u:%02u:%02u\n",
-			   y, m, d));
-		return false;
-	}
-
-	/* timegm is non-Posix. */
-	ZERO(tm);
-	tm.tm_year = y-1900;
-	tm.tm_mon = m-1;
-	tm.tm_mday = d;
-	dt->tv_sec += timegm(&tm);	/* No error checking */
-
-	return true;
-}
-
 /* Use system time for missing date field.
  * Time from GPS is in dt.  We add a day offset.
  * This assumes the system time is within 12 hours.
@@ -21,6 +21,7 @@
 #undef fileno
 #include "ntp_stdlib.h"
 #include "ntp_assert.h"
+#include "ntp_shm.h"
 
 #undef fileno
 #include <ctype.h>
@@ -28,7 +29,9 @@
 
 #include <sys/ipc.h>
 #include <sys/shm.h>
+#include <sys/stat.h>
 #include <assert.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <stdio.h>
 
@@ -54,6 +57,7 @@
  * Mode flags
  */
 #define SHM_MODE_PRIVATE 0x0001
+#define SHM_MODE_RING	 0x0002	/* version 2 segment, see ntp_shm.h */
 
 /*
  * Function prototypes
@@ -63,6 +67,8 @@ static  void    shm_shutdown    (struct refclockproc *peer);
 static  void    shm_poll        (int unit, struct peer *peer);
 static  void    shm_timer       (int unit, struct peer *peer);
 static	void	shm_clockstats  (int unit, struct peer *peer);
+static	void	shm_doorbell	(struct recvbuf *rbufp);
+static	void	shm_drain	(int unit, struct peer *peer);
 static	void	shm_control	(int unit, const struct refclockstat * in_st,
 				 struct refclockstat * out_st, struct peer *peer);
 
@@ -104,6 +110,9 @@ struct shmTime {
 
 struct shmunit {
 	struct shmTime *shm;	/* pointer to shared memory segment */
+	struct shm_ring *ring;	/* or to the version 2 one */
+	uint32_t tail;		/* next ring sample to read */
+	int seen;		/* ring samples read since the last tick */
 	int forall;		/* access for all UIDs?	*/
 
 	/* debugging/monitoring counters - reset when printed */
@@ -112,6 +121,7 @@ struct shmunit {
 	int notready;		/* number of peeks without data ready */
 	int bad;		/* number of invalid samples */
 	int clash;		/* number of access clashes while reading */
+	int lost;		/* ring samples overwritten before reading */
 
 	time_t max_delta;	/* difference limit */
 	time_t max_delay;	/* age/stale limit */
@@ -148,6 +158,51 @@ getShmTime(
 }
 
 
+static struct shm_ring*
+getShmRing(
+	int unit,
+	bool forall
+	)
+{
+	struct shm_ring *p;
+	int shmid;
+
+	shmid = shmget(SHM_RING_KEY + unit, sizeof(struct shm_ring),
+		       IPC_CREAT | (forall ? 0666 : 0600));
+	if (shmid == -1) {
+		msyslog(LOG_ERR, "REFCLOCK: SHM ring shmget (unit %d): %s",
+			unit, strerror(errno));
+		return NULL;
+	}
+	p = (struct shm_ring *)shmat(shmid, 0, 0);
+	if (p == (struct shm_ring *)-1) {
+		msyslog(LOG_ERR, "REFCLOCK: SHM ring shmat (unit %d): %s",
+			unit, strerror(errno));
+		return NULL;
+	}
+
+	/* A fresh segment is all zeros; whoever attaches first sets it up */
+	if (0 == p->magic) {
+		p->version = SHM_RING_VERSION;
+		p->slots = SHM_RING_SLOTS;
+		p->sample_size = sizeof(struct shm_sample);
+		p->magic = SHM_RING_MAGIC;
+	}
+	if (SHM_RING_MAGIC != p->magic || SHM_RING_VERSION != p->version ||
+	    SHM_RING_SLOTS != p->slots ||
+	    sizeof(struct shm_sample) != p->sample_size) {
+		msyslog(LOG_ERR,
+			"REFCLOCK: SHM ring (unit %d): segment layout "
+			"%#x/%u/%u/%u not understood", unit, p->magic,
+			p->version, p->slots, p->sample_size);
+		(void)shmdt((char *)p);
+		return NULL;
+	}
+
+	return p;
+}
+
+
 /*
  * shm_start - attach to shared memory
  */
@@ -167,13 +222,53 @@ shm_start(
 
 	up->forall = (unit >= 2) && !(peer->cfg.mode & SHM_MODE_PRIVATE);
 
-	up->shm = getShmTime(unit, up->forall);
-
 	/*
 	 * Initialize miscellaneous peer variables
 	 */
 	memcpy((char *)&pp->refid, REFID, REFIDLEN);
 	peer->sstclktype = CTL_SST_TS_UHF;
+
+	if (peer->cfg.mode & SHM_MODE_RING) {
+		up->ring = getShmRing(unit, up->forall);
+		if (NULL == up->ring) {
+			free(up);
+			return false;
+		}
+		pp->unitptr = up;
+		up->tail = up->ring->head;
+		peer->precision = PRECISION;
+		pp->clockname = NAME;
+		pp->clockdesc = DESCRIPTION;
+		up->max_delay = 5;
+		up->max_delta = 4 * SECSPERHR;
+
+		/*
+		 * The optional doorbell is a FIFO the producer writes to
+		 * after each sample.  Open it read-write so there is
+		 * always a writer and select() never sees end of file.
+		 */
+		if (NULL != peer->cfg.path) {
+			if (mkfifo(peer->cfg.path, up->forall ? 0666 : 0600)
+			    < 0 && EEXIST != errno)
+				msyslog(LOG_ERR, "REFCLOCK: SHM mkfifo %s: %s",
+					peer->cfg.path, strerror(errno));
+			pp->io.fd = open(peer->cfg.path,
+					 O_RDWR | O_NONBLOCK | O_CLOEXEC);
+			if (-1 == pp->io.fd) {
+				msyslog(LOG_ERR, "REFCLOCK: SHM open %s: %s",
+					peer->cfg.path, strerror(errno));
+			} else {
+				pp->io.clock_recv = shm_doorbell;
+				if (!io_addclock(&pp->io)) {
+					close(pp->io.fd);
+					pp->io.fd = -1;
+				}
+			}
+		}
+		return true;
+	}
+
+	up->shm = getShmTime(unit, up->forall);
 	if (up->shm != 0) {
 		pp->unitptr = up;
 		up->shm->precision = PRECISION;
@@ -242,7 +337,12 @@ shm_shutdown(
 		return;
 	}
 
-	(void)shmdt((char *)up->shm);
+	if (-1 != pp->io.fd)
+		io_closeclock(&pp->io);
+	if (NULL != up->ring)
+		(void)shmdt((char *)up->ring);
+	else
+		(void)shmdt((char *)up->shm);
 
 	free(up);
 }
@@ -263,6 +363,10 @@ shm_poll(
 
 	pp->polls++;
 
+	/* in ring mode, take everything up to now */
+	if (NULL != up->ring)
+		shm_drain(unit, peer);
+
 	/* get dominant reason if we have no samples at all */
 	major_error = max(up->notready, up->bad);
 	major_error = max(major_error, up->clash);
@@ -275,7 +379,8 @@ shm_poll(
 		/* have some samples, everything OK */
 		pp->lastref = pp->lastrec;
 		refclock_receive(peer);
-	} else if (NULL == up->shm) { /* is this possible at all? */
+	} else if (NULL == up->shm && NULL == up->ring) {
+		/* is this possible at all? */
 		/* we're out of business without SHM access */
 		refclock_report(peer, CEVNT_FAULT);
 	} else if (major_error == up->clash) {
@@ -305,6 +410,9 @@ struct shm_stat_t {
 	int leap;
 };
 
+static	void	shm_feed	(int unit, struct peer *peer,
+				 const struct shm_stat_t *shm_stat);
+
 static inline void memory_barrier(void) {
 #if defined(HAVE_STDATOMIC_H) && !defined(__COVERITY__)
 	atomic_thread_fence(memory_order_seq_cst);
@@ -455,15 +563,17 @@ shm_timer(
 
 	volatile struct shmTime *shm;
 
-	l_fp tsrcv;
-	l_fp tsref;
-	int c;
-	time_t tt;
-
 	enum segstat_t status;
 	struct shm_stat_t shm_stat;
 
 	up->ticks++;
+	if (NULL != up->ring) {
+		shm_drain(unit, peer);
+		if (0 == up->seen)
+			up->notready++;
+		up->seen = 0;
+		return;
+	}
 	if ((shm = up->shm) == NULL) {
 		/* try to map again - this may succeed if meanwhile some-
 		body has ipcrm'ed the old (unaccessible) shared mem segment */
@@ -513,6 +623,100 @@ shm_timer(
 	}
 
 
+	shm_feed(unit, peer, &shm_stat);
+}
+
+
+/*
+ * shm_drain - feed everything the producer has added to the ring
+ */
+static void
+shm_drain(
+	int unit,
+	struct peer *peer
+	)
+{
+	struct refclockproc * const pp = peer->procptr;
+	struct shmunit *      const up = pp->unitptr;
+	volatile struct shm_ring *ring = up->ring;
+	volatile struct shm_sample *slot;
+	struct shm_stat_t shm_stat;
+	uint32_t head, seq;
+	struct timespec now;
+
+	head = ring->head;
+	memory_barrier();
+	if (head - up->tail > SHM_RING_SLOTS) {
+		/* the producer has lapped us */
+		up->lost += (int)(head - up->tail - SHM_RING_SLOTS);
+		up->tail = head - SHM_RING_SLOTS;
+	}
+	/* not time(), which may lag the producer's clock_gettime() */
+	clock_gettime(CLOCK_REALTIME, &now);
+	for (; up->tail != head; up->tail++) {
+		slot = &ring->sample[up->tail % SHM_RING_SLOTS];
+		seq = slot->seq;
+		memory_barrier();
+		shm_stat.tvt.tv_sec = (time_t)slot->clock_sec;
+		shm_stat.tvt.tv_nsec = slot->clock_nsec;
+		shm_stat.tvr.tv_sec = (time_t)slot->recv_sec;
+		shm_stat.tvr.tv_nsec = slot->recv_nsec;
+		shm_stat.leap = slot->leap;
+		shm_stat.precision = slot->precision;
+		memory_barrier();
+		if (seq != up->tail + 1 || slot->seq != seq) {
+			/* overwritten while we were reading it */
+			up->clash++;
+			continue;
+		}
+		up->seen++;
+		if (shm_stat.tvt.tv_nsec < 0 ||
+		    shm_stat.tvt.tv_nsec >= NS_PER_S ||
+		    shm_stat.tvr.tv_nsec < 0 ||
+		    shm_stat.tvr.tv_nsec >= NS_PER_S) {
+			up->bad++;
+			continue;
+		}
+		shm_stat.status = OK;
+		shm_stat.mode = SHM_RING_VERSION;
+		shm_stat.tvc = now;
+		shm_feed(unit, peer, &shm_stat);
+	}
+}
+
+
+/*
+ * shm_doorbell - the producer says there is something in the ring
+ */
+static void
+shm_doorbell(
+	struct recvbuf *rbufp
+	)
+{
+	struct peer * const peer = rbufp->recv_peer;
+
+	shm_drain(peer->procptr->refclkunit, peer);
+}
+
+
+/*
+ * shm_feed - sanity check a sample and put it in the median filter
+ */
+static void
+shm_feed(
+	int unit,
+	struct peer *peer,
+	const struct shm_stat_t *shm_stat
+	)
+{
+	struct refclockproc * const pp = peer->procptr;
+	struct shmunit *      const up = pp->unitptr;
+
+	l_fp tsrcv;
+	l_fp tsref;
+	int c;
+	time_t tt;
+
 	/*
 	 * Add POSIX UTC seconds and fractional seconds as a timecode.
 	 * We used to unpack this to calendar time, but it is bad
@@ -521,11 +725,11 @@ shm_timer(
 	 */
 	/* a_lastcode is seen as timecode with: ntpq -c cv [associd] */
 	c = snprintf(pp->a_lastcode, sizeof(pp->a_lastcode), "%ld.%09ld",
-		     (long)shm_stat.tvt.tv_sec, (long)shm_stat.tvt.tv_nsec);
+		     (long)shm_stat->tvt.tv_sec, (long)shm_stat->tvt.tv_nsec);
 	pp->lencode = (c < (int)sizeof(pp->a_lastcode)) ? c : 0;
 
 	/* check 1: age control of local time stamp */
-	tt = shm_stat.tvc.tv_sec - shm_stat.tvr.tv_sec;
+	tt = shm_stat->tvc.tv_sec - shm_stat->tvr.tv_sec;
 	if (tt < 0 || tt > up->max_delay) {
 		DPRINT(1, ("%s:SHM(%d) stale/bad receive time, delay=%llds\n",
 			   refclock_name(peer), unit, (long long)tt));
@@ -537,7 +741,7 @@ shm_timer(
 	}
 
 	/* check 2: delta check */
-	tt = shm_stat.tvr.tv_sec - shm_stat.tvt.tv_sec - (shm_stat.tvr.tv_nsec < shm_stat.tvt.tv_nsec);
+	tt = shm_stat->tvr.tv_sec - shm_stat->tvt.tv_sec - (shm_stat->tvr.tv_nsec < shm_stat->tvt.tv_nsec);
 	if (tt < 0) {
 		tt = -tt;
 	}
@@ -553,10 +757,10 @@ shm_timer(
 
 	/* if we really made it to this point... we're winners! */
 	DPRINT(2, ("%s: SHM(%d) feeding data\n", refclock_name(peer), unit));
-	tsrcv = tspec_stamp_to_lfp(shm_stat.tvr);
-	tsref = tspec_stamp_to_lfp(shm_stat.tvt);
-	pp->leap = (uint8_t)shm_stat.leap;
-	peer->precision = (int8_t)shm_stat.precision;
+	tsrcv = tspec_stamp_to_lfp(shm_stat->tvr);
+	tsref = tspec_stamp_to_lfp(shm_stat->tvt);
+	pp->leap = (uint8_t)shm_stat->leap;
+	peer->precision = (int8_t)shm_stat->precision;
 	refclock_process_offset(pp, tsref, tsrcv, pp->fudgetime1);
 	up->good++;
 }
@@ -574,11 +778,18 @@ static void shm_clockstats(
 
 	UNUSED_ARG(unit);
 	if (pp->sloppyclockflag & CLK_FLAG4) {
-		mprintf_clock_stats(
-			peer, "%3d %3d %3d %3d %3d",
-			up->ticks, up->good, up->notready,
-			up->bad, up->clash);
+		if (NULL != up->ring)
+			mprintf_clock_stats(
+				peer, "%3d %3d %3d %3d %3d %3d",
+				up->ticks, up->good, up->notready,
+				up->bad, up->clash, up->lost);
+		else
+			mprintf_clock_stats(
+				peer, "%3d %3d %3d %3d %3d",
+				up->ticks, up->good, up->notready,
+				up->bad, up->clash);
 	}
 	up->ticks = up->good = up->notready = up->bad = up->clash = 0;
+	up->lost = 0;
 }
 
@@ -517,6 +517,7 @@ trimble_start (
 	pp->io.srcclock = peer;
 	pp->io.datalen = 0;
 	pp->io.fd = fd;
+	pp->io.chartime = refclock_chartime(desired_speed);
 	if (!io_addclock(&pp->io)) {
 		msyslog(LOG_ERR, "%s io_addclock failed", refclock_name(peer));
 		close(fd);
@@ -1137,8 +1138,6 @@ trimble_io (
 				up->rpt_status = TSIP_PARSED_DATA;
 				/* save packet ID */
 				up->rpt_buf[0] = *c;
-				/* save packet receive time */
-				up->p_recv_time = rbufp->recv_time;
 				break;
 			}
 			break;
@@ -1169,6 +1168,10 @@ trimble_io (
 				mb(up->rpt_cnt++) = *c;
 			} else if (*c == ETX) {
 				up->rpt_status = TSIP_PARSED_FULL;
+				/* save packet receive time, when the ETX
+				 * came in rather than when it was read */
+				up->p_recv_time = refclock_bytetime(&pp->io,
+					rbufp->recv_time, (size_t)(d - c) - 1);
 				trimble_receive(peer, MSG_TSIP);
 			} else {
 				/* error: start new report packet */
@@ -1181,6 +1184,8 @@ trimble_io (
 			if (*c == '\n') {
 				mb(up->rpt_cnt++) = *c;
 				up->rpt_status = TSIP_PARSED_FULL;
+				up->p_recv_time = refclock_bytetime(&pp->io,
+					rbufp->recv_time, (size_t)(d - c) - 1);
 				trimble_receive(peer, MSG_PRAECIS);
 			} else if (up->parity_chk && *c == '\377') {
 				up->rpt_status = TSIP_PARSED_PARITY;
@@ -0,0 +1,177 @@
+# -*- coding: utf-8 -*-
+
+"""
+shmstats.py - read the statistics ntpd keeps in shared memory
+
+With "enable shmstats", ntpd refreshes a POSIX shared-memory object
+once a second with its system, I/O, protocol, MRU, NTS and
+per-association counters.  Reading it costs ntpd nothing, unlike
+asking it over mode 6.  include/ntp_shmstats.h describes the layout;
+keep SYS_FIELDS and PEER_FIELDS in step with it.
+
+    stats = ntp.shmstats.ShmStats()
+    (system, peers) = stats.read()
+    print(system["offset"], [p["address"] for p in peers])
+"""
+# SPDX-License-Identifier: BSD-2-Clause
+from __future__ import print_function, division
+
+import mmap
+import os
+import struct
+import time
+
+try:
+    import _posixshmem
+except ImportError:
+    _posixshmem = None
+
+SHMSTATS_NAME = "/ntpd-stats"
+SHMSTATS_MAGIC = 0x4e545354
+SHMSTATS_VERSION = 1
+
+# magic, version, head_size, sys_size, peer_size, peer_slots, seq,
+# peer_count, time
+HEAD = struct.Struct("=8Iq")
+
+# In order.  q and Q are 8 bytes, so is d; nothing needs padding.
+SYS_FIELDS = (
+    ("uptime", "Q"), ("stratum", "q"), ("leap", "q"), ("precision", "q"),
+    ("rootdelay", "d"), ("rootdisp", "d"), ("rootdist", "d"),
+    ("sys_peer", "Q"), ("associations", "Q"),
+    ("offset", "d"), ("sys_jitter", "d"), ("clock_jitter", "d"),
+    ("frequency", "d"), ("wander", "d"), ("tc", "q"),
+    ("proto_received", "Q"), ("proto_processed", "Q"),
+    ("proto_restricted", "Q"), ("proto_newversion", "Q"),
+    ("proto_oldversion", "Q"), ("proto_badlength", "Q"),
+    ("proto_badauth", "Q"), ("proto_declined", "Q"),
+    ("proto_limited", "Q"), ("proto_kodsent", "Q"),
+    ("io_received", "Q"), ("io_dropped", "Q"), ("io_ignored", "Q"),
+    ("io_sent", "Q"), ("io_sendfailed", "Q"), ("io_wakeups", "Q"),
+    ("io_goodwakeups", "Q"),
+    ("mru_entries", "Q"), ("mru_peak_entries", "Q"),
+    ("mru_hash_slots", "Q"), ("mru_max_entries", "Q"), ("mru_bytes", "Q"),
+    ("mru_oldest_age", "q"), ("mru_exists", "Q"), ("mru_new", "Q"),
+    ("mru_recycleold", "Q"), ("mru_recyclefull", "Q"), ("mru_none", "Q"),
+    ("nts_client_send", "Q"), ("nts_client_recv_good", "Q"),
+    ("nts_client_recv_bad", "Q"), ("nts_server_send", "Q"),
+    ("nts_server_recv_good", "Q"), ("nts_server_recv_bad", "Q"),
+    ("nts_cookie_make", "Q"), ("nts_cookie_decode", "Q"),
+    ("nts_cookie_decode_old", "Q"), ("nts_cookie_decode_too_old", "Q"),
+    ("nts_cookie_decode_error", "Q"), ("nts_ke_serves_good", "Q"),
+    ("nts_ke_serves_bad", "Q"), ("nts_ke_probes_good", "Q"),
+    ("nts_ke_probes_bad", "Q"),
+)
+
+PEER_FIELDS = (
+    ("address", "64s"), ("name", "64s"), ("assoc", "Q"), ("stratum", "q"),
+    ("reach", "Q"), ("poll", "q"), ("selection", "Q"),
+    ("offset", "d"), ("delay", "d"), ("disp", "d"), ("jitter", "d"),
+    ("sent", "Q"), ("received", "Q"), ("processed", "Q"),
+    ("badauth", "Q"),
+)
+
+
+class ShmStatsError(Exception):
+    pass
+
+
+class _Layout:
+    "One of the structures, cut down to the part the writer has."
+
+    def __init__(self, fields, size):
+        self.names = []
+        fmt = "="
+        for (name, code) in fields:
+            if struct.calcsize(fmt + code) > size:
+                break   # an older ntpd, without this one
+            fmt += code
+            self.names.append(name)
+        self.struct = struct.Struct(fmt)
+
+    def unpack(self, buf, offset):
+        values = dict(zip(self.names, self.struct.unpack_from(buf, offset)))
+        for (name, value) in values.items():
+            if isinstance(value, bytes):
+                values[name] = value.split(b"\0", 1)[0].decode(
+                    "ascii", "replace")
+        return values
+
+
+class ShmStats:
+    """Reader for ntpd's statistics segment.
+
+    name is the shared-memory object, path a file holding a copy of
+    one, which is mostly useful for testing.
+    """
+
+    WAIT = 1.0      # seconds to wait for ntpd to finish an update
+    SPINS = 16      # yields before sleeping between reads
+
+    def __init__(self, name=SHMSTATS_NAME, path=None):
+        if path is not None:
+            fd = os.open(path, os.O_RDONLY)
+        elif _posixshmem is not None:
+            fd = _posixshmem.shm_open(name, os.O_RDONLY, 0)
+        else:
+            fd = os.open("/dev/shm" + name, os.O_RDONLY)
+        try:
+            self.map = mmap.mmap(fd, 0, mmap.MAP_SHARED, mmap.PROT_READ)
+        finally:
+            os.close(fd)
+        if len(self.map) < HEAD.size:
+            raise ShmStatsError("segment is too short")
+        (magic, version, self.head_size, self.sys_size, self.peer_size,
+         self.peer_slots) = HEAD.unpack_from(self.map, 0)[:6]
+        if magic != SHMSTATS_MAGIC:
+            raise ShmStatsError("not an ntpd statistics segment")
+        if version != SHMSTATS_VERSION:
+            raise ShmStatsError("segment version %d, not %d"
+                                % (version, SHMSTATS_VERSION))
+        if (self.head_size + self.sys_size
+                + self.peer_slots * self.peer_size) > len(self.map):
+            raise ShmStatsError("segment is too short")
+        self.sys = _Layout(SYS_FIELDS, self.sys_size)
+        self.peer = _Layout(PEER_FIELDS, self.peer_size)
+        self.time = 0
+
+    def close(self):
+        self.map.close()
+
+    def _seq(self):
+        return HEAD.unpack_from(self.map, 0)[6]
+
+    def read(self):
+        """Return a consistent (system, peers) pair of a dict and a
+        list of dicts, as of the last update.  self.time is when that
+        was, in POSIX seconds; if it is more than a few seconds old,
+        ntpd has stopped.  ShmStatsError means ntpd was in the middle
+        of an update for all of self.WAIT seconds."""
+        clock = getattr(time, "monotonic", time.time)
+        deadline = clock() + self.WAIT
+        tries = 0
+        while True:
+            if tries > 0:
+                if clock() >= deadline:
+                    break
+                time.sleep(0 if tries < self.SPINS else 0.0001)
+            tries += 1
+            seq = self._seq()
+            if seq & 1:
+                continue
+            # copy first, decode after, to keep the window small
+            buf = self.map[:]
+            head = HEAD.unpack_from(buf, 0)
+            if self._seq() != seq or head[6] != seq:
+                continue
+            count = min(head[7], self.peer_slots)
+            self.time = head[8]
+            system = self.sys.unpack(buf, self.head_size)
+            base = self.head_size + self.sys_size
+            peers = [self.peer.unpack(buf, base + i * self.peer_size)
+                     for i in range(count)]
+            return (system, peers)
+        raise ShmStatsError("ntpd didn't finish an update in %g s"
+                            % self.WAIT)
+
+# end
@@ -79,7 +79,8 @@ MS_VARS = ("rootdelay", "rootdisp", "rootdist", "offset", "sys_jitter",
            "clk_jitter", "leapsmearoffset", "authdelay", "koffset", "kmaxerr",
            "kesterr", "kprecis", "kppsjitter", "fuzz", "clk_wander_threshold",
            "tick", "in", "out", "bias", "delay", "jitter", "dispersion",
-           "fudgetime1", "fudgetime2")
+           "fudgetime1", "fudgetime2", "txs_mean", "txs_avg", "txs_max",
+           "txs_auth_mean", "txs_auth_avg", "txs_auth_max")
 PPM_VARS = ("frequency", "clk_wander")
 
 
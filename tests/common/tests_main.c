@@ -53,6 +53,7 @@ static void RunAllTests(void)
 	RUN_TEST_GROUP(prettydate);
 	RUN_TEST_GROUP(random);
 	RUN_TEST_GROUP(refidsmear);
+	RUN_TEST_GROUP(shmstats);
 	RUN_TEST_GROUP(socktoa);
 	RUN_TEST_GROUP(statestr);
 	RUN_TEST_GROUP(strtolfp);
@@ -71,6 +72,7 @@ static void RunAllTests(void)
 	RUN_TEST_GROUP(leapsec);
 	RUN_TEST_GROUP(hackrestrict);
 	RUN_TEST_GROUP(recvbuff);
+	RUN_TEST_GROUP(select);
 #ifndef DISABLE_NTS
 	RUN_TEST_GROUP(nts);
 	RUN_TEST_GROUP(nts_client);
@@ -85,7 +87,6 @@ static void RunAllTests(void)
 
 int main(int argc, const char * argv[]) {
 
-	getbuf_init();
 	ssl_init();
 	auth_init();
 	init_network();
@@ -130,6 +130,35 @@ TEST(lfptostr, UnsignedInteger) {
 	TEST_ASSERT_EQUAL_STRING("3660323067.1125955647", ulfptoa(test9, 10));
 }
 
+TEST(lfptostr, CallerBuffer) {
+	l_fp test = lfpinit(-100, ONE_FOURTH); // -99.75
+	char buf[16], small[5];
+
+	TEST_ASSERT_EQUAL_STRING("-99.7500000000",
+		lfptoa_r(test, LFP_MAX_PRECISION, buf, sizeof(buf)));
+	TEST_ASSERT_EQUAL_STRING("-99750.0000000",
+		lfptoms_r(test, LFP_MAX_PRECISION_MS, buf, sizeof(buf)));
+	TEST_ASSERT_EQUAL_STRING("3000000.500",
+		ulfptoa_r(lfpinit(3000000, HALF), 3, buf, sizeof(buf)));
+
+	/* cut short to fit */
+	TEST_ASSERT_EQUAL_STRING("-99.", lfptoa_r(test, 2, small, sizeof(small)));
+	TEST_ASSERT_EQUAL_STRING("-99", lfptoa_r(test, 2, small, 4));
+}
+
+TEST(lfptostr, RoundingCarries) {
+	l_fp test = lfpinit_u(UINT32_MAX, UINT32_MAX); // just under 2^32
+
+	TEST_ASSERT_EQUAL_STRING("4294967295.99999999976717", ulfptoa(test, 14));
+	TEST_ASSERT_EQUAL_STRING("4294967296.000000000", ulfptoa(test, 9));
+	TEST_ASSERT_EQUAL_STRING("4294967296", ulfptoa(test, 0));
+	TEST_ASSERT_EQUAL_STRING("4294967296000.000000", ulfptoms(test, 6));
+	TEST_ASSERT_EQUAL_STRING("0.99999999906868", ulfptoa(lfpinit(0, 0xfffffffcU), 14));
+	TEST_ASSERT_EQUAL_STRING("1.000", ulfptoa(lfpinit(0, 0xfffffffcU), 3));
+	TEST_ASSERT_EQUAL_STRING("999.9999991", ulfptoms(lfpinit(0, 0xfffffffcU), 7));
+	TEST_ASSERT_EQUAL_STRING("-0.000", lfptoa(lfpinit(-1, UINT32_MAX), 3));
+}
+
 TEST_GROUP_RUNNER(lfptostr) {
 	RUN_TEST_CASE(lfptostr, PositiveInteger);
 	RUN_TEST_CASE(lfptostr, NegativeInteger);
@@ -142,4 +171,6 @@ TEST_GROUP_RUNNER(lfptostr) {
 	RUN_TEST_CASE(lfptostr, MillisecondsRoundingUp);
 	RUN_TEST_CASE(lfptostr, MillisecondsRoundingDown);
 	RUN_TEST_CASE(lfptostr, UnsignedInteger);
+	RUN_TEST_CASE(lfptostr, CallerBuffer);
+	RUN_TEST_CASE(lfptostr, RoundingCarries);
 }
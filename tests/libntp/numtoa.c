@@ -22,6 +22,20 @@ TEST(numtoa, RefidStr) {
 	TEST_ASSERT_EQUAL_STRING(".GPS.", res);
 }
 
+TEST(numtoa, RefidStrCallerBuffer) {
+	char buf[16];
+
+	TEST_ASSERT_EQUAL_STRING("68.51.34.17",
+		refid_str_r(htonl(0x44332211), 8, buf, sizeof(buf)));
+	TEST_ASSERT_EQUAL_STRING(".GPS.",
+		refid_str_r(htonl(0x47505300), 0, buf, sizeof(buf)));
+	TEST_ASSERT_EQUAL_STRING(".GP",
+		refid_str_r(htonl(0x47505300), 0, buf, 4));
+	TEST_ASSERT_EQUAL_STRING("68.51",
+		refid_str_r(htonl(0x44332211), 8, buf, 6));
+}
+
 TEST_GROUP_RUNNER(numtoa) {
 	RUN_TEST_CASE(numtoa, RefidStr);
+	RUN_TEST_CASE(numtoa, RefidStrCallerBuffer);
 }
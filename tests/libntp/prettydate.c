@@ -29,8 +29,23 @@ TEST(prettydate, ConstantDate) {
 	TEST_ASSERT_EQUAL_STRING("cfba1ce0.80000000 2010-06-09T14:00:00.500Z", prettydate(t));
 }
 
+TEST(prettydate, CallerBuffer) {
+	l_fp t = lfpinit((int32_t)3485080800LL, HALF); // 2010-06-09 14:00:00.5
+	char buf[64];
+
+	TEST_ASSERT_EQUAL_STRING("cfba1ce0.80000000 2010-06-09T14:00:00.500Z",
+				 prettydate_r(t, buf, sizeof(buf)));
+	TEST_ASSERT_EQUAL_STRING("2010-06-09T14:00:00.500Z",
+				 rfc3339date_r(t, buf, sizeof(buf)));
+	TEST_ASSERT_EQUAL_STRING("1970-01-01T00:00Z",
+				 rfc3339time_r(0, buf, sizeof(buf)));
+	TEST_ASSERT_EQUAL_STRING("cfba1ce0.80000000 2010",
+				 prettydate_r(t, buf, 23));
+}
+
 TEST_GROUP_RUNNER(prettydate) {
 	RUN_TEST_CASE(prettydate, ConstantDate);
 	RUN_TEST_CASE(prettydate, Rfc3339Date1);
 	RUN_TEST_CASE(prettydate, Rfc3339Time1);
+	RUN_TEST_CASE(prettydate, CallerBuffer);
 }
@@ -0,0 +1,131 @@
+#include "config.h"
+#include "ntp_stdlib.h"
+#include "ntp_shmstats.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "unity.h"
+#include "unity_fixture.h"
+
+TEST_GROUP(shmstats);
+
+static char name[64];
+static struct shmstats writer;
+
+TEST_SETUP(shmstats) {
+	snprintf(name, sizeof(name), "/ntpd-stats-test-%d", (int)getpid());
+	TEST_ASSERT_TRUE(shmstats_create(&writer, name));
+}
+
+TEST_TEAR_DOWN(shmstats) {
+	shmstats_remove(&writer, name);
+}
+
+
+TEST(shmstats, RoundTrip) {
+	struct shmstats reader;
+	struct shmstats_head head;
+	struct shmstats_sys sys;
+	struct shmstats_peer peers[4];
+	int n = 4;
+
+	shmstats_begin(&writer);
+	writer.sys->stratum = 2;
+	writer.sys->offset = -0.125;
+	writer.sys->nts_ke_probes_bad = UINT64_MAX;
+	for (int i = 0; i < 6; i++) {
+		snprintf(SHMSTATS_PEER(&writer, i)->address,
+			 sizeof(peers[0].address), "192.0.2.%d", i);
+		SHMSTATS_PEER(&writer, i)->assoc = 100U + (unsigned)i;
+	}
+	writer.head->peer_count = 6;
+	writer.head->time = 1700000000;
+	shmstats_end(&writer);
+
+	TEST_ASSERT_TRUE(shmstats_open(&reader, name));
+	TEST_ASSERT_TRUE(shmstats_read(&reader, &head, &sys, peers, &n));
+	TEST_ASSERT_EQUAL(SHMSTATS_PEERS, head.peer_slots);
+	TEST_ASSERT_EQUAL(6, head.peer_count);
+	TEST_ASSERT_EQUAL(1700000000, head.time);
+	TEST_ASSERT_EQUAL(0, head.seq & 1);
+	TEST_ASSERT_EQUAL(2, sys.stratum);
+	TEST_ASSERT_EQUAL_DOUBLE(-0.125, sys.offset);
+	TEST_ASSERT_TRUE(UINT64_MAX == sys.nts_ke_probes_bad);
+	/* only as many as there is room for */
+	TEST_ASSERT_EQUAL(4, n);
+	TEST_ASSERT_EQUAL_STRING("192.0.2.3", peers[3].address);
+	TEST_ASSERT_EQUAL(103, peers[3].assoc);
+	shmstats_close(&reader);
+}
+
+TEST(shmstats, NotThere) {
+	struct shmstats reader;
+
+	TEST_ASSERT_FALSE(shmstats_open(&reader, "/ntpd-stats-test-none"));
+	TEST_ASSERT_EQUAL(ENOENT, errno);
+}
+
+TEST(shmstats, WriterMidUpdate) {
+	struct shmstats reader;
+	struct shmstats_sys sys;
+
+	TEST_ASSERT_TRUE(shmstats_open(&reader, name));
+	shmstats_begin(&writer);
+	TEST_ASSERT_FALSE(shmstats_read(&reader, NULL, &sys, NULL, NULL));
+	TEST_ASSERT_EQUAL(EAGAIN, errno);
+	shmstats_end(&writer);
+	TEST_ASSERT_TRUE(shmstats_read(&reader, NULL, &sys, NULL, NULL));
+	shmstats_close(&reader);
+}
+
+#define UPDATES	200000
+
+static void *
+Scribble(void *arg) {
+	UNUSED_ARG(arg);
+	for (uint64_t i = 1; i <= UPDATES; i++) {
+		shmstats_begin(&writer);
+		writer.sys->io_sent = i;
+		writer.sys->io_received = i;
+		SHMSTATS_PEER(&writer, 0)->sent = i;
+		writer.head->peer_count = 1;
+		shmstats_end(&writer);
+	}
+	return NULL;
+}
+
+/* every copy a reader gets must be from a single update */
+TEST(shmstats, NeverTorn) {
+	struct shmstats reader;
+	struct shmstats_sys sys;
+	struct shmstats_peer peer;
+	pthread_t scribbler;
+	int n, reads = 0;
+	bool ok = true;
+
+	sys.io_sent = 0;
+	TEST_ASSERT_TRUE(shmstats_open(&reader, name));
+	TEST_ASSERT_EQUAL(0, pthread_create(&scribbler, NULL, Scribble, NULL));
+	do {
+		n = 1;
+		if (!shmstats_read(&reader, NULL, &sys, &peer, &n))
+			continue;
+		reads++;
+		if (sys.io_sent != sys.io_received ||
+		    (1 == n && peer.sent != sys.io_sent))
+			ok = false;
+	} while (sys.io_sent < UPDATES);
+	pthread_join(scribbler, NULL);
+	TEST_ASSERT_TRUE(ok);
+	TEST_ASSERT_TRUE(reads > 0);
+	shmstats_close(&reader);
+}
+
+TEST_GROUP_RUNNER(shmstats) {
+	RUN_TEST_CASE(shmstats, RoundTrip);
+	RUN_TEST_CASE(shmstats, NotThere);
+	RUN_TEST_CASE(shmstats, WriterMidUpdate);
+	RUN_TEST_CASE(shmstats, NeverTorn);
+}
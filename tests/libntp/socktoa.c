@@ -1,6 +1,8 @@
 #include "config.h"
 #include "ntp_stdlib.h"
 
+#include <pthread.h>
+
 #include "unity.h"
 #include "unity_fixture.h"
 
@@ -67,6 +69,52 @@ TEST(socktoa, ScopedIPv6AddressWithPort) {
 	TEST_ASSERT_EQUAL_STRING(expected_port, sockporttoa(&input));
 }
 
+/* zero runs and embedded IPv4, as inet_ntop() writes them */
+TEST(socktoa, IPv6Forms) {
+	static const struct {
+		const char *in;
+		const char *out;
+	} cases[] = {
+		{ "::", "::" },
+		{ "::1", "::1" },
+		{ "1::", "1::" },
+		{ "1:0:0:2::3", "1:0:0:2::3" },
+		{ "1:0:2:0:0:3:0:4", "1:0:2::3:0:4" },
+		{ "1:0:2:3:4:5:6:0", "1:0:2:3:4:5:6:0" },
+		{ "0:0:1:0:0:0:0:2", "0:0:1::2" },
+		{ "2001:DB8:0:0:0:0:0:FFFF", "2001:db8::ffff" },
+		{ "::ffff:192.0.2.1", "::ffff:192.0.2.1" },
+		{ "::192.0.2.1", "::192.0.2.1" },
+		{ "::0.0.0.1", "::1" },
+		{ "::1:ffff:192.0.2.1", "::1:ffff:c000:201" },
+	};
+	sockaddr_u input;
+	char buf[64];
+
+	for (size_t i = 0; i < COUNTOF(cases); i++) {
+		memset(&input, 0, sizeof(input));
+		AF(&input) = AF_INET6;
+		TEST_ASSERT_EQUAL(1, inet_pton(AF_INET6, cases[i].in,
+					       PSOCK_ADDR6(&input)));
+		TEST_ASSERT_EQUAL_STRING(cases[i].out, socktoa(&input));
+		snprintf(buf, sizeof(buf), "[%s]:123", cases[i].out);
+		SET_PORT(&input, 123);
+		TEST_ASSERT_EQUAL_STRING(buf, sockporttoa(&input));
+	}
+}
+
+TEST(socktoa, CallerBuffer) {
+	sockaddr_u input = CreateSockaddr4("192.0.2.10", 123);
+	char small[8];
+
+	TEST_ASSERT_EQUAL_STRING("192.0.2", socktoa_r(&input, small, sizeof(small)));
+	TEST_ASSERT_EQUAL_STRING("192.0.2", sockporttoa_r(&input, small, sizeof(small)));
+	AF(&input) = 99;
+	TEST_ASSERT_EQUAL_STRING("(socktoa unknown family 99)", socktoa(&input));
+	TEST_ASSERT_EQUAL_STRING("(socktoa unknown family 99):123",
+				 sockporttoa(&input));
+}
+
 TEST(socktoa, HashEqual) {
 	sockaddr_u input1 = CreateSockaddr4("192.00.2.2", 123);
 	sockaddr_u input2 = CreateSockaddr4("192.0.2.2", 123);
@@ -107,11 +155,38 @@ TEST(socktoa, IgnoreIPv6Fields) {
 	TEST_ASSERT_EQUAL(sock_hash(&input1), sock_hash(&input2));
 }
 
+/* another thread's strings don't disturb ours */
+static void *
+FormatMany(void *arg) {
+	sockaddr_u input = CreateSockaddr4("198.51.100.7", 123);
+	const char *res = NULL;
+
+	for (int i = 0; i < 100; i++)
+		res = socktoa(&input);
+	*(bool *)arg = (0 == strcmp("198.51.100.7", res));
+	return NULL;
+}
+
+TEST(socktoa, RingPerThread) {
+	sockaddr_u input = CreateSockaddr4("192.0.2.10", 123);
+	const char *res = socktoa(&input);
+	pthread_t worker;
+	bool ok = false;
+
+	TEST_ASSERT_EQUAL(0, pthread_create(&worker, NULL, FormatMany, &ok));
+	pthread_join(worker, NULL);
+	TEST_ASSERT_TRUE(ok);
+	TEST_ASSERT_EQUAL_STRING("192.0.2.10", res);
+}
+
 TEST_GROUP_RUNNER(socktoa) {
 	RUN_TEST_CASE(socktoa, IPv4AddressWithPort);
 	RUN_TEST_CASE(socktoa, IPv6AddressWithPort);
 	RUN_TEST_CASE(socktoa, ScopedIPv6AddressWithPort);
+	RUN_TEST_CASE(socktoa, IPv6Forms);
+	RUN_TEST_CASE(socktoa, CallerBuffer);
 	RUN_TEST_CASE(socktoa, HashEqual);
 	RUN_TEST_CASE(socktoa, HashNotEqual);
 	RUN_TEST_CASE(socktoa, IgnoreIPv6Fields);
+	RUN_TEST_CASE(socktoa, RingPerThread);
 }
@@ -0,0 +1,363 @@
+#include "config.h"
+#include "ntpd.h"
+#include "ntp_stdlib.h"
+
+#include "unity.h"
+#include "unity_fixture.h"
+
+/*
+ * Replay candidate lists through select_intersect() and
+ * select_cluster() and check they pick exactly what the original
+ * quadratic code in clock_select() did.  The first lists were
+ * recorded from an ntpd with 23 servers; the rest are generated,
+ * with falsetickers, up to a few hundred candidates.
+ */
+
+TEST_GROUP(select);
+
+TEST_SETUP(select) {}
+
+TEST_TEAR_DOWN(select) {}
+
+
+struct cand {
+	double	offset;
+	double	error;
+	double	synch;
+	int	flags;
+};
+
+static const struct cand recorded1[] = {
+	{ 5.960464478e-08, 3.205674994e-05, 1.000000000e-03, 0 },
+	{ 2.494361252e-05, 3.111859303e-05, 1.000000000e-03, 0 },
+	{ 1.848791726e-06, 2.582378762e-05, 1.000000000e-03, 0 },
+};
+
+static const struct cand recorded2[] = {
+	{ 4.041939974e-07, 2.697743808e-05, 1.000000000e-03, 0 },
+	{ 4.150206223e-07, 2.387109955e-05, 1.000000000e-03, 0 },
+	{ 1.683365554e-07, 7.371087450e-06, 1.000000000e-03, 0 },
+	{ -5.690380931e-07, 6.737622298e-06, 1.000000000e-03, 0 },
+	{ 2.917845268e-05, 2.630033007e-05, 1.000000000e-03, 0 },
+	{ -4.400499165e-08, 2.775731906e-05, 1.000000000e-03, 0 },
+	{ 1.835869625e-06, 6.425702801e-06, 1.000000000e-03, 0 },
+	{ 2.272485290e-05, 2.482848520e-05, 1.000000000e-03, 0 },
+	{ -1.318869181e-06, 2.593336905e-05, 1.000000000e-03, 0 },
+};
+
+static const struct cand recorded3[] = {
+	{ 6.866175681e-07, 1.183250380e-05, 1.000000000e-03, 0 },
+	{ -6.553018466e-07, 1.776328517e-05, 1.000000000e-03, 0 },
+	{ -3.238674253e-07, 1.048140103e-06, 1.000000000e-03, 0 },
+	{ 2.854131162e-05, 2.409018176e-05, 1.000000000e-03, 0 },
+	{ 1.028296538e-06, 4.563538653e-07, 1.000000000e-03, 0 },
+	{ 8.105998859e-07, 6.843489691e-07, 1.000000000e-03, 0 },
+	{ 9.245704859e-07, 1.350048747e-05, 1.000000000e-03, 0 },
+	{ -2.109678462e-06, 1.738595809e-05, 1.000000000e-03, 0 },
+	{ 2.433010377e-05, 2.453829379e-05, 1.000000000e-03, 0 },
+	{ 2.676970325e-06, 1.873360832e-06, 1.000000000e-03, 0 },
+	{ 2.527725883e-06, 1.437839005e-05, 1.000000000e-03, 0 },
+	{ 3.289221786e-05, 3.223176278e-05, 1.000000000e-03, 0 },
+	{ 2.211891115e-06, 8.080241686e-06, 1.000000000e-03, 0 },
+	{ 7.502967492e-07, 1.673396576e-05, 1.000000000e-03, 0 },
+	{ 2.770172432e-05, 2.300201747e-05, 1.000000000e-03, 0 },
+	{ 1.752516255e-06, 1.501216042e-05, 1.000000000e-03, 0 },
+	{ 9.086215869e-07, 3.273097418e-06, 1.000000000e-03, 0 },
+	{ 1.840875484e-06, 1.201077435e-05, 1.000000000e-03, 0 },
+	{ 2.029235475e-06, 8.030422337e-06, 1.000000000e-03, 0 },
+	{ 2.583255991e-07, 1.246752217e-05, 1.000000000e-03, 0 },
+	{ -1.811888069e-06, 2.128056292e-05, 1.000000000e-03, 0 },
+	{ -1.112697646e-06, 3.002786006e-06, 1.000000000e-03, 0 },
+	{ -1.111999154e-06, 1.962678460e-06, 1.000000000e-03, 0 },
+};
+
+/*
+ * The original algorithms, as they were in clock_select().
+ */
+static void
+ref_intersect(
+	struct endpoint *endpoint,
+	int		nlist,
+	double *	lowp,
+	double *	highp
+	)
+{
+	struct endpoint endp;
+	int	nl2 = 2 * nlist;
+	int *	indx = calloc((size_t)nl2 + 1, sizeof(int));
+	int	allow, i, j, k, n;
+	double	e, high = -1e9, low = 1e9;
+
+	for (i = 0; i < nl2; i++)
+		indx[i] = i;
+	for (i = 0; i < nl2; i++) {
+		endp = endpoint[indx[i]];
+		e = endp.val;
+		k = i;
+		for (j = i + 1; j < nl2; j++) {
+			endp = endpoint[indx[j]];
+			if (endp.val < e) {
+				e = endp.val;
+				k = j;
+			}
+		}
+		if (k != i) {
+			j = indx[k];
+			indx[k] = indx[i];
+			indx[i] = j;
+		}
+	}
+	for (allow = 0; 2 * allow < nlist; allow++) {
+		n = 0;
+		for (i = 0; i < nl2; i++) {
+			low = endpoint[indx[i]].val;
+			n -= endpoint[indx[i]].type;
+			if (n >= nlist - allow)
+				break;
+		}
+		n = 0;
+		for (j = nl2 - 1; j >= 0; j--) {
+			high = endpoint[indx[j]].val;
+			n += endpoint[indx[j]].type;
+			if (n >= nlist - allow)
+				break;
+		}
+		if (high > low)
+			break;
+	}
+	free(indx);
+	*lowp = low;
+	*highp = high;
+}
+
+static int
+ref_cluster(
+	peer_select *	peers,
+	int		nlist,
+	int		minclock,
+	int		maxclock
+	)
+{
+	double	d, e, f, g;
+	int	i, j, k;
+
+	while (1) {
+		d = 1e9;
+		e = -1e9;
+		g = 0;
+		k = 0;
+		for (i = 0; i < nlist; i++) {
+			if (peers[i].error < d)
+				d = peers[i].error;
+			peers[i].seljit = 0;
+			if (nlist > 1) {
+				f = 0;
+				for (j = 0; j < nlist; j++)
+					f += SQUARE(peers[j].peer->offset -
+						    peers[i].peer->offset);
+				peers[i].seljit = SQRT(f / (nlist - 1));
+			}
+			if (peers[i].seljit * peers[i].synch > e) {
+				g = peers[i].seljit;
+				e = peers[i].seljit * peers[i].synch;
+				k = i;
+			}
+		}
+		if (nlist <= max(1, minclock) || g <= d ||
+		    ((FLAG_TRUE | FLAG_PREFER) & peers[k].peer->cfg.flags))
+			break;
+		if (nlist > maxclock)
+			peers[k].peer->new_status = CTL_PST_SEL_EXCESS;
+		for (j = k + 1; j < nlist; j++)
+			peers[j - 1] = peers[j];
+		nlist--;
+	}
+	return nlist;
+}
+
+
+#define	MINCLOCK	3	/* ntpd defaults */
+#define	MAXCLOCK	10
+
+static struct select_list sl;
+
+/*
+ * Load the candidates, run the intersection, keep the truechimers
+ * the way clock_select() does and cluster them.  Returns the number
+ * of survivors, which are left at the front of peers[].
+ */
+static int
+run_select(
+	const struct cand *c,
+	int		n,
+	struct peer *	pp,
+	peer_select *	peers,
+	struct endpoint *endpoint,
+	bool		ref,
+	double *	lowp,
+	double *	highp
+	)
+{
+	double	h;
+	int	i, j;
+
+	for (i = 0; i < n; i++) {
+		pp[i].offset = c[i].offset;
+		pp[i].cfg.flags = c[i].flags;
+		pp[i].new_status = CTL_PST_SEL_SANE;
+		peers[i].peer = &pp[i];
+		peers[i].error = c[i].error;
+		peers[i].synch = c[i].synch;
+		endpoint[2 * i].type = -1;
+		endpoint[2 * i].val = c[i].offset - c[i].synch;
+		endpoint[2 * i + 1].type = 1;
+		endpoint[2 * i + 1].val = c[i].offset + c[i].synch;
+	}
+	if (ref)
+		ref_intersect(endpoint, n, lowp, highp);
+	else
+		select_intersect(&sl, n, lowp, highp);
+
+	for (i = j = 0; i < n; i++) {
+		h = peers[i].synch;
+		if ((*highp <= *lowp || peers[i].peer->offset + h < *lowp ||
+		     peers[i].peer->offset - h > *highp) &&
+		    !(peers[i].peer->cfg.flags & FLAG_TRUE))
+			continue;
+		peers[i].peer->new_status = CTL_PST_SEL_SELCAND;
+		peers[j++] = peers[i];
+	}
+	if (ref)
+		return ref_cluster(peers, j, MINCLOCK, MAXCLOCK);
+	return select_cluster(peers, j, MINCLOCK, MAXCLOCK);
+}
+
+static void
+replay(
+	const struct cand *c,
+	int		n
+	)
+{
+	struct peer *	old = calloc((size_t)n + 1, sizeof(*old));
+	struct peer *	new = calloc((size_t)n + 1, sizeof(*new));
+	peer_select *	ref_peers = calloc((size_t)n + 1, sizeof(*ref_peers));
+	struct endpoint *ref_endpoint =
+	    calloc(2 * (size_t)n + 1, sizeof(*ref_endpoint));
+	double	ref_low, ref_high, low, high;
+	int	ref_n, got_n, i;
+
+	select_grow(&sl, n);
+	ref_n = run_select(c, n, old, ref_peers, ref_endpoint, true,
+			   &ref_low, &ref_high);
+	got_n = run_select(c, n, new, sl.peers, sl.endpoint, false,
+			   &low, &high);
+
+	TEST_ASSERT_EQUAL_DOUBLE(ref_low, low);
+	TEST_ASSERT_EQUAL_DOUBLE(ref_high, high);
+	TEST_ASSERT_EQUAL_INT(ref_n, got_n);
+	for (i = 0; i < n; i++)
+		TEST_ASSERT_EQUAL_INT(old[i].new_status, new[i].new_status);
+	for (i = 0; i < got_n; i++) {
+		TEST_ASSERT_EQUAL_INT(ref_peers[i].peer - old,
+				      sl.peers[i].peer - new);
+		TEST_ASSERT_DOUBLE_WITHIN(1e-12 + 1e-9 * ref_peers[i].seljit,
+					  ref_peers[i].seljit,
+					  sl.peers[i].seljit);
+	}
+	free(old);
+	free(new);
+	free(ref_peers);
+	free(ref_endpoint);
+}
+
+/*
+ * Generated lists: a cluster of truechimers within a millisecond or
+ * so, falsetickers scattered up to a second away, and the odd TRUE
+ * or PREFER peer.  A fixed LCG keeps runs repeatable.
+ */
+static uint32_t lcg_state;
+
+static double
+uniform(double lo, double hi)
+{
+	lcg_state = lcg_state * 1664525 + 1013904223;
+	return lo + (hi - lo) * (lcg_state >> 8) / (double)(1 << 24);
+}
+
+static void
+replay_generated(
+	int	n,
+	double	falseticker,	/* fraction of falsetickers */
+	int	flagged,	/* how many TRUE or PREFER peers */
+	uint32_t seed
+	)
+{
+	struct cand *c = calloc((size_t)n, sizeof(*c));
+	int	i;
+
+	lcg_state = seed;
+	for (i = 0; i < n; i++) {
+		c[i].synch = uniform(1e-3, 5e-2);
+		c[i].error = uniform(1e-6, 1e-3);
+		if (uniform(0, 1) < falseticker)
+			c[i].offset = uniform(-1, 1);
+		else
+			c[i].offset = uniform(-1e-3, 1e-3);
+	}
+	for (i = 0; i < flagged; i++)
+		c[(int)uniform(0, n)].flags =
+		    (i & 1) ? FLAG_PREFER : FLAG_TRUE;
+	replay(c, n);
+	free(c);
+}
+
+
+TEST(select, Recorded) {
+	replay(recorded1, COUNTOF(recorded1));
+	replay(recorded2, COUNTOF(recorded2));
+	replay(recorded3, COUNTOF(recorded3));
+}
+
+TEST(select, Empty) {
+	replay(NULL, 0);
+}
+
+TEST(select, Small) {
+	uint32_t seed;
+	int	n;
+
+	for (seed = 1; seed <= 20; seed++)
+		for (n = 1; n <= 12; n++)
+			replay_generated(n, 0.3, 0, seed);
+}
+
+TEST(select, Falsetickers) {
+	uint32_t seed;
+
+	for (seed = 1; seed <= 10; seed++) {
+		replay_generated(50, 0.1, 0, seed);
+		replay_generated(50, 0.45, 0, seed);
+		replay_generated(50, 0.7, 0, seed);
+	}
+}
+
+TEST(select, Flagged) {
+	uint32_t seed;
+
+	for (seed = 1; seed <= 10; seed++)
+		replay_generated(40, 0.3, 2, seed);
+}
+
+TEST(select, Large) {
+	replay_generated(300, 0.2, 0, 7);
+	replay_generated(300, 0.6, 1, 8);
+}
+
+TEST_GROUP_RUNNER(select) {
+	RUN_TEST_CASE(select, Recorded);
+	RUN_TEST_CASE(select, Empty);
+	RUN_TEST_CASE(select, Small);
+	RUN_TEST_CASE(select, Falsetickers);
+	RUN_TEST_CASE(select, Flagged);
+	RUN_TEST_CASE(select, Large);
+}
@@ -3,7 +3,12 @@
 import unittest
 import ntp.statfiles
 import jigs
+import gzip
+import os
+import shutil
+import struct
 import sys
+import tempfile
 
 
 class TestPylibStatfiles(unittest.TestCase):
@@ -29,6 +34,131 @@ class TestPylibStatfiles(unittest.TestCase):
             "2016-12-06T04:49:46")
 
 
+class TestBinaryStats(unittest.TestCase):
+    target = ntp.statfiles.BinaryStats
+
+    @staticmethod
+    def build(order):
+        "A little peerstats-like file, as ntpd would write it."
+        cols = [(b"time", 8, b"d"), (b"label", 4, b"S"), (b"status", 2, b"H"),
+                (b"t1", 16, b"T")]
+        data = struct.pack(order + "8sHHHHII16s", b"NTPSTATB", 1,
+                           40 + 16 * len(cols), 24, len(cols), 0x01020304,
+                           0, b"teststats")
+        for (name, offset, ctype) in cols:
+            data += struct.pack(order + "12sHcB", name, offset, ctype, 0)
+        # the address doesn't fit one record; id 0 is redefined later
+        data += struct.pack(order + "HHI16s", 1, 16, 0, b"2001:db8::1234:5")
+        data += struct.pack(order + "HHI16s", 2, 1, 0, b"6")
+        data += struct.pack(order + "HHIdQ", 0, 0x961a, 0, 100.5,
+                            (5 << 32) | (1 << 31))
+        data += struct.pack(order + "HHI16s", 1, 3, 0, b"GPS")
+        data += struct.pack(order + "HHIdQ", 0, 0x9014, 0, 101.5, 1 << 32)
+        data += struct.pack(order + "HHIdQ", 0, 0x9014, 0, 102.5, 2 << 32)
+        # a record still being written
+        data += b"\0" * 10
+        return data
+
+    def test_records(self):
+        for order in ("<", ">"):
+            cls = self.target(self.build(order))
+            self.assertEqual(cls.stream, "teststats")
+            self.assertEqual(cls.names, ["time", "label", "status", "t1"])
+            self.assertEqual(cls.nrec, 6)
+            self.assertEqual(cls.records(),
+                             [[100.5, "2001:db8::1234:56", 0x961a,
+                               (5 << 32) | (1 << 31)],
+                              [101.5, "GPS", 0x9014, 1 << 32],
+                              [102.5, "GPS", 0x9014, 2 << 32]])
+            self.assertEqual(cls.records(101, 101.5),
+                             [[101.5, "GPS", 0x9014, 1 << 32]])
+            self.assertEqual(cls.records(103, 200), [])
+            self.assertEqual(cls.unixized(100, 101.5),
+                             [[100500, 100.5, "2001:db8::1234:56", 0x961a,
+                               "5.500000000"],
+                              [101500, 101.5, "GPS", 0x9014,
+                               "1.000000000"]])
+
+    def test_not_binary(self):
+        self.assertRaises(ValueError, self.target, b"40594 10\n")
+        self.assertEqual(self.target.open("/nonexistent/loopstats"), None)
+
+
+class TestStatStream(unittest.TestCase):
+    target = ntp.statfiles.StatStream
+
+    def setUp(self):
+        self.dir = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.dir)
+
+    def part(self, name, lines):
+        path = os.path.join(self.dir, name)
+        if name.endswith("gz"):
+            fp = gzip.open(path, "wt")
+        else:
+            fp = open(path, "w")
+        with fp:
+            fp.write("".join(lines))
+        return path
+
+    def test_stream(self):
+        # MJD 40587 is the Unix epoch; the two parts overlap
+        one = self.part("peerstats.1", ["40587 %d 10.0.0.%d 9614 0.5\n"
+                                        % (t, t % 2) for t in range(0, 60, 2)])
+        two = self.part("peerstats.2.gz", ["40587 %d 10.0.0.%d 9614 0.5\n"
+                                           % (t, t % 2)
+                                           for t in range(51, 100, 2)])
+        cls = self.target([two, one], 20, 60)
+        cls.CHUNK = 64      # several runs from each part
+        rows = list(cls)
+        self.assertEqual([row[0] for row in rows],
+                         [t * 1000 for t in list(range(20, 50, 2)) +
+                          list(range(50, 60))])
+        self.assertEqual(rows[0], [20000, "20.0", "10.0.0.0", "9614", "0.5"])
+        self.assertEqual([row[0] for row in cls.where(2, "10.0.0.1")],
+                         [51000, 53000, 55000, 57000, 59000])
+        self.assertTrue(cls)
+        self.assertFalse(self.target([one, two], 200, 300))
+        self.assertFalse(self.target([], 0, 300))
+
+    def test_unix(self):
+        temps = self.part("temps0", ["# comment\n", "10.5 1 cpu 40\n",
+                                     "11.5 1 cpu 41\n"])
+        self.assertEqual(list(self.target([temps], 11, 20, unix=True)),
+                         [[11500, "11.5", "1", "cpu", "41"]])
+
+
+class TestStatColumns(unittest.TestCase):
+    target = ntp.statfiles.StatColumns
+
+    rows = [[1000, "1.0", "a", "0.5", "2"],
+            [2000, "2.0", "b", "bogus", "3"],
+            [3000, "3.0", "a", "0.25"],
+            [9000, "9000.0", "a", "0.75", "1"]]
+
+    def test_read(self):
+        cls = self.target.read(self.rows, (3, 4))
+        self.assertEqual(len(cls), 4)
+        self.assertEqual(list(cls.times), [1.0, 2.0, 3.0, 9000.0])
+        (times, cols) = cls.select(3, 4)
+        self.assertEqual(list(times), [1.0, 9000.0])
+        self.assertEqual([list(col) for col in cols],
+                         [[0.5, 0.75], [2.0, 1.0]])
+        self.assertEqual(list(cls.sorted(3)), [0.25, 0.5, 0.75])
+        self.assertEqual(list(cls.sorted(4, (3, 4))), [1.0, 2.0])
+        self.assertEqual(cls.plot(3),
+                         "1.000 0.5\n3.000 0.25\n\n9000.000 0.75\ne\n")
+        self.assertEqual(self.target.read([], (3,)).plot(3), "e\n")
+
+    def test_split(self):
+        cls = self.target.read(self.rows, (3,), split=2)
+        self.assertEqual(sorted(cls.keys()), ["a", "b"])
+        self.assertEqual(list(cls["a"].sorted(3)), [0.25, 0.5, 0.75])
+        self.assertEqual(len(cls["b"].sorted(3)), 0)
+
+
 class TestNTPStats(unittest.TestCase):
     target = ntp.statfiles.NTPStats
 